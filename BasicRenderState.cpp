@@ -274,6 +274,7 @@ void BasicRenderState::Exit()
         ID3D11Buffer* nullVB[1] = { nullptr };
         context->IASetVertexBuffers(0, 1, nullVB, &stride, &offset);
         context->IASetIndexBuffer(nullptr, DXGI_FORMAT_UNKNOWN, 0);
+        _pGraphicsRef->GetStateCache().Invalidate();  // 캐시를 거치지 않고 풀었다
 
         // 렌더 타겟 클리어 (ZGraphics 메서드 사용)
         _pGraphicsRef->ClearBuffer(0.0f, 0.0f, 0.0f);
@@ -334,15 +335,36 @@ void BasicRenderState::Render(ZGraphics& gfx)
     //for (auto& b : sheets) b->Render(gfx);
 
     // LIGHT
-    for (auto& b : lightBoxes) b->Render(gfx);
-    for (auto& b : lightCylinder) b->Render(gfx);
-    for (auto& b : lightPyramid) b->Render(gfx);
-    for (auto& b : textureBox) b->Render(gfx);
-    for (auto& m : meshModel) m->Render(gfx);
+    // 셰이더(타입)/재질별로 모아 앞에서 뒤로 그린다
+    // 인스턴싱 모드: 정적 지오메트리를 공유하는 타입은 타입마다 배치 패킷 하나 (실행 시 DrawIndexedInstanced 한 번)
+    renderQueue.Begin(gfx.GetCamera());
+    const size_t packetsBefore = renderQueue.GetPackets().size();
+    if (useInstancing)
+    {
+        for (auto& b : lightBoxes) b->SubmitInstance();
+        for (auto& b : textureBox) b->SubmitInstance();
+        for (auto& m : meshModel) m->SubmitInstance();
+        for (const ZRenderable* batch : { LightBox::GetInstanceBatch(), TexturedBox::GetInstanceBatch(), MeshTest::GetInstanceBatch() })
+        {
+            if (batch) renderQueue.Submit(*batch);
+        }
+    }
+    else
+    {
+        for (auto& b : lightBoxes) renderQueue.Submit(*b);
+        for (auto& b : textureBox) renderQueue.Submit(*b);
+        for (auto& m : meshModel) renderQueue.Submit(*m);
+    }
+    boxMeshDraws = static_cast<UINT>(renderQueue.GetPackets().size() - packetsBefore);
+    for (auto& b : lightCylinder) renderQueue.Submit(*b);
+    for (auto& b : lightPyramid) renderQueue.Submit(*b);
 
-    //fbxStaticModel->Render(gfx);
-    //fbxTBNModel->Render(gfx);
-    fbxSkinnedModel->Render(gfx);
+    //renderQueue.Submit(*fbxStaticModel);
+    //renderQueue.Submit(*fbxTBNModel);
+    renderQueue.Submit(*fbxSkinnedModel);
+
+    renderQueue.Sort();
+    renderQueue.Execute(gfx);
 
     //for (auto& s : markerSpheres) s->Render(gfx);  // 마커 먼저
 
@@ -430,6 +452,10 @@ void BasicRenderState::SpawnLightBoxWindowManager(ZGraphics& gfx)
             boxControlIds.insert(*comboBoxIndex);
             comboBoxIndex.reset();
         }
+
+        ImGui::Checkbox("Hardware Instancing", &useInstancing);
+        const size_t instanced = lightBoxes.size() + textureBox.size() + meshModel.size();
+        ImGui::Text("Box/Mesh draws: %u (%zu objects)", boxMeshDraws, instanced);
     }
     ImGui::End();
 }
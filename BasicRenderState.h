@@ -2,6 +2,7 @@
 #include "GameState.h"
 #include "SpriteBatch.h"
 #include "ZTexture.h"
+#include "ZRenderQueue.h"
 #include <set>
 #include <optional>
 
@@ -29,6 +30,10 @@ private:
     std::unique_ptr<class FbxTBNModel> fbxTBNModel;
     std::unique_ptr<class FbxSkinnedModel> fbxSkinnedModel;
 
+    ZRenderQueue renderQueue;   // 프레임마다 제출 → 정렬 → 실행
+    bool useInstancing = true;  // LightBox/TexturedBox/MeshTest: 타입마다 배치 패킷 하나 (DrawIndexedInstanced 한 번)
+    UINT boxMeshDraws = 0;      // 지난 프레임 LightBox/TexturedBox/MeshTest 렌더 큐 패킷 수 (= 드로우 호출 수)
+
     std::unique_ptr<DirectX::SpriteBatch> pSpriteBatch;
     std::unique_ptr<Bind::ZTexture> pTexture;
 
@@ -29,16 +29,16 @@ public:
         // the center
         vertices.emplace_back();
         vertices.back().pos = { 0.0f,0.0f,-1.0f };
-        const auto iCenter = (unsigned short)(vertices.size() - 1);
+        const auto iCenter = (uint32_t)(vertices.size() - 1);
         // the tip :darkness:
         vertices.emplace_back();
         vertices.back().pos = { 0.0f,0.0f,1.0f };
-        const auto iTip = (unsigned short)(vertices.size() - 1);
+        const auto iTip = (uint32_t)(vertices.size() - 1);
 
 
         // base indices
-        std::vector<unsigned short> indices;
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        std::vector<uint32_t> indices;
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             indices.push_back(iCenter);
             indices.push_back((iLong + 1) % longDiv);
@@ -46,7 +46,7 @@ public:
         }
 
         // cone indices
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             indices.push_back(iLong);
             indices.push_back((iLong + 1) % longDiv);
@@ -67,7 +67,7 @@ public:
         std::vector<V> vertices;
 
         // cone vertices
-        const auto iCone = (unsigned short)vertices.size();
+        const auto iCone = (uint32_t)vertices.size();
         for (int iLong = 0; iLong < longDiv; iLong++)
         {
             const float thetas[] = {
@@ -87,10 +87,10 @@ public:
             }
         }
         // base vertices
-        const auto iBaseCenter = (unsigned short)vertices.size();
+        const auto iBaseCenter = (uint32_t)vertices.size();
         vertices.emplace_back();
         vertices.back().pos = { 0.0f,0.0f,-1.0f };
-        const auto iBaseEdge = (unsigned short)vertices.size();
+        const auto iBaseEdge = (uint32_t)vertices.size();
         for (int iLong = 0; iLong < longDiv; iLong++)
         {
             vertices.emplace_back();
@@ -101,15 +101,15 @@ public:
             dx::XMStoreFloat3(&vertices.back().pos, v);
         }
 
-        std::vector<unsigned short> indices;
+        std::vector<uint32_t> indices;
 
         // cone indices
-        for (unsigned short i = 0; i < longDiv * 3; i++)
+        for (int i = 0; i < longDiv * 3; i++)
         {
             indices.push_back(i + iCone);
         }
         // base indices
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             indices.push_back(iBaseCenter);
             indices.push_back((iLong + 1) % longDiv + iBaseEdge);
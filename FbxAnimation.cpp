@@ -0,0 +1,1126 @@
+﻿#include "FbxAnimation.h"
+#include "FbxAnimationBatch.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace DirectX;
+
+namespace
+{
+    thread_local std::ostream* t_logSink = nullptr;   // FbxAnim::ScopedLogCapture
+
+    // 키 커서를 앞으로만 이동시키며 보간 (샘플 시간이 단조 증가하므로 전체 O(keys + frames))
+    template<typename Key>
+    void AdvanceKey(const Key* keys, unsigned int numKeys, double time, unsigned int& cursor, unsigned int& next, float& factor)
+    {
+        while (cursor + 1 < numKeys && time >= keys[cursor + 1].mTime)
+        {
+            ++cursor;
+        }
+
+        if (cursor + 1 >= numKeys)
+        {
+            next = cursor;
+            factor = 0.0f;
+            return;
+        }
+
+        next = cursor + 1;
+        const double span = keys[next].mTime - keys[cursor].mTime;
+        double t = (span > 0.0) ? (time - keys[cursor].mTime) / span : 0.0;
+        factor = static_cast<float>((std::clamp)(t, 0.0, 1.0));
+    }
+
+    XMFLOAT3 LerpKey(const aiVectorKey& a, const aiVectorKey& b, float f)
+    {
+        return XMFLOAT3(
+            a.mValue.x + f * (b.mValue.x - a.mValue.x),
+            a.mValue.y + f * (b.mValue.y - a.mValue.y),
+            a.mValue.z + f * (b.mValue.z - a.mValue.z));
+    }
+
+    // Legacy key-scan sampler (이전 FbxManager::Interpolate* 와 동일) - 벤치마크 기준용
+    aiVector3D ScanVectorKeys(double time, const aiVectorKey* keys, unsigned int numKeys)
+    {
+        if (numKeys == 1)
+            return keys[0].mValue;
+
+        unsigned int frame = 0;
+        for (unsigned int i = 0; i < numKeys - 1; ++i)
+        {
+            if (time < keys[i + 1].mTime)
+            {
+                frame = i;
+                break;
+            }
+        }
+
+        unsigned int nextFrame = (frame + 1) % numKeys;
+        const aiVectorKey& key = keys[frame];
+        const aiVectorKey& nextKey = keys[nextFrame];
+
+        double factor = (time - key.mTime) / (nextKey.mTime - key.mTime);
+
+        aiVector3D result;
+        result.x = static_cast<float>(key.mValue.x + factor * (nextKey.mValue.x - key.mValue.x));
+        result.y = static_cast<float>(key.mValue.y + factor * (nextKey.mValue.y - key.mValue.y));
+        result.z = static_cast<float>(key.mValue.z + factor * (nextKey.mValue.z - key.mValue.z));
+        return result;
+    }
+
+    aiQuaternion ScanQuatKeys(double time, const aiQuatKey* keys, unsigned int numKeys)
+    {
+        if (numKeys == 1)
+            return keys[0].mValue;
+
+        unsigned int frame = 0;
+        for (unsigned int i = 0; i < numKeys - 1; ++i)
+        {
+            if (time < keys[i + 1].mTime)
+            {
+                frame = i;
+                break;
+            }
+        }
+
+        unsigned int nextFrame = (frame + 1) % numKeys;
+        const aiQuatKey& key = keys[frame];
+        const aiQuatKey& nextKey = keys[nextFrame];
+
+        float factor = static_cast<float>((time - key.mTime) / (nextKey.mTime - key.mTime));
+
+        aiQuaternion result;
+        aiQuaternion::Interpolate(result, key.mValue, nextKey.mValue, factor);
+        result.Normalize();
+        return result;
+    }
+
+    aiMatrix4x4 ScanChannelLocal(double time, const aiNodeAnim* channel)
+    {
+        aiVector3D pos = ScanVectorKeys(time, channel->mPositionKeys, channel->mNumPositionKeys);
+        aiQuaternion rot = ScanQuatKeys(time, channel->mRotationKeys, channel->mNumRotationKeys);
+        aiVector3D scale = ScanVectorKeys(time, channel->mScalingKeys, channel->mNumScalingKeys);
+
+        aiMatrix4x4 matScale, matTrans;
+        aiMatrix4x4::Scaling(scale, matScale);
+        aiMatrix4x4 matRot = aiMatrix4x4(rot.GetMatrix());
+        aiMatrix4x4::Translation(pos, matTrans);
+        return matTrans * matRot * matScale;
+    }
+
+    XMFLOAT4X4 ToFloat4x4(const aiMatrix4x4& m)
+    {
+        return XMFLOAT4X4(
+            m.a1, m.a2, m.a3, m.a4,
+            m.b1, m.b2, m.b3, m.b4,
+            m.c1, m.c2, m.c3, m.c4,
+            m.d1, m.d2, m.d3, m.d4);
+    }
+
+    // Uniformly resampled clip before compression (frame-major: [frame * trackCount + track])
+    struct RawClipSamples
+    {
+        uint32_t trackCount = 0;
+        std::vector<XMFLOAT3> positions;
+        std::vector<XMFLOAT4> rotations;    // hemisphere-aligned per track
+        std::vector<XMFLOAT3> scales;
+    };
+
+    XMMATRIX RawTrackLocal(const RawClipSamples& raw, uint32_t frame, uint32_t track)
+    {
+        const size_t i = static_cast<size_t>(frame) * raw.trackCount + track;
+        return XMMatrixTranspose(XMMatrixAffineTransformation(
+            XMLoadFloat3(&raw.scales[i]), XMVectorZero(), XMLoadFloat4(&raw.rotations[i]), XMLoadFloat3(&raw.positions[i])));
+    }
+
+    // Resample one channel into a track of raw (rotations hemisphere-aligned along the track)
+    void ResampleChannel(const aiNodeAnim* channel, const FbxAnimClip& clip, RawClipSamples& raw, uint32_t track)
+    {
+        const uint32_t trackCount = raw.trackCount;
+
+        if (channel->mNumPositionKeys == 0 || channel->mNumRotationKeys == 0 || channel->mNumScalingKeys == 0)
+        {
+            // 키가 없는 채널은 항등 변환으로 채운다
+            for (uint32_t f = 0; f < clip.frameCount; ++f)
+            {
+                const size_t i = static_cast<size_t>(f) * trackCount + track;
+                raw.positions[i] = XMFLOAT3(0.0f, 0.0f, 0.0f);
+                raw.rotations[i] = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+                raw.scales[i] = XMFLOAT3(1.0f, 1.0f, 1.0f);
+            }
+            return;
+        }
+
+        unsigned int posCursor = 0, rotCursor = 0, sclCursor = 0;
+        XMVECTOR prevRot = XMQuaternionIdentity();
+
+        for (uint32_t f = 0; f < clip.frameCount; ++f)
+        {
+            const double ticks = (static_cast<double>(f) / clip.sampleRate) * clip.ticksPerSecond;
+            const size_t i = static_cast<size_t>(f) * trackCount + track;
+            unsigned int next;
+            float factor;
+
+            AdvanceKey(channel->mPositionKeys, channel->mNumPositionKeys, ticks, posCursor, next, factor);
+            raw.positions[i] = LerpKey(channel->mPositionKeys[posCursor], channel->mPositionKeys[next], factor);
+
+            AdvanceKey(channel->mScalingKeys, channel->mNumScalingKeys, ticks, sclCursor, next, factor);
+            raw.scales[i] = LerpKey(channel->mScalingKeys[sclCursor], channel->mScalingKeys[next], factor);
+
+            AdvanceKey(channel->mRotationKeys, channel->mNumRotationKeys, ticks, rotCursor, next, factor);
+            aiQuaternion q;
+            aiQuaternion::Interpolate(q, channel->mRotationKeys[rotCursor].mValue, channel->mRotationKeys[next].mValue, factor);
+            q.Normalize();
+
+            // 인접 샘플이 같은 반구에 있도록 부호 정렬 (키 제거 시 보간 오차 측정 기준)
+            XMVECTOR rot = XMVectorSet(q.x, q.y, q.z, q.w);
+            if (f > 0 && XMVectorGetX(XMVector4Dot(prevRot, rot)) < 0.0f)
+            {
+                rot = XMVectorNegate(rot);
+            }
+            XMStoreFloat4(&raw.rotations[i], rot);
+            prevRot = rot;
+        }
+    }
+
+    // Pivot helper chains of a source tree (FbxAnim::FoldPivotChain 기준)
+    struct PivotChain
+    {
+        const aiNode* owner = nullptr;
+        std::vector<const aiNode*> helpers;     // top → bottom
+    };
+
+    struct PivotFolding
+    {
+        std::unordered_map<std::string, PivotChain> chainOfOwner;
+        std::unordered_map<std::string, std::string> ownerOfHelper;
+    };
+
+    PivotFolding CollectPivotChains(const aiNode* rootNode)
+    {
+        PivotFolding folding;
+        std::vector<const aiNode*> stack;
+        if (rootNode)
+            stack.push_back(rootNode);
+
+        while (!stack.empty())
+        {
+            const aiNode* node = stack.back();
+            stack.pop_back();
+
+            XMFLOAT4X4 local;
+            PivotChain chain;
+            chain.owner = FbxAnim::FoldPivotChain(node, local, &chain.helpers);
+            for (unsigned int i = 0; i < chain.owner->mNumChildren; ++i)
+            {
+                stack.push_back(chain.owner->mChildren[i]);
+            }
+
+            if (!chain.helpers.empty())
+            {
+                for (const aiNode* helper : chain.helpers)
+                {
+                    folding.ownerOfHelper[helper->mName.C_Str()] = chain.owner->mName.C_Str();
+                }
+                folding.chainOfOwner[chain.owner->mName.C_Str()] = std::move(chain);
+            }
+        }
+        return folding;
+    }
+
+    // Folded track: chain locals (sampled channel, or rest local without one) multiplied per frame,
+    // then decomposed back into TRS. 헬퍼 체인에 비균등 스케일 + 회전이 섞이면 전단(shear)은 표현할 수 없다.
+    void ResampleFoldedChain(const PivotChain& chain, const std::unordered_map<std::string, const aiNodeAnim*>& channelOfNode,
+                             const FbxAnimClip& clip, RawClipSamples& raw, uint32_t track)
+    {
+        std::vector<const aiNode*> members(chain.helpers);
+        members.push_back(chain.owner);
+
+        // Each member on its own single-track scratch
+        std::vector<RawClipSamples> sampled(members.size());
+        std::vector<XMFLOAT4X4> rest(members.size());
+        std::vector<bool> animated(members.size(), false);
+        for (size_t m = 0; m < members.size(); ++m)
+        {
+            rest[m] = ToFloat4x4(members[m]->mTransformation);
+            auto it = channelOfNode.find(members[m]->mName.C_Str());
+            if (it == channelOfNode.end())
+                continue;
+
+            animated[m] = true;
+            sampled[m].trackCount = 1;
+            sampled[m].positions.resize(clip.frameCount);
+            sampled[m].rotations.resize(clip.frameCount);
+            sampled[m].scales.resize(clip.frameCount);
+            ResampleChannel(it->second, clip, sampled[m], 0);
+        }
+
+        XMVECTOR prevRot = XMQuaternionIdentity();
+        for (uint32_t f = 0; f < clip.frameCount; ++f)
+        {
+            // Assimp 레이아웃(열 벡터): parent-side helper가 왼쪽
+            XMMATRIX local = XMMatrixIdentity();
+            for (size_t m = 0; m < members.size(); ++m)
+            {
+                const XMMATRIX member = animated[m] ? RawTrackLocal(sampled[m], f, 0) : XMLoadFloat4x4(&rest[m]);
+                local = XMMatrixMultiply(local, member);
+            }
+
+            XMVECTOR scale, rot, pos;
+            if (!XMMatrixDecompose(&scale, &rot, &pos, XMMatrixTranspose(local)))
+            {
+                // 스케일이 0에 가까운 프레임: 이동만 살리고 회전은 이전 샘플 유지
+                XMFLOAT4X4 m;
+                XMStoreFloat4x4(&m, local);
+                scale = XMVectorZero();
+                rot = prevRot;
+                pos = XMVectorSet(m._14, m._24, m._34, 0.0f);
+            }
+            rot = XMQuaternionNormalize(rot);
+            if (f > 0 && XMVectorGetX(XMVector4Dot(prevRot, rot)) < 0.0f)
+            {
+                rot = XMVectorNegate(rot);
+            }
+
+            const size_t i = static_cast<size_t>(f) * raw.trackCount + track;
+            XMStoreFloat3(&raw.positions[i], pos);
+            XMStoreFloat4(&raw.rotations[i], rot);
+            XMStoreFloat3(&raw.scales[i], scale);
+            prevRot = rot;
+        }
+    }
+
+    // ---- Quantization ----
+    constexpr float kQuatComponentRange = 0.70710678f;   // smallest-three 성분은 [-1/sqrt2, 1/sqrt2]
+    constexpr float kQuat15Max = 32767.0f;
+
+    uint16_t QuantizeUnorm16(float value, float minValue, float step)
+    {
+        if (step <= 0.0f)
+            return 0;
+        const float q = (value - minValue) / step;
+        return static_cast<uint16_t>((std::clamp)(q + 0.5f, 0.0f, 65535.0f));
+    }
+
+    void PackQuat48(const XMFLOAT4& q, uint16_t* out)
+    {
+        const float c[4] = { q.x, q.y, q.z, q.w };
+        int largest = 0;
+        for (int i = 1; i < 4; ++i)
+        {
+            if (std::abs(c[i]) > std::abs(c[largest]))
+                largest = i;
+        }
+
+        // q와 -q는 같은 회전 → 최대 성분을 양수로 만들어 부호 비트를 생략
+        const float sign = (c[largest] < 0.0f) ? -1.0f : 1.0f;
+        uint64_t bits = static_cast<uint64_t>(largest);
+        for (int i = 0; i < 4; ++i)
+        {
+            if (i == largest)
+                continue;
+            const float t = (c[i] * sign + kQuatComponentRange) / (2.0f * kQuatComponentRange);
+            const uint64_t v = static_cast<uint64_t>((std::clamp)(t, 0.0f, 1.0f) * kQuat15Max + 0.5f);
+            bits = (bits << 15) | v;
+        }
+
+        out[0] = static_cast<uint16_t>(bits >> 32);
+        out[1] = static_cast<uint16_t>(bits >> 16);
+        out[2] = static_cast<uint16_t>(bits);
+    }
+
+    XMVECTOR UnpackQuat48(const uint16_t* in)
+    {
+        const uint64_t bits = (static_cast<uint64_t>(in[0]) << 32) | (static_cast<uint64_t>(in[1]) << 16) | in[2];
+        const int largest = static_cast<int>((bits >> 45) & 0x3);
+
+        float c[4];
+        float sumSq = 0.0f;
+        int shift = 30;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (i == largest)
+                continue;
+            const float v = static_cast<float>((bits >> shift) & 0x7FFF) * (2.0f * kQuatComponentRange / kQuat15Max) - kQuatComponentRange;
+            c[i] = v;
+            sumSq += v * v;
+            shift -= 15;
+        }
+        c[largest] = std::sqrt((std::max)(0.0f, 1.0f - sumSq));
+        return XMVectorSet(c[0], c[1], c[2], c[3]);
+    }
+
+    XMVECTOR DecodeVec3(const uint16_t* in, const XMFLOAT3& minValue, const XMFLOAT3& step)
+    {
+        const XMVECTOR q = XMVectorSet(static_cast<float>(in[0]), static_cast<float>(in[1]), static_cast<float>(in[2]), 0.0f);
+        return XMVectorMultiplyAdd(q, XMLoadFloat3(&step), XMLoadFloat3(&minValue));
+    }
+
+    // Key segment around frame position (cursor.frame0 + cursor.alpha); returns interpolation factor
+    float FindKeySegment(const uint16_t* frames, uint32_t count, const FbxAnimSampleCursor& cursor, uint32_t& k0, uint32_t& k1)
+    {
+        if (count <= 1)
+        {
+            k0 = k1 = 0;
+            return 0.0f;
+        }
+
+        // 첫 키는 항상 프레임 0, 마지막 키는 항상 마지막 프레임
+        const uint16_t* it = std::upper_bound(frames + 1, frames + count, static_cast<uint16_t>(cursor.frame0));
+        k1 = static_cast<uint32_t>(it - frames);
+        if (k1 >= count)
+        {
+            k0 = k1 = count - 1;
+            return 0.0f;
+        }
+
+        k0 = k1 - 1;
+        const float span = static_cast<float>(frames[k1] - frames[k0]);
+        return (static_cast<float>(cursor.frame0 - frames[k0]) + cursor.alpha) / span;
+    }
+
+    // ---- Key reduction ----
+    float Vec3Distance(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&a), XMLoadFloat3(&b))));
+    }
+
+    // Rotation angle between two unit quaternions (현 길이 기반 → 작은 각도에서도 acos보다 float 오차가 적다)
+    float QuatAngle(FXMVECTOR a, FXMVECTOR b)
+    {
+        const XMVECTOR bAligned = (XMVectorGetX(XMVector4Dot(a, b)) < 0.0f) ? XMVectorNegate(b) : b;
+        const float chord = XMVectorGetX(XMVector4Length(XMVectorSubtract(a, bAligned)));
+        return 4.0f * std::asin((std::min)(1.0f, 0.5f * chord));
+    }
+
+    // 모든 프레임이 첫 샘플과 허용 오차 안이면 상수 채널
+    template<typename ErrorFn>
+    bool IsConstantChannel(uint32_t frameCount, float tolerance, ErrorFn errorToFirst)
+    {
+        for (uint32_t f = 1; f < frameCount; ++f)
+        {
+            if (errorToFirst(f) > tolerance)
+                return false;
+        }
+        return true;
+    }
+
+    // Greedy reduction: 현재 키에서 출발해 중간 프레임이 선형 보간으로 허용 오차 안에 재현되는 한 구간을 늘린다.
+    // segmentError(a, b, f): 키 a, b 사이 보간값과 프레임 f 원본 샘플의 오차
+    template<typename ErrorFn>
+    void ReduceKeys(uint32_t frameCount, float tolerance, ErrorFn segmentError, std::vector<uint32_t>& outFrames)
+    {
+        outFrames.clear();
+        outFrames.push_back(0);
+
+        uint32_t start = 0;
+        while (start + 1 < frameCount)
+        {
+            uint32_t end = start + 1;
+            while (end + 1 < frameCount)
+            {
+                const uint32_t candidate = end + 1;
+                bool fits = true;
+                for (uint32_t f = start + 1; f < candidate && fits; ++f)
+                {
+                    fits = segmentError(start, candidate, f) <= tolerance;
+                }
+                if (!fits)
+                    break;
+                end = candidate;
+            }
+            outFrames.push_back(end);
+            start = end;
+        }
+    }
+
+    struct CompressionStats
+    {
+        size_t totalKeys = 0;        // frames * channels before compression
+        size_t keptKeys = 0;
+        uint32_t constantChannels = 0;
+    };
+
+    void AppendKey(FbxAnimClip& clip, uint32_t frame, const uint16_t* data)
+    {
+        clip.keyFrames.push_back(static_cast<uint16_t>(frame));
+        clip.keyData.insert(clip.keyData.end(), data, data + 3);
+    }
+
+    void CompressVec3Channel(const RawClipSamples& raw, const std::vector<XMFLOAT3>& samples, uint32_t track, uint32_t frameCount,
+                             float tolerance, FbxAnimClip& clip, uint32_t& firstKey, uint16_t& keyCount,
+                             XMFLOAT3& minValue, XMFLOAT3& step, CompressionStats& stats, std::vector<uint32_t>& keyScratch)
+    {
+        auto sample = [&](uint32_t f) -> const XMFLOAT3& { return samples[static_cast<size_t>(f) * raw.trackCount + track]; };
+
+        // Per-track range
+        XMVECTOR lo = XMLoadFloat3(&sample(0));
+        XMVECTOR hi = lo;
+        for (uint32_t f = 1; f < frameCount; ++f)
+        {
+            const XMVECTOR v = XMLoadFloat3(&sample(f));
+            lo = XMVectorMin(lo, v);
+            hi = XMVectorMax(hi, v);
+        }
+
+        const bool constant = IsConstantChannel(frameCount, tolerance,
+            [&](uint32_t f) { return Vec3Distance(sample(0), sample(f)); });
+
+        if (constant)
+        {
+            keyScratch.assign(1, 0);
+            lo = XMLoadFloat3(&sample(0));
+            hi = lo;
+            ++stats.constantChannels;
+        }
+        else
+        {
+            ReduceKeys(frameCount, tolerance, [&](uint32_t a, uint32_t b, uint32_t f)
+            {
+                const float t = static_cast<float>(f - a) / static_cast<float>(b - a);
+                XMFLOAT3 interp;
+                XMStoreFloat3(&interp, XMVectorLerp(XMLoadFloat3(&sample(a)), XMLoadFloat3(&sample(b)), t));
+                return Vec3Distance(interp, sample(f));
+            }, keyScratch);
+        }
+
+        XMStoreFloat3(&minValue, lo);
+        XMStoreFloat3(&step, XMVectorScale(XMVectorSubtract(hi, lo), 1.0f / 65535.0f));
+
+        firstKey = static_cast<uint32_t>(clip.keyFrames.size());
+        keyCount = static_cast<uint16_t>(keyScratch.size());
+        for (uint32_t f : keyScratch)
+        {
+            const XMFLOAT3& v = sample(f);
+            const uint16_t data[3] = {
+                QuantizeUnorm16(v.x, minValue.x, step.x),
+                QuantizeUnorm16(v.y, minValue.y, step.y),
+                QuantizeUnorm16(v.z, minValue.z, step.z) };
+            AppendKey(clip, f, data);
+        }
+
+        stats.totalKeys += frameCount;
+        stats.keptKeys += keyScratch.size();
+    }
+
+    void CompressRotationChannel(const RawClipSamples& raw, uint32_t track, uint32_t frameCount, float tolerance,
+                                 FbxAnimClip& clip, FbxAnimTrack& outTrack, CompressionStats& stats, std::vector<uint32_t>& keyScratch)
+    {
+        auto sample = [&](uint32_t f) { return XMLoadFloat4(&raw.rotations[static_cast<size_t>(f) * raw.trackCount + track]); };
+
+        const bool constant = IsConstantChannel(frameCount, tolerance,
+            [&](uint32_t f) { return QuatAngle(sample(0), sample(f)); });
+
+        if (constant)
+        {
+            keyScratch.assign(1, 0);
+            ++stats.constantChannels;
+        }
+        else
+        {
+            // 원본 샘플은 반구 정렬돼 있으므로 그대로 nlerp
+            ReduceKeys(frameCount, tolerance, [&](uint32_t a, uint32_t b, uint32_t f)
+            {
+                const float t = static_cast<float>(f - a) / static_cast<float>(b - a);
+                return QuatAngle(XMQuaternionNormalize(XMVectorLerp(sample(a), sample(b), t)), sample(f));
+            }, keyScratch);
+        }
+
+        outTrack.rotFirstKey = static_cast<uint32_t>(clip.keyFrames.size());
+        outTrack.rotKeyCount = static_cast<uint16_t>(keyScratch.size());
+        for (uint32_t f : keyScratch)
+        {
+            uint16_t data[3];
+            PackQuat48(raw.rotations[static_cast<size_t>(f) * raw.trackCount + track], data);
+            AppendKey(clip, f, data);
+        }
+
+        stats.totalKeys += frameCount;
+        stats.keptKeys += keyScratch.size();
+    }
+
+    // 압축 크기/키 수 요약 (항상 출력, 비용은 트랙 수에 비례)
+    void ReportCompressionSize(const FbxAnimClip& clip, const RawClipSamples& raw, const CompressionStats& stats)
+    {
+        const size_t rawBytes = (raw.positions.size() + raw.scales.size()) * sizeof(XMFLOAT3) + raw.rotations.size() * sizeof(XMFLOAT4);
+        const size_t packedBytes = clip.tracks.size() * sizeof(FbxAnimTrack) + (clip.keyFrames.size() + clip.keyData.size()) * sizeof(uint16_t);
+
+        FbxAnim::Log() << "[FbxAnim] Compression '" << clip.name << "': " << rawBytes / 1024 << " KB -> " << packedBytes / 1024
+                  << " KB (x" << (packedBytes > 0 ? static_cast<double>(rawBytes) / packedBytes : 0.0) << "), keys "
+                  << stats.keptKeys << "/" << stats.totalKeys << ", constant channels " << stats.constantChannels
+                  << "/" << clip.GetTrackCount() * 3 << std::endl;
+    }
+
+    // World-space bone end-point error: 원본 재샘플 vs 압축 클립을 소스 휴지 계층으로 전역 변환해서 노드 원점 거리를 비교
+    // O(nodes x frames) 행렬 곱이라 FbxAnimCompressionSettings::reportError일 때만 호출
+    void ReportCompressionError(const FbxAnimClip& clip, const RawClipSamples& raw)
+    {
+        const size_t nodeCount = clip.restNodeNames.size();
+
+        std::unordered_map<std::string, int> trackOfName;
+        for (uint32_t track = 0; track < clip.GetTrackCount(); ++track)
+        {
+            trackOfName.emplace(clip.trackNodeNames[track], static_cast<int>(track));
+        }
+
+        std::vector<int> trackOfNode(nodeCount, -1);
+        for (size_t n = 0; n < nodeCount; ++n)
+        {
+            auto it = trackOfName.find(clip.restNodeNames[n]);
+            if (it != trackOfName.end())
+                trackOfNode[n] = it->second;
+        }
+
+        std::vector<XMMATRIX> rawGlobals(nodeCount);
+        std::vector<XMMATRIX> packedGlobals(nodeCount);
+        float maxError = 0.0f;
+        double sumError = 0.0;
+        size_t measured = 0;
+        size_t worstNode = 0;
+        uint32_t worstFrame = 0;
+
+        for (uint32_t f = 0; f < clip.frameCount; ++f)
+        {
+            FbxAnimSampleCursor cursor;
+            cursor.frame0 = f;
+            cursor.frame1 = f;
+
+            for (size_t n = 0; n < nodeCount; ++n)
+            {
+                const int track = trackOfNode[n];
+                const XMMATRIX rest = XMLoadFloat4x4(&clip.restNodeLocals[n]);
+                const XMMATRIX rawLocal = (track >= 0) ? RawTrackLocal(raw, f, static_cast<uint32_t>(track)) : rest;
+                const XMMATRIX packedLocal = (track >= 0) ? FbxAnim::SampleTrackLocal(clip, static_cast<uint32_t>(track), cursor) : rest;
+
+                const int parent = clip.restNodeParents[n];
+                rawGlobals[n] = (parent >= 0) ? XMMatrixMultiply(rawGlobals[parent], rawLocal) : rawLocal;
+                packedGlobals[n] = (parent >= 0) ? XMMatrixMultiply(packedGlobals[parent], packedLocal) : packedLocal;
+
+                // Assimp 레이아웃: 이동 성분은 4번째 열
+                XMFLOAT4X4 a, b;
+                XMStoreFloat4x4(&a, rawGlobals[n]);
+                XMStoreFloat4x4(&b, packedGlobals[n]);
+                const float error = XMVectorGetX(XMVector3Length(XMVectorSet(a._14 - b._14, a._24 - b._24, a._34 - b._34, 0.0f)));
+
+                sumError += error;
+                ++measured;
+                if (error > maxError)
+                {
+                    maxError = error;
+                    worstNode = n;
+                    worstFrame = f;
+                }
+            }
+        }
+
+        if (measured > 0)
+        {
+            FbxAnim::Log() << "  World-space end-point error: max " << maxError << " (" << clip.restNodeNames[worstNode]
+                      << " @ frame " << worstFrame << "), mean " << (sumError / measured) << " over "
+                      << nodeCount << " nodes x " << clip.frameCount << " frames" << std::endl;
+        }
+    }
+
+    // Headless 모드 공용: 리그의 애니메이션 파일마다 클립 컴파일 후 onClip(anim, clip). 하나라도 실패하면 false
+    template<typename OnClip>
+    bool CompileRigClips(const std::vector<FbxAnimBenchmarkRig>& rigs, const FbxAnimCompressionSettings& settings, OnClip onClip)
+    {
+        // FbxClipLibrary와 같은 임포트 설정 (좌표계 변환 후의 키를 비교해야 한다)
+        constexpr unsigned int kImportFlags =
+            aiProcess_Triangulate |
+            aiProcess_JoinIdenticalVertices |
+            aiProcess_ConvertToLeftHanded |
+            aiProcess_LimitBoneWeights;
+
+        bool allLoaded = true;
+        for (const FbxAnimBenchmarkRig& rig : rigs)
+        {
+            std::cout << "[" << rig.name << "]" << std::endl;
+            for (const std::string& animPath : rig.animPaths)
+            {
+                Assimp::Importer importer;
+                const aiScene* scene = importer.ReadFile(animPath, kImportFlags);
+                if (!scene || !scene->mAnimations || scene->mNumAnimations == 0)
+                {
+                    std::cerr << "[FbxAnim] Failed to load animation from: " << animPath << std::endl;
+                    allLoaded = false;
+                    continue;
+                }
+
+                const aiAnimation* anim = scene->mAnimations[0];
+                FbxAnimClip clip;
+                if (!FbxAnim::CompileClip(anim, scene->mRootNode, animPath, FbxAnim::kDefaultSampleRate, settings, clip))
+                {
+                    allLoaded = false;
+                    continue;
+                }
+                onClip(anim, clip);
+            }
+        }
+        return allLoaded;
+    }
+}
+
+// FbxAnimClip
+size_t FbxAnimClip::GetMemoryBytes() const
+{
+    size_t bytes = sizeof(FbxAnimClip) + name.capacity();
+    for (const std::string& n : trackNodeNames)
+        bytes += sizeof(std::string) + n.capacity();
+    for (const std::string& n : restNodeNames)
+        bytes += sizeof(std::string) + n.capacity();
+    bytes += tracks.capacity() * sizeof(FbxAnimTrack);
+    bytes += keyFrames.capacity() * sizeof(uint16_t);
+    bytes += keyData.capacity() * sizeof(uint16_t);
+    bytes += restNodeLocals.capacity() * sizeof(XMFLOAT4X4);
+    bytes += restNodeParents.capacity() * sizeof(int);
+    return bytes;
+}
+
+// FbxScratchArena
+void FbxScratchArena::Reserve(size_t bytes)
+{
+    if (GetCapacity() >= bytes)
+        return;
+
+    blocks_.clear();
+    blocks_.push_back(Block{ std::make_unique<unsigned char[]>(bytes), bytes });
+    blockIndex_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+void FbxScratchArena::Reset()
+{
+    // 지난 프레임에 블록이 늘었다면 최대 사용량 크기의 단일 블록으로 합친다 (워밍업 때만 발생)
+    if (blocks_.size() > 1)
+    {
+        const size_t total = (std::max)(highWater_, GetCapacity());
+        blocks_.clear();
+        blocks_.push_back(Block{ std::make_unique<unsigned char[]>(total), total });
+    }
+
+    blockIndex_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+void* FbxScratchArena::Allocate(size_t bytes, size_t alignment)
+{
+    while (blockIndex_ < blocks_.size())
+    {
+        Block& block = blocks_[blockIndex_];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        const size_t end = static_cast<size_t>(aligned - base) + bytes;
+
+        if (end <= block.size)
+        {
+            used_ += end - offset_;
+            highWater_ = (std::max)(highWater_, used_);
+            offset_ = end;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // 남은 공간은 버리고 다음 블록으로
+        used_ += block.size - offset_;
+        ++blockIndex_;
+        offset_ = 0;
+    }
+
+    // Grow: new block large enough for this request (at least double the current capacity)
+    const size_t size = (std::max)(bytes + alignment, GetCapacity());
+    blocks_.push_back(Block{ std::make_unique<unsigned char[]>(size), size });
+    blockIndex_ = blocks_.size() - 1;
+    offset_ = 0;
+    return Allocate(bytes, alignment);
+}
+
+size_t FbxScratchArena::GetCapacity() const
+{
+    size_t total = 0;
+    for (const Block& block : blocks_)
+    {
+        total += block.size;
+    }
+    return total;
+}
+
+namespace FbxAnim
+{
+    bool IsPivotHelper(const aiNode* node)
+    {
+        return node && node->mNumChildren == 1 && std::strstr(node->mName.C_Str(), "_$AssimpFbx$_") != nullptr;
+    }
+
+    const aiNode* FoldPivotChain(const aiNode* node, XMFLOAT4X4& outLocal, std::vector<const aiNode*>* outHelpers)
+    {
+        if (outHelpers)
+            outHelpers->clear();
+
+        if (!IsPivotHelper(node))
+        {
+            outLocal = ToFloat4x4(node->mTransformation);
+            return node;
+        }
+
+        aiMatrix4x4 local = node->mTransformation;
+        for (;;)
+        {
+            if (outHelpers)
+                outHelpers->push_back(node);
+            node = node->mChildren[0];
+            local = local * node->mTransformation;
+            if (!IsPivotHelper(node))
+                break;
+        }
+        outLocal = ToFloat4x4(local);
+        return node;
+    }
+
+    bool CompileClip(const aiAnimation* anim, const aiNode* rootNode, const std::string& name, float sampleRate,
+                     const FbxAnimCompressionSettings& settings, FbxAnimClip& outClip,
+                     const std::unordered_set<std::string>* nodeFilter)
+    {
+        if (!anim || sampleRate <= 0.0f)
+            return false;
+
+        // Pivot helper channels are retargeted to their owning node (skeleton keeps only real joints)
+        const PivotFolding folding = CollectPivotChains(rootNode);
+        std::unordered_map<std::string, const aiNodeAnim*> channelOfNode;
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c)
+        {
+            channelOfNode.emplace(anim->mChannels[c]->mNodeName.C_Str(), anim->mChannels[c]);
+        }
+
+        // Tracks (channel order, one per owner) that survive the node filter
+        struct TrackSource
+        {
+            std::string nodeName;
+            const aiNodeAnim* channel = nullptr;     // direct channel
+            const PivotChain* chain = nullptr;       // folded helper chain
+        };
+        std::vector<TrackSource> sources;
+        std::unordered_set<std::string> emitted;
+        sources.reserve(anim->mNumChannels);
+        uint32_t helperChannels = 0;
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c)
+        {
+            const aiNodeAnim* channel = anim->mChannels[c];
+            std::string nodeName = channel->mNodeName.C_Str();
+            auto helperIt = folding.ownerOfHelper.find(nodeName);
+            if (helperIt != folding.ownerOfHelper.end())
+            {
+                nodeName = helperIt->second;
+                ++helperChannels;
+            }
+
+            if (nodeFilter && nodeFilter->count(nodeName) == 0)
+                continue;
+            if (!emitted.insert(nodeName).second)
+                continue;
+
+            TrackSource source;
+            auto chainIt = folding.chainOfOwner.find(nodeName);
+            if (chainIt != folding.chainOfOwner.end())
+                source.chain = &chainIt->second;
+            else
+                source.channel = channel;
+            source.nodeName = std::move(nodeName);
+            sources.push_back(std::move(source));
+        }
+
+        outClip = FbxAnimClip{};
+        outClip.name = name;
+        outClip.ticksPerSecond = (anim->mTicksPerSecond > 0.0) ? anim->mTicksPerSecond : 25.0;
+        outClip.durationSec = anim->mDuration / outClip.ticksPerSecond;
+        outClip.sampleRate = sampleRate;
+        outClip.frameCount = static_cast<uint32_t>(std::ceil(outClip.durationSec * sampleRate)) + 1;
+
+        // 키 프레임 인덱스는 16-bit로 저장
+        if (outClip.frameCount > 0xFFFFu)
+        {
+            Log() << "[FbxAnim] Clip '" << name << "' is too long to compress (" << outClip.frameCount << " frames)" << std::endl;
+            return false;
+        }
+
+        // 1. Uniform resample (temporary, discarded after compression)
+        const uint32_t trackCount = static_cast<uint32_t>(sources.size());
+        const size_t sampleCount = static_cast<size_t>(outClip.frameCount) * trackCount;
+        RawClipSamples raw;
+        raw.trackCount = trackCount;
+        raw.positions.resize(sampleCount);
+        raw.rotations.resize(sampleCount);
+        raw.scales.resize(sampleCount);
+        outClip.trackNodeNames.reserve(trackCount);
+
+        uint32_t foldedTracks = 0;
+        for (uint32_t track = 0; track < trackCount; ++track)
+        {
+            const TrackSource& source = sources[track];
+            outClip.trackNodeNames.push_back(source.nodeName);
+
+            if (source.chain)
+            {
+                ResampleFoldedChain(*source.chain, channelOfNode, outClip, raw, track);
+                ++foldedTracks;
+            }
+            else
+            {
+                ResampleChannel(source.channel, outClip, raw, track);
+            }
+        }
+
+        if (helperChannels > 0)
+        {
+            Log() << "[FbxAnim] Clip '" << name << "': folded " << helperChannels << " pivot helper channels into "
+                      << foldedTracks << " tracks (" << anim->mNumChannels << " channels -> " << trackCount << " tracks)" << std::endl;
+        }
+
+        // 2. Compress each channel
+        CompressionStats stats;
+        std::vector<uint32_t> keyScratch;
+        outClip.tracks.resize(trackCount);
+        for (uint32_t track = 0; track < trackCount; ++track)
+        {
+            FbxAnimTrack& t = outClip.tracks[track];
+            CompressVec3Channel(raw, raw.positions, track, outClip.frameCount, settings.translationTolerance, outClip,
+                                t.posFirstKey, t.posKeyCount, t.posMin, t.posStep, stats, keyScratch);
+            CompressRotationChannel(raw, track, outClip.frameCount, settings.rotationTolerance, outClip, t, stats, keyScratch);
+            CompressVec3Channel(raw, raw.scales, track, outClip.frameCount, settings.scaleTolerance, outClip,
+                                t.sclFirstKey, t.sclKeyCount, t.sclMin, t.sclStep, stats, keyScratch);
+        }
+        outClip.keyFrames.shrink_to_fit();
+        outClip.keyData.shrink_to_fit();
+
+        // 3. Rest pose + error report
+        CaptureRestPose(rootNode, outClip, nodeFilter);
+        ReportCompressionSize(outClip, raw, stats);
+        if (settings.reportError)
+        {
+            ReportCompressionError(outClip, raw);
+        }
+        return true;
+    }
+
+    void CaptureRestPose(const aiNode* rootNode, FbxAnimClip& clip, const std::unordered_set<std::string>* nodeFilter)
+    {
+        clip.restNodeNames.clear();
+        clip.restNodeLocals.clear();
+        clip.restNodeParents.clear();
+        if (!rootNode)
+            return;
+
+        // (node, index of the nearest captured ancestor)
+        std::vector<std::pair<const aiNode*, int>> stack{ { rootNode, -1 } };
+        while (!stack.empty())
+        {
+            int parent = stack.back().second;
+            XMFLOAT4X4 local;
+            const aiNode* node = FoldPivotChain(stack.back().first, local);
+            stack.pop_back();
+
+            if (!nodeFilter || nodeFilter->count(node->mName.C_Str()) > 0)
+            {
+                clip.restNodeNames.push_back(node->mName.C_Str());
+                clip.restNodeLocals.push_back(local);
+                clip.restNodeParents.push_back(parent);
+                parent = static_cast<int>(clip.restNodeNames.size()) - 1;
+            }
+
+            // 역순으로 넣어서 전위 순회(왼쪽 자식 먼저) 순서를 유지
+            for (unsigned int i = node->mNumChildren; i > 0; --i)
+            {
+                stack.push_back({ node->mChildren[i - 1], parent });
+            }
+        }
+    }
+
+    FbxAnimSampleCursor LocateSample(const FbxAnimClip& clip, double timeSec)
+    {
+        FbxAnimSampleCursor cursor;
+        if (clip.frameCount <= 1)
+            return cursor;
+
+        const double f = (std::max)(0.0, timeSec * clip.sampleRate);
+        const uint32_t lastFrame = clip.frameCount - 1;
+        const uint32_t frame = static_cast<uint32_t>(f);
+
+        if (frame >= lastFrame)
+        {
+            cursor.frame0 = lastFrame;
+            cursor.frame1 = lastFrame;
+            return cursor;
+        }
+
+        cursor.frame0 = frame;
+        cursor.frame1 = frame + 1;
+        cursor.alpha = static_cast<float>(f - frame);
+        return cursor;
+    }
+
+    XMMATRIX SampleTrackLocal(const FbxAnimClip& clip, uint32_t track, const FbxAnimSampleCursor& cursor)
+    {
+        const FbxAnimTrack& t = clip.tracks[track];
+        const uint16_t* frames = clip.keyFrames.data();
+        const uint16_t* data = clip.keyData.data();
+        uint32_t k0, k1;
+
+        float a = FindKeySegment(frames + t.posFirstKey, t.posKeyCount, cursor, k0, k1);
+        XMVECTOR pos = XMVectorLerp(
+            DecodeVec3(data + 3 * (t.posFirstKey + k0), t.posMin, t.posStep),
+            DecodeVec3(data + 3 * (t.posFirstKey + k1), t.posMin, t.posStep), a);
+
+        a = FindKeySegment(frames + t.sclFirstKey, t.sclKeyCount, cursor, k0, k1);
+        XMVECTOR scale = XMVectorLerp(
+            DecodeVec3(data + 3 * (t.sclFirstKey + k0), t.sclMin, t.sclStep),
+            DecodeVec3(data + 3 * (t.sclFirstKey + k1), t.sclMin, t.sclStep), a);
+
+        a = FindKeySegment(frames + t.rotFirstKey, t.rotKeyCount, cursor, k0, k1);
+        XMVECTOR rot0 = UnpackQuat48(data + 3 * (t.rotFirstKey + k0));
+        XMVECTOR rot1 = UnpackQuat48(data + 3 * (t.rotFirstKey + k1));
+        // smallest-three 디코딩은 반구 정렬을 보존하지 않는다 → 짧은 경로로 nlerp
+        if (XMVectorGetX(XMVector4Dot(rot0, rot1)) < 0.0f)
+        {
+            rot1 = XMVectorNegate(rot1);
+        }
+        XMVECTOR rot = XMQuaternionNormalize(XMVectorLerp(rot0, rot1, a));
+
+        // DirectXMath는 행벡터(S*R*T) 기준 → 전치해서 Assimp 열벡터 레이아웃(T*R*S)으로 맞춘다
+        return XMMatrixTranspose(XMMatrixAffineTransformation(scale, XMVectorZero(), rot, pos));
+    }
+
+    void ReportSamplingBenchmark(const aiAnimation* anim, const FbxAnimClip& clip)
+    {
+        if (!anim || clip.GetTrackCount() == 0)
+            return;
+
+        // Source channel of each track (tracks may be a filtered subset of the channels)
+        // 피벗 헬퍼를 합친 트랙은 원본 채널 하나와 비교할 수 없으므로 제외
+        std::vector<const aiNodeAnim*> trackChannels(clip.GetTrackCount(), nullptr);
+        std::vector<uint32_t> directTracks;
+        for (uint32_t track = 0; track < clip.GetTrackCount(); ++track)
+        {
+            const std::string helperPrefix = clip.trackNodeNames[track] + "_$AssimpFbx$_";
+            bool folded = false;
+            for (unsigned int c = 0; c < anim->mNumChannels; ++c)
+            {
+                const char* channelName = anim->mChannels[c]->mNodeName.C_Str();
+                if (clip.trackNodeNames[track] == channelName)
+                    trackChannels[track] = anim->mChannels[c];
+                else if (std::strncmp(channelName, helperPrefix.c_str(), helperPrefix.size()) == 0)
+                    folded = true;
+            }
+            if (folded || !trackChannels[track])
+                continue;
+            if (trackChannels[track]->mNumPositionKeys == 0 ||
+                trackChannels[track]->mNumRotationKeys == 0 || trackChannels[track]->mNumScalingKeys == 0)
+                return;
+            directTracks.push_back(track);
+        }
+        if (directTracks.empty())
+            return;
+
+        constexpr int kSamples = 240;
+        const double duration = clip.durationSec;
+
+        // Legacy key scan
+        float checksumScan = 0.0f;
+        auto scanStart = std::chrono::high_resolution_clock::now();
+        for (int s = 0; s < kSamples; ++s)
+        {
+            const double timeSec = duration * s / kSamples;
+            const double ticks = timeSec * clip.ticksPerSecond;
+            for (uint32_t track : directTracks)
+            {
+                aiMatrix4x4 m = ScanChannelLocal(ticks, trackChannels[track]);
+                checksumScan += m.a4 + m.b4 + m.c4;
+            }
+        }
+        auto scanEnd = std::chrono::high_resolution_clock::now();
+
+        // Compressed clip sampler
+        float checksumSampled = 0.0f;
+        auto sampleStart = std::chrono::high_resolution_clock::now();
+        for (int s = 0; s < kSamples; ++s)
+        {
+            const FbxAnimSampleCursor cursor = LocateSample(clip, duration * s / kSamples);
+            for (uint32_t track : directTracks)
+            {
+                XMFLOAT4X4 m;
+                XMStoreFloat4x4(&m, SampleTrackLocal(clip, track, cursor));
+                checksumSampled += m._14 + m._24 + m._34;
+            }
+        }
+        auto sampleEnd = std::chrono::high_resolution_clock::now();
+
+        // Accuracy: max translation difference at sample points
+        float maxError = 0.0f;
+        for (int s = 0; s < kSamples; s += 8)
+        {
+            const double timeSec = duration * s / kSamples;
+            const FbxAnimSampleCursor cursor = LocateSample(clip, timeSec);
+            for (uint32_t track : directTracks)
+            {
+                aiMatrix4x4 ref = ScanChannelLocal(timeSec * clip.ticksPerSecond, trackChannels[track]);
+                XMFLOAT4X4 m;
+                XMStoreFloat4x4(&m, SampleTrackLocal(clip, track, cursor));
+                maxError = (std::max)(maxError, std::abs(ref.a4 - m._14));
+                maxError = (std::max)(maxError, std::abs(ref.b4 - m._24));
+                maxError = (std::max)(maxError, std::abs(ref.c4 - m._34));
+            }
+        }
+
+        const double scanUs = std::chrono::duration<double, std::micro>(scanEnd - scanStart).count();
+        const double sampledUs = std::chrono::duration<double, std::micro>(sampleEnd - sampleStart).count();
+
+        Log() << "[FbxAnim] Sampling benchmark '" << clip.name << "': "
+              << directTracks.size() << " tracks x " << kSamples << " samples | key scan "
+              << scanUs << "us, compressed " << sampledUs << "us (x"
+              << (sampledUs > 0.0 ? scanUs / sampledUs : 0.0) << "), max translation error "
+              << maxError << " (checksum " << (checksumScan - checksumSampled) << ")" << std::endl;
+    }
+
+    std::ostream& Log()
+    {
+        return t_logSink ? *t_logSink : std::cout;
+    }
+
+    ScopedLogCapture::ScopedLogCapture(std::ostream& sink)
+        :
+        previous_(t_logSink)
+    {
+        t_logSink = &sink;
+    }
+
+    ScopedLogCapture::~ScopedLogCapture()
+    {
+        t_logSink = previous_;
+    }
+
+    bool RunSamplingBenchmark(const std::vector<FbxAnimBenchmarkRig>& rigs)
+    {
+        std::cout << "=== FbxAnim sampling benchmark ===" << std::endl;
+        return CompileRigClips(rigs, FbxAnimCompressionSettings{}, [](const aiAnimation* anim, const FbxAnimClip& clip)
+        {
+            ReportSamplingBenchmark(anim, clip);
+        });
+    }
+
+    bool RunCompressionReport(const std::vector<FbxAnimBenchmarkRig>& rigs)
+    {
+        // 오차 측정은 CompileClip 안에서 출력된다
+        FbxAnimCompressionSettings settings;
+        settings.reportError = true;
+
+        std::cout << "=== FbxAnim compression report ===" << std::endl;
+        return CompileRigClips(rigs, settings, [](const aiAnimation*, const FbxAnimClip&) {});
+    }
+}
@@ -0,0 +1,171 @@
+﻿#pragma once
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Forward declarations
+struct aiAnimation;
+struct aiNode;
+struct FbxAnimBenchmarkRig;
+
+// Compressed key channels of one track
+// 키는 클립 공용 풀(keyFrames / keyData)의 연속 구간. keyCount == 1 이면 상수 채널(키 1개만 저장).
+struct FbxAnimTrack
+{
+    uint32_t posFirstKey = 0;
+    uint32_t rotFirstKey = 0;
+    uint32_t sclFirstKey = 0;
+    uint16_t posKeyCount = 0;
+    uint16_t rotKeyCount = 0;
+    uint16_t sclKeyCount = 0;
+
+    // Dequantization: value = min + unorm16 * step (per-track range)
+    DirectX::XMFLOAT3 posMin{ 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 posStep{ 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 sclMin{ 1.0f, 1.0f, 1.0f };
+    DirectX::XMFLOAT3 sclStep{ 0.0f, 0.0f, 0.0f };
+};
+
+// Key reduction tolerances (compile time)
+struct FbxAnimCompressionSettings
+{
+    float translationTolerance = 0.01f;   // source units (Mixamo FBX: cm)
+    float rotationTolerance = 0.0005f;    // radians
+    float scaleTolerance = 0.0005f;
+
+    // 컴파일마다 원본 대비 월드 공간 오차를 측정해 출력 (노드 x 프레임 전역 변환, 로드가 느려지므로 진단용)
+    // 클립 데이터에는 영향이 없어 캐시 키/쿠킹 헤더에 포함하지 않는다
+    bool reportError = false;
+};
+
+// Compiled animation clip
+// 로드 시점에 aiNodeAnim 키프레임을 고정 샘플레이트로 재샘플링한 뒤 압축한 엔진 소유 데이터.
+//  - 회전: smallest-three 48-bit (최대 성분 인덱스 2bit + 나머지 세 성분 15bit)
+//  - 이동/스케일: 트랙별 범위로 정규화한 16-bit
+//  - 상수 채널은 키 1개, 선형 보간으로 허용 오차 안에 재현되는 키는 제거
+struct FbxAnimClip
+{
+    std::string name;
+    double durationSec = 0.0;
+    double ticksPerSecond = 25.0;
+    float sampleRate = 30.0f;      // samples per second
+    uint32_t frameCount = 0;
+
+    std::vector<std::string> trackNodeNames;     // aiNodeAnim::mNodeName per track
+    std::vector<FbxAnimTrack> tracks;
+    std::vector<uint16_t> keyFrames;             // frame index of each key
+    std::vector<uint16_t> keyData;               // 3 x uint16 per key (vec3 unorm16 or packed quaternion)
+
+    // Rest pose of the source file's node tree (외부 애니메이션 파일은 자체 바인드 계층을 가진다)
+    std::vector<std::string> restNodeNames;
+    std::vector<DirectX::XMFLOAT4X4> restNodeLocals;  // aiNode::mTransformation (Assimp layout)
+    std::vector<int> restNodeParents;                 // nearest captured ancestor, -1 for roots (preorder)
+
+    uint32_t GetTrackCount() const { return static_cast<uint32_t>(trackNodeNames.size()); }
+    size_t GetMemoryBytes() const;
+};
+
+// Sample position inside a clip (computed once per update, shared by all tracks)
+struct FbxAnimSampleCursor
+{
+    uint32_t frame0 = 0;
+    uint32_t frame1 = 0;
+    float alpha = 0.0f;
+};
+
+// Reusable bump allocator for per-update scratch data
+// Reset()은 메모리를 유지한다 → 워밍업(또는 Reserve) 이후에는 힙 할당이 발생하지 않는다.
+// 한 프레임 안에서 용량을 넘기면 블록을 추가하고, 다음 Reset()에서 하나의 블록으로 합친다.
+class FbxScratchArena
+{
+public:
+    void Reserve(size_t bytes);
+    void Reset();
+    void* Allocate(size_t bytes, size_t alignment = 16);
+
+    template<typename T>
+    T* AllocateArray(size_t count)
+    {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    size_t GetCapacity() const;
+    size_t GetHighWater() const { return highWater_; }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size = 0;
+    };
+    std::vector<Block> blocks_;
+    size_t blockIndex_ = 0;
+    size_t offset_ = 0;
+    size_t used_ = 0;       // bytes handed out since last Reset (incl. padding)
+    size_t highWater_ = 0;
+};
+
+namespace FbxAnim
+{
+    constexpr float kDefaultSampleRate = 30.0f;
+
+    // Assimp FBX pivot helper ("<node>_$AssimpFbx$_Translation", "_PreRotation", "_Rotation" ...) with a single child
+    // 헬퍼 체인은 그 아래 첫 실제 노드(소유 노드)의 로컬 변환으로 합친다 → 스켈레톤에는 실제 관절만 남는다.
+    bool IsPivotHelper(const aiNode* node);
+
+    // Follows the helper chain starting at node and returns the owning node
+    // outLocal = helper locals x owner local (Assimp layout), outHelpers = folded helpers (top → bottom)
+    const aiNode* FoldPivotChain(const aiNode* node, DirectX::XMFLOAT4X4& outLocal,
+                                 std::vector<const aiNode*>* outHelpers = nullptr);
+
+    // aiAnimation -> fixed-rate resample -> compressed clip
+    // rootNode의 휴지 자세도 함께 기록하고, 압축 오차(월드 공간 본 끝점 오차)를 출력한다.
+    // nodeFilter가 주어지면 그 노드를 대상으로 하는 채널만 트랙으로 남긴다
+    // 피벗 헬퍼 채널은 소유 노드의 트랙으로 합쳐진다 (필터도 소유 노드 이름 기준)
+    bool CompileClip(const aiAnimation* anim, const aiNode* rootNode, const std::string& name, float sampleRate,
+                     const FbxAnimCompressionSettings& settings, FbxAnimClip& outClip,
+                     const std::unordered_set<std::string>* nodeFilter = nullptr);
+
+    // Record rest local transforms of the source node tree (filtered like CompileClip)
+    void CaptureRestPose(const aiNode* rootNode, FbxAnimClip& clip,
+                         const std::unordered_set<std::string>* nodeFilter = nullptr);
+
+    // O(1) lookup: time -> (frame0, frame1, alpha) on the resampled frame grid
+    FbxAnimSampleCursor LocateSample(const FbxAnimClip& clip, double timeSec);
+
+    // Local TRS matrix of one track, in Assimp layout (same as aiNode::mTransformation)
+    // 채널별 키 구간은 남은 키 프레임에서 이진 탐색 (키 제거 후 채널당 키 수는 적다)
+    DirectX::XMMATRIX SampleTrackLocal(const FbxAnimClip& clip, uint32_t track, const FbxAnimSampleCursor& cursor);
+
+    // Key-scan (legacy Interpolate*) vs compressed sampler timing report
+    void ReportSamplingBenchmark(const aiAnimation* anim, const FbxAnimClip& clip);
+
+    // Console output of clip compile / clip cache code on the calling thread (기본: std::cout)
+    std::ostream& Log();
+
+    // Redirects Log() of this thread into sink while alive (병렬 로드 워커의 출력을 모아 호출 스레드에서 출력)
+    class ScopedLogCapture
+    {
+    public:
+        explicit ScopedLogCapture(std::ostream& sink);
+        ~ScopedLogCapture();
+        ScopedLogCapture(const ScopedLogCapture&) = delete;
+        ScopedLogCapture& operator=(const ScopedLogCapture&) = delete;
+
+    private:
+        std::ostream* previous_;
+    };
+
+    // Headless: 리그의 애니메이션 파일마다 클립을 컴파일하고 ReportSamplingBenchmark (--anim-sampling-bench)
+    // false if any clip failed to load
+    bool RunSamplingBenchmark(const std::vector<FbxAnimBenchmarkRig>& rigs);
+
+    // Headless: reportError를 켜고 리그의 클립을 컴파일해 압축 크기와 월드 공간 오차 출력 (--anim-compression-report)
+    // false if any clip failed to load
+    bool RunCompressionReport(const std::vector<FbxAnimBenchmarkRig>& rigs);
+}
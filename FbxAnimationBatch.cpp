@@ -0,0 +1,231 @@
+﻿#include "FbxAnimationBatch.h"
+#include "FbxManager.h"
+#include "ZThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace DirectX;
+
+namespace
+{
+    // 스레드당 4청크 정도 → 인스턴스 비용 차이(뼈 수, 클립)는 스틸링이 흡수
+    size_t GrainSizeFor(size_t count, const ZThreadPool& pool)
+    {
+        const size_t chunks = static_cast<size_t>(pool.GetWorkerCount() + 1) * 4;
+        return (std::max)(static_cast<size_t>(1), count / chunks);
+    }
+
+    void ResetInstances(const std::vector<std::unique_ptr<FbxManager>>& instances, const std::vector<double>& startTimes)
+    {
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            FbxManager& instance = *instances[i];
+            instance.SetCurrentAnimation(static_cast<int>(i % static_cast<size_t>(instance.GetAnimationCount())));
+            instance.SetAnimationTimeSeconds(startTimes[i]);
+        }
+    }
+
+    bool PalettesMatch(const std::vector<std::unique_ptr<FbxManager>>& instances, const std::vector<std::vector<XMMATRIX>>& reference)
+    {
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            const std::vector<XMMATRIX>& palette = instances[i]->GetBonePalette();
+            if (palette.size() != reference[i].size() ||
+                std::memcmp(palette.data(), reference[i].data(), palette.size() * sizeof(XMMATRIX)) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace FbxAnimBatch
+{
+    void UpdateAnimations(FbxManager* const* instances, size_t count, float deltaTime, ZThreadPool& pool)
+    {
+        // 1. Time advance (cheap, may log)
+        for (size_t i = 0; i < count; ++i)
+        {
+            instances[i]->AdvanceAnimation(deltaTime);
+        }
+
+        // 2. Evaluation on the pool; instances with pending console logs are left for the calling thread
+        pool.ParallelFor(count, GrainSizeFor(count, pool), [instances](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (!instances[i]->HasPendingAnimationLogs())
+                {
+                    instances[i]->EvaluateAnimation();
+                }
+            }
+        });
+
+        // 3. First-use logging path (clip switch, first palettes) stays serial
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (instances[i]->HasPendingAnimationLogs())
+            {
+                instances[i]->EvaluateAnimation();
+            }
+        }
+    }
+
+    bool RunScalingBenchmark(const std::vector<FbxAnimBenchmarkRig>& rigs)
+    {
+        constexpr size_t kInstanceCounts[] = { 100, 500, 2000 };
+        constexpr int kFrames = 120;
+        constexpr float kDeltaTime = 1.0f / 60.0f;
+
+        const unsigned int hw = (std::max)(1u, std::thread::hardware_concurrency());
+        std::vector<unsigned int> threadCounts;
+        for (unsigned int t = 1; t < hw; t *= 2)
+        {
+            threadCounts.push_back(t);
+        }
+        threadCounts.push_back(hw);
+
+        bool allIdentical = true;
+        std::cout << "=== FbxAnimBatch scaling benchmark (" << kFrames << " frames, " << hw << " hardware threads) ===" << std::endl;
+
+        for (const FbxAnimBenchmarkRig& rig : rigs)
+        {
+            FbxManager prototype;
+            if (!prototype.LoadRig(rig.modelPath) || !prototype.HasSkinning())
+            {
+                std::cerr << "[FbxAnimBatch] Skipping rig '" << rig.name << "' (load failed or not skinned)" << std::endl;
+                continue;
+            }
+            if (!rig.animPaths.empty())
+            {
+                prototype.LoadExternalAnimations(rig.animPaths);
+            }
+            if (prototype.GetAnimationCount() == 0)
+            {
+                std::cerr << "[FbxAnimBatch] Skipping rig '" << rig.name << "' (no animations)" << std::endl;
+                continue;
+            }
+
+            for (size_t instanceCount : kInstanceCounts)
+            {
+                // Instances: shared clips, different clip/phase per instance
+                std::vector<std::unique_ptr<FbxManager>> instances;
+                std::vector<FbxManager*> pointers;
+                std::vector<double> startTimes;
+                instances.reserve(instanceCount);
+                pointers.reserve(instanceCount);
+                startTimes.reserve(instanceCount);
+                for (size_t i = 0; i < instanceCount; ++i)
+                {
+                    auto instance = std::make_unique<FbxManager>();
+                    instance->SetAnimationLogging(false);
+                    instance->CopyRigFrom(prototype);
+                    instance->SetAnimationPlaying(true);
+
+                    const int clip = static_cast<int>(i % static_cast<size_t>(prototype.GetAnimationCount()));
+                    startTimes.push_back(prototype.GetClipDurationSec(clip) * static_cast<double>((i * 37) % 100) / 100.0);
+
+                    pointers.push_back(instance.get());
+                    instances.push_back(std::move(instance));
+                }
+
+                // Reference: single-threaded UpdateAnimation
+                ResetInstances(instances, startTimes);
+                auto serialStart = std::chrono::high_resolution_clock::now();
+                for (int frame = 0; frame < kFrames; ++frame)
+                {
+                    for (FbxManager* instance : pointers)
+                    {
+                        instance->UpdateAnimation(kDeltaTime);
+                    }
+                }
+                auto serialEnd = std::chrono::high_resolution_clock::now();
+                const double serialMs = std::chrono::duration<double, std::milli>(serialEnd - serialStart).count() / kFrames;
+
+                std::vector<std::vector<XMMATRIX>> reference;
+                reference.reserve(instanceCount);
+                for (FbxManager* instance : pointers)
+                {
+                    reference.push_back(instance->GetBonePalette());
+                }
+
+                std::cout << "[FbxAnimBatch] " << rig.name << " x" << instanceCount << " (" << prototype.GetBoneCount()
+                          << " bones): serial " << std::fixed << std::setprecision(3) << serialMs << " ms/frame" << std::endl;
+
+                for (unsigned int threads : threadCounts)
+                {
+                    ZThreadPool pool(static_cast<int>(threads) - 1);
+
+                    ResetInstances(instances, startTimes);
+                    auto batchStart = std::chrono::high_resolution_clock::now();
+                    for (int frame = 0; frame < kFrames; ++frame)
+                    {
+                        UpdateAnimations(pointers.data(), pointers.size(), kDeltaTime, pool);
+                    }
+                    auto batchEnd = std::chrono::high_resolution_clock::now();
+                    const double batchMs = std::chrono::duration<double, std::milli>(batchEnd - batchStart).count() / kFrames;
+
+                    const bool identical = PalettesMatch(instances, reference);
+                    allIdentical = allIdentical && identical;
+                    std::cout << "  " << std::setw(2) << threads << " thread(s): " << batchMs << " ms/frame (x"
+                              << std::setprecision(2) << (batchMs > 0.0 ? serialMs / batchMs : 0.0) << std::setprecision(3)
+                              << "), bit-identical: " << (identical ? "yes" : "NO") << std::endl;
+                }
+                std::cout.unsetf(std::ios::fixed);
+                std::cout << std::setprecision(6);
+            }
+        }
+
+        std::cout << "=== FbxAnimBatch scaling benchmark " << (allIdentical ? "passed" : "FAILED") << " ===" << std::endl;
+        return allIdentical;
+    }
+
+    bool RunUpdateAllocationCheck(const std::vector<FbxAnimBenchmarkRig>& rigs)
+    {
+        constexpr int kUpdates = 1000;
+        constexpr float kDeltaTime = 1.0f / 60.0f;
+
+        bool allPassed = true;
+        std::cout << "=== FbxAnimBatch update allocation check (" << kUpdates << " updates per clip) ===" << std::endl;
+
+        for (const FbxAnimBenchmarkRig& rig : rigs)
+        {
+            FbxManager instance;
+            if (!instance.LoadRig(rig.modelPath) || !instance.HasSkinning())
+            {
+                std::cerr << "[FbxAnimBatch] Skipping rig '" << rig.name << "' (load failed or not skinned)" << std::endl;
+                continue;
+            }
+            if (!rig.animPaths.empty())
+            {
+                instance.LoadExternalAnimations(rig.animPaths);
+            }
+
+            for (int clip = 0; clip < instance.GetAnimationCount(); ++clip)
+            {
+                instance.SetCurrentAnimation(clip);
+                instance.SetAnimationPlaying(true);
+
+                // 정상 상태의 갱신은 힙을 건드리지 않아야 한다 (릴리스 빌드는 CRT 훅이 없어 -1)
+                const int allocations = instance.CountUpdateAllocations(kUpdates, kDeltaTime);
+                if (allocations < 0)
+                {
+                    std::cout << "[FbxAnimBatch] Allocation counting needs a Debug build (CRT alloc hook)" << std::endl;
+                    return true;
+                }
+
+                const bool passed = (allocations == 0);
+                allPassed = allPassed && passed;
+                std::cout << "[FbxAnimBatch] " << rig.name << " clip " << clip << ": " << allocations
+                          << " heap allocations" << (passed ? " OK" : " FAILED") << std::endl;
+            }
+        }
+        return allPassed;
+    }
+}
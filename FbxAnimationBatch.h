@@ -0,0 +1,34 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class FbxManager;
+class ZThreadPool;
+
+// Rig used by the headless batch benchmark
+struct FbxAnimBenchmarkRig
+{
+    std::string name;
+    std::string modelPath;
+    std::vector<std::string> animPaths;
+};
+
+// Batch animation update for all skinned instances of a frame
+// 1) 시간 진행은 호출 스레드에서 인스턴스 순서대로
+// 2) 샘플링 → local-to-global → 팔레트 계산은 인스턴스 단위로 스레드 풀에 분배
+// 3) 모든 인스턴스가 끝난 뒤 반환 (렌더 전 결정적 join)
+// 인스턴스마다 같은 코드가 자기 데이터만 계산하므로 결과는 단일 스레드 경로와 비트 단위로 같다.
+namespace FbxAnimBatch
+{
+    void UpdateAnimations(FbxManager* const* instances, size_t count, float deltaTime, ZThreadPool& pool);
+
+    // Headless: 100/500/2000 instances per rig, 1..N threads, bit-identical check against UpdateAnimation
+    // false if any batch result differs from the serial result
+    bool RunScalingBenchmark(const std::vector<FbxAnimBenchmarkRig>& rigs);
+
+    // Headless: 리그의 클립마다 UpdateAnimation 1000회 동안 CRT 힙 할당이 0회인지 (Debug 빌드 전용)
+    bool RunUpdateAllocationCheck(const std::vector<FbxAnimBenchmarkRig>& rigs);
+}
@@ -0,0 +1,221 @@
+﻿#include "FbxAnimationLod.h"
+#include "FbxManager.h"
+#include "ZThreadPool.h"
+#include <DirectXCollision.h>
+#include <algorithm>
+
+using namespace DirectX;
+
+namespace
+{
+    uint32_t UpdateIntervalOf(FbxAnimLodTier tier)
+    {
+        switch (tier)
+        {
+        case FbxAnimLodTier::Half:    return 2;
+        case FbxAnimLodTier::Quarter: return 4;
+        default:                      return 1;
+        }
+    }
+
+    // Largest axis scale of a world matrix (bounds radius)
+    float MaxAxisScale(FXMMATRIX world)
+    {
+        const float sx = XMVectorGetX(XMVector3Length(world.r[0]));
+        const float sy = XMVectorGetX(XMVector3Length(world.r[1]));
+        const float sz = XMVectorGetX(XMVector3Length(world.r[2]));
+        return (std::max)(sx, (std::max)(sy, sz));
+    }
+}
+
+FbxAnimLodPolicy& FbxAnimLodPolicy::Shared()
+{
+    static FbxAnimLodPolicy policy;
+    return policy;
+}
+
+const char* FbxAnimLodPolicy::GetTierName(FbxAnimLodTier tier)
+{
+    switch (tier)
+    {
+    case FbxAnimLodTier::Full:    return "Full";
+    case FbxAnimLodTier::Half:    return "Half";
+    case FbxAnimLodTier::Quarter: return "Quarter";
+    case FbxAnimLodTier::Culled:  return "Culled";
+    default:                      return "?";
+    }
+}
+
+void FbxAnimLodPolicy::Update(const FbxAnimLodInstance* instances, size_t count, float deltaTime,
+                              FXMMATRIX view, CXMMATRIX proj, ZThreadPool& pool)
+{
+    stats_ = FbxAnimLodStats{};
+
+    // Camera frustum and position in world space
+    const XMMATRIX invView = XMMatrixInverse(nullptr, view);
+    BoundingFrustum frustum;
+    BoundingFrustum::CreateFromMatrix(frustum, proj);
+    frustum.Transform(frustum, invView);
+    const XMVECTOR cameraPos = invView.r[3];
+
+    // 1. Tier and action per instance (calling thread)
+    frame_.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        FbxManager* animation = instances[i].animation;
+        if (!animation || !animation->HasAnimations())
+            continue;
+
+        // 시간은 컬링된 인스턴스도 계속 진행
+        animation->AdvanceAnimation(deltaTime);
+
+        InstanceState& state = states_[animation];
+
+        XMFLOAT3 boundsCenter;
+        float boundsRadius = 0.0f;
+        animation->GetBindPoseBounds(boundsCenter, boundsRadius);
+
+        const XMMATRIX world = XMLoadFloat4x4(&instances[i].world);
+        const XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&boundsCenter), world);
+        const float radius = boundsRadius * MaxAxisScale(world) * settings_.boundsScale;
+        const bool visible = (boundsRadius <= 0.0f) || frustum.Intersects(BoundingSphere(XMFLOAT3(
+            XMVectorGetX(center), XMVectorGetY(center), XMVectorGetZ(center)), radius));
+        const float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(center, cameraPos)));
+
+        FbxAnimLodTier tier = FbxAnimLodTier::Full;
+        if (!visible)
+            tier = FbxAnimLodTier::Culled;
+        else if (distance >= settings_.quarterRateDistance)
+            tier = FbxAnimLodTier::Quarter;
+        else if (distance >= settings_.halfRateDistance)
+            tier = FbxAnimLodTier::Half;
+        ++stats_.instancesPerTier[static_cast<size_t>(tier)];
+
+        const int clip = animation->GetCurrentAnimationIndex();
+        if (tier != state.tier || clip != state.clip)
+        {
+            state.snap = true;
+        }
+        state.tier = tier;
+        state.clip = clip;
+
+        if (tier == FbxAnimLodTier::Culled)
+        {
+            // 화면 밖: 팔레트 계산 생략, 다시 보이면 새로 평가
+            state.snap = true;
+            continue;
+        }
+
+        FrameEntry entry;
+        entry.animation = animation;
+        entry.state = &state;
+        entry.serial = animation->HasPendingAnimationLogs();
+
+        const uint32_t interval = UpdateIntervalOf(tier);
+        if (interval == 1)
+        {
+            entry.action = Action::Evaluate;
+            ++stats_.evaluations;
+        }
+        else
+        {
+            entry.reducedBones = (tier == FbxAnimLodTier::Quarter);
+
+            if (state.snap)
+            {
+                // 같은 프레임에 들어온 인스턴스들이 같은 프레임에 몰려 평가되지 않도록 첫 구간 길이를 흩뜨린다
+                const uint32_t stagger = static_cast<uint32_t>((reinterpret_cast<uintptr_t>(animation) >> 6) % interval);
+                state.span = interval - stagger;
+                state.step = 0;
+                state.snap = false;
+                entry.action = Action::Retarget;
+                entry.snap = true;
+                stats_.evaluations += 2;
+            }
+            else if (++state.step >= state.span)
+            {
+                state.span = interval;
+                state.step = 0;
+                entry.action = Action::Retarget;
+                ++stats_.evaluations;
+            }
+            else
+            {
+                entry.action = Action::Blend;
+                entry.blend = static_cast<float>(state.step) / static_cast<float>(state.span);
+                ++stats_.interpolations;
+            }
+
+            entry.aheadSec = static_cast<double>(state.span) * deltaTime;
+        }
+
+        frame_.push_back(entry);
+    }
+
+    // 2. Evaluate / blend on the pool (each entry touches only its own instance and state)
+    const FrameEntry* entries = frame_.data();
+    const size_t grain = (std::max)(static_cast<size_t>(1), frame_.size() / ((pool.GetWorkerCount() + 1) * 4));
+    pool.ParallelFor(frame_.size(), grain, [entries](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!entries[i].serial)
+                Run(entries[i]);
+        }
+    });
+
+    // 3. Instances with pending console logs (first update after a clip switch)
+    for (const FrameEntry& entry : frame_)
+    {
+        if (entry.serial)
+            Run(entry);
+    }
+}
+
+void FbxAnimLodPolicy::Run(const FrameEntry& entry)
+{
+    InstanceState& state = *entry.state;
+    std::vector<XMMATRIX>& palette = entry.animation->GetBonePalette();
+
+    switch (entry.action)
+    {
+    case Action::Evaluate:
+        entry.animation->EvaluateAnimation();
+        break;
+
+    case Action::Retarget:
+        // 이번 프레임에 보여줄 포즈 = 지난번 목표 (스냅이면 현재 시간에서 새로 평가)
+        if (entry.snap)
+        {
+            entry.animation->EvaluateAnimation(0.0, entry.reducedBones);
+            state.fromPalette = palette;
+        }
+        else
+        {
+            state.fromPalette.swap(state.toPalette);
+        }
+
+        entry.animation->EvaluateAnimation(entry.aheadSec, entry.reducedBones);
+        state.toPalette = palette;
+        palette = state.fromPalette;
+        break;
+
+    case Action::Blend:
+    {
+        const size_t boneCount = (std::min)(palette.size(), (std::min)(state.fromPalette.size(), state.toPalette.size()));
+        for (size_t b = 0; b < boneCount; ++b)
+        {
+            const XMMATRIX& from = state.fromPalette[b];
+            const XMMATRIX& to = state.toPalette[b];
+            palette[b].r[0] = XMVectorLerp(from.r[0], to.r[0], entry.blend);
+            palette[b].r[1] = XMVectorLerp(from.r[1], to.r[1], entry.blend);
+            palette[b].r[2] = XMVectorLerp(from.r[2], to.r[2], entry.blend);
+            palette[b].r[3] = XMVectorLerp(from.r[3], to.r[3], entry.blend);
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,105 @@
+﻿#pragma once
+
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class FbxManager;
+class ZThreadPool;
+
+// Animation LOD tiers (카메라 거리 + 가시성)
+enum class FbxAnimLodTier : uint8_t
+{
+    Full = 0,      // every frame, all bones
+    Half,          // every 2nd frame, palettes interpolated in between
+    Quarter,       // every 4th frame, interpolated, finger/face bones frozen to bind pose
+    Culled,        // off-screen: time advances, no palette
+    Count
+};
+
+struct FbxAnimLodSettings
+{
+    float halfRateDistance = 15.0f;      // world units, camera → bounds center
+    float quarterRateDistance = 30.0f;
+    float boundsScale = 1.5f;            // bind-pose bounds inflation (애니메이션으로 팔다리가 바깥으로 나간다)
+};
+
+struct FbxAnimLodInstance
+{
+    FbxManager* animation = nullptr;
+    DirectX::XMFLOAT4X4 world;           // model → world (row-vector, same as GetTransformXM)
+};
+
+// Per-frame counters
+struct FbxAnimLodStats
+{
+    uint32_t instancesPerTier[static_cast<size_t>(FbxAnimLodTier::Count)] = {};
+    uint32_t evaluations = 0;            // pose evaluations (sampling + hierarchy + palette)
+    uint32_t interpolations = 0;         // palettes blended between two evaluations
+};
+
+// Policy layer on top of FbxManager's animation update
+// 먼 인스턴스는 낮은 빈도로 평가하고 그 사이는 팔레트를 보간한다.
+// 보간 목표는 다음 평가 시점의 포즈(현재 시간 + 간격)라서 지연 없이 따라간다.
+class FbxAnimLodPolicy
+{
+public:
+    static FbxAnimLodPolicy& Shared();
+
+    void SetSettings(const FbxAnimLodSettings& settings) { settings_ = settings; }
+    const FbxAnimLodSettings& GetSettings() const { return settings_; }
+
+    // view/proj: camera of this frame (ZGraphics::GetCamera / GetProjection).
+    // 평가는 pool에서 병렬로 실행되고, 모든 인스턴스가 끝난 뒤 반환한다.
+    void Update(const FbxAnimLodInstance* instances, size_t count, float deltaTime,
+                DirectX::FXMMATRIX view, DirectX::CXMMATRIX proj, ZThreadPool& pool);
+
+    // Drop the per-instance state (~FbxManager). 주소가 재사용되어도 이전 인스턴스의 팔레트를 이어받지 않는다
+    void Forget(const FbxManager* animation) { states_.erase(animation); }
+
+    const FbxAnimLodStats& GetFrameStats() const { return stats_; }
+    static const char* GetTierName(FbxAnimLodTier tier);
+
+private:
+    struct InstanceState
+    {
+        FbxAnimLodTier tier = FbxAnimLodTier::Full;
+        int clip = -1;
+        uint32_t span = 1;               // frames between fromPalette and toPalette
+        uint32_t step = 0;               // frames since fromPalette
+        bool snap = true;                // no valid toPalette (new, tier/clip change, back on screen)
+        std::vector<DirectX::XMMATRIX> fromPalette;
+        std::vector<DirectX::XMMATRIX> toPalette;
+    };
+
+    enum class Action : uint8_t
+    {
+        None,
+        Evaluate,        // full rate: evaluate at the current time
+        Retarget,        // evaluate the next target, show the previous one
+        Blend            // interpolate between targets
+    };
+
+    struct FrameEntry
+    {
+        FbxManager* animation = nullptr;
+        InstanceState* state = nullptr;
+        Action action = Action::None;
+        bool reducedBones = false;
+        bool snap = false;
+        bool serial = false;             // console logs pending → main thread
+        double aheadSec = 0.0;
+        float blend = 0.0f;
+    };
+
+    static void Run(const FrameEntry& entry);
+
+private:
+    FbxAnimLodSettings settings_;
+    FbxAnimLodStats stats_;
+    std::unordered_map<const FbxManager*, InstanceState> states_;   // erased by Forget when the instance is destroyed
+    std::vector<FrameEntry> frame_;      // reused every frame
+};
@@ -0,0 +1,294 @@
+﻿#include "FbxClipLibrary.h"
+#include "FbxMeshCache.h"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+
+namespace
+{
+    // Same flags FbxManager used for external animations (coordinate system must match base model)
+    constexpr unsigned int kAnimImportFlags =
+        aiProcess_Triangulate |
+        aiProcess_JoinIdenticalVertices |
+        aiProcess_ConvertToLeftHanded |
+        aiProcess_LimitBoneWeights;
+
+    std::string CanonicalPath(const std::string& path)
+    {
+        std::error_code ec;
+        std::filesystem::path canonical = std::filesystem::weakly_canonical(std::filesystem::path(path), ec);
+        if (ec)
+        {
+            canonical = std::filesystem::absolute(std::filesystem::path(path), ec);
+        }
+        std::string result = canonical.generic_string();
+
+        // Windows 경로는 대소문자를 구분하지 않는다
+        std::transform(result.begin(), result.end(), result.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return result;
+    }
+
+    // FNV-1a over the sorted node-name set
+    uint64_t HashNodeNameSet(const std::vector<std::string>& names)
+    {
+        std::vector<const std::string*> sorted;
+        sorted.reserve(names.size());
+        for (const std::string& n : names)
+        {
+            sorted.push_back(&n);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+        uint64_t hash = 14695981039346656037ull;
+        for (const std::string* n : sorted)
+        {
+            for (unsigned char c : *n)
+            {
+                hash = (hash ^ c) * 1099511628211ull;
+            }
+            hash = (hash ^ 0xFFu) * 1099511628211ull;  // separator
+        }
+        return hash;
+    }
+}
+
+FbxClipLibrary& FbxClipLibrary::Get()
+{
+    static FbxClipLibrary library;
+    return library;
+}
+
+std::string FbxClipLibrary::MakeKey(const std::string& path, const std::vector<std::string>& skeletonNodeNames,
+                                    const FbxAnimCompressionSettings& settings)
+{
+    char suffix[96];
+    snprintf(suffix, sizeof(suffix), "%016llx|%g/%g/%g", static_cast<unsigned long long>(HashNodeNameSet(skeletonNodeNames)),
+             settings.translationTolerance, settings.rotationTolerance, settings.scaleTolerance);
+    return CanonicalPath(path) + "|" + suffix;
+}
+
+void FbxClipLibrary::SetCompressionSettings(const FbxAnimCompressionSettings& settings)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_ = settings;
+}
+
+FbxAnimCompressionSettings FbxClipLibrary::GetCompressionSettings()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return settings_;
+}
+
+FbxClipLibrary::ClipHandle FbxClipLibrary::Acquire(const std::string& key, const std::function<ClipHandle()>& loader)
+{
+    std::promise<ClipHandle> promise;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // 1. Already resident
+    auto it = clips_.find(key);
+    if (it != clips_.end())
+    {
+        if (ClipHandle clip = it->second.lock())
+        {
+            return clip;
+        }
+        clips_.erase(it);
+    }
+
+    // 2. Another thread is loading the same clip → wait for it
+    auto pendingIt = pending_.find(key);
+    if (pendingIt != pending_.end())
+    {
+        std::shared_future<ClipHandle> future = pendingIt->second;
+        lock.unlock();
+        return future.get();
+    }
+
+    pending_[key] = promise.get_future().share();
+    lock.unlock();
+
+    // 3. Load outside the lock
+    ClipHandle clip;
+    try
+    {
+        clip = loader();
+    }
+    catch (const std::exception& e)
+    {
+        FbxAnim::Log() << "[FbxClipLibrary] Clip load failed (" << key << "): " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        // 알 수 없는 예외: 기다리는 스레드에도 같은 예외를 넘기고, 다음 Acquire가 다시 로드할 수 있게 항목을 지운다
+        lock.lock();
+        pending_.erase(key);
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    lock.lock();
+    if (clip)
+    {
+        clips_[key] = clip;
+    }
+    pending_.erase(key);
+    lock.unlock();
+
+    promise.set_value(clip);
+    return clip;
+}
+
+FbxClipLibrary::ClipHandle FbxClipLibrary::AcquireFile(const std::string& animFilePath, const std::vector<std::string>& skeletonNodeNames)
+{
+    const FbxAnimCompressionSettings settings = GetCompressionSettings();
+    const std::string key = MakeKey(animFilePath, skeletonNodeNames, settings);
+
+    return Acquire(key, [&]() -> ClipHandle
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Cooked clip (asset cooker or an earlier run): Assimp only when it is missing or stale
+        const uint64_t skeletonHash = HashNodeNameSet(skeletonNodeNames);
+        if (std::shared_ptr<FbxAnimClip> cooked = FbxMeshCache::ReadClipFile(animFilePath, kAnimImportFlags, skeletonHash, settings))
+        {
+            auto endTime = std::chrono::high_resolution_clock::now();
+            FbxAnim::Log() << "[FbxClipLibrary] Loaded cooked '" << animFilePath << "': " << cooked->GetTrackCount() << " tracks, "
+                      << cooked->frameCount << " frames (took "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() << "ms)" << std::endl;
+            return cooked;
+        }
+
+        // Importer는 스레드마다 따로 생성 (Assimp::Importer 인스턴스는 스레드 간 공유 불가)
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFile(animFilePath, kAnimImportFlags);
+        if (!scene || !scene->mAnimations || scene->mNumAnimations == 0)
+        {
+            FbxAnim::Log() << "[FbxClipLibrary] Failed to load animation from: " << animFilePath << std::endl;
+            return nullptr;
+        }
+
+        const aiAnimation* anim = scene->mAnimations[0];
+        const std::string name = (anim->mName.length > 0)
+            ? anim->mName.C_Str()
+            : std::filesystem::path(animFilePath).filename().replace_extension().string();
+
+        const std::unordered_set<std::string> nodeFilter(skeletonNodeNames.begin(), skeletonNodeNames.end());
+        auto clip = std::make_shared<FbxAnimClip>();
+        if (!FbxAnim::CompileClip(anim, scene->mRootNode, name, FbxAnim::kDefaultSampleRate, settings, *clip, &nodeFilter))
+            return nullptr;
+        FbxMeshCache::WriteClipFile(animFilePath, kAnimImportFlags, skeletonHash, settings, *clip);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+        FbxAnim::Log() << "[FbxClipLibrary] Compiled '" << animFilePath << "': " << clip->GetTrackCount() << " tracks, "
+                  << clip->frameCount << " frames, " << clip->GetMemoryBytes() / 1024 << " KB (took " << duration.count() << "ms)" << std::endl;
+        return clip;
+    });
+}
+
+std::vector<FbxClipLibrary::ClipHandle> FbxClipLibrary::AcquireFiles(const std::vector<std::string>& animFilePaths, const std::vector<std::string>& skeletonNodeNames)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // 파일마다 워커 스레드에서 로드 (같은 키는 Acquire 내부에서 하나로 합쳐진다)
+    // 워커의 콘솔 출력은 파일별 버퍼에 모았다가 호출 스레드에서 파일 순서대로 출력한다
+    std::vector<std::ostringstream> logs(animFilePaths.size());
+    std::vector<std::future<ClipHandle>> loads;
+    loads.reserve(animFilePaths.size());
+    for (size_t i = 0; i < animFilePaths.size(); ++i)
+    {
+        loads.push_back(std::async(std::launch::async, [this, &path = animFilePaths[i], &log = logs[i], &skeletonNodeNames]()
+        {
+            FbxAnim::ScopedLogCapture capture(log);
+            return AcquireFile(path, skeletonNodeNames);
+        }));
+    }
+
+    std::vector<ClipHandle> clips;
+    clips.reserve(loads.size());
+    std::exception_ptr failure;
+    for (size_t i = 0; i < loads.size(); ++i)
+    {
+        ClipHandle clip;
+        try
+        {
+            clip = loads[i].get();
+        }
+        catch (...)
+        {
+            // 나머지 워커가 끝날 때까지 기다린 뒤 다시 던진다 (logs/경로를 참조하고 있다)
+            if (!failure)
+                failure = std::current_exception();
+        }
+        std::cout << logs[i].str();
+        clips.push_back(clip);
+    }
+    if (failure)
+        std::rethrow_exception(failure);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    std::cout << "[FbxClipLibrary] " << animFilePaths.size() << " clip(s) acquired (took " << duration.count()
+              << "ms, resident clips: " << GetResidentClipCount() << ")" << std::endl;
+    return clips;
+}
+
+FbxClipLibrary::ClipHandle FbxClipLibrary::AcquireEmbedded(const std::string& modelFilePath, unsigned int animIndex,
+                                                            const aiAnimation* anim, const aiNode* rootNode,
+                                                            const std::vector<std::string>& skeletonNodeNames)
+{
+    const FbxAnimCompressionSettings settings = GetCompressionSettings();
+    const std::string key = MakeKey(modelFilePath + "#anim" + std::to_string(animIndex), skeletonNodeNames, settings);
+
+    return Acquire(key, [&]() -> ClipHandle
+    {
+        const std::string name = (anim->mName.length > 0) ? anim->mName.C_Str() : ("Animation_" + std::to_string(animIndex));
+
+        const std::unordered_set<std::string> nodeFilter(skeletonNodeNames.begin(), skeletonNodeNames.end());
+        auto clip = std::make_shared<FbxAnimClip>();
+        if (!FbxAnim::CompileClip(anim, rootNode, name, FbxAnim::kDefaultSampleRate, settings, *clip, &nodeFilter))
+            return nullptr;
+        return clip;
+    });
+}
+
+FbxClipLibrary::ClipHandle FbxClipLibrary::AcquireEmbedded(const std::string& modelFilePath, unsigned int animIndex,
+                                                            const std::vector<std::string>& skeletonNodeNames,
+                                                            const std::function<ClipHandle()>& loader)
+{
+    const FbxAnimCompressionSettings settings = GetCompressionSettings();
+    return Acquire(MakeKey(modelFilePath + "#anim" + std::to_string(animIndex), skeletonNodeNames, settings), loader);
+}
+
+size_t FbxClipLibrary::GetResidentClipCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& pair : clips_)
+    {
+        if (!pair.second.expired())
+            ++count;
+    }
+    return count;
+}
+
+size_t FbxClipLibrary::GetResidentBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& pair : clips_)
+    {
+        if (ClipHandle clip = pair.second.lock())
+            bytes += clip->GetMemoryBytes();
+    }
+    return bytes;
+}
@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include "FbxAnimation.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+struct aiAnimation;
+struct aiNode;
+
+// Process-wide, reference-counted library of compiled animation clips
+// 키: 정규화된 파일 경로 + 스켈레톤 노드 이름 집합의 해시.
+// 같은 클립 파일을 쓰는 모델(인스턴스)들은 하나의 불변 FbxAnimClip을 공유하고,
+// 마지막 핸들이 해제되면 클립 메모리도 해제된다.
+class FbxClipLibrary
+{
+public:
+    using ClipHandle = std::shared_ptr<const FbxAnimClip>;
+
+    static FbxClipLibrary& Get();
+
+    // Clip from an animation file (first animation in the file)
+    ClipHandle AcquireFile(const std::string& animFilePath, const std::vector<std::string>& skeletonNodeNames);
+
+    // Several clip files at once: distinct files load in parallel on worker threads.
+    // Results keep the order of animFilePaths (nullptr for files that failed to load).
+    std::vector<ClipHandle> AcquireFiles(const std::vector<std::string>& animFilePaths, const std::vector<std::string>& skeletonNodeNames);
+
+    // Clip embedded in a model file (aiScene of the model is already loaded by the caller)
+    ClipHandle AcquireEmbedded(const std::string& modelFilePath, unsigned int animIndex,
+                               const aiAnimation* anim, const aiNode* rootNode,
+                               const std::vector<std::string>& skeletonNodeNames);
+
+    // Same key, clip supplied by the caller (already compiled, e.g. read from a .zmesh cache)
+    ClipHandle AcquireEmbedded(const std::string& modelFilePath, unsigned int animIndex,
+                               const std::vector<std::string>& skeletonNodeNames,
+                               const std::function<ClipHandle()>& loader);
+
+    // Compression tolerances for clips compiled from now on (part of the clip key)
+    void SetCompressionSettings(const FbxAnimCompressionSettings& settings);
+    FbxAnimCompressionSettings GetCompressionSettings();
+
+    // Stats
+    size_t GetResidentClipCount();
+    size_t GetResidentBytes();
+
+private:
+    FbxClipLibrary() = default;
+
+    ClipHandle Acquire(const std::string& key, const std::function<ClipHandle()>& loader);
+    static std::string MakeKey(const std::string& path, const std::vector<std::string>& skeletonNodeNames,
+                               const FbxAnimCompressionSettings& settings);
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::weak_ptr<const FbxAnimClip>> clips_;
+    std::unordered_map<std::string, std::shared_future<ClipHandle>> pending_;  // loads in flight
+    FbxAnimCompressionSettings settings_;
+};
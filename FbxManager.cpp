@@ -1,6 +1,16 @@
 ﻿#include "FbxManager.h"
+#include "FbxAnimation.h"
+#include "FbxAnimationLod.h"
+#include "FbxClipLibrary.h"
+#include "FbxMeshCache.h"
+#include "FbxPackedVertex.h"
+#include "FbxPaletteArena.h"
 #include "ZGraphics.h"
+#include "ZIndexBuffer.h"
 #include "ZVertex.h"
+#include "ZMeshOptimizer.h"
+#include "ZThreadPool.h"
+#include "ZAssetCooker.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -8,6 +18,8 @@
 #include <wincodec.h>
 #include <chrono>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
 
 #define USE_DIRECTXTK
 // DirectXTK headers (conditional)
@@ -16,10 +28,29 @@
 #include "WICTextureLoader.h"
 #endif
 #include <filesystem>
+#include <atomic>
+#include <Psapi.h>  // GetProcessMemoryInfo
+#ifdef _DEBUG
+#include <crtdbg.h>
+#endif
 
 using namespace DirectX;
 using Microsoft::WRL::ComPtr;
 
+#ifdef _DEBUG
+// CRT allocation hook used by FbxManager::CountUpdateAllocations
+static std::atomic<int> g_updateAllocCount{ 0 };
+
+static int __cdecl CountAllocHook(int allocType, void*, size_t, int, long, const unsigned char*, int)
+{
+    if (allocType != _HOOK_FREE)
+    {
+        ++g_updateAllocCount;
+    }
+    return TRUE;
+}
+#endif
+
 // Helper function to clean bone names for matching
 std::string CleanBoneName(const std::string& animBoneName) {
     std::string cleaned = animBoneName;
@@ -50,6 +81,46 @@ std::string CleanBoneName(const std::string& animBoneName) {
     return cleaned;
 }
 
+// Helper: finger/face bones (frozen to bind pose at reduced animation LOD)
+static bool IsDetailBoneName(const std::string& name)
+{
+    static constexpr const char* kDetailTokens[] = {
+        "thumb", "index", "middle", "ring", "pinky", "finger",
+        "eye", "jaw", "tongue", "brow", "lip", "cheek", "nose", "headtop_end" };
+
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    for (const char* token : kDetailTokens)
+    {
+        if (lower.find(token) != std::string::npos)
+            return true;
+    }
+    return false;
+}
+
+// Helper: process memory snapshot
+static void QueryProcessMemory(size_t& workingSet, size_t& privateBytes)
+{
+    PROCESS_MEMORY_COUNTERS_EX pmc{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&pmc), sizeof(pmc)))
+    {
+        workingSet = pmc.WorkingSetSize;
+        privateBytes = pmc.PrivateUsage;
+    }
+}
+
+// Helper: aiMatrix4x4 -> XMFLOAT4X4 (element-wise copy, keeps Assimp layout)
+static XMFLOAT4X4 ToXMFLOAT4X4(const aiMatrix4x4& m)
+{
+    return XMFLOAT4X4(
+        m.a1, m.a2, m.a3, m.a4,
+        m.b1, m.b2, m.b3, m.b4,
+        m.c1, m.c2, m.c3, m.c4,
+        m.d1, m.d2, m.d3, m.d4);
+}
+
 // Skinned vertex structure matching VertexInSkinned in shader
 struct VertexSkinned
 {
@@ -63,32 +134,211 @@ struct VertexSkinned
     XMFLOAT4 boneWeights; // float4 in shader
 };
 
+// Assimp post-processing for models (part of the .zmesh cache key)
+// Note: GenNormals and CalcTangentSpace are SLOW on large models
+static constexpr unsigned int kModelBaseImportFlags =
+    aiProcess_Triangulate |
+    aiProcess_JoinIdenticalVertices |
+    aiProcess_ConvertToLeftHanded |
+    aiProcess_GenSmoothNormals;   // Only generate if missing
+
+// Default descriptor (skinned, normal-mapped): FbxModel, asset cooker
+static constexpr unsigned int kModelImportFlags =
+    kModelBaseImportFlags |
+    aiProcess_CalcTangentSpace |   // Calculate tangent space (slow but needed)
+    aiProcess_LimitBoneWeights;
+
+// Helper: Assimp steps a descriptor needs
+static unsigned int ImportFlagsOf(const FbxImportDescriptor& descriptor)
+{
+    unsigned int flags = kModelBaseImportFlags;
+    if (descriptor.tangents)
+        flags |= aiProcess_CalcTangentSpace;
+    if (descriptor.skinning)
+        flags |= aiProcess_LimitBoneWeights;
+    return flags;
+}
+
+static double MillisecondsSince(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Helper: Create immutable-content vertex/index buffers (from Assimp output or the mapped cache)
+static bool CreateSkinnedMeshBuffers(ZGraphics& gfx, const void* vertices, UINT vertexStride, size_t vertexCount,
+                                     const void* indices, UINT indexStride, size_t indexCount,
+                                     ID3D11Buffer** ppVertexBuffer, ID3D11Buffer** ppIndexBuffer)
+{
+    // Create vertex buffer
+    D3D11_BUFFER_DESC vbd{};
+    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    vbd.Usage = D3D11_USAGE_DEFAULT;
+    vbd.ByteWidth = static_cast<UINT>(vertexCount * vertexStride);
+
+    D3D11_SUBRESOURCE_DATA vbData{};
+    vbData.pSysMem = vertices;
+
+    HRESULT hr = gfx.GetDeviceCOM()->CreateBuffer(&vbd, &vbData, ppVertexBuffer);
+    if (FAILED(hr))
+    {
+        std::cerr << "Failed to create vertex buffer" << std::endl;
+        return false;
+    }
+
+    // Create index buffer
+    D3D11_BUFFER_DESC ibd{};
+    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    ibd.Usage = D3D11_USAGE_DEFAULT;
+    ibd.ByteWidth = static_cast<UINT>(indexCount * indexStride);
+
+    D3D11_SUBRESOURCE_DATA ibData{};
+    ibData.pSysMem = indices;
+
+    hr = gfx.GetDeviceCOM()->CreateBuffer(&ibd, &ibData, ppIndexBuffer);
+    if (FAILED(hr))
+    {
+        std::cerr << "Failed to create index buffer" << std::endl;
+        (*ppVertexBuffer)->Release();
+        *ppVertexBuffer = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// Helper: file name part of a material texture path
+static std::string TextureFileName(const std::string& texPath)
+{
+    const size_t lastSlash = texPath.find_last_of("/\\");
+    return (lastSlash != std::string::npos) ? texPath.substr(lastSlash + 1) : texPath;
+}
+
+// Helper: default texture path rule ("./..." or a drive letter is already a full path)
+static std::string ResolveDefaultTexturePath(const std::string& baseDir, const std::string& texPath)
+{
+    return (texPath.find("./") == 0 || texPath.find(":") != std::string::npos) ? texPath : baseDir + texPath;
+}
+
+// Helper: First existing file of a texture slot: the source file's reference (as written, by name in baseDir or its
+// parent), then the material's own path, then the slot's common path. Empty if none exists
+static std::string FirstExistingTexture(const FbxTextureSlot& slot, const std::string& embeddedPath, size_t materialIndex,
+                                        const std::string& baseDir)
+{
+    std::vector<std::string> candidates;
+    if (slot.useEmbedded && !embeddedPath.empty())
+    {
+        const std::string filename = TextureFileName(embeddedPath);
+        candidates = { baseDir + embeddedPath, baseDir + filename, baseDir + "../" + filename };
+    }
+    const bool hasOwnPath = materialIndex < slot.paths.size() && !slot.paths[materialIndex].empty();
+    const std::string& explicitPath = hasOwnPath ? slot.paths[materialIndex] : slot.fallbackPath;
+    if (!explicitPath.empty())
+    {
+        candidates.push_back(ResolveDefaultTexturePath(baseDir, explicitPath));
+    }
+
+    for (const std::string& candidate : candidates)
+    {
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(candidate, ec))
+            return candidate;
+    }
+    return std::string();
+}
+
+// Texture slots filled by LoadMaterials (same order as FbxImportDescriptor)
+static constexpr size_t kTextureSlotCount = 3;
+
+struct TextureSlotRequest
+{
+    const char* name;
+    const FbxTextureSlot* slot;
+    std::vector<ComPtr<ID3D11ShaderResourceView>>* srvs;   // output, one per material
+    DXGI_FORMAT fallbackFormat;
+    UINT fallbackTexel;                                    // 1x1 texture for missing/failed slots
+};
+
+// Helper: 1x1 immutable texture of one texel
+static ComPtr<ID3D11ShaderResourceView> CreateSolidTexture(ZGraphics& gfx, DXGI_FORMAT format, UINT texel)
+{
+    D3D11_TEXTURE2D_DESC td{};
+    td.Width = 1;
+    td.Height = 1;
+    td.MipLevels = 1;
+    td.ArraySize = 1;
+    td.Format = format;
+    td.SampleDesc.Count = 1;
+    td.Usage = D3D11_USAGE_IMMUTABLE;
+    td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA sd{};
+    sd.pSysMem = &texel;
+    sd.SysMemPitch = sizeof(UINT);
+
+    ComPtr<ID3D11Texture2D> tex;
+    ComPtr<ID3D11ShaderResourceView> srv;
+    if (SUCCEEDED(gfx.GetDeviceCOM()->CreateTexture2D(&td, &sd, &tex)))
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
+        srvd.Format = td.Format;
+        srvd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+        srvd.Texture2D.MipLevels = 1;
+        srvd.Texture2D.MostDetailedMip = 0;
+        gfx.GetDeviceCOM()->CreateShaderResourceView(tex.Get(), &srvd, &srv);
+    }
+    return srv;
+}
+
 // Implementation struct
 struct FbxManager::Impl
 {
     // Assimp
     std::unique_ptr<Assimp::Importer> importer;
     const aiScene* scene = nullptr;
+    std::string sourcePath;
+    bool keepScene = false;  // debug/opt-in: keep aiScene alive after Load (GetScene)
 
     // Mesh buffers
     ID3D11Buffer* pVertexBuffer = nullptr;
     ID3D11Buffer* pIndexBuffer = nullptr;
+    DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT;
     int indexCount = 0;
-    UINT vertexStride = sizeof(VertexSkinned);  // Skinned vertex with bone data
+    UINT vertexStride = sizeof(VertexSkinned);  // Skinned vertex with bone data (FbxPackedVertex when packed)
+    FbxVertexFormat requestedVertexFormat = FbxVertexFormat::Full;   // SetVertexFormat
+    FbxVertexFormat vertexFormat = FbxVertexFormat::Full;            // format of pVertexBuffer
     UINT vertexOffset = 0;
 
+    // Bind-pose mesh bounds (model space, animation LOD visibility)
+    XMFLOAT3 boundsCenter = { 0.0f, 0.0f, 0.0f };
+    float boundsRadius = 0.0f;
+
+    // Mesh data kept between BuildMeshData and the .zmesh cache write (released right after)
+    std::vector<VertexSkinned> meshVertices;
+    std::vector<FbxPackedVertex> meshPackedVertices;
+    std::vector<uint32_t> meshIndices;
+    std::vector<uint16_t> meshIndices16;         // only the width that went to the GPU is kept
+
     // Subsets and materials
     std::vector<FbxSubset> subsets;
+    std::vector<FbxMaterialInfo> materialInfos;   // texture references from the source file
     std::vector<ComPtr<ID3D11ShaderResourceView>> materialSRVs;
     std::vector<ComPtr<ID3D11ShaderResourceView>> normalMapSRVs;
     std::vector<ComPtr<ID3D11ShaderResourceView>> specularMapSRVs;
     std::unordered_map<std::string, ComPtr<ID3D11ShaderResourceView>> textureCache;
-    ComPtr<ID3D11ShaderResourceView> fallbackBaseTexture;
+
+    // Import (FbxImportDescriptor → Assimp steps, .zmesh key)
+    unsigned int importFlags = kModelImportFlags;
+    FbxImportStats importStats;
 
     // Skeleton
     std::vector<FbxSkeletonNode> skeleton;
     int skeletonRoot = -1;
     std::unordered_map<std::string, int> nodeIndexOfName;
+    
+    // Flat skeleton (preorder: parent index < child index)
+    std::vector<int> parentOfNode;
+    std::vector<XMFLOAT4X4> restLocalOfNode;     // aiNode::mTransformation (Assimp layout, pivot helpers folded in)
+    uint32_t foldedPivotHelpers = 0;             // helper nodes removed by the last BuildSkeleton
+    XMFLOAT4X4 rootTransform;                    // root node transform (Assimp layout, globalInverse source)
 
     // Animation
     bool hasAnimations = false;
@@ -103,17 +353,39 @@ struct FbxManager::Impl
     std::vector<std::string> boneNames;
     std::vector<XMFLOAT4X4> boneOffsets;
     std::unordered_map<std::string, int> boneIndexOfName;
+    std::vector<int> nodeOfBone;  // bone index -> skeleton node index (-1 = not in hierarchy)
     XMFLOAT4X4 globalInverse;
     bool hasSkinning = false;
     
-    // Animation channel cache
-    std::vector<const aiNodeAnim*> channelOfNode;
+    // Compiled clips (base + external, same index as animationNames), shared via FbxClipLibrary
+    std::vector<std::shared_ptr<const FbxAnimClip>> clips;
+    
+    // Per-clip track binding (built once per clip, same index as clips)
+    struct ClipBinding
+    {
+        std::vector<int> trackOfNode;            // node index -> track index, -1 = not animated
+        std::vector<int> trackOfNodeReduced;     // same, finger/face tracks removed (animation LOD: frozen to bind pose)
+        std::vector<XMFLOAT4X4> restLocal;       // rest local per node, taken from the clip's source scene
+        int matchedTracks = 0;
+        int frozenTracks = 0;
+
+        // Reduced LOD node pass (BuildClipBinding에서 한 번 계산)
+        // 애니메이션 트랙이 없는 서브트리는 가장 가까운 움직이는 조상 기준 상대 변환이 고정 → 노드 패스에서 빼고 본만 한 번의 곱으로 구한다
+        struct FrozenBoneNode
+        {
+            int node = -1;
+            int anchor = -1;                     // nearest ancestor evaluated in the node pass (-1: none)
+            XMFLOAT4X4 relative;                 // anchor global → node global (frozen bones: model bind local)
+        };
+        std::vector<int> reducedLiveNodes;       // preorder, nodes with an animated track at or below them
+        std::vector<XMFLOAT4X4> reducedRestLocal;    // restLocal, frozen finger/face nodes → model bind local
+        std::vector<FrozenBoneNode> frozenBoneNodes;
+    };
+    std::vector<ClipBinding> clipBindings;
     
     // External animations
     struct ExternalAnimation
     {
-        std::unique_ptr<Assimp::Importer> importer;
-        const aiScene* scene = nullptr;
         std::string name;
         double duration = 0.0;
         double ticksPerSecond = 25.0;
@@ -122,12 +394,21 @@ struct FbxManager::Impl
     int baseAnimationCount = 0;  // Number of animations from main file
     int lastLoggedClip = -1;     // Track last logged animation for debug output
     
-    // Bone constant buffer for GPU skinning
+    // Per-update scratch (UpdateAnimation does no heap allocation in steady state)
+    FbxScratchArena scratch;
+    double lastTimeLogSec = 0.0;     // periodic animation time log
+    int paletteLogCount = 0;         // "Bone palette computed" log for first few updates
+    bool animationLogging = true;    // console logs of the animation path (off for batch/benchmark instances)
+    
+    // Bone constant buffer for GPU skinning: this instance's range in the shared 3x4 palette arena
     ID3D11Buffer* pBoneCB = nullptr;
-    static constexpr int kMaxBones = 1023;  // Match shader MAX_BONES
+    uint32_t boneCBBase = UINT32_MAX;      // values last written to pBoneCB
+    uint32_t boneCBCount = UINT32_MAX;
     
     // Current bone palette (computed each frame)
     std::vector<XMMATRIX> currentBonePalette;
+    uint64_t paletteArenaFrame = 0;        // arena frame currentBonePalette was packed in (0: not packed)
+    uint32_t paletteArenaBase = 0;
 };
 
 FbxManager::FbxManager()
@@ -137,6 +418,7 @@ FbxManager::FbxManager()
 
 FbxManager::~FbxManager()
 {
+    FbxAnimLodPolicy::Shared().Forget(this);
     Release();
 }
 
@@ -158,145 +440,179 @@ void FbxManager::Release()
     m_->normalMapSRVs.clear();
     m_->specularMapSRVs.clear();
     m_->textureCache.clear();
-    m_->fallbackBaseTexture.Reset();
     m_->subsets.clear();
+    m_->materialInfos.clear();
     m_->skeleton.clear();
+    m_->parentOfNode.clear();
+    m_->restLocalOfNode.clear();
     m_->animationNames.clear();
     m_->boneNames.clear();
     m_->boneOffsets.clear();
     m_->boneIndexOfName.clear();
-    m_->channelOfNode.clear();
+    m_->nodeOfBone.clear();
+    m_->clipBindings.clear();
+    m_->clips.clear();
     
     if (m_->pBoneCB)
     {
         m_->pBoneCB->Release();
         m_->pBoneCB = nullptr;
     }
+    m_->boneCBBase = UINT32_MAX;
+    m_->boneCBCount = UINT32_MAX;
+    m_->paletteArenaFrame = 0;
     
     m_->scene = nullptr;
     m_->importer.reset();
 }
 
-bool FbxManager::Load(ZGraphics& gfx, const std::string& filePath, const std::string& defaultTexturePath)
+// Single import pipeline: mesh (.zmesh cache or Assimp with the descriptor's post-process steps) → materials
+bool FbxManager::Load(ZGraphics& gfx, const std::string& filePath, const FbxImportDescriptor& descriptor, FbxImportStats* outStats)
 {
     auto loadStartTime = std::chrono::high_resolution_clock::now();
     std::cout << "=== FbxManager::Load ===" << std::endl;
     std::cout << "Loading: " << filePath << std::endl;
-    if (!defaultTexturePath.empty())
-    {
-        std::cout << "Default texture: " << defaultTexturePath << std::endl;
-    }
 
-    // Create Assimp importer
-    m_->importer = std::make_unique<Assimp::Importer>();
+    m_->importStats = FbxImportStats{};
+    m_->importFlags = ImportFlagsOf(descriptor);
+    m_->importStats.postProcessFlags = m_->importFlags;
 
-    // Load with Assimp
-    // Note: GenNormals and CalcTangentSpace are SLOW on large models
-    // Only use them if the model doesn't already have them
-    const unsigned int flags =
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_ConvertToLeftHanded |
-        aiProcess_GenSmoothNormals |  // Only generate if missing
-        aiProcess_CalcTangentSpace |   // Calculate tangent space (slow but needed)
-        aiProcess_LimitBoneWeights;
+    // Skeleton, bones, mesh buffers, material references and animations (.zmesh cache or Assimp)
+    if (!ImportModel(gfx, filePath))
+    {
+        return false;
+    }
 
-    std::cout << "Reading file with Assimp..." << std::flush;
-    auto assimpStart = std::chrono::high_resolution_clock::now();
-    m_->scene = m_->importer->ReadFile(filePath, flags);
-    auto assimpEnd = std::chrono::high_resolution_clock::now();
-    auto assimpDuration = std::chrono::duration_cast<std::chrono::milliseconds>(assimpEnd - assimpStart);
-    std::cout << " Done (" << assimpDuration.count() << "ms)" << std::endl;
+    // Save global inverse of root (for animation, Assimp layout like the rest pose)
+    XMStoreFloat4x4(&m_->globalInverse, XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_->rootTransform)));
 
-    if (!m_->scene || !m_->scene->mRootNode || m_->scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
+    // Load materials and textures
+    auto materialsStart = std::chrono::high_resolution_clock::now();
+    if (!LoadMaterials(gfx, m_->materialInfos, ExtractDirectory(filePath), descriptor))
     {
-        std::cerr << "Assimp Error: " << m_->importer->GetErrorString() << std::endl;
+        std::cerr << "Failed to load materials" << std::endl;
         return false;
     }
+    m_->importStats.materialsMs = MillisecondsSince(materialsStart);
 
-    std::cout << "Mesh count: " << m_->scene->mNumMeshes << std::endl;
-    std::cout << "Material count: " << m_->scene->mNumMaterials << std::endl;
+    // Engine data is built → drop Assimp scene unless explicitly kept
+    ReleaseImportedScene();
 
-    // Save global inverse of root (for animation)
-    if (m_->scene->mRootNode)
+    FbxImportStats& stats = m_->importStats;
+    stats.totalMs = MillisecondsSince(loadStartTime);
+    std::cout << "=== FbxManager::Load Complete (" << (stats.fromMeshCache ? "mesh cache" : "Assimp") << ", " << stats.totalMs
+              << "ms: cache " << stats.meshCacheMs << ", read " << stats.assimpReadMs << ", skeleton " << stats.skeletonMs
+              << ", mesh " << stats.meshBuildMs << ", animations " << stats.animationMs << ", cache write " << stats.meshCacheWriteMs
+              << ", materials " << stats.materialsMs << ") ===" << std::endl;
+
+    if (outStats)
     {
-        aiMatrix4x4 rootInv = m_->scene->mRootNode->mTransformation;
-        rootInv.Inverse();
-        m_->globalInverse._11 = rootInv.a1; m_->globalInverse._12 = rootInv.a2; m_->globalInverse._13 = rootInv.a3; m_->globalInverse._14 = rootInv.a4;
-        m_->globalInverse._21 = rootInv.b1; m_->globalInverse._22 = rootInv.b2; m_->globalInverse._23 = rootInv.b3; m_->globalInverse._24 = rootInv.b4;
-        m_->globalInverse._31 = rootInv.c1; m_->globalInverse._32 = rootInv.c2; m_->globalInverse._33 = rootInv.c3; m_->globalInverse._34 = rootInv.c4;
-        m_->globalInverse._41 = rootInv.d1; m_->globalInverse._42 = rootInv.d2; m_->globalInverse._43 = rootInv.d3; m_->globalInverse._44 = rootInv.d4;
+        *outStats = stats;
     }
+    return true;
+}
 
-    // Extract base directory
-    std::string baseDir = ExtractDirectory(filePath);
+const FbxImportStats& FbxManager::GetImportStats() const
+{
+    return m_->importStats;
+}
 
-    // Build skeleton
-    std::cout << "Building skeleton..." << std::flush;
-    auto skelStart = std::chrono::high_resolution_clock::now();
-    if (m_->scene->mRootNode)
+// Helper: Import skeleton, bones, mesh buffers, material references and animations
+// 유효한 .zmesh 캐시가 있으면 Assimp를 건너뛰고, 없으면 Assimp로 임포트한 뒤 캐시를 쓴다.
+bool FbxManager::ImportModel(ZGraphics& gfx, const std::string& filePath)
+{
+    m_->sourcePath = filePath;
+    const FbxAnimCompressionSettings clipSettings = FbxClipLibrary::Get().GetCompressionSettings();
+
+    // Warm path (SetKeepScene 사용자는 aiScene이 필요하다)
+    if (!m_->keepScene)
     {
-        BuildSkeleton(m_->scene->mRootNode, -1);
-        m_->skeletonRoot = 0;
-        CollectBones(m_->scene);
+        auto cacheStart = std::chrono::high_resolution_clock::now();
+        FbxMeshCache cache;
+        if (OpenMeshCache(cache, filePath, clipSettings))
+        {
+            if (LoadFromMeshCache(gfx, cache.GetContents()))
+            {
+                m_->importStats.fromMeshCache = true;
+                m_->importStats.meshCacheMs = MillisecondsSince(cacheStart);
+                std::cout << "Loaded from mesh cache: " << m_->skeleton.size() << " nodes, " << m_->boneNames.size() << " bones, "
+                          << m_->subsets.size() << " subsets, " << m_->animationNames.size() << " animations" << std::endl;
+                return true;
+            }
+            std::cerr << "[FbxManager] Mesh cache could not be used, importing with Assimp" << std::endl;
+        }
     }
-    auto skelEnd = std::chrono::high_resolution_clock::now();
-    auto skelDuration = std::chrono::duration_cast<std::chrono::milliseconds>(skelEnd - skelStart);
-    std::cout << " Done (" << skelDuration.count() << "ms)" << std::endl;
-    std::cout << "Skeleton nodes: " << m_->skeleton.size() << std::endl;
 
-    // Load materials and textures
-    if (!LoadMaterials(gfx, m_->scene, baseDir, defaultTexturePath))
-    {
-        std::cerr << "Failed to load materials" << std::endl;
+    if (!ImportScene(filePath))
         return false;
-    }
 
     // Build mesh buffers
+    auto meshStart = std::chrono::high_resolution_clock::now();
     if (!BuildMeshBuffers(gfx, m_->scene))
     {
         std::cerr << "Failed to build mesh buffers" << std::endl;
         return false;
     }
+    m_->importStats.meshBuildMs = MillisecondsSince(meshStart);
 
     // Initialize animation metadata
+    auto animationStart = std::chrono::high_resolution_clock::now();
     InitAnimationMetadata(m_->scene);
+    m_->importStats.animationMs = MillisecondsSince(animationStart);
 
-    auto loadEndTime = std::chrono::high_resolution_clock::now();
-    auto loadDuration = std::chrono::duration_cast<std::chrono::milliseconds>(loadEndTime - loadStartTime);
-    std::cout << "=== FbxManager::Load Complete (Total time: " << loadDuration.count() << "ms) ===" << std::endl;
+    auto cacheWriteStart = std::chrono::high_resolution_clock::now();
+    WriteMeshCache(clipSettings);
+    m_->importStats.meshCacheWriteMs = MillisecondsSince(cacheWriteStart);
     return true;
 }
 
-// Load with multiple default textures (one per material)
-bool FbxManager::Load(ZGraphics& gfx, const std::string& filePath, const std::vector<std::string>& defaultTexturePaths)
+// Headless cook (asset cooker): Assimp import → .zmesh without GPU resources
+// 유효한 캐시가 이미 있으면 임포트를 건너뛰고 outUpToDate = true.
+// 어느 경우든 스켈레톤/뼈/클립은 로드된 상태로 끝난다 (이어서 외부 애니메이션을 쿡할 수 있다).
+bool FbxManager::CookModel(const std::string& filePath, bool& outUpToDate)
 {
-    auto loadStartTime = std::chrono::high_resolution_clock::now();
-    std::cout << "=== FbxManager::Load ===" << std::endl;
-    std::cout << "Loading: " << filePath << std::endl;
-    if (!defaultTexturePaths.empty())
+    outUpToDate = false;
+    m_->sourcePath = filePath;
+    const FbxAnimCompressionSettings clipSettings = FbxClipLibrary::Get().GetCompressionSettings();
+
+    FbxMeshCache cache;
+    if (OpenMeshCache(cache, filePath, clipSettings) && IsMeshCacheUsable(cache.GetContents()))
     {
-        std::cout << "Default textures: " << defaultTexturePaths.size() << " textures" << std::endl;
+        LoadMeshCacheMetadata(cache.GetContents());
+        outUpToDate = true;
+        return true;
     }
 
+    if (!ImportScene(filePath))
+        return false;
+
+    BuildMeshData(m_->scene);
+    InitAnimationMetadata(m_->scene);
+    WriteMeshCache(clipSettings);
+    ReleaseImportedScene();
+    return true;
+}
+
+// Helper: Open the .zmesh of filePath in the requested vertex format
+bool FbxManager::OpenMeshCache(FbxMeshCache& cache, const std::string& filePath, const FbxAnimCompressionSettings& clipSettings) const
+{
+    const bool packedRequested = (m_->requestedVertexFormat == FbxVertexFormat::Packed);
+    const uint32_t cacheStride = packedRequested ? sizeof(FbxPackedVertex) : sizeof(VertexSkinned);
+    // 팩 형식을 요청해도 뼈가 256개를 넘는 모델은 전체 형식으로 캐시된다
+    return cache.Open(filePath, m_->importFlags, cacheStride, clipSettings) ||
+           (packedRequested && cache.Open(filePath, m_->importFlags, sizeof(VertexSkinned), clipSettings));
+}
+
+// Helper: Assimp import up to the mesh conversion (skeleton, bones, material references)
+bool FbxManager::ImportScene(const std::string& filePath)
+{
     // Create Assimp importer
     m_->importer = std::make_unique<Assimp::Importer>();
 
-    // Load with Assimp
-    const unsigned int flags =
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_ConvertToLeftHanded |
-        aiProcess_GenSmoothNormals |
-        aiProcess_CalcTangentSpace |
-        aiProcess_LimitBoneWeights;
-
-    std::cout << "Reading file with Assimp..." << std::flush;
+    std::cout << "Reading file with Assimp..." << std::endl;
     auto assimpStart = std::chrono::high_resolution_clock::now();
-    m_->scene = m_->importer->ReadFile(filePath, flags);
-    auto assimpEnd = std::chrono::high_resolution_clock::now();
-    auto assimpDuration = std::chrono::duration_cast<std::chrono::milliseconds>(assimpEnd - assimpStart);
-    std::cout << " Done (" << assimpDuration.count() << "ms)" << std::endl;
+    m_->scene = m_->importer->ReadFile(filePath, m_->importFlags);
+    m_->importStats.assimpReadMs = MillisecondsSince(assimpStart);
 
     if (!m_->scene || !m_->scene->mRootNode || m_->scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
     {
@@ -307,240 +623,271 @@ bool FbxManager::Load(ZGraphics& gfx, const std::string& filePath, const std::ve
     std::cout << "Mesh count: " << m_->scene->mNumMeshes << std::endl;
     std::cout << "Material count: " << m_->scene->mNumMaterials << std::endl;
 
-    // Save global inverse of root (for animation)
-    if (m_->scene->mRootNode)
-    {
-        aiMatrix4x4 rootInv = m_->scene->mRootNode->mTransformation;
-        rootInv.Inverse();
-        m_->globalInverse._11 = rootInv.a1; m_->globalInverse._12 = rootInv.a2; m_->globalInverse._13 = rootInv.a3; m_->globalInverse._14 = rootInv.a4;
-        m_->globalInverse._21 = rootInv.b1; m_->globalInverse._22 = rootInv.b2; m_->globalInverse._23 = rootInv.b3; m_->globalInverse._24 = rootInv.b4;
-        m_->globalInverse._31 = rootInv.c1; m_->globalInverse._32 = rootInv.c2; m_->globalInverse._33 = rootInv.c3; m_->globalInverse._34 = rootInv.c4;
-        m_->globalInverse._41 = rootInv.d1; m_->globalInverse._42 = rootInv.d2; m_->globalInverse._43 = rootInv.d3; m_->globalInverse._44 = rootInv.d4;
-    }
-
-    // Extract base directory
-    std::string baseDir = ExtractDirectory(filePath);
+    m_->rootTransform = ToXMFLOAT4X4(m_->scene->mRootNode->mTransformation);
 
     // Build skeleton
-    std::cout << "Building skeleton..." << std::flush;
     auto skelStart = std::chrono::high_resolution_clock::now();
-    if (m_->scene->mRootNode)
-    {
-        BuildSkeleton(m_->scene->mRootNode, -1);
-        m_->skeletonRoot = 0;
-        CollectBones(m_->scene);
-    }
-    auto skelEnd = std::chrono::high_resolution_clock::now();
-    auto skelDuration = std::chrono::duration_cast<std::chrono::milliseconds>(skelEnd - skelStart);
-    std::cout << " Done (" << skelDuration.count() << "ms)" << std::endl;
-    std::cout << "Skeleton nodes: " << m_->skeleton.size() << std::endl;
+    BuildSkeleton(m_->scene->mRootNode, -1);
+    m_->skeletonRoot = 0;
+    CollectBones(m_->scene);
+    std::cout << "Skeleton nodes: " << m_->skeleton.size() << " (" << m_->skeleton.size() + m_->foldedPivotHelpers
+              << " before folding " << m_->foldedPivotHelpers << " pivot helpers)" << std::endl;
 
-    // Load materials and textures with multiple defaults
-    if (!LoadMaterials(gfx, m_->scene, baseDir, defaultTexturePaths))
-    {
-        std::cerr << "Failed to load materials" << std::endl;
+    CollectMaterialInfo(m_->scene);
+    m_->importStats.skeletonMs = MillisecondsSince(skelStart);
+    return true;
+}
+
+// Helper: Engine data from a mapped .zmesh cache (vertex/index data goes straight to the GPU buffers)
+bool FbxManager::LoadFromMeshCache(ZGraphics& gfx, const FbxMeshCacheContents& contents)
+{
+    if (!IsMeshCacheUsable(contents))
         return false;
-    }
+    const bool packed = (contents.vertexStride == sizeof(FbxPackedVertex));
 
-    // Build mesh buffers
-    if (!BuildMeshBuffers(gfx, m_->scene))
+    // GPU buffers first: nothing else is touched if this fails
+    if (!CreateSkinnedMeshBuffers(gfx, contents.vertexData, contents.vertexStride, contents.vertexCount,
+                                  contents.indexData, contents.indexStride, contents.indexCount,
+                                  &m_->pVertexBuffer, &m_->pIndexBuffer))
     {
-        std::cerr << "Failed to build mesh buffers" << std::endl;
         return false;
     }
+    m_->vertexFormat = packed ? FbxVertexFormat::Packed : FbxVertexFormat::Full;
+    m_->vertexStride = contents.vertexStride;
+    m_->indexFormat = (contents.indexStride == sizeof(uint16_t)) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    m_->indexCount = static_cast<int>(contents.indexCount);
+    LoadMeshCacheMetadata(contents);
+    return true;
+}
 
-    // Initialize animation metadata
-    InitAnimationMetadata(m_->scene);
+// Helper: Vertex format of the cache must be the one an import would produce now
+// (전체 형식 캐시는 뼈가 많아 팩 형식이 불가능할 때만)
+bool FbxManager::IsMeshCacheUsable(const FbxMeshCacheContents& contents) const
+{
+    const bool packed = (contents.vertexStride == sizeof(FbxPackedVertex));
+    if (!packed && contents.vertexStride != sizeof(VertexSkinned))
+        return false;
 
-    auto loadEndTime = std::chrono::high_resolution_clock::now();
-    auto loadDuration = std::chrono::duration_cast<std::chrono::milliseconds>(loadEndTime - loadStartTime);
-    std::cout << "=== FbxManager::Load Complete (Total time: " << loadDuration.count() << "ms) ===" << std::endl;
-    return true;
+    const bool packable = contents.boneNames.size() <= FbxVertexPack::kMaxBones;
+    return packed == (m_->requestedVertexFormat == FbxVertexFormat::Packed && packable);
 }
 
-// Load with multiple default textures and normal maps (one per material)
-bool FbxManager::Load(ZGraphics& gfx, const std::string& filePath, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths)
+// Helper: Everything of the cache except the GPU buffers (subsets, skeleton, bones, clips)
+void FbxManager::LoadMeshCacheMetadata(const FbxMeshCacheContents& contents)
 {
-    auto loadStartTime = std::chrono::high_resolution_clock::now();
-    std::cout << "=== FbxManager::Load ===" << std::endl;
-    std::cout << "Loading: " << filePath << std::endl;
-    if (!defaultTexturePaths.empty())
+    m_->subsets = contents.subsets;
+    m_->boundsCenter = contents.boundsCenter;
+    m_->boundsRadius = contents.boundsRadius;
+    m_->rootTransform = contents.rootTransform;
+    m_->materialInfos = contents.materials;
+
+    // Skeleton (same tables BuildSkeleton fills)
+    m_->skeleton = contents.skeleton;
+    m_->restLocalOfNode = contents.restLocalOfNode;
+    m_->parentOfNode.reserve(m_->skeleton.size());
+    for (size_t i = 0; i < m_->skeleton.size(); ++i)
     {
-        std::cout << "Default textures: " << defaultTexturePaths.size() << " textures" << std::endl;
+        m_->nodeIndexOfName[m_->skeleton[i].name] = static_cast<int>(i);
+        m_->parentOfNode.push_back(m_->skeleton[i].parent);
     }
-    if (!defaultNormalMapPaths.empty())
+    m_->skeletonRoot = m_->skeleton.empty() ? -1 : 0;
+    m_->scratch.Reserve(sizeof(XMMATRIX) * (m_->skeleton.size() + 1));
+
+    // Bones (same tables CollectBones fills)
+    m_->boneNames = contents.boneNames;
+    m_->boneOffsets = contents.boneOffsets;
+    for (size_t b = 0; b < m_->boneNames.size(); ++b)
     {
-        std::cout << "Default normal maps: " << defaultNormalMapPaths.size() << " normal maps" << std::endl;
+        m_->boneIndexOfName[m_->boneNames[b]] = static_cast<int>(b);
+        auto it = m_->nodeIndexOfName.find(m_->boneNames[b]);
+        m_->nodeOfBone.push_back(it != m_->nodeIndexOfName.end() ? it->second : -1);
     }
+    m_->hasSkinning = !m_->boneNames.empty();
 
-    // Create Assimp importer
-    m_->importer = std::make_unique<Assimp::Importer>();
-
-    // Load with Assimp
-    const unsigned int flags =
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_ConvertToLeftHanded |
-        aiProcess_GenSmoothNormals |
-        aiProcess_CalcTangentSpace |
-        aiProcess_LimitBoneWeights;
-
-    std::cout << "Reading file with Assimp..." << std::flush;
-    auto assimpStart = std::chrono::high_resolution_clock::now();
-    m_->scene = m_->importer->ReadFile(filePath, flags);
-    auto assimpEnd = std::chrono::high_resolution_clock::now();
-    auto assimpDuration = std::chrono::duration_cast<std::chrono::milliseconds>(assimpEnd - assimpStart);
-    std::cout << " Done (" << assimpDuration.count() << "ms)" << std::endl;
-
-    if (!m_->scene || !m_->scene->mRootNode || m_->scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
+    // Embedded animations: cached clips, shared through the clip library like compiled ones
+    if (!contents.animations.empty())
     {
-        std::cerr << "Assimp Error: " << m_->importer->GetErrorString() << std::endl;
-        return false;
+        m_->hasAnimations = true;
+        const std::vector<std::string> skeletonNodeNames = GetSkeletonNodeNames();
+        for (size_t i = 0; i < contents.animations.size(); ++i)
+        {
+            const FbxMeshCacheContents::Animation& animation = contents.animations[i];
+            m_->animationNames.push_back(animation.name);
+            m_->clipDurationSec.push_back(animation.durationSec);
+            m_->clipTicksPerSec.push_back(animation.ticksPerSecond);
+
+            std::shared_ptr<const FbxAnimClip> cachedClip = animation.clip;
+            m_->clips.push_back(FbxClipLibrary::Get().AcquireEmbedded(m_->sourcePath, static_cast<unsigned int>(i), skeletonNodeNames,
+                [cachedClip]() { return cachedClip; }));
+            BuildClipBinding(static_cast<int>(m_->clips.size()) - 1);
+        }
+        m_->baseAnimationCount = static_cast<int>(m_->animationNames.size());
     }
+}
 
-    std::cout << "Mesh count: " << m_->scene->mNumMeshes << std::endl;
-    std::cout << "Material count: " << m_->scene->mNumMaterials << std::endl;
-
-    // Save global inverse of root (for animation)
-    if (m_->scene->mRootNode)
+// Helper: Write the .zmesh cache after an Assimp import
+void FbxManager::WriteMeshCache(const FbxAnimCompressionSettings& clipSettings)
+{
+    FbxMeshCacheContents contents;
+    if (m_->vertexFormat == FbxVertexFormat::Packed)
     {
-        XMMATRIX globalTransform = XMMATRIX(
-            m_->scene->mRootNode->mTransformation.a1, m_->scene->mRootNode->mTransformation.b1, m_->scene->mRootNode->mTransformation.c1, m_->scene->mRootNode->mTransformation.d1,
-            m_->scene->mRootNode->mTransformation.a2, m_->scene->mRootNode->mTransformation.b2, m_->scene->mRootNode->mTransformation.c2, m_->scene->mRootNode->mTransformation.d2,
-            m_->scene->mRootNode->mTransformation.a3, m_->scene->mRootNode->mTransformation.b3, m_->scene->mRootNode->mTransformation.c3, m_->scene->mRootNode->mTransformation.d3,
-            m_->scene->mRootNode->mTransformation.a4, m_->scene->mRootNode->mTransformation.b4, m_->scene->mRootNode->mTransformation.c4, m_->scene->mRootNode->mTransformation.d4
-        );
-        XMStoreFloat4x4(&m_->globalInverse, XMMatrixInverse(nullptr, globalTransform));
+        contents.vertexData = m_->meshPackedVertices.data();
+        contents.vertexStride = sizeof(FbxPackedVertex);
+        contents.vertexCount = static_cast<uint32_t>(m_->meshPackedVertices.size());
     }
-
-    // Extract base directory for texture loading
-    std::string baseDir = ExtractDirectory(filePath);
-
-    // Build skeleton
-    std::cout << "Building skeleton..." << std::flush;
-    auto skelStart = std::chrono::high_resolution_clock::now();
-    BuildSkeleton(m_->scene->mRootNode, -1);
-    CollectBones(m_->scene);
-    auto skelEnd = std::chrono::high_resolution_clock::now();
-    auto skelDuration = std::chrono::duration_cast<std::chrono::milliseconds>(skelEnd - skelStart);
-    std::cout << " Done (" << skelDuration.count() << "ms)" << std::endl;
-    std::cout << "Skeleton nodes: " << m_->skeleton.size() << std::endl;
-
-    // Load materials and textures with multiple defaults and normal maps
-    if (!LoadMaterials(gfx, m_->scene, baseDir, defaultTexturePaths, defaultNormalMapPaths))
+    else
     {
-        std::cerr << "Failed to load materials" << std::endl;
-        return false;
+        contents.vertexData = m_->meshVertices.data();
+        contents.vertexStride = sizeof(VertexSkinned);
+        contents.vertexCount = static_cast<uint32_t>(m_->meshVertices.size());
     }
-
-    // Build mesh buffers
-    if (!BuildMeshBuffers(gfx, m_->scene))
+    if (m_->indexFormat == DXGI_FORMAT_R16_UINT)
     {
-        std::cerr << "Failed to build mesh buffers" << std::endl;
-        return false;
+        contents.indexData = m_->meshIndices16.data();
+        contents.indexStride = sizeof(uint16_t);
+        contents.indexCount = static_cast<uint32_t>(m_->meshIndices16.size());
     }
+    else
+    {
+        contents.indexData = m_->meshIndices.data();
+        contents.indexStride = sizeof(uint32_t);
+        contents.indexCount = static_cast<uint32_t>(m_->meshIndices.size());
+    }
+    contents.subsets = m_->subsets;
+    contents.boundsCenter = m_->boundsCenter;
+    contents.boundsRadius = m_->boundsRadius;
+    contents.rootTransform = m_->rootTransform;
+    contents.skeleton = m_->skeleton;
+    contents.restLocalOfNode = m_->restLocalOfNode;
+    contents.boneNames = m_->boneNames;
+    contents.boneOffsets = m_->boneOffsets;
+    contents.materials = m_->materialInfos;
+    for (int i = 0; i < m_->baseAnimationCount; ++i)
+    {
+        FbxMeshCacheContents::Animation animation;
+        animation.name = m_->animationNames[i];
+        animation.durationSec = m_->clipDurationSec[i];
+        animation.ticksPerSecond = m_->clipTicksPerSec[i];
+        animation.clip = m_->clips[i];
+        contents.animations.push_back(std::move(animation));
+    }
+
+    FbxMeshCache::Write(m_->sourcePath, m_->importFlags, clipSettings, contents);
+
+    // GPU buffers own the mesh from here on
+    std::vector<VertexSkinned>().swap(m_->meshVertices);
+    std::vector<FbxPackedVertex>().swap(m_->meshPackedVertices);
+    std::vector<uint32_t>().swap(m_->meshIndices);
+    std::vector<uint16_t>().swap(m_->meshIndices16);
+}
 
-    // Initialize animation metadata
-    InitAnimationMetadata(m_->scene);
+// Helper: Texture references of every material (LoadMaterials works from these, not from the aiScene)
+void FbxManager::CollectMaterialInfo(const aiScene* scene)
+{
+    m_->materialInfos.clear();
+    m_->materialInfos.resize(scene->mNumMaterials);
+    for (unsigned int m = 0; m < scene->mNumMaterials; ++m)
+    {
+        const aiMaterial* mat = scene->mMaterials[m];
+        FbxMaterialInfo& info = m_->materialInfos[m];
 
-    auto loadEndTime = std::chrono::high_resolution_clock::now();
-    auto loadDuration = std::chrono::duration_cast<std::chrono::milliseconds>(loadEndTime - loadStartTime);
-    std::cout << "=== FbxManager::Load Complete (Total time: " << loadDuration.count() << "ms) ===" << std::endl;
-    return true;
+        aiString texPath;
+        if (mat->GetTexture(aiTextureType_DIFFUSE, 0, &texPath) == AI_SUCCESS)
+        {
+            info.hasDiffuse = true;
+            info.diffusePath = texPath.C_Str();
+        }
+
+        aiString normalPath;
+        if (mat->GetTexture(aiTextureType_NORMALS, 0, &normalPath) == AI_SUCCESS)
+        {
+            info.hasNormalMap = true;
+            info.normalMapPath = normalPath.C_Str();
+        }
+    }
 }
 
-// Load with multiple default textures, normal maps, and specular maps (one per material)
-bool FbxManager::Load(ZGraphics& gfx, const std::string& filePath, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths, const std::vector<std::string>& defaultSpecularMapPaths)
+// Headless load: skeleton, bones and animation clips only (no materials/GPU buffers)
+bool FbxManager::LoadRig(const std::string& filePath)
 {
     auto loadStartTime = std::chrono::high_resolution_clock::now();
-    std::cout << "=== FbxManager::Load ===" << std::endl;
+    std::cout << "=== FbxManager::LoadRig ===" << std::endl;
     std::cout << "Loading: " << filePath << std::endl;
-    if (!defaultTexturePaths.empty())
-    {
-        std::cout << "Default textures: " << defaultTexturePaths.size() << " textures" << std::endl;
-    }
-    if (!defaultNormalMapPaths.empty())
-    {
-        std::cout << "Default normal maps: " << defaultNormalMapPaths.size() << " normal maps" << std::endl;
-    }
-    if (!defaultSpecularMapPaths.empty())
-    {
-        std::cout << "Default specular maps: " << defaultSpecularMapPaths.size() << " specular maps" << std::endl;
-    }
 
-    // Create Assimp importer
     m_->importer = std::make_unique<Assimp::Importer>();
+    m_->sourcePath = filePath;
 
-    // Load with Assimp
+    // 정점 속성 생성(법선/탄젠트)은 필요 없다. 좌표계 변환은 Load와 같아야 한다
     const unsigned int flags =
         aiProcess_Triangulate |
         aiProcess_JoinIdenticalVertices |
         aiProcess_ConvertToLeftHanded |
-        aiProcess_GenSmoothNormals |
-        aiProcess_CalcTangentSpace |
         aiProcess_LimitBoneWeights;
 
-    std::cout << "Reading file with Assimp..." << std::flush;
-    auto assimpStart = std::chrono::high_resolution_clock::now();
     m_->scene = m_->importer->ReadFile(filePath, flags);
-    auto assimpEnd = std::chrono::high_resolution_clock::now();
-    auto assimpDuration = std::chrono::duration_cast<std::chrono::milliseconds>(assimpEnd - assimpStart);
-    std::cout << " Done (" << assimpDuration.count() << "ms)" << std::endl;
-
-    if (!m_->scene || m_->scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !m_->scene->mRootNode)
+    if (!m_->scene || !m_->scene->mRootNode || m_->scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
     {
-        std::cerr << "Error loading FBX file: " << m_->importer->GetErrorString() << std::endl;
+        std::cerr << "Assimp Error: " << m_->importer->GetErrorString() << std::endl;
         return false;
     }
 
-    // Save global inverse of root (for animation) - CRITICAL!
-    if (m_->scene->mRootNode)
-    {
-        XMMATRIX globalTransform = XMMATRIX(
-            m_->scene->mRootNode->mTransformation.a1, m_->scene->mRootNode->mTransformation.b1, m_->scene->mRootNode->mTransformation.c1, m_->scene->mRootNode->mTransformation.d1,
-            m_->scene->mRootNode->mTransformation.a2, m_->scene->mRootNode->mTransformation.b2, m_->scene->mRootNode->mTransformation.c2, m_->scene->mRootNode->mTransformation.d2,
-            m_->scene->mRootNode->mTransformation.a3, m_->scene->mRootNode->mTransformation.b3, m_->scene->mRootNode->mTransformation.c3, m_->scene->mRootNode->mTransformation.d3,
-            m_->scene->mRootNode->mTransformation.a4, m_->scene->mRootNode->mTransformation.b4, m_->scene->mRootNode->mTransformation.c4, m_->scene->mRootNode->mTransformation.d4
-        );
-        XMStoreFloat4x4(&m_->globalInverse, XMMatrixInverse(nullptr, globalTransform));
-    }
+    aiMatrix4x4 rootInv = m_->scene->mRootNode->mTransformation;
+    rootInv.Inverse();
+    m_->globalInverse = ToXMFLOAT4X4(rootInv);
 
-    // Extract base directory from file path
-    std::string baseDir = filePath.substr(0, filePath.find_last_of("/\\") + 1);
-
-    // Build skeleton
-    std::cout << "Building skeleton..." << std::flush;
-    auto skelStart = std::chrono::high_resolution_clock::now();
     BuildSkeleton(m_->scene->mRootNode, -1);
+    m_->skeletonRoot = 0;
     CollectBones(m_->scene);
-    auto skelEnd = std::chrono::high_resolution_clock::now();
-    auto skelDuration = std::chrono::duration_cast<std::chrono::milliseconds>(skelEnd - skelStart);
-    std::cout << " Done (" << skelDuration.count() << "ms)" << std::endl;
-    std::cout << "Skeleton nodes: " << m_->skeleton.size() << std::endl;
-
-    // Load materials and textures with multiple defaults, normal maps, and specular maps
-    if (!LoadMaterials(gfx, m_->scene, baseDir, defaultTexturePaths, defaultNormalMapPaths, defaultSpecularMapPaths))
-    {
-        std::cerr << "Failed to load materials" << std::endl;
-        return false;
-    }
-
-    // Build mesh buffers
-    if (!BuildMeshBuffers(gfx, m_->scene))
-    {
-        std::cerr << "Failed to build mesh buffers" << std::endl;
-        return false;
-    }
-
-    // Initialize animation metadata
+    std::cout << "Skeleton nodes: " << m_->skeleton.size() << " (" << m_->skeleton.size() + m_->foldedPivotHelpers
+              << " before folding " << m_->foldedPivotHelpers << " pivot helpers)" << std::endl;
     InitAnimationMetadata(m_->scene);
 
+    ReleaseImportedScene();
+
     auto loadEndTime = std::chrono::high_resolution_clock::now();
     auto loadDuration = std::chrono::duration_cast<std::chrono::milliseconds>(loadEndTime - loadStartTime);
-    std::cout << "=== FbxManager::Load Complete (Total time: " << loadDuration.count() << "ms) ===" << std::endl;
+    std::cout << "=== FbxManager::LoadRig Complete (Total time: " << loadDuration.count() << "ms) ===" << std::endl;
     return true;
 }
 
+// Copy skeleton, bones and clip bindings from a loaded model (clips stay shared)
+void FbxManager::CopyRigFrom(const FbxManager& source)
+{
+    const Impl& src = *source.m_;
+
+    m_->sourcePath = src.sourcePath;
+    m_->skeleton = src.skeleton;
+    m_->skeletonRoot = src.skeletonRoot;
+    m_->nodeIndexOfName = src.nodeIndexOfName;
+    m_->parentOfNode = src.parentOfNode;
+    m_->restLocalOfNode = src.restLocalOfNode;
+
+    m_->hasAnimations = src.hasAnimations;
+    m_->animationNames = src.animationNames;
+    m_->clipDurationSec = src.clipDurationSec;
+    m_->clipTicksPerSec = src.clipTicksPerSec;
+    m_->currentClip = src.currentClip;
+    m_->clipTimeSec = src.clipTimeSec;
+    m_->playing = src.playing;
+
+    m_->boneNames = src.boneNames;
+    m_->boneOffsets = src.boneOffsets;
+    m_->boneIndexOfName = src.boneIndexOfName;
+    m_->nodeOfBone = src.nodeOfBone;
+    m_->globalInverse = src.globalInverse;
+    m_->hasSkinning = src.hasSkinning;
+    m_->boundsCenter = src.boundsCenter;
+    m_->boundsRadius = src.boundsRadius;
+
+    m_->clips = src.clips;
+    m_->clipBindings = src.clipBindings;
+    m_->externalAnimations = src.externalAnimations;
+    m_->baseAnimationCount = src.baseAnimationCount;
+
+    m_->scratch.Reserve(sizeof(XMMATRIX) * (m_->skeleton.size() + 1));
+    m_->currentBonePalette.reserve(m_->boneNames.size());
+}
+
 bool FbxManager::HasMesh() const
 {
     return m_->pVertexBuffer != nullptr && m_->pIndexBuffer != nullptr;
@@ -556,6 +903,11 @@ ID3D11Buffer* FbxManager::GetIndexBuffer() const
     return m_->pIndexBuffer;
 }
 
+DXGI_FORMAT FbxManager::GetIndexFormat() const
+{
+    return m_->indexFormat;
+}
+
 int FbxManager::GetIndexCount() const
 {
     return m_->indexCount;
@@ -571,6 +923,16 @@ UINT FbxManager::GetVertexOffset() const
     return m_->vertexOffset;
 }
 
+void FbxManager::SetVertexFormat(FbxVertexFormat format)
+{
+    m_->requestedVertexFormat = format;
+}
+
+FbxVertexFormat FbxManager::GetVertexFormat() const
+{
+    return m_->vertexFormat;
+}
+
 const std::vector<FbxSubset>& FbxManager::GetSubsets() const
 {
     return m_->subsets;
@@ -593,9 +955,75 @@ const std::vector<ComPtr<ID3D11ShaderResourceView>>& FbxManager::GetSpecularMapS
 
 const aiScene* FbxManager::GetScene() const
 {
+    // Debug/opt-in path: only valid when SetKeepScene(true) was called before Load
     return m_->scene;
 }
 
+void FbxManager::SetKeepScene(bool keep)
+{
+    m_->keepScene = keep;
+}
+
+void FbxManager::ReleaseScene()
+{
+    m_->keepScene = false;
+    ReleaseImportedScene();
+}
+
+// Helper: Release Assimp importer/scene after engine data has been extracted
+void FbxManager::ReleaseImportedScene()
+{
+    if (m_->keepScene || !m_->importer)
+        return;
+
+    size_t workingSetBefore = 0, privateBefore = 0;
+    QueryProcessMemory(workingSetBefore, privateBefore);
+
+    m_->scene = nullptr;
+    m_->importer.reset();
+
+    size_t workingSetAfter = 0, privateAfter = 0;
+    QueryProcessMemory(workingSetAfter, privateAfter);
+
+    std::cout << "[FbxManager] Assimp scene released: private "
+              << privateBefore / (1024.0 * 1024.0) << " MB -> " << privateAfter / (1024.0 * 1024.0) << " MB, working set "
+              << workingSetBefore / (1024.0 * 1024.0) << " MB -> " << workingSetAfter / (1024.0 * 1024.0) << " MB"
+              << " (engine-owned animation data: " << GetEngineMemoryBytes() / 1024 << " KB)" << std::endl;
+}
+
+// Approximate CPU bytes of the compact engine data kept after import
+size_t FbxManager::GetEngineMemoryBytes() const
+{
+    size_t bytes = 0;
+    for (const auto& node : m_->skeleton)
+    {
+        bytes += sizeof(FbxSkeletonNode) + node.name.capacity() + node.children.capacity() * sizeof(int);
+    }
+    bytes += m_->parentOfNode.capacity() * sizeof(int);
+    bytes += m_->restLocalOfNode.capacity() * sizeof(XMFLOAT4X4);
+    bytes += m_->nodeIndexOfName.size() * (sizeof(std::string) + sizeof(int) + 32);
+    for (const auto& name : m_->boneNames)
+    {
+        bytes += sizeof(std::string) + name.capacity();
+    }
+    bytes += m_->boneOffsets.capacity() * sizeof(XMFLOAT4X4);
+    bytes += m_->nodeOfBone.capacity() * sizeof(int);
+    for (const auto& binding : m_->clipBindings)
+    {
+        bytes += binding.trackOfNode.capacity() * sizeof(int) + binding.restLocal.capacity() * sizeof(XMFLOAT4X4);
+        bytes += binding.trackOfNodeReduced.capacity() * sizeof(int) + binding.reducedLiveNodes.capacity() * sizeof(int);
+        bytes += binding.reducedRestLocal.capacity() * sizeof(XMFLOAT4X4);
+        bytes += binding.frozenBoneNodes.capacity() * sizeof(Impl::ClipBinding::FrozenBoneNode);
+    }
+    for (const auto& clip : m_->clips)
+    {
+        if (clip)
+            bytes += clip->GetMemoryBytes();  // shared: counted per referencing model
+    }
+    bytes += m_->scratch.GetCapacity();
+    return bytes;
+}
+
 const std::vector<FbxSkeletonNode>& FbxManager::GetSkeleton() const
 {
     return m_->skeleton;
@@ -638,6 +1066,17 @@ void FbxManager::BuildSkeleton(const aiNode* node, int parentIndex)
 {
     if (!node) return;
 
+    if (parentIndex < 0)
+    {
+        m_->foldedPivotHelpers = 0;
+    }
+
+    // Assimp FBX pivot helpers are folded into the owning node's local transform
+    XMFLOAT4X4 local;
+    std::vector<const aiNode*> helpers;
+    node = FbxAnim::FoldPivotChain(node, local, &helpers);
+    m_->foldedPivotHelpers += static_cast<uint32_t>(helpers.size());
+
     int currentIndex = static_cast<int>(m_->skeleton.size());
 
     FbxSkeletonNode skelNode;
@@ -647,6 +1086,8 @@ void FbxManager::BuildSkeleton(const aiNode* node, int parentIndex)
 
     m_->skeleton.push_back(skelNode);
     m_->nodeIndexOfName[skelNode.name] = currentIndex;
+    m_->parentOfNode.push_back(parentIndex);
+    m_->restLocalOfNode.push_back(local);
 
     // Process children
     for (unsigned int i = 0; i < node->mNumChildren; ++i)
@@ -655,6 +1096,12 @@ void FbxManager::BuildSkeleton(const aiNode* node, int parentIndex)
         m_->skeleton[currentIndex].children.push_back(childIndex);
         BuildSkeleton(node->mChildren[i], currentIndex);
     }
+
+    // Root call: skeleton complete, reserve evaluation scratch once
+    if (parentIndex < 0)
+    {
+        m_->scratch.Reserve(sizeof(XMMATRIX) * (m_->skeleton.size() + 1));
+    }
 }
 
 // Helper: Collect bones from meshes
@@ -692,6 +1139,7 @@ void FbxManager::CollectBones(const aiScene* scene)
                 offsetMat._31 = offset.c1; offsetMat._32 = offset.c2; offsetMat._33 = offset.c3; offsetMat._34 = offset.c4;
                 offsetMat._41 = offset.d1; offsetMat._42 = offset.d2; offsetMat._43 = offset.d3; offsetMat._44 = offset.d4;
                 m_->boneOffsets.push_back(offsetMat);
+                m_->nodeOfBone.push_back(it != m_->nodeIndexOfName.end() ? it->second : -1);
             }
         }
     }
@@ -712,6 +1160,8 @@ void FbxManager::InitAnimationMetadata(const aiScene* scene)
     m_->animationNames.reserve(scene->mNumAnimations);
     m_->clipDurationSec.reserve(scene->mNumAnimations);
     m_->clipTicksPerSec.reserve(scene->mNumAnimations);
+    m_->clips.reserve(scene->mNumAnimations);
+    const std::vector<std::string> skeletonNodeNames = GetSkeletonNodeNames();
 
     for (unsigned int i = 0; i < scene->mNumAnimations; ++i)
     {
@@ -726,6 +1176,10 @@ void FbxManager::InitAnimationMetadata(const aiScene* scene)
         m_->clipDurationSec.push_back(durationSec);
 
         std::cout << "    " << name << " (duration: " << durationSec << "s, tps: " << tps << ")" << std::endl;
+
+        // Compile keyframes into fixed-rate tracks (UpdateAnimation samples these)
+        m_->clips.push_back(FbxClipLibrary::Get().AcquireEmbedded(m_->sourcePath, i, anim, scene->mRootNode, skeletonNodeNames));
+        BuildClipBinding(static_cast<int>(m_->clips.size()) - 1);
     }
 
     std::cout << "Animations: " << m_->animationNames.size() << std::endl;
@@ -735,1135 +1189,511 @@ void FbxManager::InitAnimationMetadata(const aiScene* scene)
     std::cout << "[FbxManager] Base animation count set to: " << m_->baseAnimationCount << std::endl;
 }
 
-// Helper: Load materials and textures
-bool FbxManager::LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::string& defaultTexturePath)
+// Helper: Load materials and textures (diffuse / normal map / specular map slots of the descriptor)
+// 1) 슬롯마다 실제로 열 파일을 정한다 (파일의 참조 → 재질별 경로 → 공통 경로, 처음 존재하는 것)
+// 2) 디코드는 스레드 풀에서 병렬로, 3) 업로드만 이 스레드에서 (없거나 실패한 슬롯은 1x1 기본 텍스처)
+bool FbxManager::LoadMaterials(ZGraphics& gfx, const std::vector<FbxMaterialInfo>& materials, const std::string& baseDir, const FbxImportDescriptor& descriptor)
 {
-    auto startTime = std::chrono::high_resolution_clock::now();
     std::cout << "=== LoadMaterials ===" << std::endl;
-    std::cout << "Loading " << scene->mNumMaterials << " materials..." << std::endl;
-    if (!defaultTexturePath.empty())
-    {
-        std::cout << "Default texture path: " << defaultTexturePath << std::endl;
-    }
+    std::cout << "Loading " << materials.size() << " materials..." << std::endl;
 
-    // Create white fallback texture
-    if (!m_->fallbackBaseTexture)
-    {
-        UINT white = 0xFFFFFFFF;
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = 1;
-        td.Height = 1;
-        td.MipLevels = 1;
-        td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        td.SampleDesc.Count = 1;
-        td.Usage = D3D11_USAGE_IMMUTABLE;
-        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    // 탄젠트 스페이스 노멀 (B8G8R8A8: B=255 → N=1, G/R=128 → 0) = 평평한 표면
+    const TextureSlotRequest slots[kTextureSlotCount] = {
+        { "diffuse", &descriptor.diffuse, &m_->materialSRVs, DXGI_FORMAT_R8G8B8A8_UNORM, 0xFFFFFFFF },
+        { "normal map", &descriptor.normalMap, &m_->normalMapSRVs, DXGI_FORMAT_B8G8R8A8_UNORM, 0xFF8080FF },
+        { "specular map", &descriptor.specularMap, &m_->specularMapSRVs, DXGI_FORMAT_R8G8B8A8_UNORM, 0xFFFFFFFF },
+    };
 
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = &white;
-        sd.SysMemPitch = sizeof(UINT);
+    // Resolve: the file each (material, slot) opens
+    std::vector<std::string> files(materials.size() * kTextureSlotCount);
+    std::vector<std::wstring> prefetchFiles;
+    for (size_t m = 0; m < materials.size(); ++m)
+    {
+        const FbxMaterialInfo& material = materials[m];
+        const std::string embedded[kTextureSlotCount] = {
+            material.hasDiffuse ? material.diffusePath : std::string(),
+            material.hasNormalMap ? material.normalMapPath : std::string(),
+            std::string() };
 
-        ComPtr<ID3D11Texture2D> tex;
-        HRESULT hr = gfx.GetDeviceCOM()->CreateTexture2D(&td, &sd, &tex);
-        if (SUCCEEDED(hr))
+        for (size_t s = 0; s < kTextureSlotCount; ++s)
         {
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
-            srvd.Format = td.Format;
-            srvd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-            srvd.Texture2D.MipLevels = 1;
-            srvd.Texture2D.MostDetailedMip = 0;
-
-            gfx.GetDeviceCOM()->CreateShaderResourceView(tex.Get(), &srvd, &m_->fallbackBaseTexture);
+            std::string& file = files[m * kTextureSlotCount + s];
+            file = FirstExistingTexture(*slots[s].slot, embedded[s], m, baseDir);
+            if (!file.empty() && m_->textureCache.find(file) == m_->textureCache.end())
+            {
+                prefetchFiles.emplace_back(file.begin(), file.end());
+            }
         }
     }
 
-    // Resize material SRVs
-    m_->materialSRVs.resize(scene->mNumMaterials);
+    // Decode phase (references keep the decoded images alive until the upload below)
+    const std::vector<ZAssetCooker::DecodedTextureRef> prefetched = ZAssetCooker::PrefetchTextures(prefetchFiles);
 
-    // Load textures for each material
-    for (unsigned int m = 0; m < scene->mNumMaterials; ++m)
+    // Upload phase
+    for (const TextureSlotRequest& request : slots)
     {
-        aiMaterial* mat = scene->mMaterials[m];
-        aiString texPath;
-
-        std::cout << "Material [" << m << "]: ";
-
-        if (mat->GetTexture(aiTextureType_DIFFUSE, 0, &texPath) == AI_SUCCESS)
+        request.srvs->assign(materials.size(), nullptr);
+    }
+    for (size_t s = 0; s < kTextureSlotCount; ++s)
+    {
+        const TextureSlotRequest& request = slots[s];
+        ComPtr<ID3D11ShaderResourceView> fallback;
+        for (size_t m = 0; m < materials.size(); ++m)
         {
-            std::string texPathStr = texPath.C_Str();
-            std::cout << "Original texture path: " << texPathStr << std::endl;
-
-            if (!texPathStr.empty())
+            const std::string& file = files[m * kTextureSlotCount + s];
+            ComPtr<ID3D11ShaderResourceView>& srv = (*request.srvs)[m];
+            if (!file.empty())
             {
-                // Extract filename only
-                std::string filename = texPathStr;
-                size_t lastSlash = filename.find_last_of("/\\");
-                if (lastSlash != std::string::npos)
-                {
-                    filename = filename.substr(lastSlash + 1);
-                }
-                
-                std::cout << "Extracted filename: " << filename << std::endl;
-                
-                // Check cache first (use original path as key)
-                auto cacheIt = m_->textureCache.find(texPathStr);
+                auto cacheIt = m_->textureCache.find(file);
                 if (cacheIt != m_->textureCache.end())
                 {
-                    m_->materialSRVs[m] = cacheIt->second;
-                    std::cout << "  -> From cache" << std::endl;
-                    continue;
+                    srv = cacheIt->second;
+                    std::cout << "Material [" << m << "] " << request.name << ": " << file << " (cache)" << std::endl;
                 }
-
-                // Try multiple possible paths
-                std::vector<std::string> possiblePaths = {
-                    baseDir + texPathStr,           // Original path
-                    baseDir + filename,             // Direct in baseDir
-                    baseDir + "../" + filename      // Parent directory
-                };
-                
-                #ifdef USE_DIRECTXTK
-                ComPtr<ID3D11Resource> res;
-                ID3D11ShaderResourceView* srv = nullptr;
-                HRESULT hr = E_FAIL;
-                std::string successPath;
-                
-                // Try each possible path
-                for (const auto& tryPath : possiblePaths)
+                else
                 {
-                    std::wstring wPath(tryPath.begin(), tryPath.end());
-                    std::cout << "  -> Trying: " << tryPath << std::flush;
-                    
-                    hr = DirectX::CreateWICTextureFromFile(
-                        gfx.GetDeviceCOM(),
-                        wPath.c_str(),
-                        res.GetAddressOf(),
-                        &srv);
-                    
+                    std::wstring widePath(file.begin(), file.end());
+                    const HRESULT hr = ZAssetCooker::CreateTextureFromFile(gfx.GetDeviceCOM(), nullptr, widePath.c_str(), nullptr, &srv);
                     if (SUCCEEDED(hr))
                     {
-                        successPath = tryPath;
-                        std::cout << " SUCCESS" << std::endl;
-                        break;
+                        m_->textureCache[file] = srv;
+                        std::cout << "Material [" << m << "] " << request.name << ": " << file << std::endl;
                     }
                     else
                     {
-                        std::cout << " FAILED (0x" << std::hex << hr << std::dec << ")" << std::endl;
+                        std::cout << "Material [" << m << "] " << request.name << ": " << file << " FAILED (0x" << std::hex << hr
+                                  << std::dec << ")" << std::endl;
                     }
                 }
-                
-                if (SUCCEEDED(hr))
-                {
-                    m_->materialSRVs[m].Attach(srv);
-                    m_->textureCache[texPathStr] = m_->materialSRVs[m];
-                    std::cout << "  -> Loaded from: " << successPath << std::endl;
-                }
-                else
+            }
+
+            if (!srv)
+            {
+                if (!fallback)
                 {
-                    std::cout << "  -> All paths failed" << std::endl;
-                    
-                    // Try default texture path if provided
-                    if (!defaultTexturePath.empty())
-                    {
-                        std::wstring wDefaultPath(defaultTexturePath.begin(), defaultTexturePath.end());
-                        std::cout << "  -> Trying default texture: " << defaultTexturePath << std::flush;
-                        
-                        hr = DirectX::CreateWICTextureFromFile(
-                            gfx.GetDeviceCOM(),
-                            wDefaultPath.c_str(),
-                            res.GetAddressOf(),
-                            &srv);
-                        
-                        if (SUCCEEDED(hr))
-                        {
-                            m_->materialSRVs[m].Attach(srv);
-                            m_->textureCache[texPathStr] = m_->materialSRVs[m];
-                            std::cout << " SUCCESS" << std::endl;
-                        }
-                        else
-                        {
-                            std::cout << " FAILED (0x" << std::hex << hr << std::dec << ")" << std::endl;
-                        }
-                    }
+                    fallback = CreateSolidTexture(gfx, request.fallbackFormat, request.fallbackTexel);
                 }
-                #else
-                std::cout << "  -> USE_DIRECTXTK not defined, using white texture" << std::endl;
-                #endif
+                srv = fallback;
             }
         }
-        else
-        {
-            std::cout << "No texture" << std::endl;
-        }
-
-        // Fallback to white
-        if (!m_->materialSRVs[m])
-        {
-            m_->materialSRVs[m] = m_->fallbackBaseTexture;
-            std::cout << "  -> Using fallback base texture" << std::endl;
-        }
     }
-
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    std::cout << "=== LoadMaterials Complete (took " << duration.count() << "ms) ===" << std::endl;
     return true;
 }
 
-// Helper: Load materials with multiple default textures (one per material)
-bool FbxManager::LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::vector<std::string>& defaultTexturePaths)
+// Top-4 bone influences of one vertex, weight-descending
+// 같은 가중치는 먼저 들어온 뼈가 앞에 남는다 (이전 구현: 정점당 vector + std::sort, 4개 이하에서는 삽입 정렬이라 안정적)
+struct VertexInfluences
 {
-    auto startTime = std::chrono::high_resolution_clock::now();
-    std::cout << "=== LoadMaterials (Multiple Defaults) ===" << std::endl;
-    std::cout << "Loading " << scene->mNumMaterials << " materials..." << std::endl;
-    std::cout << "Default textures provided: " << defaultTexturePaths.size() << std::endl;
-    
-    // DEBUG: Print detailed texture mapping info
-    for (size_t i = 0; i < defaultTexturePaths.size(); ++i)
-    {
-        std::cout << "  Texture[" << i << "]: " << defaultTexturePaths[i] << std::endl;
-    }
+    UINT bone[4];
+    float weight[4];
+    uint32_t count;
 
-    // Create white fallback texture
-    if (!m_->fallbackBaseTexture)
+    void Add(UINT boneIndex, float w)
     {
-        UINT white = 0xFFFFFFFF;
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = 1;
-        td.Height = 1;
-        td.MipLevels = 1;
-        td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        td.SampleDesc.Count = 1;
-        td.Usage = D3D11_USAGE_IMMUTABLE;
-        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = &white;
-        sd.SysMemPitch = sizeof(UINT);
-
-        ComPtr<ID3D11Texture2D> tex;
-        HRESULT hr = gfx.GetDeviceCOM()->CreateTexture2D(&td, &sd, &tex);
-        if (SUCCEEDED(hr))
+        uint32_t slot = count;
+        while (slot > 0 && weight[slot - 1] < w)
         {
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
-            srvd.Format = td.Format;
-            srvd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-            srvd.Texture2D.MipLevels = 1;
-            srvd.Texture2D.MostDetailedMip = 0;
+            --slot;
+        }
+        if (slot >= 4)
+            return;
 
-            gfx.GetDeviceCOM()->CreateShaderResourceView(tex.Get(), &srvd, &m_->fallbackBaseTexture);
+        const uint32_t last = (count < 4) ? count : 3;
+        for (uint32_t i = last; i > slot; --i)
+        {
+            bone[i] = bone[i - 1];
+            weight[i] = weight[i - 1];
         }
+        bone[slot] = boneIndex;
+        weight[slot] = w;
+        if (count < 4)
+            ++count;
     }
+};
 
-    // Resize material SRVs
-    m_->materialSRVs.resize(scene->mNumMaterials);
-
-    // Load textures for each material
-    for (unsigned int m = 0; m < scene->mNumMaterials; ++m)
-    {
-        aiMaterial* mat = scene->mMaterials[m];
-        aiString texPath;
+// Post-transform cache statistics of one subset, before/after the import-time reordering
+struct SubsetCacheReport
+{
+    bool optimized = false;
+    ZMeshOptimizer::CacheStats before;
+    ZMeshOptimizer::CacheStats after;
+};
 
-        std::cout << "Material [" << m << "]: ";
+// Helper: One aiMesh into its slice of the shared vertex/index arrays (runs on the pool, one mesh per task)
+// 삼각형 메시는 슬라이스 안에서 삼각형 순서(캐시 → 오버드로)와 정점 순서(첫 사용 순)를 다시 정한다
+// 인덱스는 메시 로컬로 남는다 (FbxSubset::baseVertex로 그린다)
+static void ConvertSkinnedMesh(const aiMesh* mesh, const std::unordered_map<std::string, int>& boneIndexOfName,
+                               VertexSkinned* outVertices, uint32_t* outIndices, SubsetCacheReport& outReport)
+{
+    // Bone weights of this mesh (one flat allocation)
+    std::vector<VertexInfluences> influences(mesh->mNumVertices, VertexInfluences{});
 
-        // Get default texture for this material index
-        std::string defaultTexForMaterial;
-        if (m < defaultTexturePaths.size() && !defaultTexturePaths[m].empty())
-        {
-            defaultTexForMaterial = defaultTexturePaths[m];
-            std::cout << "(Default: " << defaultTexForMaterial << ") ";
-        }
+    for (unsigned int bi = 0; bi < mesh->mNumBones; ++bi)
+    {
+        const aiBone* bone = mesh->mBones[bi];
 
-        if (mat->GetTexture(aiTextureType_DIFFUSE, 0, &texPath) == AI_SUCCESS)
-        {
-            std::string texPathStr = texPath.C_Str();
-            std::cout << "Original texture path: " << texPathStr << std::endl;
+        auto it = boneIndexOfName.find(bone->mName.C_Str());
+        if (it == boneIndexOfName.end()) continue;
 
-            if (!texPathStr.empty())
-            {
-                // Extract filename only
-                std::string filename = texPathStr;
-                size_t lastSlash = filename.find_last_of("/\\");
-                if (lastSlash != std::string::npos)
-                {
-                    filename = filename.substr(lastSlash + 1);
-                }
-                
-                std::cout << "Extracted filename: " << filename << std::endl;
-                
-                // Check cache first
-                auto cacheIt = m_->textureCache.find(texPathStr);
-                if (cacheIt != m_->textureCache.end())
-                {
-                    m_->materialSRVs[m] = cacheIt->second;
-                    std::cout << "  -> From cache" << std::endl;
-                    continue;
-                }
+        const UINT boneIdx = static_cast<UINT>(it->second);
 
-                // Try multiple possible paths
-                std::vector<std::string> possiblePaths = {
-                    baseDir + texPathStr,
-                    baseDir + filename,
-                    baseDir + "../" + filename
-                };
-                
-                #ifdef USE_DIRECTXTK
-                ComPtr<ID3D11Resource> res;
-                ID3D11ShaderResourceView* srv = nullptr;
-                HRESULT hr = E_FAIL;
-                std::string successPath;
-                
-                // Try each possible path
-                for (const auto& tryPath : possiblePaths)
-                {
-                    std::wstring wPath(tryPath.begin(), tryPath.end());
-                    std::cout << "  -> Trying: " << tryPath << std::flush;
-                    
-                    hr = DirectX::CreateWICTextureFromFile(
-                        gfx.GetDeviceCOM(),
-                        wPath.c_str(),
-                        res.GetAddressOf(),
-                        &srv);
-                    
-                    if (SUCCEEDED(hr))
-                    {
-                        successPath = tryPath;
-                        std::cout << " SUCCESS" << std::endl;
-                        break;
-                    }
-                    else
-                    {
-                        std::cout << " FAILED" << std::endl;
-                    }
-                }
-                
-                if (SUCCEEDED(hr))
-                {
-                    m_->materialSRVs[m].Attach(srv);
-                    m_->textureCache[texPathStr] = m_->materialSRVs[m];
-                }
-                else if (!defaultTexForMaterial.empty())
-                {
-                    // Try material-specific default texture
-                    std::cout << "  -> Trying material default: " << defaultTexForMaterial << std::flush;
-                    std::wstring wDefaultPath(defaultTexForMaterial.begin(), defaultTexForMaterial.end());
-                    
-                    hr = DirectX::CreateWICTextureFromFile(
-                        gfx.GetDeviceCOM(),
-                        wDefaultPath.c_str(),
-                        res.GetAddressOf(),
-                        &srv);
-                    
-                    if (SUCCEEDED(hr))
-                    {
-                        m_->materialSRVs[m].Attach(srv);
-                        std::cout << " SUCCESS" << std::endl;
-                    }
-                    else
-                    {
-                        std::cout << " FAILED" << std::endl;
-                    }
-                }
-                #endif
-            }
-        }
-        else if (!defaultTexForMaterial.empty())
+        for (unsigned int wi = 0; wi < bone->mNumWeights; ++wi)
         {
-            // No embedded texture, use default for this material
-            std::cout << "No embedded texture, using default: " << defaultTexForMaterial << std::flush;
-            
-            #ifdef USE_DIRECTXTK
-            ComPtr<ID3D11Resource> res;
-            ID3D11ShaderResourceView* srv = nullptr;
-            std::wstring wDefaultPath(defaultTexForMaterial.begin(), defaultTexForMaterial.end());
-            
-            HRESULT hr = DirectX::CreateWICTextureFromFile(
-                gfx.GetDeviceCOM(),
-                wDefaultPath.c_str(),
-                res.GetAddressOf(),
-                &srv);
-            
-            if (SUCCEEDED(hr))
+            const unsigned int vertexId = bone->mWeights[wi].mVertexId;
+            if (vertexId < mesh->mNumVertices)
             {
-                m_->materialSRVs[m].Attach(srv);
-                std::cout << " SUCCESS" << std::endl;
+                influences[vertexId].Add(boneIdx, bone->mWeights[wi].mWeight);
             }
-            else
-            {
-                std::cout << " FAILED" << std::endl;
-            }
-            #endif
-        }
-        else
-        {
-            std::cout << "No texture" << std::endl;
-        }
-
-        // Fallback to white
-        if (!m_->materialSRVs[m])
-        {
-            m_->materialSRVs[m] = m_->fallbackBaseTexture;
-            std::cout << "  -> Using fallback base texture" << std::endl;
         }
     }
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    std::cout << "=== LoadMaterials Complete (took " << duration.count() << "ms) ===" << std::endl;
-    return true;
-}
-
-// Helper: Load materials with multiple default textures and normal maps (one per material)
-bool FbxManager::LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths)
-{
-    auto startTime = std::chrono::high_resolution_clock::now();
-    std::cout << "=== LoadMaterials (Multiple Defaults with Normal Maps) ===" << std::endl;
-    std::cout << "Loading " << scene->mNumMaterials << " materials..." << std::endl;
-    std::cout << "Default textures provided: " << defaultTexturePaths.size() << std::endl;
-    std::cout << "Default normal maps provided: " << defaultNormalMapPaths.size() << std::endl;
-    
-    // DEBUG: Print detailed texture mapping info
-    for (size_t i = 0; i < defaultTexturePaths.size(); ++i)
-    {
-        std::cout << "  Texture[" << i << "]: " << defaultTexturePaths[i] << std::endl;
-    }
-    for (size_t i = 0; i < defaultNormalMapPaths.size(); ++i)
-    {
-        std::cout << "  NormalMap[" << i << "]: " << defaultNormalMapPaths[i] << std::endl;
-    }
+    const bool hasNormals = mesh->HasNormals();
+    const bool hasTangents = mesh->HasTangentsAndBitangents();
+    const bool hasTexCoords = mesh->HasTextureCoords(0);
 
-    if (!scene || !scene->mNumMaterials)
+    for (unsigned int vi = 0; vi < mesh->mNumVertices; ++vi)
     {
-        std::cout << "No materials to load" << std::endl;
-        return true;
-    }
-
-    // Clear existing materials
-    m_->materialSRVs.clear();
-    m_->normalMapSRVs.clear();
-
-    m_->materialSRVs.reserve(scene->mNumMaterials);
-    m_->normalMapSRVs.reserve(scene->mNumMaterials);
+        VertexSkinned& v = outVertices[vi];
+        v = VertexSkinned{};
 
-    for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
-    {
-        aiMaterial* material = scene->mMaterials[i];
-        std::cout << "Processing material " << i << "..." << std::endl;
+        v.position = XMFLOAT3{ mesh->mVertices[vi].x, mesh->mVertices[vi].y, mesh->mVertices[vi].z };
 
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> textureSRV = nullptr;
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> normalMapSRV = nullptr;
+        v.normal = hasNormals
+            ? XMFLOAT3{ mesh->mNormals[vi].x, mesh->mNormals[vi].y, mesh->mNormals[vi].z }
+            : XMFLOAT3{ 0.0f, 1.0f, 0.0f };
 
-        // Try to load diffuse texture from the material
-        aiString texturePath;
-        if (material->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == AI_SUCCESS)
+        if (hasTangents)
         {
-            std::string fullPath = baseDir + texturePath.C_Str();
-            std::cout << "  Found material diffuse texture: " << fullPath << std::endl;
-            
-            try
-            {
-                std::wstring wFullPath(fullPath.begin(), fullPath.end());
-                Microsoft::WRL::ComPtr<ID3D11Resource> res;
-                ID3D11ShaderResourceView* srv = nullptr;
-                
-                HRESULT hr = DirectX::CreateWICTextureFromFile(
-                    gfx.GetDeviceCOM(),
-                    wFullPath.c_str(),
-                    res.GetAddressOf(),
-                    &srv);
-                    
-                if (SUCCEEDED(hr))
-                {
-                    textureSRV.Attach(srv);
-                    std::cout << "  Loaded material diffuse texture successfully" << std::endl;
-                }
-                else
-                {
-                    std::cout << "  Failed to load material diffuse texture (0x" << std::hex << hr << std::dec << ")" << std::endl;
-                }
-            }
-            catch (const std::exception& e)
-            {
-                std::cout << "  Failed to load material diffuse texture: " << e.what() << std::endl;
-            }
+            v.tangent = XMFLOAT3{ mesh->mTangents[vi].x, mesh->mTangents[vi].y, mesh->mTangents[vi].z };
+            v.bitangent = XMFLOAT3{ mesh->mBitangents[vi].x, mesh->mBitangents[vi].y, mesh->mBitangents[vi].z };
         }
-
-        // Try to load normal map from the material
-        aiString normalPath;
-        if (material->GetTexture(aiTextureType_NORMALS, 0, &normalPath) == AI_SUCCESS)
+        else
         {
-            std::string fullNormalPath = baseDir + normalPath.C_Str();
-            std::cout << "  Found material normal map: " << fullNormalPath << std::endl;
-            
-            try
-            {
-                std::wstring wFullNormalPath(fullNormalPath.begin(), fullNormalPath.end());
-                Microsoft::WRL::ComPtr<ID3D11Resource> res;
-                ID3D11ShaderResourceView* srv = nullptr;
-                
-                HRESULT hr = DirectX::CreateWICTextureFromFile(
-                    gfx.GetDeviceCOM(),
-                    wFullNormalPath.c_str(),
-                    res.GetAddressOf(),
-                    &srv);
-                    
-                if (SUCCEEDED(hr))
-                {
-                    normalMapSRV.Attach(srv);
-                    std::cout << "  Loaded material normal map successfully" << std::endl;
-                }
-                else
-                {
-                    std::cout << "  Failed to load material normal map (0x" << std::hex << hr << std::dec << ")" << std::endl;
-                }
-            }
-            catch (const std::exception& e)
-            {
-                std::cout << "  Failed to load material normal map: " << e.what() << std::endl;
-            }
+            v.tangent = XMFLOAT3{ 1.0f, 0.0f, 0.0f };
+            v.bitangent = XMFLOAT3{ 0.0f, 0.0f, 1.0f };
         }
 
-        // If no material texture found, use default texture if available
-        if (!textureSRV && i < defaultTexturePaths.size() && !defaultTexturePaths[i].empty())
-        {
-            std::cout << "  Using default texture: " << defaultTexturePaths[i] << std::endl;
-            try
-            {
-                std::wstring wDefaultTexturePath(defaultTexturePaths[i].begin(), defaultTexturePaths[i].end());
-                Microsoft::WRL::ComPtr<ID3D11Resource> res;
-                ID3D11ShaderResourceView* srv = nullptr;
-                
-                HRESULT hr = DirectX::CreateWICTextureFromFile(
-                    gfx.GetDeviceCOM(),
-                    wDefaultTexturePath.c_str(),
-                    res.GetAddressOf(),
-                    &srv);
-                    
-                if (SUCCEEDED(hr))
-                {
-                    textureSRV.Attach(srv);
-                    std::cout << "  Loaded default texture successfully" << std::endl;
-                }
-                else
-                {
-                    std::cout << "  Failed to load default texture (0x" << std::hex << hr << std::dec << ")" << std::endl;
-                }
-            }
-            catch (const std::exception& e)
-            {
-                std::cout << "  Failed to load default texture: " << e.what() << std::endl;
-            }
-        }
+        v.texCoord = hasTexCoords
+            ? XMFLOAT2{ mesh->mTextureCoords[0][vi].x, mesh->mTextureCoords[0][vi].y }
+            : XMFLOAT2{ 0.0f, 0.0f };
 
-        // If no material normal map found, use default normal map if available
-        if (!normalMapSRV && i < defaultNormalMapPaths.size() && !defaultNormalMapPaths[i].empty())
-        {
-            std::cout << "  Using default normal map: " << defaultNormalMapPaths[i] << std::endl;
-            try
-            {
-                std::wstring wDefaultNormalPath(defaultNormalMapPaths[i].begin(), defaultNormalMapPaths[i].end());
-                Microsoft::WRL::ComPtr<ID3D11Resource> res;
-                ID3D11ShaderResourceView* srv = nullptr;
-                
-                HRESULT hr = DirectX::CreateWICTextureFromFile(
-                    gfx.GetDeviceCOM(),
-                    wDefaultNormalPath.c_str(),
-                    res.GetAddressOf(),
-                    &srv);
-                    
-                if (SUCCEEDED(hr))
-                {
-                    normalMapSRV.Attach(srv);
-                    std::cout << "  Loaded default normal map successfully" << std::endl;
-                }
-                else
-                {
-                    std::cout << "  Failed to load default normal map (0x" << std::hex << hr << std::dec << ")" << std::endl;
-                }
-            }
-            catch (const std::exception& e)
-            {
-                std::cout << "  Failed to load default normal map: " << e.what() << std::endl;
-            }
-        }
+        // Color (default white)
+        v.color = XMFLOAT4{ 1.0f, 1.0f, 1.0f, 1.0f };
 
-        // If still no texture, try to load a default white texture
-        if (!textureSRV)
+        // Bone indices and weights (unused slots: bone 0, weight 0)
+        const VertexInfluences& inf = influences[vi];
+        if (inf.count > 0)
         {
-            std::cout << "  Using fallback white texture" << std::endl;
-            try
+            float totalWeight = 0.0f;
+            for (uint32_t i = 0; i < inf.count; ++i)
             {
-                std::wstring wWhitePath(L"Data/Images/white.png");
-                Microsoft::WRL::ComPtr<ID3D11Resource> res;
-                ID3D11ShaderResourceView* srv = nullptr;
-                
-                HRESULT hr = DirectX::CreateWICTextureFromFile(
-                    gfx.GetDeviceCOM(),
-                    wWhitePath.c_str(),
-                    res.GetAddressOf(),
-                    &srv);
-                    
-                if (SUCCEEDED(hr))
-                {
-                    textureSRV.Attach(srv);
-                }
-                else
-                {
-                    std::cout << "  Failed to load fallback white texture (0x" << std::hex << hr << std::dec << ")" << std::endl;
-                }
+                v.boneIndices[i] = inf.bone[i];
+                reinterpret_cast<float*>(&v.boneWeights)[i] = inf.weight[i];
+                totalWeight += inf.weight[i];
             }
-            catch (...)
+
+            // Normalize weights
+            if (totalWeight > 0.0f)
             {
-                std::cout << "  Failed to load fallback white texture" << std::endl;
+                v.boneWeights.x /= totalWeight;
+                v.boneWeights.y /= totalWeight;
+                v.boneWeights.z /= totalWeight;
+                v.boneWeights.w /= totalWeight;
             }
         }
-
-        m_->materialSRVs.push_back(textureSRV);
-        m_->normalMapSRVs.push_back(normalMapSRV);
-    }
-
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    std::cout << "=== LoadMaterials Complete (took " << duration.count() << "ms) ===" << std::endl;
-    return true;
-}
-
-// Helper: Load materials with multiple default textures and normal maps (one per material)
-bool FbxManager::LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths, const std::vector<std::string>& defaultSpecularMapPaths)
-{
-    auto startTime = std::chrono::high_resolution_clock::now();
-    std::cout << "=== LoadMaterials (Multiple Defaults with Normal Maps) ===" << std::endl;
-    std::cout << "Loading " << scene->mNumMaterials << " materials..." << std::endl;
-    std::cout << "Default textures provided: " << defaultTexturePaths.size() << std::endl;
-    std::cout << "Default normal maps provided: " << defaultNormalMapPaths.size() << std::endl;
-    std::cout << "Default specular maps provided: " << defaultSpecularMapPaths.size() << std::endl;
-    
-    // DEBUG: Print detailed texture mapping info
-    for (size_t i = 0; i < defaultTexturePaths.size(); ++i)
-    {
-        std::cout << "  Texture[" << i << "]: " << defaultTexturePaths[i] << std::endl;
-    }
-    for (size_t i = 0; i < defaultNormalMapPaths.size(); ++i)
-    {
-        std::cout << "  NormalMap[" << i << "]: " << defaultNormalMapPaths[i] << std::endl;
-    }
-    for (size_t i = 0; i < defaultSpecularMapPaths.size(); ++i)
-    {
-        std::cout << "  SpecularMap[" << i << "]: " << defaultSpecularMapPaths[i] << std::endl;
-    }
-
-    // Create white fallback texture (general purpose for any missing texture)
-    ComPtr<ID3D11ShaderResourceView> fallbackBaseTexture;
-    {
-        UINT white = 0xFFFFFFFF;
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = 1;
-        td.Height = 1;
-        td.MipLevels = 1;
-        td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        td.SampleDesc.Count = 1;
-        td.Usage = D3D11_USAGE_IMMUTABLE;
-        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = &white;
-        sd.SysMemPitch = sizeof(UINT);
-
-        ComPtr<ID3D11Texture2D> tex;
-        HRESULT hr = gfx.GetDeviceCOM()->CreateTexture2D(&td, &sd, &tex);
-        if (SUCCEEDED(hr))
+        else
         {
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
-            srvd.Format = td.Format;
-            srvd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-            srvd.Texture2D.MipLevels = 1;
-            srvd.Texture2D.MostDetailedMip = 0;
-
-            gfx.GetDeviceCOM()->CreateShaderResourceView(tex.Get(), &srvd, &fallbackBaseTexture);
+            // No bone weights - use identity (bone 0, weight 1.0)
+            v.boneWeights.x = 1.0f;
         }
     }
 
-    // Create fallback base normal map (flat normal: RGB = 128, 128, 255)
-    ComPtr<ID3D11ShaderResourceView> fallbackBaseNormalMap;
-    {
-        UINT neutralNormal = 0xFF8080FF;  // B8G8R8A8 format: (255, 128, 128, 255) = normal pointing up
-        // 탄젠트 스페이스 노멀맵 설명 (B8G8R8A8 포맷 기준):
-        // - B(255) = 노멀(N) 성분: 255 → 1.0 (최대값, 위 방향을 가리킴)
-        // - G(128) = 바이탄젠트(V) 성분: 128 → 0.0 (중간값, 탄젠트 스페이스에서 0)
-        // - R(128) = 탄젠트(U) 성분: 128 → 0.0 (중간값, 탄젠트 스페이스에서 0)
-        // - A(255) = 알파: 1.0 (불투명)
-        // 
-        // 탄젠트 스페이스 좌표계: RGB [0,255] → XYZ [-1,1] 매핑
-        // - 0 → -1.0, 128 → 0.0, 255 → 1.0
-        // - 따라서 (128,128,255)는 (0,0,1) = 표면 법선 방향(위)을 의미
-        // - 이는 평평한 표면의 기본 노멀 벡터로, 노멀맵이 없을 때의 안전한 기본값
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = 1;
-        td.Height = 1;
-        td.MipLevels = 1;
-        td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
-        td.SampleDesc.Count = 1;
-        td.Usage = D3D11_USAGE_IMMUTABLE;
-        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = &neutralNormal;
-        sd.SysMemPitch = sizeof(UINT);
-
-        ComPtr<ID3D11Texture2D> tex;
-        HRESULT hr = gfx.GetDeviceCOM()->CreateTexture2D(&td, &sd, &tex);
-        if (SUCCEEDED(hr))
+    // Mesh-local indices (0 ~ mNumVertices-1)
+    uint32_t* const meshIndices = outIndices;
+    for (unsigned int fi = 0; fi < mesh->mNumFaces; ++fi)
+    {
+        const aiFace& face = mesh->mFaces[fi];
+        for (unsigned int ii = 0; ii < face.mNumIndices; ++ii)
         {
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
-            srvd.Format = td.Format;
-            srvd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-            srvd.Texture2D.MipLevels = 1;
-            srvd.Texture2D.MostDetailedMip = 0;
-
-            gfx.GetDeviceCOM()->CreateShaderResourceView(tex.Get(), &srvd, &fallbackBaseNormalMap);
+            *outIndices++ = face.mIndices[ii];
         }
     }
+    const size_t indexCount = static_cast<size_t>(outIndices - meshIndices);
 
-    // Create fallback base specular map (white for full specular response)
-    ComPtr<ID3D11ShaderResourceView> fallbackBaseSpecularMap;
+    // 점/선이 섞인 메시는 순서를 건드리지 않는다
+    if (mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE && indexCount > 0)
     {
-        UINT white = 0xFFFFFFFF;  // 완전한 반사광 응답
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = 1;
-        td.Height = 1;
-        td.MipLevels = 1;
-        td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        td.SampleDesc.Count = 1;
-        td.Usage = D3D11_USAGE_IMMUTABLE;
-        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        outReport.optimized = true;
+        outReport.before = ZMeshOptimizer::AnalyzeVertexCache(meshIndices, indexCount, mesh->mNumVertices);
 
-        D3D11_SUBRESOURCE_DATA sd{};
-        sd.pSysMem = &white;
-        sd.SysMemPitch = sizeof(UINT);
+        ZMeshOptimizer::OptimizeVertexCache(meshIndices, indexCount, mesh->mNumVertices);
+        ZMeshOptimizer::OptimizeOverdraw(meshIndices, indexCount, &outVertices[0].position, sizeof(VertexSkinned),
+                                         mesh->mNumVertices);
 
-        ComPtr<ID3D11Texture2D> tex;
-        HRESULT hr = gfx.GetDeviceCOM()->CreateTexture2D(&td, &sd, &tex);
-        if (SUCCEEDED(hr))
-        {
-            D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
-            srvd.Format = td.Format;
-            srvd.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-            srvd.Texture2D.MipLevels = 1;
-            srvd.Texture2D.MostDetailedMip = 0;
+        std::vector<uint32_t> remap;
+        ZMeshOptimizer::OptimizeVertexFetch(meshIndices, indexCount, mesh->mNumVertices, remap);
+        ZMeshOptimizer::ApplyVertexRemap(outVertices, mesh->mNumVertices, remap);
 
-            gfx.GetDeviceCOM()->CreateShaderResourceView(tex.Get(), &srvd, &fallbackBaseSpecularMap);
-        }
+        outReport.after = ZMeshOptimizer::AnalyzeVertexCache(meshIndices, indexCount, mesh->mNumVertices);
     }
+}
 
-    // Resize material SRVs and normal map SRVs
-    m_->materialSRVs.resize(scene->mNumMaterials);
-    m_->normalMapSRVs.resize(scene->mNumMaterials);
-    m_->specularMapSRVs.resize(scene->mNumMaterials);
-
-    // Load textures for each material
-    for (unsigned int m = 0; m < scene->mNumMaterials; ++m)
+// LOD chain targets: triangle ratio of LOD 0, error limit relative to the subset size
+struct SubsetLodLevel
+{
+    float triangleRatio;
+    float maxError;
+};
+static constexpr SubsetLodLevel kSubsetLodLevels[kFbxMaxSubsetLods] = { { 0.5f, 0.01f }, { 0.25f, 0.02f }, { 0.1f, 0.05f } };
+static constexpr uint32_t kMinLodTriangles = 64;       // 이보다 작은 서브셋은 LOD를 만들지 않는다
+static constexpr float kMinLodReduction = 0.8f;        // 이전 단계보다 20% 이상 줄지 않으면 버린다
+
+// Helper: Quadric simplification of every triangle subset (runs on the pool, one subset per task)
+// LOD 인덱스는 기본 인덱스 뒤에 붙고, 정점 버퍼와 baseVertex는 LOD 0과 공유한다
+static void BuildSubsetLods(const std::vector<VertexSkinned>& vertices, const std::vector<uint32_t>& vertexOffsets,
+                            const std::vector<SubsetCacheReport>& cacheReports, std::vector<uint32_t>& indices,
+                            std::vector<FbxSubset>& subsets)
+{
+    struct SubsetLods
     {
-        std::cout << "Material " << m << ":" << std::endl;
-
-        // Load diffuse texture
-        if (m < defaultTexturePaths.size() && !defaultTexturePaths[m].empty())
-        {
-            std::string texPath = defaultTexturePaths[m];
-            std::string fullTexPath;
-            
-            // Check if texPath is already a full path (starts with "./" or contains drive letter)
-            if (texPath.find("./") == 0 || texPath.find(":") != std::string::npos)
-            {
-                fullTexPath = texPath;  // Already a full path
-            }
-            else
-            {
-                fullTexPath = baseDir + texPath;  // Relative path, add baseDir
-            }
-
-            std::cout << "  Loading diffuse texture: " << fullTexPath << std::endl;
-
-            // Check cache first
-            auto cacheIt = m_->textureCache.find(fullTexPath);
-            if (cacheIt != m_->textureCache.end())
-            {
-                m_->materialSRVs[m] = cacheIt->second;
-                std::cout << "    -> Found in cache" << std::endl;
-            }
-            else
-            {
-                // Load texture
-                std::wstring widePath(fullTexPath.begin(), fullTexPath.end());
-                Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
-                HRESULT hr = DirectX::CreateWICTextureFromFile(gfx.GetDeviceCOM(), gfx.GetDeviceContext(), widePath.c_str(), nullptr, &srv);
-
-                if (SUCCEEDED(hr))
-                {
-                    m_->materialSRVs[m] = srv;
-                    m_->textureCache[fullTexPath] = m_->materialSRVs[m];
-                    std::cout << "    -> Loaded successfully" << std::endl;
-                }
-                else
-                {
-                    std::cout << "    -> Failed to load (HRESULT: 0x" << std::hex << hr << ")" << std::endl;
-                }
-            }
-        }
-        else
-        {
-            std::cout << "  No default diffuse texture provided" << std::endl;
-        }
-
-        // Load normal map
-        if (m < defaultNormalMapPaths.size() && !defaultNormalMapPaths[m].empty())
-        {
-            std::string normalPath = defaultNormalMapPaths[m];
-            std::string fullNormalPath;
-            
-            // Check if normalPath is already a full path (starts with "./" or contains drive letter)
-            if (normalPath.find("./") == 0 || normalPath.find(":") != std::string::npos)
-            {
-                fullNormalPath = normalPath;  // Already a full path
-            }
-            else
-            {
-                fullNormalPath = baseDir + normalPath;  // Relative path, add baseDir
-            }
-
-            std::cout << "  Loading normal map: " << fullNormalPath << std::endl;
-
-            // Check cache first
-            auto cacheIt = m_->textureCache.find(fullNormalPath);
-            if (cacheIt != m_->textureCache.end())
-            {
-                m_->normalMapSRVs[m] = cacheIt->second;
-                std::cout << "    -> Found in cache" << std::endl;
-            }
-            else
-            {
-                // Load normal map
-                std::wstring widePath(fullNormalPath.begin(), fullNormalPath.end());
-                Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
-                HRESULT hr = DirectX::CreateWICTextureFromFile(gfx.GetDeviceCOM(), gfx.GetDeviceContext(), widePath.c_str(), nullptr, &srv);
-
-                if (SUCCEEDED(hr))
-                {
-                    m_->normalMapSRVs[m] = srv;
-                    m_->textureCache[fullNormalPath] = m_->normalMapSRVs[m];
-                    std::cout << "    -> Loaded successfully" << std::endl;
-                }
-                else
-                {
-                    std::cout << "    -> Failed to load normal map (HRESULT: 0x" << std::hex << hr << ")" << std::endl;
-                }
-            }
-        }
-        else
-        {
-            std::cout << "  No default normal map provided" << std::endl;
-        }
+        uint32_t count = 0;
+        std::vector<uint32_t> indices[kFbxMaxSubsetLods];
+        float error[kFbxMaxSubsetLods] = {};
+    };
+    std::vector<SubsetLods> lods(subsets.size());
 
-        // Load specular map
-        if (m < defaultSpecularMapPaths.size() && !defaultSpecularMapPaths[m].empty())
+    ZThreadPool::Shared().ParallelFor(subsets.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t si = begin; si < end; ++si)
         {
-            std::string specularPath = defaultSpecularMapPaths[m];
-            std::string fullSpecularPath;
-            
-            // Check if specularPath is already a full path (starts with "./" or contains drive letter)
-            if (specularPath.find("./") == 0 || specularPath.find(":") != std::string::npos)
+            const FbxSubset& subset = subsets[si];
+            if (!cacheReports[si].optimized || subset.indexCount / 3 < kMinLodTriangles)
+                continue;
+
+            const VertexSkinned* subsetVertices = vertices.data() + subset.baseVertex;
+            const size_t vertexCount = vertexOffsets[si + 1] - vertexOffsets[si];
+            const uint32_t* subsetIndices = indices.data() + subset.startIndex;
+            const float scale = ZMeshOptimizer::ComputeMeshScale(&subsetVertices[0].position, sizeof(VertexSkinned), vertexCount);
+
+            ZMeshOptimizer::SkinInfluences skin;
+            skin.boneIndices = subsetVertices[0].boneIndices;
+            skin.boneWeights = &subsetVertices[0].boneWeights.x;
+            skin.stride = sizeof(VertexSkinned);
+
+            SubsetLods& out = lods[si];
+            size_t previousCount = subset.indexCount;
+            for (const SubsetLodLevel& level : kSubsetLodLevels)
             {
-                fullSpecularPath = specularPath;  // Already a full path
-            }
-            else
-            {
-                fullSpecularPath = baseDir + specularPath;  // Relative path, add baseDir
-            }
-
-            std::cout << "  Loading specular map: " << fullSpecularPath << std::endl;
-
-            // Check cache first
-            auto cacheIt = m_->textureCache.find(fullSpecularPath);
-            if (cacheIt != m_->textureCache.end())
-            {
-                m_->specularMapSRVs[m] = cacheIt->second;
-                std::cout << "    -> Loaded from cache" << std::endl;
-            }
-            else
-            {
-                // Load from file
-                std::wstring wideSpecularPath(fullSpecularPath.begin(), fullSpecularPath.end());
-                Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
-                HRESULT hr = DirectX::CreateWICTextureFromFile(gfx.GetDeviceCOM(), gfx.GetDeviceContext(), wideSpecularPath.c_str(), nullptr, &srv);
-
-                if (SUCCEEDED(hr))
-                {
-                    m_->specularMapSRVs[m] = srv;
-                    m_->textureCache[fullSpecularPath] = m_->specularMapSRVs[m];
-                    std::cout << "    -> Loaded successfully" << std::endl;
-                }
-                else
-                {
-                    std::cout << "    -> Failed to load (HRESULT: 0x" << std::hex << hr << ")" << std::endl;
-                }
+                const size_t target = static_cast<size_t>(subset.indexCount * level.triangleRatio) / 3 * 3;
+                std::vector<uint32_t> lodIndices(subset.indexCount);
+                float error = 0.0f;
+                const size_t lodCount = ZMeshOptimizer::Simplify(lodIndices.data(), subsetIndices, subset.indexCount,
+                                                                 &subsetVertices[0].position, sizeof(VertexSkinned), vertexCount,
+                                                                 target, level.maxError, &skin, &error);
+                if (lodCount == 0 || lodCount > previousCount * kMinLodReduction)
+                    break;
+
+                lodIndices.resize(lodCount);
+                ZMeshOptimizer::OptimizeVertexCache(lodIndices.data(), lodCount, vertexCount);
+                out.indices[out.count] = std::move(lodIndices);
+                out.error[out.count] = error * scale;
+                ++out.count;
+                previousCount = lodCount;
             }
         }
-        else
-        {
-            std::cout << "  No default specular map provided" << std::endl;
-        }
+    });
 
-        // Fallback to white texture for diffuse
-        if (!m_->materialSRVs[m])
+    // Append after the base indices (LOD 0 ranges stay where they are)
+    for (size_t si = 0; si < subsets.size(); ++si)
+    {
+        FbxSubset& subset = subsets[si];
+        subset.lodCount = lods[si].count;
+        for (uint32_t level = 0; level < lods[si].count; ++level)
         {
-            m_->materialSRVs[m] = fallbackBaseTexture;
-            std::cout << "  -> Using fallback base texture for diffuse" << std::endl;
+            subset.lods[level].startIndex = static_cast<uint32_t>(indices.size());
+            subset.lods[level].indexCount = static_cast<uint32_t>(lods[si].indices[level].size());
+            subset.lods[level].error = lods[si].error[level];
+            indices.insert(indices.end(), lods[si].indices[level].begin(), lods[si].indices[level].end());
         }
+    }
+}
 
-        // Fallback to base normal map
-        if (!m_->normalMapSRVs[m])
-        {
-            m_->normalMapSRVs[m] = fallbackBaseNormalMap;
-            std::cout << "  -> Using fallback base normal map" << std::endl;
-        }
+// Helper: Build vertex and index buffers from the mesh data
+bool FbxManager::BuildMeshBuffers(ZGraphics& gfx, const aiScene* scene)
+{
+    BuildMeshData(scene);
 
-        // Fallback to base specular map
-        if (!m_->specularMapSRVs[m])
-        {
-            m_->specularMapSRVs[m] = fallbackBaseSpecularMap;
-            std::cout << "  -> Using fallback base specular map" << std::endl;
-        }
-    }
+    const bool packed = (m_->vertexFormat == FbxVertexFormat::Packed);
+    const void* vertexData = packed ? static_cast<const void*>(m_->meshPackedVertices.data()) : m_->meshVertices.data();
+    const size_t vertexCount = packed ? m_->meshPackedVertices.size() : m_->meshVertices.size();
+    const bool shortIndices = (m_->indexFormat == DXGI_FORMAT_R16_UINT);
+    const void* indexData = shortIndices ? static_cast<const void*>(m_->meshIndices16.data()) : m_->meshIndices.data();
+    const UINT indexStride = shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    std::cout << "=== LoadMaterials Complete (took " << duration.count() << "ms) ===" << std::endl;
-    return true;
+    return CreateSkinnedMeshBuffers(gfx, vertexData, m_->vertexStride, vertexCount, indexData, indexStride,
+                                    static_cast<size_t>(m_->indexCount), &m_->pVertexBuffer, &m_->pIndexBuffer);
 }
 
-// Helper: Build vertex and index buffers
-bool FbxManager::BuildMeshBuffers(ZGraphics& gfx, const aiScene* scene)
+// Helper: Vertex/index data, subsets, LODs and bounds of every mesh (CPU only, kept in Impl for the GPU buffers and the .zmesh cache)
+// 1) 메시별 정점/인덱스 수 → 출력 오프셋 (정확한 크기로 한 번에 할당)
+// 2) 메시별 변환 + 인덱스/정점 재배치를 스레드 풀에서 병렬로, 각 메시는 자기 구간에만 쓴다 → 결과는 순차 변환과 바이트 단위로 같다
+void FbxManager::BuildMeshData(const aiScene* scene)
 {
     auto startTime = std::chrono::high_resolution_clock::now();
-    std::cout << "=== BuildMeshBuffers ===" << std::endl;
+    std::cout << "=== BuildMeshData ===" << std::endl;
     std::cout << "Processing " << scene->mNumMeshes << " meshes..." << std::endl;
-    std::vector<VertexSkinned> vertices;
-    std::vector<uint32_t> indices;
 
-    m_->subsets.clear();
-
-    // Process all meshes
-    for (unsigned int mi = 0; mi < scene->mNumMeshes; ++mi)
+    // Pass 1: counts and offsets
+    const unsigned int meshCount = scene->mNumMeshes;
+    std::vector<uint32_t> vertexOffsets(meshCount + 1, 0);
+    std::vector<uint32_t> indexOffsets(meshCount + 1, 0);
+    for (unsigned int mi = 0; mi < meshCount; ++mi)
     {
         const aiMesh* mesh = scene->mMeshes[mi];
-
-        FbxSubset subset;
-        subset.startIndex = static_cast<uint32_t>(indices.size());
-        subset.materialIndex = mesh->mMaterialIndex;
-
-        uint32_t baseVertex = static_cast<uint32_t>(vertices.size());
-
-        // Build bone weight map for this mesh
-        std::vector<std::vector<std::pair<int, float>>> vertexBoneWeights(mesh->mNumVertices);
-        
-        for (unsigned int bi = 0; bi < mesh->mNumBones; ++bi)
+        uint32_t meshIndexCount = 0;
+        for (unsigned int fi = 0; fi < mesh->mNumFaces; ++fi)
         {
-            const aiBone* bone = mesh->mBones[bi];
-            std::string boneName = bone->mName.C_Str();
-            
-            auto it = m_->boneIndexOfName.find(boneName);
-            if (it == m_->boneIndexOfName.end()) continue;
-            
-            int boneIdx = it->second;
-            
-            for (unsigned int wi = 0; wi < bone->mNumWeights; ++wi)
-            {
-                unsigned int vertexId = bone->mWeights[wi].mVertexId;
-                float weight = bone->mWeights[wi].mWeight;
-                
-                if (vertexId < mesh->mNumVertices)
-                {
-                    vertexBoneWeights[vertexId].push_back({boneIdx, weight});
-                }
-            }
+            meshIndexCount += mesh->mFaces[fi].mNumIndices;
         }
-        
-        // Load vertices
-        for (unsigned int vi = 0; vi < mesh->mNumVertices; ++vi)
-        {
-            VertexSkinned v{};
-
-            // Position
-            v.position = XMFLOAT3{
-                mesh->mVertices[vi].x,
-                mesh->mVertices[vi].y,
-                mesh->mVertices[vi].z
-            };
-
-            // Normal
-            if (mesh->HasNormals())
-            {
-                v.normal = XMFLOAT3{
-                    mesh->mNormals[vi].x,
-                    mesh->mNormals[vi].y,
-                    mesh->mNormals[vi].z
-                };
-            }
-            else
-            {
-                v.normal = XMFLOAT3{ 0.0f, 1.0f, 0.0f };
-            }
-
-            // Tangent and Bitangent
-            if (mesh->HasTangentsAndBitangents())
-            {
-                v.tangent = XMFLOAT3{
-                    mesh->mTangents[vi].x,
-                    mesh->mTangents[vi].y,
-                    mesh->mTangents[vi].z
-                };
-
-                v.bitangent = XMFLOAT3{
-                    mesh->mBitangents[vi].x,
-                    mesh->mBitangents[vi].y,
-                    mesh->mBitangents[vi].z
-                };
-            }
-            else
-            {
-                v.tangent = XMFLOAT3{ 1.0f, 0.0f, 0.0f };
-                v.bitangent = XMFLOAT3{ 0.0f, 0.0f, 1.0f };
-            }
-
-            // TexCoord
-            if (mesh->HasTextureCoords(0))
-            {
-                v.texCoord = XMFLOAT2{
-                    mesh->mTextureCoords[0][vi].x,
-                    mesh->mTextureCoords[0][vi].y
-                };
-            }
-            else
-            {
-                v.texCoord = XMFLOAT2{ 0.0f, 0.0f };
-            }
-
-            // Color (default white)
-            v.color = XMFLOAT4{ 1.0f, 1.0f, 1.0f, 1.0f };
-            
-            // Bone indices and weights
-            v.boneIndices[0] = v.boneIndices[1] = v.boneIndices[2] = v.boneIndices[3] = 0;
-            v.boneWeights = XMFLOAT4{ 0.0f, 0.0f, 0.0f, 0.0f };
-            
-            auto& boneWeights = vertexBoneWeights[vi];
-            if (!boneWeights.empty())
-            {
-                // Sort by weight descending
-                std::sort(boneWeights.begin(), boneWeights.end(),
-                    [](const auto& a, const auto& b) { return a.second > b.second; });
-                
-                // Take top 4 weights
-                float totalWeight = 0.0f;
-                for (size_t i = 0; i < (std::min)(boneWeights.size(), size_t(4)); ++i)
-                {
-                    v.boneIndices[i] = boneWeights[i].first;
-                    reinterpret_cast<float*>(&v.boneWeights)[i] = boneWeights[i].second;
-                    totalWeight += boneWeights[i].second;
-                }
-                
-                // Normalize weights
-                if (totalWeight > 0.0f)
-                {
-                    v.boneWeights.x /= totalWeight;
-                    v.boneWeights.y /= totalWeight;
-                    v.boneWeights.z /= totalWeight;
-                    v.boneWeights.w /= totalWeight;
-                }
-            }
-            else
-            {
-                // No bone weights - use identity (bone 0, weight 1.0)
-                v.boneIndices[0] = 0;
-                v.boneWeights.x = 1.0f;
-            }
+        vertexOffsets[mi + 1] = vertexOffsets[mi] + mesh->mNumVertices;
+        indexOffsets[mi + 1] = indexOffsets[mi] + meshIndexCount;
+    }
 
-            vertices.push_back(v);
-        }
+    std::vector<VertexSkinned> vertices(vertexOffsets[meshCount]);
+    std::vector<uint32_t> indices(indexOffsets[meshCount]);
+    std::vector<SubsetCacheReport> cacheReports(meshCount);
+    auto countEnd = std::chrono::high_resolution_clock::now();
 
-        // Load indices
-        for (unsigned int fi = 0; fi < mesh->mNumFaces; ++fi)
+    // Pass 2: per-mesh conversion (큰 메시와 작은 메시가 섞여 있으므로 메시 하나씩 스틸링)
+    ZThreadPool& pool = ZThreadPool::Shared();
+    pool.ParallelFor(meshCount, 1, [&](size_t begin, size_t end)
+    {
+        for (size_t mi = begin; mi < end; ++mi)
         {
-            const aiFace& face = mesh->mFaces[fi];
-            for (unsigned int ii = 0; ii < face.mNumIndices; ++ii)
-            {
-                indices.push_back(baseVertex + face.mIndices[ii]);
-            }
+            ConvertSkinnedMesh(scene->mMeshes[mi], m_->boneIndexOfName, vertices.data() + vertexOffsets[mi],
+                               indices.data() + indexOffsets[mi], cacheReports[mi]);
         }
+    });
+    auto convertEnd = std::chrono::high_resolution_clock::now();
 
-        subset.indexCount = static_cast<uint32_t>(indices.size()) - subset.startIndex;
+    m_->subsets.clear();
+    m_->subsets.reserve(meshCount);
+    for (unsigned int mi = 0; mi < meshCount; ++mi)
+    {
+        FbxSubset subset;
+        subset.startIndex = indexOffsets[mi];
+        subset.indexCount = indexOffsets[mi + 1] - indexOffsets[mi];
+        subset.materialIndex = scene->mMeshes[mi]->mMaterialIndex;
+        subset.baseVertex = vertexOffsets[mi];
         m_->subsets.push_back(subset);
 
-        std::cout << "Subset [" << mi << "]: vertices=" << mesh->mNumVertices
+        std::cout << "Subset [" << mi << "]: vertices=" << scene->mMeshes[mi]->mNumVertices
                   << ", indices=" << subset.indexCount
                   << ", material=" << subset.materialIndex << std::endl;
+
+        const SubsetCacheReport& report = cacheReports[mi];
+        if (report.optimized)
+        {
+            std::cout << "  Vertex cache (FIFO " << ZMeshOptimizer::kStatsCacheSize << "): ACMR " << report.before.acmr
+                      << " -> " << report.after.acmr << ", ATVR " << report.before.atvr << " -> " << report.after.atvr
+                      << std::endl;
+        }
+    }
+
+    // LOD chains (quadric simplification per subset)
+    const size_t baseIndexCount = indices.size();
+    BuildSubsetLods(vertices, vertexOffsets, cacheReports, indices, m_->subsets);
+    auto lodEnd = std::chrono::high_resolution_clock::now();
+
+    for (size_t si = 0; si < m_->subsets.size(); ++si)
+    {
+        const FbxSubset& subset = m_->subsets[si];
+        if (subset.lodCount == 0)
+            continue;
+        std::cout << "  Subset [" << si << "] LODs: " << subset.indexCount / 3;
+        for (uint32_t level = 0; level < subset.lodCount; ++level)
+        {
+            std::cout << " -> " << subset.lods[level].indexCount / 3 << " (err " << subset.lods[level].error << ")";
+        }
+        std::cout << " triangles" << std::endl;
     }
 
+    std::cout << "Mesh conversion: count " << std::chrono::duration<double, std::milli>(countEnd - startTime).count()
+              << "ms, convert + optimize " << std::chrono::duration<double, std::milli>(convertEnd - countEnd).count()
+              << "ms, LODs " << std::chrono::duration<double, std::milli>(lodEnd - convertEnd).count()
+              << "ms (+" << (indices.size() - baseIndexCount) << " indices) (" << pool.GetWorkerCount() + 1 << " threads)" << std::endl;
+
     // Debug: Print vertex structure size
     std::cout << "sizeof(VertexSkinned) = " << sizeof(VertexSkinned) << " bytes" << std::endl;
 
-    // Create vertex buffer
-    D3D11_BUFFER_DESC vbd{};
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    vbd.Usage = D3D11_USAGE_DEFAULT;
-    vbd.ByteWidth = static_cast<UINT>(vertices.size() * sizeof(VertexSkinned));
-
-    D3D11_SUBRESOURCE_DATA vbData{};
-    vbData.pSysMem = vertices.data();
+    // Bind-pose AABB, one pass: bounding sphere (center, half diagonal) and the bounding box log below
+    XMFLOAT3 minBounds = { 0.0f, 0.0f, 0.0f };
+    XMFLOAT3 maxBounds = { 0.0f, 0.0f, 0.0f };
+    if (!vertices.empty())
+    {
+        XMVECTOR boundsMin = XMLoadFloat3(&vertices[0].position);
+        XMVECTOR boundsMax = boundsMin;
+        for (const VertexSkinned& v : vertices)
+        {
+            const XMVECTOR p = XMLoadFloat3(&v.position);
+            boundsMin = XMVectorMin(boundsMin, p);
+            boundsMax = XMVectorMax(boundsMax, p);
+        }
+        XMStoreFloat3(&minBounds, boundsMin);
+        XMStoreFloat3(&maxBounds, boundsMax);
+        XMStoreFloat3(&m_->boundsCenter, XMVectorScale(XMVectorAdd(boundsMin, boundsMax), 0.5f));
+        m_->boundsRadius = 0.5f * XMVectorGetX(XMVector3Length(XMVectorSubtract(boundsMax, boundsMin)));
+    }
 
-    HRESULT hr = gfx.GetDeviceCOM()->CreateBuffer(&vbd, &vbData, &m_->pVertexBuffer);
-    if (FAILED(hr))
+    // Index width: subset-local indices fit 16 bits unless a subset has more than 65536 vertices
+    const bool shortIndices = Bind::ZIndexBuffer::FitsIn16Bit(indices.data(), indices.size());
+    std::vector<uint16_t> shortIndexData;
+    if (shortIndices)
     {
-        std::cerr << "Failed to create vertex buffer" << std::endl;
-        return false;
+        shortIndexData = Bind::ZIndexBuffer::Narrow(indices.data(), indices.size());
     }
+    m_->indexFormat = shortIndices ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    const UINT indexStride = shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+    std::cout << "Index format: " << (shortIndices ? "16" : "32") << "-bit, index buffer "
+              << indices.size() * indexStride / 1024 << " KB" << std::endl;
 
-    // Create index buffer
-    D3D11_BUFFER_DESC ibd{};
-    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    ibd.Usage = D3D11_USAGE_DEFAULT;
-    ibd.ByteWidth = static_cast<UINT>(indices.size() * sizeof(uint32_t));
+    // Quantized vertex format (opt-in, uint8 bone indices)
+    const bool packable = m_->boneNames.size() <= FbxVertexPack::kMaxBones;
+    if (m_->requestedVertexFormat == FbxVertexFormat::Packed && !packable)
+    {
+        std::cout << "[FbxManager] " << m_->boneNames.size() << " bones do not fit uint8 indices, keeping the full vertex format" << std::endl;
+    }
+    m_->vertexFormat = (m_->requestedVertexFormat == FbxVertexFormat::Packed && packable) ? FbxVertexFormat::Packed : FbxVertexFormat::Full;
 
-    D3D11_SUBRESOURCE_DATA ibData{};
-    ibData.pSysMem = indices.data();
+    if (m_->vertexFormat == FbxVertexFormat::Packed)
+    {
+        std::vector<FbxPackedVertex> packedVertices(vertices.size());
+        ZThreadPool::Shared().ParallelFor(vertices.size(), 4096, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const VertexSkinned& v = vertices[i];
+                FbxVertexPack::Pack(v.position, v.normal, v.tangent, v.bitangent, v.texCoord, v.boneIndices, v.boneWeights,
+                                    packedVertices[i]);
+            }
+        });
+        m_->vertexStride = sizeof(FbxPackedVertex);
 
-    hr = gfx.GetDeviceCOM()->CreateBuffer(&ibd, &ibData, &m_->pIndexBuffer);
-    if (FAILED(hr))
+        std::cout << "Vertex format: packed " << sizeof(FbxPackedVertex) << " bytes/vertex (full " << sizeof(VertexSkinned)
+                  << "), vertex buffer " << vertices.size() * sizeof(VertexSkinned) / 1024 << " KB -> "
+                  << packedVertices.size() * sizeof(FbxPackedVertex) / 1024 << " KB" << std::endl;
+        m_->meshPackedVertices = std::move(packedVertices);
+    }
+    else
     {
-        std::cerr << "Failed to create index buffer" << std::endl;
-        return false;
+        m_->vertexStride = sizeof(VertexSkinned);
     }
 
     m_->indexCount = static_cast<int>(indices.size());
 
-    // Calculate bounding box
+    // Bounding box (min/max from the bounding sphere pass above)
     if (!vertices.empty())
     {
-        XMFLOAT3 minBounds = vertices[0].position;
-        XMFLOAT3 maxBounds = vertices[0].position;
-        
-        for (const auto& v : vertices)
-        {
-            minBounds.x = (std::min)(minBounds.x, v.position.x);
-            minBounds.y = (std::min)(minBounds.y, v.position.y);
-            minBounds.z = (std::min)(minBounds.z, v.position.z);
-            maxBounds.x = (std::max)(maxBounds.x, v.position.x);
-            maxBounds.y = (std::max)(maxBounds.y, v.position.y);
-            maxBounds.z = (std::max)(maxBounds.z, v.position.z);
-        }
-        
         XMFLOAT3 size = {
             maxBounds.x - minBounds.x,
             maxBounds.y - minBounds.y,
@@ -1879,11 +1709,23 @@ bool FbxManager::BuildMeshBuffers(ZGraphics& gfx, const aiScene* scene)
     std::cout << "Total vertices: " << vertices.size() << std::endl;
     std::cout << "Total indices: " << indices.size() << std::endl;
     
+    // Kept for the GPU buffers and the .zmesh cache write (only the chosen formats)
+    if (m_->vertexFormat == FbxVertexFormat::Full)
+    {
+        m_->meshVertices = std::move(vertices);
+    }
+    if (shortIndices)
+    {
+        m_->meshIndices16 = std::move(shortIndexData);
+    }
+    else
+    {
+        m_->meshIndices = std::move(indices);
+    }
+    
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    std::cout << "=== BuildMeshBuffers Complete (took " << duration.count() << "ms) ===" << std::endl;
-
-    return true;
+    std::cout << "=== BuildMeshData Complete (took " << duration.count() << "ms) ===" << std::endl;
 }
 
 // Animation control methods
@@ -1900,13 +1742,20 @@ void FbxManager::SetCurrentAnimation(int idx)
     m_->currentClip = idx;
     m_->clipTimeSec = 0.0;
     
-    std::cout << "[FbxManager] Animation set to: " << m_->animationNames[idx] << std::endl;
+    if (m_->animationLogging)
+        std::cout << "[FbxManager] Animation set to: " << m_->animationNames[idx] << std::endl;
 }
 
 void FbxManager::SetAnimationPlaying(bool playing)
 {
     m_->playing = playing;
-    std::cout << "[FbxManager] Animation " << (playing ? "playing" : "paused") << std::endl;
+    if (m_->animationLogging)
+        std::cout << "[FbxManager] Animation " << (playing ? "playing" : "paused") << std::endl;
+}
+
+void FbxManager::SetAnimationLogging(bool enabled)
+{
+    m_->animationLogging = enabled;
 }
 
 bool FbxManager::IsAnimationPlaying() const
@@ -1963,223 +1812,192 @@ int FbxManager::GetBoneCount() const
     return static_cast<int>(m_->boneOffsets.size());
 }
 
+// Bone CB: range of this instance in the shared palette buffer (matches BonesBuffer in the skinned VS)
+struct BoneRangeCB
+{
+    uint32_t paletteBase;   // first float4 row
+    uint32_t boneCount;
+    uint32_t padding[2];
+};
+
 // Helper: Create bone constant buffer
-void CreateBoneConstantBuffer(ZGraphics& gfx, ID3D11Buffer** ppBuffer, int maxBones)
+void CreateBoneConstantBuffer(ZGraphics& gfx, ID3D11Buffer** ppBuffer)
 {
     if (!ppBuffer || *ppBuffer) return;
     
-    // Bone CB structure: array of matrices + bone count (matching shader)
-    struct BoneCB
-    {
-        XMFLOAT4X4 boneMatrices[1023];  // MAX_BONES from shader
-        unsigned int boneCount;
-        float padding[3];
-    };
-    
     D3D11_BUFFER_DESC cbd{};
     cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
     cbd.Usage = D3D11_USAGE_DYNAMIC;
     cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    cbd.ByteWidth = sizeof(BoneCB);
+    cbd.ByteWidth = sizeof(BoneRangeCB);
     
     HRESULT hr = gfx.GetDeviceCOM()->CreateBuffer(&cbd, nullptr, ppBuffer);
-    if (SUCCEEDED(hr))
-    {
-        std::cout << "[FbxManager] Bone constant buffer created (size: " << sizeof(BoneCB) << " bytes)" << std::endl;
-    }
-    else
+    if (FAILED(hr))
     {
         std::cerr << "[FbxManager] Failed to create bone constant buffer!" << std::endl;
     }
 }
 
-// Helper: Upload bone palette to GPU
-void UploadBonePalette(ZGraphics& gfx, ID3D11Buffer* pBoneCB, const std::vector<XMMATRIX>& palette)
+// Helper: Point the bone CB at a palette range
+void UploadBoneRange(ZGraphics& gfx, ID3D11Buffer* pBoneCB, uint32_t paletteBase, uint32_t boneCount)
 {
     if (!pBoneCB) return;
     
-    struct BoneCB
-    {
-        XMFLOAT4X4 boneMatrices[1023];
-        unsigned int boneCount;
-        float padding[3];
-    };
-    
-    BoneCB cb{};
-    
-    // Initialize all matrices to identity
-    XMMATRIX identity = XMMatrixIdentity();
-    for (int i = 0; i < 1023; ++i)
-    {
-        XMStoreFloat4x4(&cb.boneMatrices[i], XMMatrixTranspose(identity));
-    }
-    
-    // Copy bone palette (transposed for HLSL)
-    size_t numBones = (std::min)(palette.size(), size_t(1023));
-    for (size_t i = 0; i < numBones; ++i)
-    {
-        XMMATRIX transposed = XMMatrixTranspose(palette[i]);
-        XMStoreFloat4x4(&cb.boneMatrices[i], transposed);
-    }
-    
-    cb.boneCount = static_cast<unsigned int>(numBones);
+    BoneRangeCB cb{};
+    cb.paletteBase = paletteBase;
+    cb.boneCount = boneCount;
     
-    // Map and upload
     D3D11_MAPPED_SUBRESOURCE mapped;
     HRESULT hr = gfx.GetDeviceContext()->Map(pBoneCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
     if (SUCCEEDED(hr))
     {
-        memcpy(mapped.pData, &cb, sizeof(BoneCB));
+        memcpy(mapped.pData, &cb, sizeof(BoneRangeCB));
         gfx.GetDeviceContext()->Unmap(pBoneCB, 0);
     }
 }
 
-// Helper: Interpolate position keyframes
-static aiVector3D InterpolatePosition(double time, const aiNodeAnim* channel)
+// Helper: Bind clip tracks to skeleton nodes (once per clip)
+void FbxManager::BuildClipBinding(int clipIndex)
 {
-    if (channel->mNumPositionKeys == 1)
-        return channel->mPositionKeys[0].mValue;
+    const FbxAnimClip& clip = *m_->clips[clipIndex];
     
-    // Find keyframe indices
-    unsigned int frame = 0;
-    for (unsigned int i = 0; i < channel->mNumPositionKeys - 1; ++i)
+    if (static_cast<int>(m_->clipBindings.size()) <= clipIndex)
     {
-        if (time < channel->mPositionKeys[i + 1].mTime)
-        {
-            frame = i;
-            break;
-        }
+        m_->clipBindings.resize(clipIndex + 1);
     }
     
-    unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
-    const aiVectorKey& key = channel->mPositionKeys[frame];
-    const aiVectorKey& nextKey = channel->mPositionKeys[nextFrame];
-    
-    double deltaTime = nextKey.mTime - key.mTime;
-    double factor = (time - key.mTime) / deltaTime;
-    
-    aiVector3D result;
-    result.x = static_cast<float>(key.mValue.x + factor * (nextKey.mValue.x - key.mValue.x));
-    result.y = static_cast<float>(key.mValue.y + factor * (nextKey.mValue.y - key.mValue.y));
-    result.z = static_cast<float>(key.mValue.z + factor * (nextKey.mValue.z - key.mValue.z));
-    return result;
-}
-
-// Helper: Interpolate rotation keyframes
-static aiQuaternion InterpolateRotation(double time, const aiNodeAnim* channel)
-{
-    if (channel->mNumRotationKeys == 1)
-        return channel->mRotationKeys[0].mValue;
+    Impl::ClipBinding& binding = m_->clipBindings[clipIndex];
+    binding.trackOfNode.assign(m_->skeleton.size(), -1);
+    binding.restLocal = m_->restLocalOfNode;
+    binding.matchedTracks = 0;
     
-    unsigned int frame = 0;
-    for (unsigned int i = 0; i < channel->mNumRotationKeys - 1; ++i)
+    // 외부 애니메이션 파일은 자체 노드 트리를 가진다 → 같은 이름 노드의 rest 변환을 사용
+    // (클립의 rest pose는 전위 순회 순서 → 이름이 중복되면 먼저 나온 노드를 쓴다)
+    std::vector<bool> restAssigned(m_->skeleton.size(), false);
+    for (size_t r = 0; r < clip.restNodeNames.size(); ++r)
     {
-        if (time < channel->mRotationKeys[i + 1].mTime)
+        auto it = m_->nodeIndexOfName.find(clip.restNodeNames[r]);
+        if (it != m_->nodeIndexOfName.end() && !restAssigned[it->second])
         {
-            frame = i;
-            break;
+            binding.restLocal[it->second] = clip.restNodeLocals[r];
+            restAssigned[it->second] = true;
         }
     }
     
-    unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
-    const aiQuatKey& key = channel->mRotationKeys[frame];
-    const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
+    std::cout << "[FbxManager] Building channel map for animation: " << clip.name << std::endl;
     
-    double deltaTime = nextKey.mTime - key.mTime;
-    float factor = static_cast<float>((time - key.mTime) / deltaTime);
-    
-    aiQuaternion result;
-    aiQuaternion::Interpolate(result, key.mValue, nextKey.mValue, factor);
-    result.Normalize();
-    return result;
-}
-
-// Helper: Interpolate scaling keyframes
-static aiVector3D InterpolateScaling(double time, const aiNodeAnim* channel)
-{
-    if (channel->mNumScalingKeys == 1)
-        return channel->mScalingKeys[0].mValue;
-    
-    unsigned int frame = 0;
-    for (unsigned int i = 0; i < channel->mNumScalingKeys - 1; ++i)
+    // 본 매핑: 애니메이션 트랙을 스켈레톤 노드에 연결
+    // 애니메이션 트랙: 각 본의 애니메이션 데이터(위치, 회전, 크기 샘플)
+    // 예: mixamorig:Hips 본의 시간에 따른 위치/회전/크기 변화 정보
+    // 로드 시 한 번만 이름으로 매칭 → 매 프레임 문자열 해싱 없음
+    for (uint32_t i = 0; i < clip.GetTrackCount(); ++i)
     {
-        if (time < channel->mScalingKeys[i + 1].mTime)
+        const std::string& trackNodeName = clip.trackNodeNames[i];
+        
+        // 애니메이션 트랙의 노드 이름으로 기본 모델의 노드 인덱스 찾기
+        auto it = m_->nodeIndexOfName.find(trackNodeName);
+        
+        if (it != m_->nodeIndexOfName.end() && it->second >= 0 && it->second < static_cast<int>(binding.trackOfNode.size()))
         {
-            frame = i;
-            break;
+            binding.trackOfNode[it->second] = static_cast<int>(i);
+            binding.matchedTracks++;
+            std::cout << "  Matched: " << trackNodeName << " -> bone " << it->second << std::endl;
+        }
+        else
+        {
+            // 기본 모델에 해당 본이 없는 경우 (본 이름 불일치) → 애니메이션이 적용되지 않음
+            std::cout << "  Unmatched: " << trackNodeName << " (no corresponding bone)" << std::endl;
         }
     }
     
-    unsigned int nextFrame = (frame + 1) % channel->mNumScalingKeys;
-    const aiVectorKey& key = channel->mScalingKeys[frame];
-    const aiVectorKey& nextKey = channel->mScalingKeys[nextFrame];
-    
-    double deltaTime = nextKey.mTime - key.mTime;
-    double factor = (time - key.mTime) / deltaTime;
+    std::cout << "  Total matched channels: " << binding.matchedTracks << "/" << clip.GetTrackCount() << std::endl;
     
-    aiVector3D result;
-    result.x = static_cast<float>(key.mValue.x + factor * (nextKey.mValue.x - key.mValue.x));
-    result.y = static_cast<float>(key.mValue.y + factor * (nextKey.mValue.y - key.mValue.y));
-    result.z = static_cast<float>(key.mValue.z + factor * (nextKey.mValue.z - key.mValue.z));
-    return result;
-}
+    // Reduced bone set for distant LOD: finger/face nodes keep their rest local
+    binding.trackOfNodeReduced = binding.trackOfNode;
+    for (size_t n = 0; n < binding.trackOfNodeReduced.size(); ++n)
+    {
+        if (binding.trackOfNodeReduced[n] >= 0 && IsDetailBoneName(m_->skeleton[n].name))
+        {
+            binding.trackOfNodeReduced[n] = -1;
+            binding.frozenTracks++;
+        }
+    }
 
-// Helper: Evaluate global matrices for all nodes
-void EvaluateGlobalMatrices(const aiScene* scene, const aiNode* node, int nodeIdx,
-                            const std::vector<const aiNodeAnim*>& channelOfNode,
-                            std::vector<XMFLOAT4X4>& outGlobal,
-                            const std::unordered_map<std::string, int>& nodeIndexOfName,
-                            double animTime, XMMATRIX parentGlobal)
-{
-    // Get local transform
-    aiMatrix4x4 localTransform = node->mTransformation;
-    
-    // Apply animation if channel exists
-    if (nodeIdx >= 0 && nodeIdx < static_cast<int>(channelOfNode.size()) && channelOfNode[nodeIdx])
+    // Frozen nodes hold the model's bind pose (클립 소스 rest가 아니라 바인드 포즈로 고정)
+    const size_t nodeCount = m_->parentOfNode.size();
+    binding.reducedRestLocal = binding.restLocal;
+    for (size_t n = 0; n < nodeCount; ++n)
     {
-        const aiNodeAnim* channel = channelOfNode[nodeIdx];
-        
-        // Interpolate position, rotation, scaling
-        aiVector3D pos = InterpolatePosition(animTime, channel);
-        aiQuaternion rot = InterpolateRotation(animTime, channel);
-        aiVector3D scale = InterpolateScaling(animTime, channel);
-        
-        // Build local matrix from TRS
-        aiMatrix4x4 matScale, matRot, matTrans;
-        aiMatrix4x4::Scaling(scale, matScale);
-        matRot = aiMatrix4x4(rot.GetMatrix());
-        aiMatrix4x4::Translation(pos, matTrans);
-        
-        localTransform = matTrans * matRot * matScale;
+        if (binding.trackOfNode[n] >= 0 && binding.trackOfNodeReduced[n] < 0)
+            binding.reducedRestLocal[n] = m_->restLocalOfNode[n];
     }
-    
-    // Convert to XMMATRIX
-    XMFLOAT4X4 localF;
-    localF._11 = localTransform.a1; localF._12 = localTransform.a2; localF._13 = localTransform.a3; localF._14 = localTransform.a4;
-    localF._21 = localTransform.b1; localF._22 = localTransform.b2; localF._23 = localTransform.b3; localF._24 = localTransform.b4;
-    localF._31 = localTransform.c1; localF._32 = localTransform.c2; localF._33 = localTransform.c3; localF._34 = localTransform.c4;
-    localF._41 = localTransform.d1; localF._42 = localTransform.d2; localF._43 = localTransform.d3; localF._44 = localTransform.d4;
-    
-    XMMATRIX local = XMLoadFloat4x4(&localF);
-    XMMATRIX global = XMMatrixMultiply(parentGlobal, local);
-    
-    // Store global matrix
-    if (nodeIdx >= 0 && nodeIdx < static_cast<int>(outGlobal.size()))
+
+    // Live = animated track at or below the node (부모 인덱스 < 자식 인덱스 → 역순 한 번으로 전파)
+    std::vector<bool> live(nodeCount, false);
+    for (size_t n = nodeCount; n-- > 0;)
     {
-        XMStoreFloat4x4(&outGlobal[nodeIdx], global);
+        if (binding.trackOfNodeReduced[n] >= 0)
+            live[n] = true;
+        const int parent = m_->parentOfNode[n];
+        if (live[n] && parent >= 0)
+            live[parent] = true;
     }
-    
-    // Process children
-    for (unsigned int i = 0; i < node->mNumChildren; ++i)
+
+    std::vector<bool> isBoneNode(nodeCount, false);
+    for (int node : m_->nodeOfBone)
+    {
+        if (node >= 0 && node < static_cast<int>(nodeCount))
+            isBoneNode[node] = true;
+    }
+
+    // Static subtrees: relative transform to the nearest live ancestor, accumulated in preorder
+    std::vector<int> anchorOfNode(nodeCount, -1);
+    std::vector<XMFLOAT4X4> relativeOfNode(nodeCount);
+    binding.reducedLiveNodes.clear();
+    binding.frozenBoneNodes.clear();
+    for (size_t n = 0; n < nodeCount; ++n)
     {
-        auto it = nodeIndexOfName.find(node->mChildren[i]->mName.C_Str());
-        int childIdx = (it != nodeIndexOfName.end()) ? it->second : -1;
-        EvaluateGlobalMatrices(scene, node->mChildren[i], childIdx, channelOfNode, 
-                              outGlobal, nodeIndexOfName, animTime, global);
+        if (live[n])
+        {
+            binding.reducedLiveNodes.push_back(static_cast<int>(n));
+            continue;
+        }
+
+        const int parent = m_->parentOfNode[n];
+        const XMMATRIX local = XMLoadFloat4x4(&binding.reducedRestLocal[n]);
+        if (parent < 0 || live[parent])
+        {
+            anchorOfNode[n] = parent;
+            XMStoreFloat4x4(&relativeOfNode[n], local);
+        }
+        else
+        {
+            anchorOfNode[n] = anchorOfNode[parent];
+            XMStoreFloat4x4(&relativeOfNode[n], XMMatrixMultiply(XMLoadFloat4x4(&relativeOfNode[parent]), local));
+        }
+
+        if (isBoneNode[n])
+        {
+            Impl::ClipBinding::FrozenBoneNode frozen;
+            frozen.node = static_cast<int>(n);
+            frozen.anchor = anchorOfNode[n];
+            frozen.relative = relativeOfNode[n];
+            binding.frozenBoneNodes.push_back(frozen);
+        }
     }
+
+    std::cout << "  Reduced LOD bone set: " << binding.frozenTracks << " finger/face tracks frozen, "
+              << binding.reducedLiveNodes.size() << "/" << nodeCount << " nodes evaluated, "
+              << binding.frozenBoneNodes.size() << " bones from fixed subtrees" << std::endl;
 }
 
 void FbxManager::UpdateAnimation(float deltaTime)
+{
+    AdvanceAnimation(deltaTime);
+    EvaluateAnimation();
+}
+
+void FbxManager::AdvanceAnimation(float deltaTime)
 {
     // Update animation time if playing
     if (m_->playing && m_->hasAnimations && m_->currentClip >= 0)
@@ -2187,63 +2005,45 @@ void FbxManager::UpdateAnimation(float deltaTime)
         SetAnimationTimeSeconds(m_->clipTimeSec + static_cast<double>(deltaTime));
         
         // Log animation time periodically (every 1 second)
-        static double lastLogTime = 0.0;
-        if (m_->clipTimeSec - lastLogTime >= 1.0)
+        if (m_->animationLogging && m_->clipTimeSec - m_->lastTimeLogSec >= 1.0)
         {
             std::cout << "[FbxManager] Animation time: " << m_->clipTimeSec 
                       << "s / " << m_->clipDurationSec[m_->currentClip] << "s" << std::endl;
-            lastLogTime = m_->clipTimeSec;
+            m_->lastTimeLogSec = m_->clipTimeSec;
         }
     }
-    
+}
+
+bool FbxManager::HasPendingAnimationLogs() const
+{
+    return m_->animationLogging && (m_->lastLoggedClip != m_->currentClip || m_->paletteLogCount < 3);
+}
+
+void FbxManager::EvaluateAnimation(double timeOffsetSec, bool reducedBones)
+{
     // If no skinning, nothing to update
     if (!m_->hasSkinning || !m_->hasAnimations || m_->currentClip < 0)
         return;
     
-    // 1. Get current animation (from base or external)
-    const aiAnimation* anim = nullptr;
-    const aiScene* animScene = nullptr;
-    
-    if (m_->currentClip < m_->baseAnimationCount)
+    // 1. Get current compiled clip (base and external clips share one index space)
+    if (m_->currentClip >= static_cast<int>(m_->clips.size()) ||
+        m_->currentClip >= static_cast<int>(m_->clipBindings.size()))
     {
-        // Animation from base model
-        anim = m_->scene->mAnimations[m_->currentClip];
-        animScene = m_->scene;
-    }
-    else
-    {
-        // External animation
-        int extIndex = m_->currentClip - m_->baseAnimationCount;
-        
-        if (extIndex >= 0 && extIndex < static_cast<int>(m_->externalAnimations.size()))
-        {
-            const auto& extAnim = m_->externalAnimations[extIndex];
-            if (extAnim.scene && extAnim.scene->mNumAnimations > 0)
-            {
-                anim = extAnim.scene->mAnimations[0];
-                animScene = extAnim.scene;
-            }
-        }
-        else
-        {
-            std::cout << "[FbxManager] Invalid external animation index!" << std::endl;
-        }
-    }
-    
-    if (!anim || !animScene)
+        std::cout << "[FbxManager] Invalid animation clip index!" << std::endl;
         return;
+    }
     
-    // 2. Build channel map for current animation
-    m_->channelOfNode.assign(m_->skeleton.size(), nullptr);
+    const FbxAnimClip& clip = *m_->clips[m_->currentClip];
+    const Impl::ClipBinding& binding = m_->clipBindings[m_->currentClip];
     
     // Log animation change only once when animation switches
-    bool shouldLog = (m_->lastLoggedClip != m_->currentClip);
+    bool shouldLog = m_->animationLogging && (m_->lastLoggedClip != m_->currentClip);
     
     if (shouldLog)
     {
         if (m_->currentClip < m_->baseAnimationCount)
         {
-            std::cout << "[FbxManager] Using base animation: " << anim->mName.C_Str() << std::endl;
+            std::cout << "[FbxManager] Using base animation: " << clip.name << std::endl;
         }
         else
         {
@@ -2259,8 +2059,8 @@ void FbxManager::UpdateAnimation(float deltaTime)
             }
         }
         
-        std::cout << "[FbxManager] Building channel map for animation: " << anim->mName.C_Str() << std::endl;
-        std::cout << "  Animation channels: " << anim->mNumChannels << std::endl;
+        std::cout << "[FbxManager] Channel binding for animation: " << clip.name << std::endl;
+        std::cout << "  Animation channels: " << clip.GetTrackCount() << std::endl;
         std::cout << "  Skeleton bones: " << m_->skeleton.size() << std::endl;
         
         // Print base model bone names for comparison
@@ -2279,70 +2079,65 @@ void FbxManager::UpdateAnimation(float deltaTime)
                 break;
             }
         }
+        
+        std::cout << "  Bound tracks: " << binding.matchedTracks << "/" << clip.GetTrackCount() << std::endl;
+        m_->lastLoggedClip = m_->currentClip;
     }
     
-    // 본 매핑: 애니메이션 채널을 스켈레톤 본에 연결
-    // 애니메이션 채널: 각 본의 애니메이션 데이터(위치, 회전, 크기 키프레임)를 담고 있는 구조체
-    // 예: mixamorig:Hips 본의 시간에 따른 위치/회전/크기 변화 정보
-    // 이 채널들을 기본 모델의 실제 본들에 매핑하여 애니메이션을 적용
-    int matchedChannels = 0;
-    for (unsigned int i = 0; i < anim->mNumChannels; ++i)
+    // 3. Local -> global: one linear pass over the flat skeleton
+    // BuildSkeleton은 전위 순회로 인덱스를 매기므로 부모 인덱스 < 자식 인덱스가 보장된다
+    // LOD 보간 목표는 현재 시간보다 앞선 포즈 (루프 경계에서 감아 돌린다)
+    double sampleTimeSec = m_->clipTimeSec;
+    if (timeOffsetSec != 0.0)
     {
-        // 현재 애니메이션 채널 가져오기 (본 이름과 애니메이션 데이터 포함)
-        // aiNodeAnim: 특정 본의 애니메이션 키프레임들을 저장하는 Assimp 구조체
-        const aiNodeAnim* channel = anim->mChannels[i];
-        
-        // 애니메이션 채널의 본 이름으로 기본 모델의 본 인덱스 찾기
-        // m_->nodeIndexOfName: 본 이름 -> 본 인덱스 맵
-        auto it = m_->nodeIndexOfName.find(channel->mNodeName.C_Str());
-        
-        if (it != m_->nodeIndexOfName.end())
+        const double dur = m_->clipDurationSec[m_->currentClip];
+        sampleTimeSec = (dur > 0.0) ? std::fmod(sampleTimeSec + timeOffsetSec, dur) : 0.0;
+        if (sampleTimeSec < 0.0)
+            sampleTimeSec += dur;
+    }
+    
+    const FbxAnimSampleCursor cursor = FbxAnim::LocateSample(clip, sampleTimeSec);
+    const size_t nodeCount = m_->parentOfNode.size();
+    m_->scratch.Reset();
+    XMMATRIX* globals = m_->scratch.AllocateArray<XMMATRIX>(nodeCount);
+    
+    if (!reducedBones)
+    {
+        for (size_t n = 0; n < nodeCount; ++n)
         {
-            // 기본 모델에 해당 본이 존재하는 경우
-            int nodeIdx = it->second;
+            const int track = binding.trackOfNode[n];
+            const XMMATRIX local = (track >= 0)
+                ? FbxAnim::SampleTrackLocal(clip, static_cast<uint32_t>(track), cursor)
+                : XMLoadFloat4x4(&binding.restLocal[n]);
             
-            // 본 인덱스가 유효한 범위인지 확인
-            if (nodeIdx >= 0 && nodeIdx < static_cast<int>(m_->channelOfNode.size()))
-            {
-                // 채널 포인터를 본 매핑 배열에 저장
-                // m_->channelOfNode[nodeIdx]: 해당 본에 적용할 애니메이션 채널
-                m_->channelOfNode[nodeIdx] = channel;
-                matchedChannels++;
-                
-                // 디버그 로그: 성공적으로 매핑된 본 정보 출력
-                if (shouldLog)
-                {
-                    std::cout << "  Matched: " << channel->mNodeName.C_Str() << " -> bone " << nodeIdx << std::endl;
-                }
-            }
-        }
-        else
-        {
-            // 기본 모델에 해당 본이 없는 경우 (본 이름 불일치)
-            // 이 경우 애니메이션이 적용되지 않음
-            if (shouldLog)
-            {
-                std::cout << "  Unmatched: " << channel->mNodeName.C_Str() << " (no corresponding bone)" << std::endl;
-            }
+            const int parent = m_->parentOfNode[n];
+            globals[n] = (parent >= 0) ? XMMatrixMultiply(globals[parent], local) : local;
         }
     }
-    
-    if (shouldLog)
+    else
     {
-        std::cout << "  Total matched channels: " << matchedChannels << "/" << anim->mNumChannels << std::endl;
-        m_->lastLoggedClip = m_->currentClip;
+        // Reduced LOD: 움직이는 노드만 계층 패스, 고정 서브트리의 본은 앵커 전역 x 미리 계산한 상대 변환
+        // (본이 아닌 고정 노드는 팔레트에 쓰이지 않으므로 계산하지 않는다)
+        for (int n : binding.reducedLiveNodes)
+        {
+            const int track = binding.trackOfNodeReduced[n];
+            const XMMATRIX local = (track >= 0)
+                ? FbxAnim::SampleTrackLocal(clip, static_cast<uint32_t>(track), cursor)
+                : XMLoadFloat4x4(&binding.reducedRestLocal[n]);
+            
+            const int parent = m_->parentOfNode[n];
+            globals[n] = (parent >= 0) ? XMMatrixMultiply(globals[parent], local) : local;
+        }
+        for (const Impl::ClipBinding::FrozenBoneNode& frozen : binding.frozenBoneNodes)
+        {
+            const XMMATRIX relative = XMLoadFloat4x4(&frozen.relative);
+            globals[frozen.node] = (frozen.anchor >= 0) ? XMMatrixMultiply(globals[frozen.anchor], relative) : relative;
+        }
     }
     
-    // 3. Evaluate global matrices for all nodes
-    std::vector<XMFLOAT4X4> globalMatrices(m_->skeleton.size());
-    double animTime = m_->clipTimeSec * m_->clipTicksPerSec[m_->currentClip];
-    
-    EvaluateGlobalMatrices(animScene, animScene->mRootNode, m_->skeletonRoot,
-                          m_->channelOfNode, globalMatrices, m_->nodeIndexOfName,
-                          animTime, XMMatrixIdentity());
-    
-    // 3. Build bone palette matrices
+    // 4. Build bone palette matrices
     m_->currentBonePalette.resize(m_->boneNames.size());
+    m_->paletteArenaFrame = 0;
     XMMATRIX globalInverse = XMLoadFloat4x4(&m_->globalInverse);
     
     // Debug: Compare globalInverse matrix between models to detect coordinate system differences
@@ -2402,21 +2197,20 @@ void FbxManager::UpdateAnimation(float deltaTime)
     }
     
     // Debug: Log matrix calculations for key bones to detect rotation issues
-    std::vector<std::string> debugBones = {"mixamorig:Hips", "mixamorig:Spine", "mixamorig:LeftArm"};
+    static constexpr const char* kDebugBones[] = { "mixamorig:Hips", "mixamorig:Spine", "mixamorig:LeftArm" };
     
     for (size_t i = 0; i < m_->boneNames.size(); ++i)
     {
-        auto it = m_->nodeIndexOfName.find(m_->boneNames[i]);
-        if (it != m_->nodeIndexOfName.end())
+        int nodeIdx = m_->nodeOfBone[i];
+        if (nodeIdx >= 0)
         {
-            int nodeIdx = it->second;
-            XMMATRIX global = XMLoadFloat4x4(&globalMatrices[nodeIdx]);
+            XMMATRIX global = globals[nodeIdx];
             XMMATRIX offset = XMLoadFloat4x4(&m_->boneOffsets[i]);
             
             // Debug logging for key bones
             if (shouldLog)
             {
-                for (const std::string& debugBone : debugBones)
+                for (const char* debugBone : kDebugBones)
                 {
                     if (m_->boneNames[i] == debugBone)
                     {
@@ -2463,31 +2257,92 @@ void FbxManager::UpdateAnimation(float deltaTime)
     }
     
     // Log first few updates
-    static int updateCount = 0;
-    if (updateCount < 3)
+    if (m_->animationLogging && m_->paletteLogCount < 3)
     {
         std::cout << "[FbxManager] Bone palette computed: " << m_->currentBonePalette.size() << " bones" << std::endl;
-        updateCount++;
+        m_->paletteLogCount++;
     }
 }
 
+// Debug hook: count CRT heap allocations across simulated UpdateAnimation calls
+int FbxManager::CountUpdateAllocations(int updateCount, float deltaTime)
+{
+#ifdef _DEBUG
+    if (!m_->hasSkinning || !m_->hasAnimations || m_->currentClip < 0)
+        return 0;
+    
+    const double savedTime = m_->clipTimeSec;
+    const bool savedPlaying = m_->playing;
+    m_->playing = false;  // 시간은 직접 진행 (주기 로그 경로 제외)
+    const bool savedLogging = m_->animationLogging;
+    m_->animationLogging = false;  // 팔레트 로그(cout)가 세는 구간에서 할당하지 않도록
+    
+    // Warm-up: first-use logging, palette sizing, arena growth
+    UpdateAnimation(0.0f);
+    
+    g_updateAllocCount = 0;
+    _CRT_ALLOC_HOOK prevHook = _CrtSetAllocHook(CountAllocHook);
+    for (int i = 0; i < updateCount; ++i)
+    {
+        SetAnimationTimeSeconds(savedTime + static_cast<double>(deltaTime) * (i + 1));
+        UpdateAnimation(0.0f);
+    }
+    _CrtSetAllocHook(prevHook);
+    
+    m_->playing = savedPlaying;
+    m_->animationLogging = savedLogging;
+    SetAnimationTimeSeconds(savedTime);
+    return g_updateAllocCount.load();
+#else
+    (void)updateCount;
+    (void)deltaTime;
+    return -1;
+#endif
+}
+
+// Pack current bone palette into the frame's arena (once per frame)
+void FbxManager::PackBonePalette(FbxPaletteArena& arena)
+{
+    if (!m_->hasSkinning || m_->currentBonePalette.empty())
+        return;
+    
+    if (m_->paletteArenaFrame == arena.GetFrameIndex())
+        return;
+    
+    m_->paletteArenaBase = arena.Pack(m_->currentBonePalette);
+    m_->paletteArenaFrame = arena.GetFrameIndex();
+}
+
 // Upload bone palette to GPU (called from FbxModel before rendering)
+// 팔레트 행은 공유 버퍼(VS t0)에 있고, b1에는 이 인스턴스의 구간만 쓴다.
 void FbxManager::UploadBonePaletteToGPU(ZGraphics& gfx)
 {
     if (!m_->hasSkinning || m_->currentBonePalette.empty())
         return;
     
+    FbxPaletteArena& arena = gfx.GetPaletteArena();
+    PackBonePalette(arena);
+    
+    if (!arena.Upload(gfx))
+        return;
+    
     // Create bone constant buffer if needed
     if (!m_->pBoneCB)
     {
-        CreateBoneConstantBuffer(gfx, &m_->pBoneCB, Impl::kMaxBones);
+        CreateBoneConstantBuffer(gfx, &m_->pBoneCB);
     }
     
-    // Upload current bone palette
-    if (m_->pBoneCB)
+    // Range changes only when the frame's pack order changes
+    const uint32_t boneCount = static_cast<uint32_t>(m_->currentBonePalette.size());
+    if (m_->pBoneCB && (m_->boneCBBase != m_->paletteArenaBase || m_->boneCBCount != boneCount))
     {
-        UploadBonePalette(gfx, m_->pBoneCB, m_->currentBonePalette);
+        UploadBoneRange(gfx, m_->pBoneCB, m_->paletteArenaBase, boneCount);
+        m_->boneCBBase = m_->paletteArenaBase;
+        m_->boneCBCount = boneCount;
     }
+    
+    // 상태 캐시 경유: 같은 프레임의 다음 스킨 인스턴스는 같은 SRV라 다시 보내지 않는다
+    gfx.GetStateCache().SetVSShaderResource(0, arena.GetShaderResourceView());
 }
 
 ID3D11Buffer* FbxManager::GetBoneConstantBuffer() const
@@ -2495,6 +2350,23 @@ ID3D11Buffer* FbxManager::GetBoneConstantBuffer() const
     return m_->pBoneCB;
 }
 
+const std::vector<XMMATRIX>& FbxManager::GetBonePalette() const
+{
+    return m_->currentBonePalette;
+}
+
+std::vector<XMMATRIX>& FbxManager::GetBonePalette()
+{
+    m_->paletteArenaFrame = 0;  // caller may write → pack again
+    return m_->currentBonePalette;
+}
+
+void FbxManager::GetBindPoseBounds(XMFLOAT3& center, float& radius) const
+{
+    center = m_->boundsCenter;
+    radius = m_->boundsRadius;
+}
+
 bool FbxManager::IsMixamoModel() const
 {
     // Check if any bone name contains "mixamorig:" prefix
@@ -2516,46 +2388,57 @@ bool FbxManager::LoadExternalAnimation(const std::string& animFilePath, const st
         return false;
     }
     
-    // Create new importer for this animation
-    Impl::ExternalAnimation extAnim;
-    extAnim.importer = std::make_unique<Assimp::Importer>();
-    
-    // Load animation file with same flags as base model for coordinate system consistency
-    extAnim.scene = extAnim.importer->ReadFile(animFilePath,
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_ConvertToLeftHanded |  // CRITICAL: Must match base model loading
-        aiProcess_LimitBoneWeights);
-    
-    if (!extAnim.scene || !extAnim.scene->mAnimations || extAnim.scene->mNumAnimations == 0)
+    // Shared compiled clip (loaded once per process, keyed by path + skeleton node names)
+    auto clip = FbxClipLibrary::Get().AcquireFile(animFilePath, GetSkeletonNodeNames());
+    return AddExternalClip(std::move(clip), animName, animFilePath);
+}
+
+// Load multiple external animation files
+bool FbxManager::LoadExternalAnimations(const std::vector<std::string>& animFilePaths)
+{
+    if (!m_->hasSkinning)
     {
-        std::cerr << "[FbxManager] Failed to load animation from: " << animFilePath << std::endl;
+        std::cerr << "[FbxManager] Cannot load external animations: No skeleton in base model" << std::endl;
         return false;
     }
     
-    // Use first animation from the file
-    const aiAnimation* anim = extAnim.scene->mAnimations[0];
+    // Distinct files load in parallel on worker threads; results keep the input order
+    auto clips = FbxClipLibrary::Get().AcquireFiles(animFilePaths, GetSkeletonNodeNames());
     
-    // Set animation name
-    if (!animName.empty())
-    {
-        extAnim.name = animName;
-    }
-    else if (anim->mName.length > 0)
+    bool allSuccess = true;
+    
+    for (size_t i = 0; i < animFilePaths.size(); ++i)
     {
-        extAnim.name = anim->mName.C_Str();
+        std::string filename = std::filesystem::path(animFilePaths[i]).filename().replace_extension().string();
+
+        if (!AddExternalClip(std::move(clips[i]), filename, animFilePaths[i]))
+        {
+            allSuccess = false;
+        }
     }
-    else
+    
+    return allSuccess;
+}
+
+// Helper: Register a compiled external clip with this model
+bool FbxManager::AddExternalClip(std::shared_ptr<const FbxAnimClip> clip, const std::string& animName, const std::string& animFilePath)
+{
+    if (!clip)
     {
-        extAnim.name = "External_" + std::to_string(m_->externalAnimations.size());
+        std::cerr << "[FbxManager] Failed to load animation from: " << animFilePath << std::endl;
+        return false;
     }
     
-    // Store duration and ticks per second
-    extAnim.ticksPerSecond = (anim->mTicksPerSecond > 0.0) ? anim->mTicksPerSecond : 25.0;
-    extAnim.duration = anim->mDuration / extAnim.ticksPerSecond;
+    Impl::ExternalAnimation extAnim;
+    extAnim.name = !animName.empty() ? animName : clip->name;
+    extAnim.ticksPerSecond = clip->ticksPerSecond;
+    extAnim.duration = clip->durationSec;
     
     std::cout << "  Loaded: " << extAnim.name << " (duration: " << extAnim.duration << "s)" << std::endl;
     
+    m_->clips.push_back(std::move(clip));
+    BuildClipBinding(static_cast<int>(m_->clips.size()) - 1);
+    
     // Add to animation lists
     m_->animationNames.push_back(extAnim.name);
     m_->clipDurationSec.push_back(extAnim.duration);
@@ -2569,20 +2452,14 @@ bool FbxManager::LoadExternalAnimation(const std::string& animFilePath, const st
     return true;
 }
 
-// Load multiple external animation files
-bool FbxManager::LoadExternalAnimations(const std::vector<std::string>& animFilePaths)
+// Helper: Node names of the base skeleton (clip library key + track filter)
+std::vector<std::string> FbxManager::GetSkeletonNodeNames() const
 {
-    bool allSuccess = true;
-    
-    for (const auto& path : animFilePaths)
+    std::vector<std::string> names;
+    names.reserve(m_->skeleton.size());
+    for (const auto& node : m_->skeleton)
     {
-        std::string filename = std::filesystem::path(path).filename().replace_extension().string();
-
-        if (!LoadExternalAnimation(path, filename))
-        {
-            allSuccess = false;
-        }
+        names.push_back(node.name);
     }
-    
-    return allSuccess;
+    return names;
 }
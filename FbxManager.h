@@ -12,7 +12,13 @@
 struct aiScene;
 struct aiNode;
 struct aiMesh;
+struct FbxAnimClip;
+struct FbxAnimCompressionSettings;
+struct FbxMeshCacheContents;
+class FbxMeshCache;
+enum class FbxVertexFormat : uint8_t;
 class ZGraphics;
+class FbxPaletteArena;
 
 // Simple vertex structure with TBN (Tangent, Bitangent, Normal)
 struct VertexTBN
@@ -25,12 +31,68 @@ struct VertexTBN
     DirectX::XMFLOAT4 color;
 };
 
+// Simplified index range of a subset (same vertices and baseVertex, fewer triangles)
+struct FbxSubsetLod
+{
+    uint32_t startIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;          // geometric deviation from LOD 0 in model units (screen-space LOD selection)
+};
+
+constexpr uint32_t kFbxMaxSubsetLods = 3;   // LOD 1..3 (50% / 25% / 10% triangles)
+
 // Mesh subset for material-based rendering
 struct FbxSubset
 {
     uint32_t startIndex = 0;
     uint32_t indexCount = 0;
     uint32_t materialIndex = 0;
+    uint32_t baseVertex = 0;     // indices are subset-local (DrawIndexed BaseVertexLocation)
+    uint32_t lodCount = 0;       // simplified levels in lods (0: full detail only)
+    FbxSubsetLod lods[kFbxMaxSubsetLods];
+};
+
+// Material texture references as stored in the source file (diffuse/normal map paths)
+struct FbxMaterialInfo
+{
+    bool hasDiffuse = false;
+    std::string diffusePath;
+    bool hasNormalMap = false;
+    std::string normalMapPath;
+};
+
+// One texture slot of an import (diffuse / normal map / specular map)
+struct FbxTextureSlot
+{
+    std::vector<std::string> paths;   // per material (index = material index), empty entry = fallbackPath
+    std::string fallbackPath;         // every material without its own path
+    bool useEmbedded = true;          // texture referenced by the source file first, paths only when it is missing
+};
+
+// What a model needs from FbxManager::Load: texture slots and the Assimp post-process steps
+// (필요 없는 단계는 건너뛴다, 사용한 플래그는 .zmesh 키에 들어간다)
+struct FbxImportDescriptor
+{
+    FbxTextureSlot diffuse;
+    FbxTextureSlot normalMap;
+    FbxTextureSlot specularMap;
+    bool tangents = true;             // aiProcess_CalcTangentSpace (normal mapping; 없으면 고정 탄젠트)
+    bool skinning = true;             // aiProcess_LimitBoneWeights (GPU skinning, 4 influences)
+};
+
+// Per-stage timing of the last Load (milliseconds, 0 for stages that did not run)
+struct FbxImportStats
+{
+    bool fromMeshCache = false;
+    unsigned int postProcessFlags = 0;   // Assimp steps of the descriptor
+    double meshCacheMs = 0.0;            // .zmesh open + GPU buffers (warm path)
+    double assimpReadMs = 0.0;           // ReadFile including post-processing
+    double skeletonMs = 0.0;             // skeleton, bones, material references
+    double meshBuildMs = 0.0;            // vertex conversion, cache optimization, LODs, GPU buffers
+    double animationMs = 0.0;            // clip metadata and compilation
+    double meshCacheWriteMs = 0.0;
+    double materialsMs = 0.0;            // texture decode + upload
+    double totalMs = 0.0;
 };
 
 // Skeleton node
@@ -49,28 +111,45 @@ public:
     FbxManager();
     ~FbxManager();
 
-    // Load FBX/OBJ file using Assimp
-    bool Load(ZGraphics& gfx, const std::string& filePath, const std::string& defaultTexturePath = "");
-    bool Load(ZGraphics& gfx, const std::string& filePath, const std::vector<std::string>& defaultTexturePaths);
-    bool Load(ZGraphics& gfx, const std::string& filePath, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths);
-    bool Load(ZGraphics& gfx, const std::string& filePath, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths, const std::vector<std::string>& defaultSpecularMapPaths);
+    // Load FBX/OBJ file using Assimp (or its .zmesh cache), materials as described
+    bool Load(ZGraphics& gfx, const std::string& filePath, const FbxImportDescriptor& descriptor = FbxImportDescriptor{},
+              FbxImportStats* outStats = nullptr);
+    const FbxImportStats& GetImportStats() const;
     void Release();
 
+    // Headless animation rig (skeleton, bones, clips; no GPU resources)
+    bool LoadRig(const std::string& filePath);
+    void CopyRigFrom(const FbxManager& source);
+
+    // Headless cook: writes the .zmesh of filePath (vertex format as requested), no GPU resources.
+    // outUpToDate: the cache was already valid (content hash + settings), nothing was imported
+    bool CookModel(const std::string& filePath, bool& outUpToDate);
+
     // Queries
     bool HasMesh() const;
     ID3D11Buffer* GetVertexBuffer() const;
     ID3D11Buffer* GetIndexBuffer() const;
-    int GetIndexCount() const;
+    DXGI_FORMAT GetIndexFormat() const;   // R16_UINT when every subset fits 16-bit local indices
+    int GetIndexCount() const;            // whole index buffer (LOD 0 + simplified subset ranges)
     UINT GetVertexStride() const;
     UINT GetVertexOffset() const;
 
+    // Vertex format of the mesh buffers: request before Load (Packed needs <= 256 bones, otherwise Full)
+    void SetVertexFormat(FbxVertexFormat format);
+    FbxVertexFormat GetVertexFormat() const;
+
     const std::vector<FbxSubset>& GetSubsets() const;
     const std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>& GetMaterialSRVs() const;
     const std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>& GetNormalMapSRVs() const;
     const std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>& GetSpecularMapSRVs() const;
     
-    // Access to scene data
+    // Access to scene data (debug/opt-in)
+    // Load 후 Assimp 임포터/씬은 해제된다. 씬이 필요하면 Load 전에 SetKeepScene(true)을 호출하고,
+    // 다 쓴 뒤 ReleaseScene()으로 해제한다.
     const struct aiScene* GetScene() const;
+    void SetKeepScene(bool keep);
+    void ReleaseScene();
+    size_t GetEngineMemoryBytes() const;
 
     // Skeleton
     const std::vector<FbxSkeletonNode>& GetSkeleton() const;
@@ -98,14 +177,33 @@ public:
     bool LoadExternalAnimation(const std::string& animFilePath, const std::string& animName = "");
     bool LoadExternalAnimations(const std::vector<std::string>& animFilePaths);
     
-    // Update animation (call per frame)
+    // Update animation (call per frame) = AdvanceAnimation + EvaluateAnimation
     void UpdateAnimation(float deltaTime);
     
-    // Upload bone palette to GPU (call before rendering)
+    // Split update for FbxAnimBatch: time advance on the calling thread, evaluation may run on a worker.
+    // EvaluateAnimation touches only this instance's data; console logs must stay on the main thread
+    // (HasPendingAnimationLogs → evaluate serially).
+    // timeOffsetSec: evaluate ahead of the current time (LOD interpolation target)
+    // reducedBones: finger/face bones frozen to the bind pose (distant LOD)
+    void AdvanceAnimation(float deltaTime);
+    void EvaluateAnimation(double timeOffsetSec = 0.0, bool reducedBones = false);
+    bool HasPendingAnimationLogs() const;
+    void SetAnimationLogging(bool enabled);
+    
+    // Debug: heap allocations made by N simulated updates (-1 in release builds)
+    int CountUpdateAllocations(int updateCount, float deltaTime);
+    
+    // Pack the palette into the frame's 3x4 arena (ZGraphics::GetPaletteArena), once per frame
+    void PackBonePalette(FbxPaletteArena& arena);
+    
+    // Upload bone palette to GPU and bind the shared palette buffer to VS t0 (call before rendering)
     void UploadBonePaletteToGPU(ZGraphics& gfx);
     
-    // Get bone constant buffer for binding
+    // Get bone constant buffer for binding (b1: this instance's palette range)
     ID3D11Buffer* GetBoneConstantBuffer() const;
+    const std::vector<DirectX::XMMATRIX>& GetBonePalette() const;
+    std::vector<DirectX::XMMATRIX>& GetBonePalette();         // LOD policy writes interpolated palettes
+    void GetBindPoseBounds(DirectX::XMFLOAT3& center, float& radius) const;  // model space
     
     // Check if this is a Mixamo model (based on bone names)
     bool IsMixamoModel() const;
@@ -115,14 +213,24 @@ private:
     std::unique_ptr<Impl> m_;
 
     // Loading helpers
-    bool LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::string& defaultTexturePath);
-    bool LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::vector<std::string>& defaultTexturePaths);
-    bool LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths);
-    bool LoadMaterials(ZGraphics& gfx, const aiScene* scene, const std::string& baseDir, const std::vector<std::string>& defaultTexturePaths, const std::vector<std::string>& defaultNormalMapPaths, const std::vector<std::string>& defaultSpecularMapPaths);
+    bool LoadMaterials(ZGraphics& gfx, const std::vector<FbxMaterialInfo>& materials, const std::string& baseDir, const FbxImportDescriptor& descriptor);
+    bool ImportModel(ZGraphics& gfx, const std::string& filePath);
+    bool ImportScene(const std::string& filePath);
+    bool OpenMeshCache(FbxMeshCache& cache, const std::string& filePath, const FbxAnimCompressionSettings& clipSettings) const;
+    bool LoadFromMeshCache(ZGraphics& gfx, const FbxMeshCacheContents& contents);
+    bool IsMeshCacheUsable(const FbxMeshCacheContents& contents) const;
+    void LoadMeshCacheMetadata(const FbxMeshCacheContents& contents);
+    void WriteMeshCache(const FbxAnimCompressionSettings& clipSettings);
+    void CollectMaterialInfo(const aiScene* scene);
     bool BuildMeshBuffers(ZGraphics& gfx, const aiScene* scene);
+    void BuildMeshData(const aiScene* scene);
     void BuildSkeleton(const aiNode* node, int parentIndex);
     void CollectBones(const aiScene* scene);
     void InitAnimationMetadata(const aiScene* scene);
+    void BuildClipBinding(int clipIndex);
+    bool AddExternalClip(std::shared_ptr<const FbxAnimClip> clip, const std::string& animName, const std::string& animFilePath);
+    std::vector<std::string> GetSkeletonNodeNames() const;
+    void ReleaseImportedScene();
 
     std::string ExtractDirectory(const std::string& path);
 };
@@ -0,0 +1,788 @@
+﻿#include "FbxMeshCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr char kMagic[4] = { 'Z', 'M', 'S', 'H' };
+    constexpr char kClipMagic[4] = { 'Z', 'C', 'L', 'P' };
+    constexpr uint64_t kSectionAlignment = 16;
+
+    struct CacheHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t importFlags;
+        uint32_t vertexStride;
+        uint64_t sourceSize;
+        uint64_t sourceWriteTime;
+        uint64_t sourceHash;
+        float translationTolerance;
+        float rotationTolerance;
+        float scaleTolerance;
+        uint32_t indexStride;
+        uint64_t vertexOffset;
+        uint64_t vertexCount;
+        uint64_t indexOffset;
+        uint64_t indexCount;
+        uint64_t metaOffset;
+        uint64_t metaSize;
+        uint64_t fileSize;
+    };
+
+    struct ClipCacheHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t importFlags;
+        uint32_t reserved;
+        uint64_t sourceSize;
+        uint64_t sourceWriteTime;
+        uint64_t sourceHash;
+        uint64_t skeletonHash;
+        float translationTolerance;
+        float rotationTolerance;
+        float scaleTolerance;
+        uint32_t reserved2;
+        uint64_t metaSize;
+        uint64_t fileSize;
+    };
+
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Read-only mapping of a whole file
+    class MappedFile
+    {
+    public:
+        ~MappedFile() { Close(); }
+
+        bool Open(const std::string& path)
+        {
+            std::wstring widePath(path.begin(), path.end());
+            file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+
+            LARGE_INTEGER fileSize{};
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+                return false;
+            size = static_cast<uint64_t>(fileSize.QuadPart);
+
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping)
+                return false;
+
+            data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            return data != nullptr;
+        }
+
+        void Close()
+        {
+            if (data) UnmapViewOfFile(data);
+            if (mapping) CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+            data = nullptr;
+            mapping = nullptr;
+            file = INVALID_HANDLE_VALUE;
+            size = 0;
+        }
+
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+        const uint8_t* data = nullptr;
+        uint64_t size = 0;
+    };
+
+    // 64-bit content hash (8 bytes per step, FNV-style multiply + xor-shift finalizer)
+    uint64_t HashBytes(const uint8_t* data, uint64_t size)
+    {
+        uint64_t hash = 14695981039346656037ull ^ size;
+        uint64_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            hash = (hash ^ word) * 1099511628211ull;
+            hash ^= hash >> 29;
+        }
+        for (; i < size; ++i)
+        {
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    bool HashFile(const std::string& path, uint64_t& outHash)
+    {
+        MappedFile source;
+        if (!source.Open(path))
+            return false;
+        outHash = HashBytes(source.data, source.size);
+        return true;
+    }
+
+    bool QuerySourceStamp(const std::string& path, uint64_t& outSize, uint64_t& outWriteTime)
+    {
+        std::error_code ec;
+        const std::filesystem::path sourcePath(path);
+        outSize = static_cast<uint64_t>(std::filesystem::file_size(sourcePath, ec));
+        if (ec)
+            return false;
+        outWriteTime = static_cast<uint64_t>(std::filesystem::last_write_time(sourcePath, ec).time_since_epoch().count());
+        return !ec;
+    }
+
+    // Metadata section: PODs, length-prefixed strings and arrays
+    class MetaWriter
+    {
+    public:
+        template<typename T>
+        void Pod(const T& value)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        void String(const std::string& value)
+        {
+            Pod(static_cast<uint32_t>(value.size()));
+            data.insert(data.end(), value.begin(), value.end());
+        }
+
+        template<typename T>
+        void Array(const std::vector<T>& values)
+        {
+            Pod(static_cast<uint32_t>(values.size()));
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+            data.insert(data.end(), bytes, bytes + values.size() * sizeof(T));
+        }
+
+        void Strings(const std::vector<std::string>& values)
+        {
+            Pod(static_cast<uint32_t>(values.size()));
+            for (const std::string& value : values)
+            {
+                String(value);
+            }
+        }
+
+        std::vector<uint8_t> data;
+    };
+
+    // Bounds-checked reader: any overrun marks the cache corrupt
+    class MetaReader
+    {
+    public:
+        MetaReader(const uint8_t* begin, uint64_t size) : cursor(begin), end(begin + size) {}
+
+        template<typename T>
+        bool Pod(T& value)
+        {
+            if (static_cast<uint64_t>(end - cursor) < sizeof(T))
+                return false;
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return true;
+        }
+
+        bool String(std::string& value)
+        {
+            uint32_t length = 0;
+            if (!Pod(length) || static_cast<uint64_t>(end - cursor) < length)
+                return false;
+            value.assign(reinterpret_cast<const char*>(cursor), length);
+            cursor += length;
+            return true;
+        }
+
+        template<typename T>
+        bool Array(std::vector<T>& values)
+        {
+            uint32_t count = 0;
+            if (!Pod(count) || static_cast<uint64_t>(end - cursor) < static_cast<uint64_t>(count) * sizeof(T))
+                return false;
+            values.resize(count);
+            std::memcpy(values.data(), cursor, static_cast<size_t>(count) * sizeof(T));
+            cursor += static_cast<size_t>(count) * sizeof(T);
+            return true;
+        }
+
+        bool Strings(std::vector<std::string>& values)
+        {
+            uint32_t count = 0;
+            if (!Pod(count) || static_cast<uint64_t>(end - cursor) < count)
+                return false;
+            values.resize(count);
+            for (std::string& value : values)
+            {
+                if (!String(value))
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        const uint8_t* cursor;
+        const uint8_t* end;
+    };
+
+    void WriteClip(MetaWriter& writer, const FbxAnimClip& clip)
+    {
+        writer.String(clip.name);
+        writer.Pod(clip.durationSec);
+        writer.Pod(clip.ticksPerSecond);
+        writer.Pod(clip.sampleRate);
+        writer.Pod(clip.frameCount);
+        writer.Strings(clip.trackNodeNames);
+        writer.Array(clip.tracks);
+        writer.Array(clip.keyFrames);
+        writer.Array(clip.keyData);
+        writer.Strings(clip.restNodeNames);
+        writer.Array(clip.restNodeLocals);
+        writer.Array(clip.restNodeParents);
+    }
+
+    // 채널 키 구간: 범위 안, 첫 키는 프레임 0, 프레임은 순증가, 키가 둘 이상이면 마지막 키는 마지막 프레임
+    // (FindKeySegment가 frames[k1] - frames[k0]로 나누므로 같은 프레임이 반복되면 inf/NaN 포즈가 된다)
+    bool KeyRangeValid(const FbxAnimClip& clip, uint32_t firstKey, uint16_t keyCount)
+    {
+        const size_t totalKeys = clip.keyFrames.size();
+        if (keyCount == 0 || firstKey > totalKeys || keyCount > totalKeys - firstKey)
+            return false;
+
+        const uint16_t* frames = clip.keyFrames.data() + firstKey;
+        if (frames[0] != 0)
+            return false;
+        for (uint32_t k = 1; k < keyCount; ++k)
+        {
+            if (frames[k] <= frames[k - 1])
+                return false;
+        }
+        return keyCount == 1 || frames[keyCount - 1] + 1u == clip.frameCount;
+    }
+
+    // 샘플러/휴지 계층 패스가 그대로 인덱싱하는 범위 검사 (손상된 캐시가 범위 밖을 읽지 않도록)
+    bool ClipRangesValid(const FbxAnimClip& clip)
+    {
+        const size_t keyCount = clip.keyFrames.size();
+        if (clip.tracks.size() != clip.trackNodeNames.size() ||
+            clip.keyData.size() != keyCount * 3)
+            return false;
+
+        for (const FbxAnimTrack& track : clip.tracks)
+        {
+            if (!KeyRangeValid(clip, track.posFirstKey, track.posKeyCount) ||
+                !KeyRangeValid(clip, track.rotFirstKey, track.rotKeyCount) ||
+                !KeyRangeValid(clip, track.sclFirstKey, track.sclKeyCount))
+                return false;
+        }
+
+        const size_t restCount = clip.restNodeNames.size();
+        if (clip.restNodeLocals.size() != restCount || clip.restNodeParents.size() != restCount)
+            return false;
+        for (size_t n = 0; n < restCount; ++n)
+        {
+            const int parent = clip.restNodeParents[n];
+            if (parent < -1 || parent >= static_cast<int>(n))   // preorder: parent before child
+                return false;
+        }
+        return true;
+    }
+
+    // Index range inside the index section, every (subset-local) index inside the subset's vertex range
+    bool SubsetRangeValid(uint32_t startIndex, uint32_t indexCount, uint64_t totalIndices,
+                          const void* indexData, uint32_t indexStride, uint64_t subsetVertexCount)
+    {
+        if (startIndex > totalIndices || indexCount > totalIndices - startIndex)
+            return false;
+
+        uint32_t maxIndex = 0;
+        if (indexStride == sizeof(uint16_t))
+        {
+            const uint16_t* indices = static_cast<const uint16_t*>(indexData) + startIndex;
+            for (uint32_t i = 0; i < indexCount; ++i)
+                maxIndex = (std::max)(maxIndex, static_cast<uint32_t>(indices[i]));
+        }
+        else
+        {
+            const uint32_t* indices = static_cast<const uint32_t*>(indexData) + startIndex;
+            for (uint32_t i = 0; i < indexCount; ++i)
+                maxIndex = (std::max)(maxIndex, indices[i]);
+        }
+        return indexCount == 0 || maxIndex < subsetVertexCount;
+    }
+
+    // Subset (and LOD) index ranges against the index section, index values against the subset's vertices
+    // 서브셋 정점 구간: baseVertex부터 다음으로 큰 baseVertex(없으면 정점 끝)까지
+    bool SubsetsValid(const std::vector<FbxSubset>& subsets, const void* indexData, uint32_t indexStride,
+                      uint64_t indexCount, uint64_t vertexCount)
+    {
+        std::vector<uint64_t> vertexStarts;
+        vertexStarts.reserve(subsets.size());
+        for (const FbxSubset& subset : subsets)
+        {
+            if (subset.baseVertex > vertexCount || subset.lodCount > kFbxMaxSubsetLods)
+                return false;
+            vertexStarts.push_back(subset.baseVertex);
+        }
+        std::sort(vertexStarts.begin(), vertexStarts.end());
+
+        for (const FbxSubset& subset : subsets)
+        {
+            const auto next = std::upper_bound(vertexStarts.begin(), vertexStarts.end(), static_cast<uint64_t>(subset.baseVertex));
+            const uint64_t subsetVertexCount = ((next != vertexStarts.end()) ? *next : vertexCount) - subset.baseVertex;
+
+            if (!SubsetRangeValid(subset.startIndex, subset.indexCount, indexCount, indexData, indexStride, subsetVertexCount))
+                return false;
+            for (uint32_t lod = 0; lod < subset.lodCount; ++lod)
+            {
+                if (!SubsetRangeValid(subset.lods[lod].startIndex, subset.lods[lod].indexCount, indexCount,
+                                      indexData, indexStride, subsetVertexCount))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool ReadClip(MetaReader& reader, FbxAnimClip& clip)
+    {
+        return reader.String(clip.name) &&
+               reader.Pod(clip.durationSec) &&
+               reader.Pod(clip.ticksPerSecond) &&
+               reader.Pod(clip.sampleRate) &&
+               reader.Pod(clip.frameCount) &&
+               reader.Strings(clip.trackNodeNames) &&
+               reader.Array(clip.tracks) &&
+               reader.Array(clip.keyFrames) &&
+               reader.Array(clip.keyData) &&
+               reader.Strings(clip.restNodeNames) &&
+               reader.Array(clip.restNodeLocals) &&
+               reader.Array(clip.restNodeParents) &&
+               ClipRangesValid(clip);
+    }
+
+    void WriteMeta(MetaWriter& writer, const FbxMeshCacheContents& contents)
+    {
+        writer.Array(contents.subsets);
+        writer.Pod(contents.boundsCenter);
+        writer.Pod(contents.boundsRadius);
+        writer.Pod(contents.rootTransform);
+
+        writer.Pod(static_cast<uint32_t>(contents.skeleton.size()));
+        for (const FbxSkeletonNode& node : contents.skeleton)
+        {
+            writer.String(node.name);
+            writer.Pod(static_cast<int32_t>(node.parent));
+            writer.Pod(static_cast<uint8_t>(node.isBone ? 1 : 0));
+        }
+        writer.Array(contents.restLocalOfNode);
+
+        writer.Strings(contents.boneNames);
+        writer.Array(contents.boneOffsets);
+
+        writer.Pod(static_cast<uint32_t>(contents.materials.size()));
+        for (const FbxMaterialInfo& material : contents.materials)
+        {
+            writer.Pod(static_cast<uint8_t>(material.hasDiffuse ? 1 : 0));
+            writer.String(material.diffusePath);
+            writer.Pod(static_cast<uint8_t>(material.hasNormalMap ? 1 : 0));
+            writer.String(material.normalMapPath);
+        }
+
+        writer.Pod(static_cast<uint32_t>(contents.animations.size()));
+        for (const FbxMeshCacheContents::Animation& animation : contents.animations)
+        {
+            writer.String(animation.name);
+            writer.Pod(animation.durationSec);
+            writer.Pod(animation.ticksPerSecond);
+            WriteClip(writer, *animation.clip);
+        }
+    }
+
+    bool ReadMeta(MetaReader& reader, FbxMeshCacheContents& contents)
+    {
+        if (!reader.Array(contents.subsets) ||
+            !reader.Pod(contents.boundsCenter) ||
+            !reader.Pod(contents.boundsRadius) ||
+            !reader.Pod(contents.rootTransform))
+            return false;
+
+        uint32_t nodeCount = 0;
+        if (!reader.Pod(nodeCount))
+            return false;
+        contents.skeleton.resize(nodeCount);
+        for (uint32_t i = 0; i < nodeCount; ++i)
+        {
+            FbxSkeletonNode& node = contents.skeleton[i];
+            int32_t parent = -1;
+            uint8_t isBone = 0;
+            if (!reader.String(node.name) || !reader.Pod(parent) || !reader.Pod(isBone))
+                return false;
+            if (parent >= static_cast<int32_t>(i))   // preorder: parent before child
+                return false;
+            node.parent = parent;
+            node.isBone = (isBone != 0);
+            if (parent >= 0)
+                contents.skeleton[parent].children.push_back(static_cast<int>(i));
+        }
+        if (!reader.Array(contents.restLocalOfNode) || contents.restLocalOfNode.size() != nodeCount)
+            return false;
+
+        if (!reader.Strings(contents.boneNames) || !reader.Array(contents.boneOffsets) ||
+            contents.boneNames.size() != contents.boneOffsets.size())
+            return false;
+
+        uint32_t materialCount = 0;
+        if (!reader.Pod(materialCount))
+            return false;
+        contents.materials.resize(materialCount);
+        for (FbxMaterialInfo& material : contents.materials)
+        {
+            uint8_t hasDiffuse = 0;
+            uint8_t hasNormalMap = 0;
+            if (!reader.Pod(hasDiffuse) || !reader.String(material.diffusePath) ||
+                !reader.Pod(hasNormalMap) || !reader.String(material.normalMapPath))
+                return false;
+            material.hasDiffuse = (hasDiffuse != 0);
+            material.hasNormalMap = (hasNormalMap != 0);
+        }
+
+        uint32_t animationCount = 0;
+        if (!reader.Pod(animationCount))
+            return false;
+        contents.animations.resize(animationCount);
+        for (FbxMeshCacheContents::Animation& animation : contents.animations)
+        {
+            auto clip = std::make_shared<FbxAnimClip>();
+            if (!reader.String(animation.name) || !reader.Pod(animation.durationSec) ||
+                !reader.Pod(animation.ticksPerSecond) || !ReadClip(reader, *clip))
+                return false;
+            animation.clip = std::move(clip);
+        }
+        return true;
+    }
+}
+
+FbxMeshCache::~FbxMeshCache()
+{
+    Close();
+}
+
+std::string FbxMeshCache::GetCachePath(const std::string& sourcePath)
+{
+    return sourcePath + ".zmesh";
+}
+
+std::string FbxMeshCache::GetClipCachePath(const std::string& sourcePath)
+{
+    return sourcePath + ".zclip";
+}
+
+bool FbxMeshCache::WriteFileAtomically(const std::string& path, const void* data, size_t size)
+{
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!out)
+        {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool FbxMeshCache::StampSource(const std::string& sourcePath, SourceStamp& outStamp)
+{
+    return QuerySourceStamp(sourcePath, outStamp.size, outStamp.writeTime) && HashFile(sourcePath, outStamp.hash);
+}
+
+bool FbxMeshCache::MatchesSource(const std::string& sourcePath, const SourceStamp& stamp)
+{
+    uint64_t sourceSize = 0;
+    uint64_t sourceWriteTime = 0;
+    if (!QuerySourceStamp(sourcePath, sourceSize, sourceWriteTime) || sourceSize != stamp.size)
+        return false;
+    if (sourceWriteTime == stamp.writeTime)
+        return true;
+
+    uint64_t sourceHash = 0;
+    return HashFile(sourcePath, sourceHash) && sourceHash == stamp.hash;
+}
+
+void FbxMeshCache::Close()
+{
+    if (view_) UnmapViewOfFile(view_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+    view_ = nullptr;
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+    viewSize_ = 0;
+    contents_ = FbxMeshCacheContents{};
+}
+
+bool FbxMeshCache::Open(const std::string& sourcePath, uint32_t importFlags, uint32_t vertexStride,
+                        const FbxAnimCompressionSettings& settings)
+{
+    Close();
+    auto startTime = std::chrono::high_resolution_clock::now();
+    const std::string cachePath = GetCachePath(sourcePath);
+
+    MappedFile cacheFile;
+    if (!cacheFile.Open(cachePath))
+        return false;  // no cache yet
+
+    CacheHeader header{};
+    if (cacheFile.size < sizeof(CacheHeader))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Ignoring truncated cache: " << cachePath << std::endl;
+        return false;
+    }
+    std::memcpy(&header, cacheFile.data, sizeof(CacheHeader));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.fileSize != cacheFile.size)
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Ignoring cache (format/version " << header.version << "): " << cachePath << std::endl;
+        return false;
+    }
+    if (header.importFlags != importFlags || header.vertexStride != vertexStride ||
+        header.translationTolerance != settings.translationTolerance ||
+        header.rotationTolerance != settings.rotationTolerance ||
+        header.scaleTolerance != settings.scaleTolerance)
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Cache built with different import settings, rebuilding: " << cachePath << std::endl;
+        return false;
+    }
+
+    // Source identity: size + write time, content hash if the stamp changed
+    if (!MatchesSource(sourcePath, SourceStamp{ header.sourceSize, header.sourceWriteTime, header.sourceHash }))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Source changed, rebuilding: " << cachePath << std::endl;
+        return false;
+    }
+
+    // Section bounds (all offsets/sizes are bounded by the file size before adding)
+    const uint64_t vertexBytes = (std::min)(header.vertexCount, static_cast<uint64_t>(UINT32_MAX)) * vertexStride;
+    const uint64_t indexBytes = (std::min)(header.indexCount, static_cast<uint64_t>(UINT32_MAX)) * header.indexStride;
+    if (header.vertexCount > UINT32_MAX || header.indexCount > UINT32_MAX ||
+        (header.indexStride != sizeof(uint16_t) && header.indexStride != sizeof(uint32_t)) ||
+        header.vertexOffset % kSectionAlignment != 0 || header.indexOffset % kSectionAlignment != 0 ||
+        header.vertexOffset > cacheFile.size || vertexBytes > cacheFile.size - header.vertexOffset ||
+        header.indexOffset > cacheFile.size || indexBytes > cacheFile.size - header.indexOffset ||
+        header.metaOffset > cacheFile.size || header.metaSize > cacheFile.size - header.metaOffset)
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Ignoring corrupt cache: " << cachePath << std::endl;
+        return false;
+    }
+
+    MetaReader reader(cacheFile.data + header.metaOffset, header.metaSize);
+    if (!ReadMeta(reader, contents_) ||
+        !SubsetsValid(contents_.subsets, cacheFile.data + header.indexOffset, header.indexStride, header.indexCount, header.vertexCount))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Ignoring corrupt cache: " << cachePath << std::endl;
+        contents_ = FbxMeshCacheContents{};
+        return false;
+    }
+
+    // Keep the mapping: vertex/index pointers go straight to buffer creation
+    contents_.vertexData = cacheFile.data + header.vertexOffset;
+    contents_.vertexStride = vertexStride;
+    contents_.vertexCount = static_cast<uint32_t>(header.vertexCount);
+    contents_.indexData = cacheFile.data + header.indexOffset;
+    contents_.indexStride = header.indexStride;
+    contents_.indexCount = static_cast<uint32_t>(header.indexCount);
+
+    file_ = cacheFile.file;
+    mapping_ = cacheFile.mapping;
+    view_ = cacheFile.data;
+    viewSize_ = cacheFile.size;
+    cacheFile.file = INVALID_HANDLE_VALUE;
+    cacheFile.mapping = nullptr;
+    cacheFile.data = nullptr;
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    FbxAnim::Log() << "[FbxMeshCache] Mapped " << cachePath << " (" << viewSize_ / 1024 << " KB, "
+              << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms)" << std::endl;
+    return true;
+}
+
+bool FbxMeshCache::Write(const std::string& sourcePath, uint32_t importFlags,
+                         const FbxAnimCompressionSettings& settings, const FbxMeshCacheContents& contents)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    const std::string cachePath = GetCachePath(sourcePath);
+
+    for (const FbxMeshCacheContents::Animation& animation : contents.animations)
+    {
+        if (!animation.clip)
+        {
+            FbxAnim::Log() << "[FbxMeshCache] Not caching " << sourcePath << " (clip '" << animation.name << "' failed to compile)" << std::endl;
+            return false;
+        }
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.importFlags = importFlags;
+    header.vertexStride = contents.vertexStride;
+    header.translationTolerance = settings.translationTolerance;
+    header.rotationTolerance = settings.rotationTolerance;
+    header.scaleTolerance = settings.scaleTolerance;
+    header.indexStride = contents.indexStride;
+    SourceStamp stamp;
+    if (!StampSource(sourcePath, stamp))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Cannot read source for hashing: " << sourcePath << std::endl;
+        return false;
+    }
+    header.sourceSize = stamp.size;
+    header.sourceWriteTime = stamp.writeTime;
+    header.sourceHash = stamp.hash;
+
+    MetaWriter meta;
+    WriteMeta(meta, contents);
+
+    const uint64_t vertexBytes = static_cast<uint64_t>(contents.vertexCount) * contents.vertexStride;
+    const uint64_t indexBytes = static_cast<uint64_t>(contents.indexCount) * contents.indexStride;
+    header.vertexOffset = AlignUp(sizeof(CacheHeader), kSectionAlignment);
+    header.vertexCount = contents.vertexCount;
+    header.indexOffset = AlignUp(header.vertexOffset + vertexBytes, kSectionAlignment);
+    header.indexCount = contents.indexCount;
+    header.metaOffset = AlignUp(header.indexOffset + indexBytes, kSectionAlignment);
+    header.metaSize = meta.data.size();
+    header.fileSize = header.metaOffset + header.metaSize;
+
+    // 섹션 사이 패딩은 0으로 남긴다.
+    std::vector<uint8_t> file(static_cast<size_t>(header.fileSize));
+    std::memcpy(file.data(), &header, sizeof(CacheHeader));
+    if (vertexBytes > 0)
+        std::memcpy(file.data() + header.vertexOffset, contents.vertexData, static_cast<size_t>(vertexBytes));
+    if (indexBytes > 0)
+        std::memcpy(file.data() + header.indexOffset, contents.indexData, static_cast<size_t>(indexBytes));
+    if (!meta.data.empty())
+        std::memcpy(file.data() + header.metaOffset, meta.data.data(), meta.data.size());
+    if (!WriteFileAtomically(cachePath, file.data(), file.size()))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Cannot write " << cachePath << std::endl;
+        return false;
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    FbxAnim::Log() << "[FbxMeshCache] Wrote " << cachePath << " (" << header.fileSize / 1024 << " KB, "
+              << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms)" << std::endl;
+    return true;
+}
+
+std::shared_ptr<FbxAnimClip> FbxMeshCache::ReadClipFile(const std::string& sourcePath, uint32_t importFlags, uint64_t skeletonHash,
+                                                        const FbxAnimCompressionSettings& settings)
+{
+    const std::string cachePath = GetClipCachePath(sourcePath);
+
+    MappedFile cacheFile;
+    if (!cacheFile.Open(cachePath))
+        return nullptr;  // not cooked yet
+
+    ClipCacheHeader header{};
+    if (cacheFile.size < sizeof(ClipCacheHeader))
+        return nullptr;
+    std::memcpy(&header, cacheFile.data, sizeof(ClipCacheHeader));
+
+    if (std::memcmp(header.magic, kClipMagic, sizeof(kClipMagic)) != 0 || header.version != kClipVersion ||
+        header.fileSize != cacheFile.size || header.metaSize != cacheFile.size - sizeof(ClipCacheHeader))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Ignoring clip cache (format/version " << header.version << "): " << cachePath << std::endl;
+        return nullptr;
+    }
+    if (header.importFlags != importFlags || header.skeletonHash != skeletonHash ||
+        header.translationTolerance != settings.translationTolerance ||
+        header.rotationTolerance != settings.rotationTolerance ||
+        header.scaleTolerance != settings.scaleTolerance)
+    {
+        return nullptr;  // 다른 스켈레톤/설정용 (같은 애니메이션 파일을 여러 모델이 쓸 수 있다)
+    }
+    if (!MatchesSource(sourcePath, SourceStamp{ header.sourceSize, header.sourceWriteTime, header.sourceHash }))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Source changed, recompiling clip: " << cachePath << std::endl;
+        return nullptr;
+    }
+
+    auto clip = std::make_shared<FbxAnimClip>();
+    MetaReader reader(cacheFile.data + sizeof(ClipCacheHeader), header.metaSize);
+    if (!ReadClip(reader, *clip))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Ignoring corrupt clip cache: " << cachePath << std::endl;
+        return nullptr;
+    }
+    return clip;
+}
+
+bool FbxMeshCache::WriteClipFile(const std::string& sourcePath, uint32_t importFlags, uint64_t skeletonHash,
+                                 const FbxAnimCompressionSettings& settings, const FbxAnimClip& clip)
+{
+    const std::string cachePath = GetClipCachePath(sourcePath);
+
+    ClipCacheHeader header{};
+    std::memcpy(header.magic, kClipMagic, sizeof(kClipMagic));
+    header.version = kClipVersion;
+    header.importFlags = importFlags;
+    header.skeletonHash = skeletonHash;
+    header.translationTolerance = settings.translationTolerance;
+    header.rotationTolerance = settings.rotationTolerance;
+    header.scaleTolerance = settings.scaleTolerance;
+
+    SourceStamp stamp;
+    if (!StampSource(sourcePath, stamp))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Cannot read source for hashing: " << sourcePath << std::endl;
+        return false;
+    }
+    header.sourceSize = stamp.size;
+    header.sourceWriteTime = stamp.writeTime;
+    header.sourceHash = stamp.hash;
+
+    MetaWriter meta;
+    WriteClip(meta, clip);
+    header.metaSize = meta.data.size();
+    header.fileSize = sizeof(ClipCacheHeader) + header.metaSize;
+
+    std::vector<uint8_t> file(sizeof(ClipCacheHeader));
+    std::memcpy(file.data(), &header, sizeof(ClipCacheHeader));
+    file.insert(file.end(), meta.data.begin(), meta.data.end());
+    if (!WriteFileAtomically(cachePath, file.data(), file.size()))
+    {
+        FbxAnim::Log() << "[FbxMeshCache] Cannot write " << cachePath << std::endl;
+        return false;
+    }
+
+    FbxAnim::Log() << "[FbxMeshCache] Wrote " << cachePath << " (" << header.fileSize / 1024 << " KB)" << std::endl;
+    return true;
+}
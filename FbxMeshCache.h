@@ -0,0 +1,107 @@
+﻿#pragma once
+
+#include "FbxAnimation.h"
+#include "FbxManager.h"
+#include <DirectXMath.h>
+#include <Windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Engine data of one imported model (everything Load builds from the aiScene)
+// Write: 콜드 로드가 만든 결과를 채워서 넘긴다 (정점/인덱스는 포인터만 빌린다).
+// Open: 정점/인덱스 포인터는 매핑된 파일 안을 가리킨다 → FbxMeshCache가 살아 있는 동안만 유효.
+struct FbxMeshCacheContents
+{
+    // Mesh
+    const void* vertexData = nullptr;
+    uint32_t vertexStride = 0;
+    uint32_t vertexCount = 0;
+    const void* indexData = nullptr;
+    uint32_t indexStride = sizeof(uint32_t);              // 2 (R16_UINT) or 4 (R32_UINT), subset-local indices
+    uint32_t indexCount = 0;
+    std::vector<FbxSubset> subsets;
+    DirectX::XMFLOAT3 boundsCenter = { 0.0f, 0.0f, 0.0f };
+    float boundsRadius = 0.0f;
+
+    // Skeleton (preorder, children rebuilt from parent on read)
+    DirectX::XMFLOAT4X4 rootTransform;                    // aiNode::mTransformation of the root (Assimp layout)
+    std::vector<FbxSkeletonNode> skeleton;
+    std::vector<DirectX::XMFLOAT4X4> restLocalOfNode;
+
+    // Bones
+    std::vector<std::string> boneNames;
+    std::vector<DirectX::XMFLOAT4X4> boneOffsets;
+
+    // Materials (texture references only; textures are loaded from their own files)
+    std::vector<FbxMaterialInfo> materials;
+
+    // Embedded animations (compiled clips)
+    struct Animation
+    {
+        std::string name;
+        double durationSec = 0.0;
+        double ticksPerSecond = 25.0;
+        std::shared_ptr<const FbxAnimClip> clip;
+    };
+    std::vector<Animation> animations;
+};
+
+// Versioned on-disk cache of an imported model: "<source>.zmesh" next to the source file
+// 키: 원본 파일 해시 + Assimp 임포트 플래그 + 정점 stride + 클립 압축 설정.
+// 원본의 크기/수정 시각이 같으면 저장된 해시를 믿고, 다르면 원본을 다시 해시해서 비교한다.
+// 웜 로드는 파일을 메모리 매핑하고, 정점/인덱스 구간을 그대로 버퍼 생성에 넘긴다.
+class FbxMeshCache
+{
+public:
+    static constexpr uint32_t kVersion = 5;   // 5: per-subset LOD index ranges after the base indices
+    static constexpr uint32_t kClipVersion = 1;
+
+    // Source identity of a cooked file (size + write time, content hash)
+    struct SourceStamp
+    {
+        uint64_t size = 0;
+        uint64_t writeTime = 0;
+        uint64_t hash = 0;
+    };
+    static bool StampSource(const std::string& sourcePath, SourceStamp& outStamp);
+    // 크기/수정 시각이 같으면 해시를 다시 계산하지 않는다
+    static bool MatchesSource(const std::string& sourcePath, const SourceStamp& stamp);
+
+    // Temp file + rename: readers never see a partially written file
+    static bool WriteFileAtomically(const std::string& path, const void* data, size_t size);
+
+    FbxMeshCache() = default;
+    ~FbxMeshCache();
+    FbxMeshCache(const FbxMeshCache&) = delete;
+    FbxMeshCache& operator=(const FbxMeshCache&) = delete;
+
+    static std::string GetCachePath(const std::string& sourcePath);
+
+    // Maps and validates the cache of sourcePath; false if missing, stale or corrupt
+    bool Open(const std::string& sourcePath, uint32_t importFlags, uint32_t vertexStride,
+              const FbxAnimCompressionSettings& settings);
+    const FbxMeshCacheContents& GetContents() const { return contents_; }
+    void Close();
+
+    // Writes the cache of sourcePath (temp file + rename, never leaves a partial cache behind)
+    static bool Write(const std::string& sourcePath, uint32_t importFlags,
+                      const FbxAnimCompressionSettings& settings, const FbxMeshCacheContents& contents);
+
+    // Compiled clip of an animation file: "<source>.zclip"
+    // 키에 스켈레톤 노드 이름 집합의 해시가 들어간다 (트랙은 그 스켈레톤에 맞춰 걸러져 있다).
+    static std::string GetClipCachePath(const std::string& sourcePath);
+    static std::shared_ptr<FbxAnimClip> ReadClipFile(const std::string& sourcePath, uint32_t importFlags, uint64_t skeletonHash,
+                                                     const FbxAnimCompressionSettings& settings);
+    static bool WriteClipFile(const std::string& sourcePath, uint32_t importFlags, uint64_t skeletonHash,
+                              const FbxAnimCompressionSettings& settings, const FbxAnimClip& clip);
+
+private:
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+    const uint8_t* view_ = nullptr;
+    uint64_t viewSize_ = 0;
+    FbxMeshCacheContents contents_;
+};
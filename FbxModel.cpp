@@ -1,11 +1,19 @@
 ﻿#include <memory>
 #include <iostream>
+#include <cassert>
+#include <cfloat>
+#include <algorithm>
 #include <DirectXMath.h>
 #include "imgui/imgui.h"
 
 #include "FbxManager.h"
+#include "FbxAnimationLod.h"
+#include "FbxPackedVertex.h"
+#include "FbxPaletteArena.h"
+#include "ZThreadPool.h"
 #include "ZRasterizer.h"
 #include "ZGraphics.h"
+#include "ZConstantRing.h"
 #include "ZBindableBase.h"
 #include "FbxModel.h"
 
@@ -13,6 +21,15 @@
 using namespace Bind;
 using namespace DirectX;
 
+namespace
+{
+    // Static variant of a vertex format (all FbxModels of a format share one VS + input layout)
+    size_t VertexFormatVariant(FbxVertexFormat format)
+    {
+        return format == FbxVertexFormat::Packed ? 1u : 0u;
+    }
+}
+
 FbxModel::FbxModel(
     ZGraphics& gfx, 
     const std::string& filePath, 
@@ -25,29 +42,19 @@ FbxModel::FbxModel(
 {
     // Create FbxManager and load model with multiple textures and normal maps
     fbxManager_ = std::make_unique<FbxManager>();
+    fbxManager_->SetVertexFormat(FbxVertexFormat::Packed);   // 104 → 32 bytes/vertex (뼈 256개 초과 시 전체 형식)
     
-    // Choose appropriate Load function based on whether normal maps and specular maps are provided
-    bool loadSuccess = false;
-    if (!defaultSpecularMapPaths.empty())
-    {
-        std::cout << "[FbxModel] Loading with normal maps and specular maps..." << std::endl;
-        loadSuccess = fbxManager_->Load(gfx, filePath, defaultTexturePaths, defaultNormalMapPaths, defaultSpecularMapPaths);
-    }
-    else if (!defaultNormalMapPaths.empty())
-    {
-        std::cout << "[FbxModel] Loading with normal maps..." << std::endl;
-        loadSuccess = fbxManager_->Load(gfx, filePath, defaultTexturePaths, defaultNormalMapPaths);
-    }
-    else if (!defaultTexturePaths.empty())
-    {
-        std::cout << "[FbxModel] Loading with multiple textures..." << std::endl;
-        loadSuccess = fbxManager_->Load(gfx, filePath, defaultTexturePaths);
-    }
-    else
-    {
-        std::cout << "[FbxModel] Loading with default texture..." << std::endl;
-        loadSuccess = fbxManager_->Load(gfx, filePath);
-    }
+    // Texture slots: the file's own references first, the given paths fill in
+    // (스페큘러 맵까지 지정하면 전체 텍스처 세트로 보고 파일의 참조를 쓰지 않는다)
+    FbxImportDescriptor descriptor;
+    descriptor.diffuse.paths = defaultTexturePaths;
+    descriptor.normalMap.paths = defaultNormalMapPaths;
+    descriptor.specularMap.paths = defaultSpecularMapPaths;
+    const bool useEmbedded = defaultSpecularMapPaths.empty();
+    descriptor.diffuse.useEmbedded = useEmbedded;
+    descriptor.normalMap.useEmbedded = useEmbedded;
+
+    const bool loadSuccess = fbxManager_->Load(gfx, filePath, descriptor);
     
     if (!loadSuccess)
     {
@@ -85,28 +92,51 @@ FbxModel::FbxModel(
             std::cout << "  Subsets: " << fbxManager_->GetSubsets().size() << std::endl;
         }
 
-        // SkinnedVS shader
-        auto pvs = std::make_unique<ZVertexShader>(gfx, L"./x64/Debug/SkinnedModelVS.cso");
-        auto pvsbc = pvs->GetBytecode();
-        AddStaticBind(std::move(pvs));
-
         // SkinnedPS shader
         std::cout << "[FbxModel] Using SkinnedPS_NormalMap shader" << std::endl;
         AddStaticBind(std::make_unique<ZPixelShader>(gfx, L"./x64/Debug/SkinnedModelPS.cso"));
 
-        // Input Layout (Skinned vertex format matching VertexInSkinned in SkinnedModelVS.hlsl)
+        AddStaticBind(std::make_unique<ZTopology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST));
+        AddStaticBind(std::make_unique<ZSampler>(gfx));
+
+        std::cout << "[FbxModel] Static bindables initialized" << std::endl;
+    }
+
+    // Vertex shader + input layout of this model's vertex format
+    const size_t variant = VertexFormatVariant(fbxManager_->GetVertexFormat());
+    if (!IsStaticVariantInitialized(variant))
+    {
+        const bool packed = (fbxManager_->GetVertexFormat() == FbxVertexFormat::Packed);
+        auto pvs = std::make_unique<ZVertexShader>(gfx, packed ? L"./x64/Debug/SkinnedModelPackedVS.cso"
+                                                               : L"./x64/Debug/SkinnedModelVS.cso");
+        auto pvsbc = pvs->GetBytecode();
+        AddStaticVariantBind(variant, std::move(pvs));
+
+        // Input Layout (matching VertexInSkinned / VertexInPacked)
         using Dvtx::VertexLayout;
         Dvtx::VertexLayout layout;
-        layout.Append(VertexLayout::Position3D);
-        layout.Append(VertexLayout::Normal);
-        layout.Append(VertexLayout::Tangent);
-        layout.Append(VertexLayout::Bitangent);
-        layout.Append(VertexLayout::Texture2D);
-        layout.Append(VertexLayout::Float4Color);
-        layout.Append(VertexLayout::UInt4);
-        layout.Append(VertexLayout::Float4);
-
-        std::cout << "[FbxModel] Input Layout (Skinned):" << std::endl;
+        if (packed)
+        {
+            layout.Append(VertexLayout::Position3D);
+            layout.Append(VertexLayout::PackedNormal);
+            layout.Append(VertexLayout::PackedTangent);
+            layout.Append(VertexLayout::HalfTexture2D);
+            layout.Append(VertexLayout::UByte4);
+            layout.Append(VertexLayout::UByte4Norm);
+        }
+        else
+        {
+            layout.Append(VertexLayout::Position3D);
+            layout.Append(VertexLayout::Normal);
+            layout.Append(VertexLayout::Tangent);
+            layout.Append(VertexLayout::Bitangent);
+            layout.Append(VertexLayout::Texture2D);
+            layout.Append(VertexLayout::Float4Color);
+            layout.Append(VertexLayout::UInt4);
+            layout.Append(VertexLayout::Float4);
+        }
+
+        std::cout << "[FbxModel] Input Layout (" << (packed ? "Skinned, packed" : "Skinned") << "):" << std::endl;
         auto d3dLayout = layout.GetD3DLayout();
         for (size_t i = 0; i < d3dLayout.size(); ++i)
         {
@@ -115,11 +145,7 @@ FbxModel::FbxModel(
         }
         std::cout << "  Total stride: " << layout.Size() << " bytes" << std::endl;
 
-        AddStaticBind(std::make_unique<ZInputLayout>(gfx, d3dLayout, pvsbc));
-        AddStaticBind(std::make_unique<ZTopology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST));
-        AddStaticBind(std::make_unique<ZSampler>(gfx));
-
-        std::cout << "[FbxModel] Static bindables initialized" << std::endl;
+        AddStaticVariantBind(variant, std::make_unique<ZInputLayout>(gfx, d3dLayout, pvsbc));
     }
     
     // Create dynamic rasterizer states (not static, so we can switch between them)
@@ -163,8 +189,11 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
     if (!fbxManager_ || !fbxManager_->HasMesh())
         return;
 
-    // Bind all static bindables (Shaders, Input Layout, Topology, etc.)
+    // Bind all static bindables (Pixel shader, Topology, Sampler)
     BindAll(gfx);
+
+    // Vertex shader + input layout of the vertex format
+    BindStaticVariant(gfx, VertexFormatVariant(fbxManager_->GetVertexFormat()));
     
     // Bind appropriate rasterizer state based on wireframe mode
     if (wireframe_ && rasterizerWireframe_)
@@ -215,20 +244,15 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
     cbufCopy.pointLight.range = pointLight.range;
     cbufCopy.pointLight.att = pointLight.att;
 
-    // Create and bind constant buffer
-    D3D11_BUFFER_DESC cbd{};
-    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbd.Usage = D3D11_USAGE_DYNAMIC;
-    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    cbd.ByteWidth = sizeof(FbxModelConstantBuffer);
-
-    D3D11_SUBRESOURCE_DATA csd{};
-    csd.pSysMem = &cbufCopy;
-
-    Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
-    gfx.GetDeviceCOM()->CreateBuffer(&cbd, &csd, &pConstantBuffer);
-    gfx.GetDeviceContext()->VSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
-    gfx.GetDeviceContext()->PSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
+    // Upload and bind constant buffer (this frame's ring memory)
+    ZConstantRing& ring = gfx.GetConstantRing();
+    ZConstantRing::Allocation cbAlloc;
+    if (!ring.Upload(&cbufCopy, sizeof(FbxModelConstantBuffer), cbAlloc))
+    {
+        return;
+    }
+    ring.BindVS(0u, cbAlloc);
+    ring.BindPS(0u, cbAlloc);
 
     // Upload bone palette to GPU
     if (fbxManager_->HasSkeleton() && fbxManager_->HasAnimations())
@@ -238,7 +262,7 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
         ID3D11Buffer* boneCB = fbxManager_->GetBoneConstantBuffer();
         if (boneCB)
         {
-            gfx.GetDeviceContext()->VSSetConstantBuffers(1, 1, &boneCB);
+            gfx.GetStateCache().SetVSConstantBuffer(1u, boneCB);
         }
     }
 
@@ -248,8 +272,8 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
     UINT stride = fbxManager_->GetVertexStride();
     UINT offset = fbxManager_->GetVertexOffset();
 
-    gfx.GetDeviceContext()->IASetVertexBuffers(0u, 1u, &vb, &stride, &offset);
-    gfx.GetDeviceContext()->IASetIndexBuffer(ib, DXGI_FORMAT_R32_UINT, 0u);
+    gfx.GetStateCache().SetVertexBuffer(0u, vb, stride, offset);
+    gfx.GetStateCache().SetIndexBuffer(ib, fbxManager_->GetIndexFormat(), 0u);
 
     // Render subsets
     // Get rendering data from FbxManager
@@ -257,6 +281,25 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
     // Each subset represents a portion of the mesh with a specific material/texture
     const auto& subsets = fbxManager_->GetSubsets();
     const auto& srvs = fbxManager_->GetMaterialSRVs();
+
+    // Mesh LOD: model units → pixels at the nearest point of the bounding sphere
+    // (투영 _22 = cot(fovY / 2), 화면 높이의 절반이 NDC 1에 해당)
+    float pixelsPerUnit = FLT_MAX;
+    {
+        XMFLOAT3 boundsCenter;
+        float boundsRadius = 0.0f;
+        fbxManager_->GetBindPoseBounds(boundsCenter, boundsRadius);
+        const XMVECTOR centerView = XMVector3TransformCoord(XMLoadFloat3(&boundsCenter), XMMatrixMultiply(modelTransform, view));
+        const float depth = XMVectorGetZ(centerView) - boundsRadius * scale_;
+        if (depth > 0.01f)
+        {
+            XMFLOAT4X4 projF;
+            XMStoreFloat4x4(&projF, proj);
+            pixelsPerUnit = projF._22 * 0.5f * static_cast<float>(gfx.GetClientHeight()) / depth * scale_;
+        }
+    }
+    drawnTriangles_ = 0;
+    fullTriangles_ = 0;
     const auto& normalMapSRVs = fbxManager_->GetNormalMapSRVs();
     const auto& specularMapSRVs = fbxManager_->GetSpecularMapSRVs();
 
@@ -266,7 +309,7 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
         if (subset.materialIndex >= 0 && subset.materialIndex < (int)srvs.size())
         {
             ID3D11ShaderResourceView* srv = srvs[subset.materialIndex].Get();
-            gfx.GetDeviceContext()->PSSetShaderResources(0u, 1u, &srv);
+            gfx.GetStateCache().SetPSShaderResource(0u, srv);
         }
 
         // Bind normal map to slot 1 if available
@@ -275,7 +318,7 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
             ID3D11ShaderResourceView* normalSRV = normalMapSRVs[subset.materialIndex].Get();
             if (normalSRV)
             {
-                gfx.GetDeviceContext()->PSSetShaderResources(1u, 1u, &normalSRV);
+                gfx.GetStateCache().SetPSShaderResource(1u, normalSRV);
             }
         }
 
@@ -285,11 +328,27 @@ void FbxModel::Render(ZGraphics& gfx) const noxnd
             ID3D11ShaderResourceView* specularSRV = specularMapSRVs[subset.materialIndex].Get();
             if (specularSRV)
             {
-                gfx.GetDeviceContext()->PSSetShaderResources(2u, 1u, &specularSRV);
+                gfx.GetStateCache().SetPSShaderResource(2u, specularSRV);
             }
         }
 
-        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, 0);
+        // LOD 0 = subset itself, LOD k = lods[k - 1]
+        uint32_t lod = 0;
+        if (forcedLod_ >= 0)
+        {
+            lod = (std::min)(static_cast<uint32_t>(forcedLod_), subset.lodCount);
+        }
+        else
+        {
+            while (lod < subset.lodCount && subset.lods[lod].error * pixelsPerUnit <= lodPixelError_)
+                ++lod;
+        }
+        const uint32_t indexCount = lod == 0 ? subset.indexCount : subset.lods[lod - 1].indexCount;
+        const uint32_t startIndex = lod == 0 ? subset.startIndex : subset.lods[lod - 1].startIndex;
+        drawnTriangles_ += indexCount / 3;
+        fullTriangles_ += subset.indexCount / 3;
+
+        gfx.GetDeviceContext()->DrawIndexed(indexCount, startIndex, subset.baseVertex);
     }
 }
 
@@ -301,6 +360,31 @@ void FbxModel::Update(float deltaTime) noexcept
     }
 }
 
+void FbxModel::UpdateAnimations(ZGraphics& gfx, FbxModel* const* models, size_t count, float deltaTime,
+                                std::vector<FbxAnimLodInstance>& instances)
+{
+    instances.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (models[i] && models[i]->fbxManager_ && models[i]->fbxManager_->HasAnimations())
+        {
+            FbxAnimLodInstance instance;
+            instance.animation = models[i]->fbxManager_.get();
+            XMStoreFloat4x4(&instance.world, models[i]->GetTransformXM());
+            instances.push_back(instance);
+        }
+    }
+
+    FbxAnimLodPolicy::Shared().Update(instances.data(), instances.size(), deltaTime, gfx.GetCamera(), gfx.GetProjection(), ZThreadPool::Shared());
+
+    // 모든 팔레트를 렌더 전에 공유 버퍼에 채워 둔다 → 첫 드로우에서 업로드 한 번
+    FbxPaletteArena& paletteArena = gfx.GetPaletteArena();
+    for (const FbxAnimLodInstance& instance : instances)
+    {
+        instance.animation->PackBonePalette(paletteArena);
+    }
+}
+
 XMMATRIX FbxModel::GetTransformXM() const noexcept
 {
     return XMMatrixScaling(scale_, scale_, scale_) *
@@ -308,7 +392,12 @@ XMMATRIX FbxModel::GetTransformXM() const noexcept
            XMMatrixTranslation(position_.x, position_.y, position_.z);
 }
 
-void FbxModel::ShowControlWindow()
+const void* FbxModel::GetShaderKey() const noexcept
+{
+    return GetStaticVariantKey(VertexFormatVariant(fbxManager_->GetVertexFormat()));
+}
+
+void FbxModel::ShowControlWindow(ZGraphics& gfx)
 {
     if (ImGui::Begin("Skinned Model Animation Control"))
     {
@@ -322,6 +411,19 @@ void FbxModel::ShowControlWindow()
             ImGui::Text("Animation Control");
             ImGui::Separator();
             
+            // Animation LOD counters (last frame, all instances)
+            const FbxAnimLodStats& lodStats = FbxAnimLodPolicy::Shared().GetFrameStats();
+            ImGui::Text("LOD: Full %u / Half %u / Quarter %u / Culled %u",
+                lodStats.instancesPerTier[static_cast<size_t>(FbxAnimLodTier::Full)],
+                lodStats.instancesPerTier[static_cast<size_t>(FbxAnimLodTier::Half)],
+                lodStats.instancesPerTier[static_cast<size_t>(FbxAnimLodTier::Quarter)],
+                lodStats.instancesPerTier[static_cast<size_t>(FbxAnimLodTier::Culled)]);
+            ImGui::Text("Evaluations %u, interpolated %u", lodStats.evaluations, lodStats.interpolations);
+            const FbxPaletteArena& paletteArena = gfx.GetPaletteArena();
+            ImGui::Text("Palette: %u bones packed, %zu bytes in %u upload(s)",
+                paletteArena.GetUsedRows() / FbxPalette::kRowsPerBone, paletteArena.GetUploadedBytes(), paletteArena.GetUploadCount());
+            ImGui::Separator();
+            
             const auto& animNames = fbxManager_->GetAnimationNames();
             int currentAnim = fbxManager_->GetCurrentAnimationIndex();
             
@@ -385,6 +487,8 @@ void FbxModel::ShowControlWindow()
             if (fbxManager_->HasSkinning())
             {
                 ImGui::Text("Bones: %d", fbxManager_->GetBoneCount());
+                ImGui::Text("Vertex format: %s (%u bytes)",
+                    fbxManager_->GetVertexFormat() == FbxVertexFormat::Packed ? "Packed" : "Full", fbxManager_->GetVertexStride());
             }
             else
             {
@@ -396,6 +500,17 @@ void FbxModel::ShowControlWindow()
             ImGui::Text("No animations loaded");
         }
         
+        ImGui::Separator();
+        ImGui::Text("Mesh LOD");
+        ImGui::SliderFloat("Pixel Error", &lodPixelError_, 0.25f, 8.0f, "%.2f px");
+        const char* lodModes[] = { "Auto", "LOD 0", "LOD 1", "LOD 2", "LOD 3" };
+        int lodMode = forcedLod_ + 1;
+        if (ImGui::Combo("LOD", &lodMode, lodModes, IM_ARRAYSIZE(lodModes)))
+        {
+            forcedLod_ = lodMode - 1;
+        }
+        ImGui::Text("Triangles: %u / %u", drawnTriangles_, fullTriangles_);
+
         ImGui::Separator();
         ImGui::Text("Shading Mode");
         
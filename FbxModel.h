@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "ZRenderableBase.h"
+#include "FbxAnimationLod.h"
 
 // Skinned model constant buffer (supports skeletal animation)
 struct FbxModelConstantBuffer
@@ -61,9 +62,18 @@ public:
             const std::vector<std::string>& defaultSpecularMapPaths = {},
             const std::vector<std::string>& externalAnimPaths = {});
 
-    void Render(ZGraphics& gfx) const noxnd;
+    void Render(ZGraphics& gfx) const noxnd override;
     void Update(float deltaTime) noexcept override;
+    
+    // Animation update for all models of a frame at once (parallel, returns after every model is done)
+    // gfx camera/projection drive the animation LOD policy (distance → update rate, off-screen → no palette),
+    // palettes are packed into gfx.GetPaletteArena()
+    // instances: caller-owned scratch, reuse it every frame (정상 상태에서 힙 할당 없음)
+    static void UpdateAnimations(ZGraphics& gfx, FbxModel* const* models, size_t count, float deltaTime,
+                                 std::vector<FbxAnimLodInstance>& instances);
+    
     DirectX::XMMATRIX GetTransformXM() const noexcept override;
+    const void* GetShaderKey() const noexcept override;   // per vertex format (VS + input layout differ)
     
     // Transform controls
     void SetPosition(DirectX::XMFLOAT3 pos) { position_ = pos; }
@@ -75,7 +85,7 @@ public:
     bool LoadExternalAnimations(const std::vector<std::string>& animFilePaths);
     
     // ImGui controls
-    void ShowControlWindow();
+    void ShowControlWindow(ZGraphics& gfx);
     
     // Wireframe mode control
     void SetWireframe(bool enabled) { wireframe_ = enabled; }
@@ -89,6 +99,10 @@ public:
     void SetSpecularMapEnabled(bool enabled) { cbuf_.useSpecularMap = enabled ? 1 : 0; }
     bool IsSpecularMapEnabled() const { return cbuf_.useSpecularMap == 1; }
 
+    // Mesh LOD: coarsest level whose simplification error stays under lodPixelError pixels on screen
+    void SetLodPixelError(float pixels) { lodPixelError_ = pixels; }
+    void SetForcedLod(int lod) { forcedLod_ = lod; }   // -1: screen-space selection
+
 private:
     std::unique_ptr<class FbxManager> fbxManager_;
     FbxModelConstantBuffer cbuf_;
@@ -106,4 +120,10 @@ private:
     
     // Rendering mode
     bool wireframe_ = false;
+
+    // Mesh LOD
+    float lodPixelError_ = 1.0f;
+    int forcedLod_ = -1;
+    mutable uint32_t drawnTriangles_ = 0;     // last Render (ImGui readout)
+    mutable uint32_t fullTriangles_ = 0;
 };
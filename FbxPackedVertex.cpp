@@ -0,0 +1,246 @@
+﻿#include "FbxPackedVertex.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+namespace
+{
+    // D3D SNORM decode: -max and -max-1 both map to -1
+    float SnormToFloat(int value, int maxValue)
+    {
+        return (std::max)(static_cast<float>(value) / static_cast<float>(maxValue), -1.0f);
+    }
+
+    // 내림/올림 4가지 조합 중 복원 오차가 가장 작은 값 (8-bit 탄젠트에서 차이가 크다)
+    void QuantizeOctahedral(FXMVECTOR n, int maxValue, int& outX, int& outY)
+    {
+        const XMFLOAT2 oct = FbxVertexPack::EncodeOctahedral(n);
+        const float sx = oct.x * maxValue;
+        const float sy = oct.y * maxValue;
+
+        float bestDot = -2.0f;
+        for (int i = 0; i < 4; ++i)
+        {
+            const int qx = (std::clamp)(static_cast<int>((i & 1) ? std::ceil(sx) : std::floor(sx)), -maxValue, maxValue);
+            const int qy = (std::clamp)(static_cast<int>((i & 2) ? std::ceil(sy) : std::floor(sy)), -maxValue, maxValue);
+            const XMVECTOR decoded = FbxVertexPack::DecodeOctahedral(SnormToFloat(qx, maxValue), SnormToFloat(qy, maxValue));
+            const float d = XMVectorGetX(XMVector3Dot(decoded, n));
+            if (d > bestDot)
+            {
+                bestDot = d;
+                outX = qx;
+                outY = qy;
+            }
+        }
+    }
+
+    // Angle between unit vectors from the chord length (acos loses precision near 0)
+    float AngleDegrees(FXMVECTOR a, FXMVECTOR b)
+    {
+        const float chord = XMVectorGetX(XMVector3Length(XMVectorSubtract(a, b)));
+        return XMConvertToDegrees(2.0f * std::asin((std::min)(1.0f, 0.5f * chord)));
+    }
+
+    XMVECTOR RandomUnitVector(std::mt19937& rng)
+    {
+        std::normal_distribution<float> gauss;
+        for (;;)
+        {
+            const XMVECTOR v = XMVectorSet(gauss(rng), gauss(rng), gauss(rng), 0.0f);
+            if (XMVectorGetX(XMVector3LengthSq(v)) > 1e-6f)
+                return XMVector3Normalize(v);
+        }
+    }
+
+    // Error bounds of the round-trip check
+    constexpr float kMaxNormalErrorDeg = 0.05f;       // 16-bit octahedral
+    constexpr float kMaxTangentErrorDeg = 0.75f;      // 8-bit octahedral
+    constexpr float kMaxBitangentErrorDeg = 1.0f;     // cross of the two decoded vectors
+    constexpr float kMaxTexCoordError = 1.0f / 1024.0f;   // half, |uv| <= 2
+    constexpr float kMaxWeightError = 2.5f / 255.0f;  // rounding + sum correction on the largest weight
+}
+
+namespace FbxVertexPack
+{
+    XMFLOAT2 EncodeOctahedral(FXMVECTOR n)
+    {
+        XMFLOAT3 v;
+        XMStoreFloat3(&v, n);
+        const float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+        float x = (l1 > 0.0f) ? v.x / l1 : 0.0f;
+        float y = (l1 > 0.0f) ? v.y / l1 : 0.0f;
+        if (v.z < 0.0f)
+        {
+            // 아래쪽 반구는 대각선 기준으로 접어 넣는다
+            const float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            const float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x = fx;
+            y = fy;
+        }
+        return XMFLOAT2(x, y);
+    }
+
+    XMVECTOR DecodeOctahedral(float x, float y)
+    {
+        float z = 1.0f - std::abs(x) - std::abs(y);
+        const float t = (std::max)(-z, 0.0f);
+        x += (x >= 0.0f) ? -t : t;
+        y += (y >= 0.0f) ? -t : t;
+        return XMVector3Normalize(XMVectorSet(x, y, z, 0.0f));
+    }
+
+    void Pack(const XMFLOAT3& position, const XMFLOAT3& normal, const XMFLOAT3& tangent, const XMFLOAT3& bitangent,
+              const XMFLOAT2& texCoord, const uint32_t boneIndices[4], const XMFLOAT4& boneWeights, FbxPackedVertex& out)
+    {
+        out.position = position;
+
+        const XMVECTOR n = XMVector3Normalize(XMLoadFloat3(&normal));
+        const XMVECTOR t = XMVector3Normalize(XMLoadFloat3(&tangent));
+        int qx = 0, qy = 0;
+        QuantizeOctahedral(n, 32767, qx, qy);
+        out.normal.x = static_cast<int16_t>(qx);
+        out.normal.y = static_cast<int16_t>(qy);
+
+        QuantizeOctahedral(t, 127, qx, qy);
+        const bool flipped = XMVectorGetX(XMVector3Dot(XMVector3Cross(n, t), XMLoadFloat3(&bitangent))) < 0.0f;
+        out.tangent.x = static_cast<int8_t>(qx);
+        out.tangent.y = static_cast<int8_t>(qy);
+        out.tangent.z = 0;
+        out.tangent.w = flipped ? -127 : 127;
+
+        out.texCoord.x = XMConvertFloatToHalf(texCoord.x);
+        out.texCoord.y = XMConvertFloatToHalf(texCoord.y);
+
+        out.boneIndices.x = static_cast<uint8_t>(boneIndices[0]);
+        out.boneIndices.y = static_cast<uint8_t>(boneIndices[1]);
+        out.boneIndices.z = static_cast<uint8_t>(boneIndices[2]);
+        out.boneIndices.w = static_cast<uint8_t>(boneIndices[3]);
+
+        // 반올림 후 합이 255가 되도록 가장 큰 가중치에서 차이를 보정 (셰이더에서 합 = 1)
+        const float w[4] = { boneWeights.x, boneWeights.y, boneWeights.z, boneWeights.w };
+        int q[4];
+        int sum = 0;
+        int largest = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            q[i] = static_cast<int>((std::clamp)(w[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+            sum += q[i];
+            if (w[i] > w[largest])
+                largest = i;
+        }
+        if (sum > 0)
+        {
+            q[largest] = (std::clamp)(q[largest] + 255 - sum, 0, 255);
+        }
+        out.boneWeights.x = static_cast<uint8_t>(q[0]);
+        out.boneWeights.y = static_cast<uint8_t>(q[1]);
+        out.boneWeights.z = static_cast<uint8_t>(q[2]);
+        out.boneWeights.w = static_cast<uint8_t>(q[3]);
+    }
+
+    FbxUnpackedVertex Unpack(const FbxPackedVertex& v)
+    {
+        FbxUnpackedVertex out{};
+        out.position = v.position;
+
+        const XMVECTOR n = DecodeOctahedral(SnormToFloat(v.normal.x, 32767), SnormToFloat(v.normal.y, 32767));
+        const XMVECTOR t = DecodeOctahedral(SnormToFloat(v.tangent.x, 127), SnormToFloat(v.tangent.y, 127));
+        const float sign = (v.tangent.w < 0) ? -1.0f : 1.0f;
+        XMStoreFloat3(&out.normal, n);
+        XMStoreFloat3(&out.tangent, t);
+        XMStoreFloat3(&out.bitangent, XMVectorScale(XMVector3Cross(n, t), sign));
+
+        out.texCoord = XMFLOAT2(XMConvertHalfToFloat(v.texCoord.x), XMConvertHalfToFloat(v.texCoord.y));
+
+        out.boneIndices[0] = v.boneIndices.x;
+        out.boneIndices[1] = v.boneIndices.y;
+        out.boneIndices[2] = v.boneIndices.z;
+        out.boneIndices[3] = v.boneIndices.w;
+        out.boneWeights = XMFLOAT4(v.boneWeights.x / 255.0f, v.boneWeights.y / 255.0f,
+                                   v.boneWeights.z / 255.0f, v.boneWeights.w / 255.0f);
+        return out;
+    }
+
+    bool RunRoundTripCheck()
+    {
+        constexpr int kSamples = 200000;
+        std::mt19937 rng(20250114u);
+        std::uniform_real_distribution<float> uv(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_int_distribution<uint32_t> bone(0, kMaxBones - 1);
+        std::uniform_int_distribution<int> influenceCount(1, 4);
+
+        float maxNormal = 0.0f, maxTangent = 0.0f, maxBitangent = 0.0f, maxTexCoord = 0.0f, maxWeight = 0.0f;
+        int indexMismatches = 0;
+        int weightSumMismatches = 0;
+
+        for (int s = 0; s < kSamples; ++s)
+        {
+            // Orthonormal frame with a random handedness
+            const XMVECTOR n = RandomUnitVector(rng);
+            const XMVECTOR t = XMVector3Normalize(XMVector3Cross(n, RandomUnitVector(rng)));
+            const XMVECTOR b = XMVectorScale(XMVector3Cross(n, t), (rng() & 1) ? -1.0f : 1.0f);
+
+            XMFLOAT3 position(uv(rng) * 100.0f, uv(rng) * 100.0f, uv(rng) * 100.0f);
+            XMFLOAT3 normal, tangent, bitangent;
+            XMStoreFloat3(&normal, n);
+            XMStoreFloat3(&tangent, t);
+            XMStoreFloat3(&bitangent, b);
+            const XMFLOAT2 texCoord(uv(rng), uv(rng));
+
+            // 가중치 내림차순 (FbxManager 변환 결과와 같은 형태)
+            uint32_t indices[4] = { 0, 0, 0, 0 };
+            float weights[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            const int count = influenceCount(rng);
+            float total = 0.0f;
+            for (int i = 0; i < count; ++i)
+            {
+                indices[i] = bone(rng);
+                weights[i] = 0.05f + unit(rng);
+                total += weights[i];
+            }
+            std::sort(weights, weights + count, [](float a, float c) { return a > c; });
+            const XMFLOAT4 boneWeights(weights[0] / total, weights[1] / total, weights[2] / total, weights[3] / total);
+
+            FbxPackedVertex packed;
+            Pack(position, normal, tangent, bitangent, texCoord, indices, boneWeights, packed);
+            const FbxUnpackedVertex u = Unpack(packed);
+
+            maxNormal = (std::max)(maxNormal, AngleDegrees(n, XMLoadFloat3(&u.normal)));
+            maxTangent = (std::max)(maxTangent, AngleDegrees(t, XMLoadFloat3(&u.tangent)));
+            maxBitangent = (std::max)(maxBitangent, AngleDegrees(b, XMLoadFloat3(&u.bitangent)));
+            maxTexCoord = (std::max)(maxTexCoord, (std::max)(std::abs(u.texCoord.x - texCoord.x), std::abs(u.texCoord.y - texCoord.y)));
+
+            const float decodedWeights[4] = { u.boneWeights.x, u.boneWeights.y, u.boneWeights.z, u.boneWeights.w };
+            const float sourceWeights[4] = { boneWeights.x, boneWeights.y, boneWeights.z, boneWeights.w };
+            for (int i = 0; i < 4; ++i)
+            {
+                maxWeight = (std::max)(maxWeight, std::abs(decodedWeights[i] - sourceWeights[i]));
+                if (u.boneIndices[i] != indices[i])
+                    ++indexMismatches;
+            }
+            if (packed.boneWeights.x + packed.boneWeights.y + packed.boneWeights.z + packed.boneWeights.w != 255)
+                ++weightSumMismatches;
+
+        }
+
+        const bool passed = maxNormal <= kMaxNormalErrorDeg && maxTangent <= kMaxTangentErrorDeg &&
+                            maxBitangent <= kMaxBitangentErrorDeg && maxTexCoord <= kMaxTexCoordError &&
+                            maxWeight <= kMaxWeightError && indexMismatches == 0 && weightSumMismatches == 0;
+
+        std::cout << "=== FbxVertexPack round-trip check (" << kSamples << " vertices) ===" << std::endl;
+        std::cout << "  normal    max " << maxNormal << " deg (bound " << kMaxNormalErrorDeg << ")" << std::endl;
+        std::cout << "  tangent   max " << maxTangent << " deg (bound " << kMaxTangentErrorDeg << ")" << std::endl;
+        std::cout << "  bitangent max " << maxBitangent << " deg (bound " << kMaxBitangentErrorDeg << ")" << std::endl;
+        std::cout << "  texcoord  max " << maxTexCoord << " (bound " << kMaxTexCoordError << ", |uv| <= 2)" << std::endl;
+        std::cout << "  weights   max " << maxWeight << " (bound " << kMaxWeightError << "), sum != 255: "
+                  << weightSumMismatches << ", index mismatches: " << indexMismatches << std::endl;
+        std::cout << "  vertex size: 104 -> " << sizeof(FbxPackedVertex) << " bytes" << std::endl;
+        std::cout << "=== " << (passed ? "passed" : "FAILED") << " ===" << std::endl;
+        return passed;
+    }
+}
@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <cstdint>
+
+// Vertex format of a skinned mesh (FbxManager::SetVertexFormat before Load)
+enum class FbxVertexFormat : uint8_t
+{
+    Full = 0,      // VertexSkinned (104 bytes): SkinnedModelVS, SkinnedVS*
+    Packed         // FbxPackedVertex (32 bytes): SkinnedModelPackedVS
+};
+
+// Quantized skinned vertex
+//  - 노멀/탄젠트: 팔면체(octahedral) 인코딩, 바이탄젠트는 저장하지 않고 cross(N, T) * sign으로 복원
+//  - UV: half, 뼈 인덱스: uint8 (뼈 256개 이하), 가중치: unorm8 (합이 정확히 255)
+//  - 색: 원본 경로도 항상 흰색이었으므로 스트림을 두지 않는다 (셰이더에서 상수)
+struct FbxPackedVertex
+{
+    DirectX::XMFLOAT3 position;                    // R32G32B32_FLOAT
+    DirectX::PackedVector::XMSHORTN2 normal;       // R16G16_SNORM, octahedral
+    DirectX::PackedVector::XMBYTEN4 tangent;       // R8G8B8A8_SNORM, octahedral xy, w = bitangent sign
+    DirectX::PackedVector::XMHALF2 texCoord;       // R16G16_FLOAT
+    DirectX::PackedVector::XMUBYTE4 boneIndices;   // R8G8B8A8_UINT
+    DirectX::PackedVector::XMUBYTEN4 boneWeights;  // R8G8B8A8_UNORM
+};
+static_assert(sizeof(FbxPackedVertex) == 32, "FbxPackedVertex must match SkinnedModelPackedVS input");
+
+// Decoded vertex (CPU side, round-trip checks)
+struct FbxUnpackedVertex
+{
+    DirectX::XMFLOAT3 position;
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT3 tangent;
+    DirectX::XMFLOAT3 bitangent;
+    DirectX::XMFLOAT2 texCoord;
+    uint32_t boneIndices[4];
+    DirectX::XMFLOAT4 boneWeights;
+};
+
+namespace FbxVertexPack
+{
+    constexpr uint32_t kMaxBones = 256;   // uint8 bone indices
+
+    // Unit vector <-> octahedral [-1, 1]^2 (same arithmetic as SkinnedModelPackedVS.hlsl)
+    DirectX::XMFLOAT2 EncodeOctahedral(DirectX::FXMVECTOR n);
+    DirectX::XMVECTOR DecodeOctahedral(float x, float y);
+
+    // boneWeights: normalized (sum 1), boneIndices < kMaxBones
+    void Pack(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& normal, const DirectX::XMFLOAT3& tangent,
+              const DirectX::XMFLOAT3& bitangent, const DirectX::XMFLOAT2& texCoord, const uint32_t boneIndices[4],
+              const DirectX::XMFLOAT4& boneWeights, FbxPackedVertex& out);
+
+    FbxUnpackedVertex Unpack(const FbxPackedVertex& v);
+
+    // Headless: random tangent frames / UVs / weights through Pack → Unpack, checked against error bounds
+    bool RunRoundTripCheck();
+}
@@ -0,0 +1,250 @@
+﻿#include "FbxPaletteArena.h"
+#include "FbxAnimationBatch.h"
+#include "FbxManager.h"
+#include "ZGraphics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr uint32_t kMinCapacityRows = 3 * 256;
+
+    // Former 4x4 path on the original palette matrix: uploaded transposed into a row_major matrix,
+    // shader does mul(float4(p, 1), M) for points and mul(n, (float3x3)M) for directions
+    XMVECTOR TransformReference4x4(const XMMATRIX& bone, FXMVECTOR v)
+    {
+        const XMMATRIX uploaded = XMMatrixTranspose(bone);
+        return XMVectorGetW(v) != 0.0f ? XMVector3Transform(v, uploaded) : XMVector3TransformNormal(v, uploaded);
+    }
+
+    // Packed path, same arithmetic as SkinnedModelVS.hlsl
+    XMVECTOR TransformPacked3x4(const XMFLOAT4* rows, FXMVECTOR v)
+    {
+        const XMVECTOR r0 = XMLoadFloat4(&rows[0]);
+        const XMVECTOR r1 = XMLoadFloat4(&rows[1]);
+        const XMVECTOR r2 = XMLoadFloat4(&rows[2]);
+        return XMVectorSet(XMVectorGetX(XMVector4Dot(r0, v)),
+                           XMVectorGetX(XMVector4Dot(r1, v)),
+                           XMVectorGetX(XMVector4Dot(r2, v)),
+                           XMVectorGetW(v));
+    }
+
+    float MaxAbsDifference(FXMVECTOR a, FXMVECTOR b)
+    {
+        XMFLOAT4 d;
+        XMStoreFloat4(&d, XMVectorAbs(XMVectorSubtract(a, b)));
+        return (std::max)((std::max)(d.x, d.y), (std::max)(d.z, d.w));
+    }
+}
+
+namespace FbxPalette
+{
+    void PackAffine3x4(const XMMATRIX* palette, size_t boneCount, XMFLOAT4* outRows)
+    {
+        for (size_t i = 0; i < boneCount; ++i)
+        {
+            XMStoreFloat4(&outRows[i * kRowsPerBone + 0], palette[i].r[0]);
+            XMStoreFloat4(&outRows[i * kRowsPerBone + 1], palette[i].r[1]);
+            XMStoreFloat4(&outRows[i * kRowsPerBone + 2], palette[i].r[2]);
+        }
+    }
+
+    float CompareWithReference(const std::vector<XMMATRIX>& palette)
+    {
+        if (palette.empty())
+            return 0.0f;
+
+        std::vector<XMFLOAT4> rows(palette.size() * kRowsPerBone);
+        PackAffine3x4(palette.data(), palette.size(), rows.data());
+
+        const XMVECTOR points[] = {
+            XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f),
+            XMVectorSet(12.5f, -3.0f, 7.25f, 1.0f),
+            XMVectorSet(-40.0f, 160.0f, 5.0f, 1.0f),
+            XMVectorSet(0.3f, 0.7f, -0.2f, 0.0f),       // direction (normal/tangent, w = 0)
+        };
+
+        float maxError = 0.0f;
+        const size_t boneCount = palette.size();
+        for (size_t b = 0; b < boneCount; ++b)
+        {
+            // Single bone
+            for (const XMVECTOR& p : points)
+            {
+                maxError = (std::max)(maxError, MaxAbsDifference(
+                    TransformReference4x4(palette[b], p), TransformPacked3x4(&rows[b * kRowsPerBone], p)));
+            }
+
+            // 4-bone blend: the shader blends matrices (rows) first, then transforms
+            const size_t idx[4] = { b, (b * 7 + 1) % boneCount, (b * 13 + 2) % boneCount, (b * 31 + 3) % boneCount };
+            const float w[4] = { 0.4f, 0.3f, 0.2f, 0.1f };
+            XMMATRIX blended = XMMatrixSet(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+            XMFLOAT4 blendedRows[3] = {};
+            for (int k = 0; k < 4; ++k)
+            {
+                blended.r[0] = XMVectorMultiplyAdd(palette[idx[k]].r[0], XMVectorReplicate(w[k]), blended.r[0]);
+                blended.r[1] = XMVectorMultiplyAdd(palette[idx[k]].r[1], XMVectorReplicate(w[k]), blended.r[1]);
+                blended.r[2] = XMVectorMultiplyAdd(palette[idx[k]].r[2], XMVectorReplicate(w[k]), blended.r[2]);
+                blended.r[3] = XMVectorMultiplyAdd(palette[idx[k]].r[3], XMVectorReplicate(w[k]), blended.r[3]);
+                for (uint32_t r = 0; r < kRowsPerBone; ++r)
+                {
+                    const XMVECTOR row = XMLoadFloat4(&rows[idx[k] * kRowsPerBone + r]);
+                    XMStoreFloat4(&blendedRows[r], XMVectorMultiplyAdd(row, XMVectorReplicate(w[k]), XMLoadFloat4(&blendedRows[r])));
+                }
+            }
+            for (const XMVECTOR& p : points)
+            {
+                maxError = (std::max)(maxError, MaxAbsDifference(
+                    TransformReference4x4(blended, p), TransformPacked3x4(blendedRows, p)));
+            }
+        }
+        return maxError;
+    }
+
+    bool RunPackingCheck(const std::vector<FbxAnimBenchmarkRig>& rigs)
+    {
+        constexpr int kSamplesPerClip = 8;
+        constexpr float kTolerance = 1e-3f;   // 4x4 경로와 연산 순서만 다르다 (float 반올림 수준)
+
+        bool allPassed = true;
+        std::cout << "=== FbxPalette 3x4 packing check ===" << std::endl;
+
+        for (const FbxAnimBenchmarkRig& rig : rigs)
+        {
+            FbxManager rigInstance;
+            rigInstance.SetAnimationLogging(false);
+            if (!rigInstance.LoadRig(rig.modelPath) || !rigInstance.HasSkinning())
+            {
+                std::cerr << "[FbxPalette] Skipping rig '" << rig.name << "' (load failed or not skinned)" << std::endl;
+                continue;
+            }
+            if (!rig.animPaths.empty())
+            {
+                rigInstance.LoadExternalAnimations(rig.animPaths);
+            }
+
+            float maxError = 0.0f;
+            int palettes = 0;
+            for (int clip = 0; clip < rigInstance.GetAnimationCount(); ++clip)
+            {
+                rigInstance.SetCurrentAnimation(clip);
+                const double duration = rigInstance.GetClipDurationSec(clip);
+                for (int s = 0; s < kSamplesPerClip; ++s)
+                {
+                    rigInstance.SetAnimationTimeSeconds(duration * s / kSamplesPerClip);
+                    rigInstance.EvaluateAnimation();
+                    maxError = (std::max)(maxError, CompareWithReference(rigInstance.GetBonePalette()));
+                    ++palettes;
+                }
+            }
+
+            const bool passed = maxError <= kTolerance;
+            allPassed = allPassed && passed;
+            const size_t bones = static_cast<size_t>(rigInstance.GetBoneCount());
+            std::cout << "[FbxPalette] " << rig.name << ": " << palettes << " palettes, " << bones << " bones, "
+                      << bones * kRowsPerBone * sizeof(XMFLOAT4) << " bytes/instance (4x4 CB: "
+                      << (1023 * sizeof(XMFLOAT4X4) + 16) << "), max |3x4 - 4x4| = " << maxError
+                      << (passed ? "  OK" : "  FAILED") << std::endl;
+        }
+
+        std::cout << "=== FbxPalette 3x4 packing check " << (allPassed ? "passed" : "FAILED") << " ===" << std::endl;
+        return allPassed;
+    }
+}
+
+void FbxPaletteArena::BeginFrame()
+{
+    ++frameIndex_;
+    usedRows_ = 0;
+    uploadedRows_ = 0;
+    uploadedBytes_ = 0;
+    uploadCount_ = 0;
+}
+
+uint32_t FbxPaletteArena::Pack(const std::vector<XMMATRIX>& palette)
+{
+    const uint32_t base = usedRows_;
+    const uint32_t rowCount = static_cast<uint32_t>(palette.size()) * FbxPalette::kRowsPerBone;
+    if (rows_.size() < static_cast<size_t>(base) + rowCount)
+    {
+        rows_.resize((std::max)(static_cast<size_t>(base) + rowCount, rows_.size() * 2));
+    }
+
+    FbxPalette::PackAffine3x4(palette.data(), palette.size(), rows_.data() + base);
+    usedRows_ = base + rowCount;
+    return base;
+}
+
+bool FbxPaletteArena::EnsureCapacity(ZGraphics& gfx, uint32_t rows)
+{
+    if (pBuffer_ && capacityRows_ >= rows)
+        return true;
+
+    uint32_t capacity = (std::max)(kMinCapacityRows, capacityRows_);
+    while (capacity < rows)
+    {
+        capacity *= 2;
+    }
+
+    D3D11_BUFFER_DESC bd{};
+    bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bd.Usage = D3D11_USAGE_DYNAMIC;
+    bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    bd.ByteWidth = capacity * sizeof(XMFLOAT4);
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pBuffer;
+    HRESULT hr = gfx.GetDeviceCOM()->CreateBuffer(&bd, nullptr, &pBuffer);
+    if (FAILED(hr))
+    {
+        std::cerr << "[FbxPaletteArena] Failed to create palette buffer (" << bd.ByteWidth << " bytes)" << std::endl;
+        return false;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvd{};
+    srvd.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+    srvd.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvd.Buffer.FirstElement = 0;
+    srvd.Buffer.NumElements = capacity;
+
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pSRV;
+    hr = gfx.GetDeviceCOM()->CreateShaderResourceView(pBuffer.Get(), &srvd, &pSRV);
+    if (FAILED(hr))
+    {
+        std::cerr << "[FbxPaletteArena] Failed to create palette SRV" << std::endl;
+        return false;
+    }
+
+    pBuffer_ = pBuffer;
+    pSRV_ = pSRV;
+    capacityRows_ = capacity;
+    uploadedRows_ = 0;  // 새 버퍼는 비어 있다
+    return true;
+}
+
+bool FbxPaletteArena::Upload(ZGraphics& gfx)
+{
+    if (usedRows_ == 0)
+        return false;
+    if (!EnsureCapacity(gfx, usedRows_))
+        return false;
+    if (uploadedRows_ == usedRows_)
+        return true;
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = gfx.GetDeviceContext()->Map(pBuffer_.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (FAILED(hr))
+        return false;
+
+    const size_t bytes = static_cast<size_t>(usedRows_) * sizeof(XMFLOAT4);
+    std::memcpy(mapped.pData, rows_.data(), bytes);
+    gfx.GetDeviceContext()->Unmap(pBuffer_.Get(), 0);
+
+    uploadedRows_ = usedRows_;
+    uploadedBytes_ += bytes;
+    ++uploadCount_;
+    return true;
+}
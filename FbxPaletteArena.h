@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include <DirectXMath.h>
+#include <d3d11.h>
+#include <wrl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class ZGraphics;
+struct FbxAnimBenchmarkRig;
+
+// Compact bone palette: 3x4 affine rows
+// 스키닝 행렬의 마지막 행은 항상 (0,0,0,1)이므로 뼈당 float4 3개(48바이트)만 GPU로 보낸다.
+// 행은 Assimp 배치(column vector, 이동은 _14/_24/_34) 그대로: pos' = (dot(r0,p), dot(r1,p), dot(r2,p)).
+namespace FbxPalette
+{
+    constexpr uint32_t kRowsPerBone = 3;
+
+    void PackAffine3x4(const DirectX::XMMATRIX* palette, size_t boneCount, DirectX::XMFLOAT4* outRows);
+
+    // Max abs difference between the packed 3x4 path and the former 4x4 path
+    // (transposed row_major matrix, mul(v, M)) over test points, directions and 4-bone blends
+    float CompareWithReference(const std::vector<DirectX::XMMATRIX>& palette);
+
+    // Headless: every clip of every rig at several times, 3x4 vs 4x4
+    bool RunPackingCheck(const std::vector<FbxAnimBenchmarkRig>& rigs);
+}
+
+// One shared palette buffer for all skinned instances of a frame (ZGraphics 소유, GetPaletteArena)
+// BeginFrame → 인스턴스마다 Pack으로 구간을 잘라 쓰고 → 첫 스킨 드로우 전에 Upload 한 번 (Map DISCARD).
+// 프레임 중간에 새 구간이 생기면 전체 사용 구간을 다시 올린다 (DISCARD 리네이밍이라 앞선 드로우는 이전 내용을 본다).
+class FbxPaletteArena
+{
+public:
+    FbxPaletteArena() = default;
+    FbxPaletteArena(const FbxPaletteArena&) = delete;
+    FbxPaletteArena& operator=(const FbxPaletteArena&) = delete;
+
+    void BeginFrame();
+    uint64_t GetFrameIndex() const { return frameIndex_; }
+
+    // Packs the palette into this frame's range; returns the first row (shader: paletteBase)
+    uint32_t Pack(const std::vector<DirectX::XMMATRIX>& palette);
+
+    // Uploads the used rows if anything was packed since the last upload
+    bool Upload(ZGraphics& gfx);
+    ID3D11ShaderResourceView* GetShaderResourceView() const { return pSRV_.Get(); }
+
+    // Stats (this frame)
+    uint32_t GetUsedRows() const { return usedRows_; }
+    size_t GetUploadedBytes() const { return uploadedBytes_; }
+    uint32_t GetUploadCount() const { return uploadCount_; }
+
+private:
+    bool EnsureCapacity(ZGraphics& gfx, uint32_t rows);
+
+private:
+    std::vector<DirectX::XMFLOAT4> rows_;        // CPU staging, grows to the peak frame
+    uint32_t usedRows_ = 0;
+    uint32_t uploadedRows_ = 0;
+    uint64_t frameIndex_ = 1;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pBuffer_;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pSRV_;
+    uint32_t capacityRows_ = 0;
+
+    size_t uploadedBytes_ = 0;
+    uint32_t uploadCount_ = 0;
+};
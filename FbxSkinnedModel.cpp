@@ -1,6 +1,7 @@
 ﻿#include "FbxSkinnedModel.h"
 #include "ZBindableBase.h"
 #include "ZGraphics.h"
+#include "ZConstantRing.h"
 #include "imgui/imgui.h"
 #include <iostream>
 
@@ -20,28 +21,17 @@ FbxSkinnedModel::FbxSkinnedModel(
     // Create FbxManager and load model with multiple textures and normal maps
     m_FbxManager = std::make_unique<FbxManager>();
     
-    // Choose appropriate Load function based on whether normal maps and specular maps are provided
-    bool loadSuccess = false;
-    if (!defaultSpecularMapPaths.empty())
-    {
-        std::cout << "[FbxSkinnedModel] Loading with normal maps and specular maps..." << std::endl;
-        loadSuccess = m_FbxManager->Load(gfx, filePath, defaultTexturePaths, defaultNormalMapPaths, defaultSpecularMapPaths);
-    }
-    else if (!defaultNormalMapPaths.empty())
-    {
-        std::cout << "[FbxSkinnedModel] Loading with normal maps..." << std::endl;
-        loadSuccess = m_FbxManager->Load(gfx, filePath, defaultTexturePaths, defaultNormalMapPaths);
-    }
-    else if (!defaultTexturePaths.empty())
-    {
-        std::cout << "[FbxSkinnedModel] Loading with multiple textures..." << std::endl;
-        loadSuccess = m_FbxManager->Load(gfx, filePath, defaultTexturePaths);
-    }
-    else
-    {
-        std::cout << "[FbxSkinnedModel] Loading with default texture..." << std::endl;
-        loadSuccess = m_FbxManager->Load(gfx, filePath);
-    }
+    // Texture slots: the file's own references first, the given paths fill in
+    // (스페큘러 맵까지 지정하면 전체 텍스처 세트로 보고 파일의 참조를 쓰지 않는다)
+    FbxImportDescriptor descriptor;
+    descriptor.diffuse.paths = defaultTexturePaths;
+    descriptor.normalMap.paths = defaultNormalMapPaths;
+    descriptor.specularMap.paths = defaultSpecularMapPaths;
+    const bool useEmbedded = defaultSpecularMapPaths.empty();
+    descriptor.diffuse.useEmbedded = useEmbedded;
+    descriptor.normalMap.useEmbedded = useEmbedded;
+
+    const bool loadSuccess = m_FbxManager->Load(gfx, filePath, descriptor);
     
     if (!loadSuccess)
     {
@@ -206,20 +196,15 @@ void FbxSkinnedModel::Render(ZGraphics& gfx) const noxnd
     cbufCopy.pointLight.range = pointLight.range;
     cbufCopy.pointLight.att = pointLight.att;
 
-    // Create and bind constant buffer
-    D3D11_BUFFER_DESC cbd{};
-    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbd.Usage = D3D11_USAGE_DYNAMIC;
-    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    cbd.ByteWidth = sizeof(FbxSkinnedModelConstantBuffer);
-
-    D3D11_SUBRESOURCE_DATA csd{};
-    csd.pSysMem = &cbufCopy;
-
-    Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
-    gfx.GetDeviceCOM()->CreateBuffer(&cbd, &csd, &pConstantBuffer);
-    gfx.GetDeviceContext()->VSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
-    gfx.GetDeviceContext()->PSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
+    // Upload and bind constant buffer (this frame's ring memory)
+    ZConstantRing& ring = gfx.GetConstantRing();
+    ZConstantRing::Allocation cbAlloc;
+    if (!ring.Upload(&cbufCopy, sizeof(FbxSkinnedModelConstantBuffer), cbAlloc))
+    {
+        return;
+    }
+    ring.BindVS(0u, cbAlloc);
+    ring.BindPS(0u, cbAlloc);
 
     // Upload bone palette to GPU
     if (m_FbxManager->HasSkeleton() && m_FbxManager->HasAnimations())
@@ -229,7 +214,7 @@ void FbxSkinnedModel::Render(ZGraphics& gfx) const noxnd
         ID3D11Buffer* boneCB = m_FbxManager->GetBoneConstantBuffer();
         if (boneCB)
         {
-            gfx.GetDeviceContext()->VSSetConstantBuffers(1, 1, &boneCB);
+            gfx.GetStateCache().SetVSConstantBuffer(1u, boneCB);
         }
     }
 
@@ -239,8 +224,8 @@ void FbxSkinnedModel::Render(ZGraphics& gfx) const noxnd
     UINT stride = m_FbxManager->GetVertexStride();
     UINT offset = m_FbxManager->GetVertexOffset();
 
-    gfx.GetDeviceContext()->IASetVertexBuffers(0u, 1u, &vb, &stride, &offset);
-    gfx.GetDeviceContext()->IASetIndexBuffer(ib, DXGI_FORMAT_R32_UINT, 0u);
+    gfx.GetStateCache().SetVertexBuffer(0u, vb, stride, offset);
+    gfx.GetStateCache().SetIndexBuffer(ib, m_FbxManager->GetIndexFormat(), 0u);
 
     // Render subsets
     const auto& subsets = m_FbxManager->GetSubsets();
@@ -254,7 +239,7 @@ void FbxSkinnedModel::Render(ZGraphics& gfx) const noxnd
         if (subset.materialIndex >= 0 && subset.materialIndex < (int)srvs.size())
         {
             ID3D11ShaderResourceView* srv = srvs[subset.materialIndex].Get();
-            gfx.GetDeviceContext()->PSSetShaderResources(0u, 1u, &srv);
+            gfx.GetStateCache().SetPSShaderResource(0u, srv);
         }
 
         // Bind normal map to slot 1 if available
@@ -263,7 +248,7 @@ void FbxSkinnedModel::Render(ZGraphics& gfx) const noxnd
             ID3D11ShaderResourceView* normalSRV = normalMapSRVs[subset.materialIndex].Get();
             if (normalSRV)
             {
-                gfx.GetDeviceContext()->PSSetShaderResources(1u, 1u, &normalSRV);
+                gfx.GetStateCache().SetPSShaderResource(1u, normalSRV);
             }
         }
 
@@ -273,11 +258,11 @@ void FbxSkinnedModel::Render(ZGraphics& gfx) const noxnd
             ID3D11ShaderResourceView* specularSRV = specularMapSRVs[subset.materialIndex].Get();
             if (specularSRV)
             {
-                gfx.GetDeviceContext()->PSSetShaderResources(2u, 1u, &specularSRV);
+                gfx.GetStateCache().SetPSShaderResource(2u, specularSRV);
             }
         }
 
-        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, 0);
+        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, subset.baseVertex);
     }
 }
 
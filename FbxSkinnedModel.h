@@ -66,7 +66,7 @@ public:
                     const std::vector<std::string>& defaultSpecularMapPaths = {},
                     const std::vector<std::string>& externalAnimPaths = {});
 
-    void Render(ZGraphics& gfx) const noxnd;
+    void Render(ZGraphics& gfx) const noxnd override;
     void Update(float deltaTime) noexcept override;
     DirectX::XMMATRIX GetTransformXM() const noexcept override;
     
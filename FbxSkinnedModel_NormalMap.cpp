@@ -1,4 +1,4 @@
-#include "FbxSkinnedModel_NormalMap.h"
+﻿#include "FbxSkinnedModel_NormalMap.h"
 #include "ZBindableBase.h"
 #include "ZGraphics.h"
 #include "imgui/imgui.h"
@@ -239,7 +239,7 @@ void FbxSkinnedModel_NormalMap::Render(ZGraphics& gfx) const noxnd
     UINT offset = m_FbxManager->GetVertexOffset();
 
     gfx.GetDeviceContext()->IASetVertexBuffers(0u, 1u, &vb, &stride, &offset);
-    gfx.GetDeviceContext()->IASetIndexBuffer(ib, DXGI_FORMAT_R32_UINT, 0u);
+    gfx.GetDeviceContext()->IASetIndexBuffer(ib, m_FbxManager->GetIndexFormat(), 0u);
 
     // Render subsets
     const auto& subsets = m_FbxManager->GetSubsets();
@@ -264,7 +264,7 @@ void FbxSkinnedModel_NormalMap::Render(ZGraphics& gfx) const noxnd
             }
         }
 
-        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, 0);
+        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, subset.baseVertex);
     }
 }
 
@@ -1,6 +1,7 @@
 ﻿#include "FbxStaticModel.h"
 #include "ZBindableBase.h"
 #include "ZGraphics.h"
+#include "ZConstantRing.h"
 #include "imgui/imgui.h"
 #include <iostream>
 #include <assimp/scene.h>
@@ -13,14 +14,22 @@ FbxStaticModel::FbxStaticModel(ZGraphics& gfx, const std::string& filePath, XMFL
 {
     // Create FbxManager and load model
     m_FbxManager = std::make_unique<FbxManager>();
+    m_FbxManager->SetKeepScene(true);  // BuildSimpleBuffers reads the Assimp scene
+
+    // Position + Normal + TexCoord only: no tangent space, no bone weight limiting
+    FbxImportDescriptor descriptor;
+    descriptor.diffuse.fallbackPath = defaultTexturePath;
+    descriptor.tangents = false;
+    descriptor.skinning = false;
     
-    if (!m_FbxManager->Load(gfx, filePath, defaultTexturePath))
+    if (!m_FbxManager->Load(gfx, filePath, descriptor))
     {
         throw std::runtime_error("Failed to load FBX model: " + filePath);
     }
 
-    // Build simple vertex buffer from Assimp scene
+    // Build simple vertex buffer from Assimp scene, then drop the scene
     BuildSimpleBuffers(gfx);
+    m_FbxManager->ReleaseScene();
 
     if (!IsStaticInitialized())
     {
@@ -143,27 +152,22 @@ void FbxStaticModel::Render(ZGraphics& gfx) const noxnd
     cbufCopy.pointLight.range = pointLight.range;
     cbufCopy.pointLight.att = pointLight.att;
 
-    // Create and bind constant buffer
-    D3D11_BUFFER_DESC cbd{};
-    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbd.Usage = D3D11_USAGE_DYNAMIC;
-    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    cbd.ByteWidth = sizeof(FbxStaticModelConstantBuffer);
-
-    D3D11_SUBRESOURCE_DATA csd{};
-    csd.pSysMem = &cbufCopy;
-
-    ComPtr<ID3D11Buffer> pConstantBuffer;
-    gfx.GetDeviceCOM()->CreateBuffer(&cbd, &csd, &pConstantBuffer);
-    gfx.GetDeviceContext()->VSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
-    gfx.GetDeviceContext()->PSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
+    // Upload and bind constant buffer (this frame's ring memory)
+    ZConstantRing& ring = gfx.GetConstantRing();
+    ZConstantRing::Allocation cbAlloc;
+    if (!ring.Upload(&cbufCopy, sizeof(FbxStaticModelConstantBuffer), cbAlloc))
+    {
+        return;
+    }
+    ring.BindVS(0u, cbAlloc);
+    ring.BindPS(0u, cbAlloc);
 
     // Set vertex and index buffers (use our simple buffers)
     UINT stride = sizeof(VertexSimple);
     UINT offset = 0;
 
-    gfx.GetDeviceContext()->IASetVertexBuffers(0u, 1u, m_pVertexBuffer.GetAddressOf(), &stride, &offset);
-    gfx.GetDeviceContext()->IASetIndexBuffer(m_pIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0u);
+    gfx.GetStateCache().SetVertexBuffer(0u, m_pVertexBuffer.Get(), stride, offset);
+    gfx.GetStateCache().SetIndexBuffer(m_pIndexBuffer.Get(), m_IndexFormat, 0u);
 
     // Render subsets (use our own subsets)
     const auto& srvs = m_FbxManager->GetMaterialSRVs();
@@ -173,10 +177,10 @@ void FbxStaticModel::Render(ZGraphics& gfx) const noxnd
         if (subset.materialIndex >= 0 && subset.materialIndex < (int)srvs.size())
         {
             ID3D11ShaderResourceView* srv = srvs[subset.materialIndex].Get();
-            gfx.GetDeviceContext()->PSSetShaderResources(0u, 1u, &srv);
+            gfx.GetStateCache().SetPSShaderResource(0u, srv);
         }
 
-        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, 0);
+        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, subset.baseVertex);
     }
 }
 
@@ -258,8 +262,7 @@ void FbxStaticModel::BuildSimpleBuffers(ZGraphics& gfx)
         FbxSubset subset{};
         subset.startIndex = static_cast<uint32_t>(indices.size());
         subset.materialIndex = mesh->mMaterialIndex;
-
-        uint32_t vertexOffset = static_cast<uint32_t>(vertices.size());
+        subset.baseVertex = static_cast<uint32_t>(vertices.size());
 
         // Load vertices
         for (unsigned int vi = 0; vi < mesh->mNumVertices; ++vi)
@@ -303,13 +306,13 @@ void FbxStaticModel::BuildSimpleBuffers(ZGraphics& gfx)
             vertices.push_back(v);
         }
 
-        // Load indices
+        // Load indices (mesh-local, drawn with subset.baseVertex)
         for (unsigned int fi = 0; fi < mesh->mNumFaces; ++fi)
         {
             const aiFace& face = mesh->mFaces[fi];
             for (unsigned int ii = 0; ii < face.mNumIndices; ++ii)
             {
-                indices.push_back(vertexOffset + face.mIndices[ii]);
+                indices.push_back(face.mIndices[ii]);
             }
         }
 
@@ -340,14 +343,25 @@ void FbxStaticModel::BuildSimpleBuffers(ZGraphics& gfx)
         throw std::runtime_error("Failed to create vertex buffer");
     }
 
-    // Create index buffer
+    // Create index buffer (16-bit when every mesh has at most 65536 vertices)
+    std::vector<uint16_t> shortIndices;
+    if (Bind::ZIndexBuffer::FitsIn16Bit(indices.data(), indices.size()))
+    {
+        shortIndices = Bind::ZIndexBuffer::Narrow(indices.data(), indices.size());
+        m_IndexFormat = DXGI_FORMAT_R16_UINT;
+    }
+    else
+    {
+        m_IndexFormat = DXGI_FORMAT_R32_UINT;
+    }
+
     D3D11_BUFFER_DESC ibd{};
     ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
     ibd.Usage = D3D11_USAGE_DEFAULT;
-    ibd.ByteWidth = static_cast<UINT>(indices.size() * sizeof(uint32_t));
+    ibd.ByteWidth = static_cast<UINT>(indices.size() * (m_IndexFormat == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) : sizeof(uint32_t)));
 
     D3D11_SUBRESOURCE_DATA ibData{};
-    ibData.pSysMem = indices.data();
+    ibData.pSysMem = (m_IndexFormat == DXGI_FORMAT_R16_UINT) ? static_cast<const void*>(shortIndices.data()) : indices.data();
 
     hr = device->CreateBuffer(&ibd, &ibData, &m_pIndexBuffer);
     if (FAILED(hr))
@@ -64,7 +64,7 @@ public:
                    DirectX::XMFLOAT3 baseMaterialColor = { 1.0f, 1.0f, 1.0f },
                    const std::string& defaultTexturePath = "");
 
-    void Render(ZGraphics& gfx) const noxnd;
+    void Render(ZGraphics& gfx) const noxnd override;
     void Update(float deltaTime) noexcept override;
     DirectX::XMMATRIX GetTransformXM() const noexcept override;
     
@@ -96,6 +96,7 @@ private:
     // Self-managed vertex/index buffers
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_pVertexBuffer;
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_pIndexBuffer;
+    DXGI_FORMAT m_IndexFormat = DXGI_FORMAT_R32_UINT;
     UINT m_IndexCount = 0;
     std::vector<FbxSubset> m_Subsets;
     
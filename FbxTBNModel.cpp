@@ -1,6 +1,7 @@
 ﻿#include "FbxTBNModel.h"
 #include "ZBindableBase.h"
 #include "ZGraphics.h"
+#include "ZConstantRing.h"
 #include "imgui/imgui.h"
 #include <iostream>
 
@@ -11,8 +12,13 @@ FbxTBNModel::FbxTBNModel(ZGraphics& gfx, const std::string& filePath, XMFLOAT3 b
 {
     // Create FbxManager and load model
     m_FbxManager = std::make_unique<FbxManager>();
+
+    // TBN vertex format without skinning: no bone weight limiting
+    FbxImportDescriptor descriptor;
+    descriptor.diffuse.fallbackPath = defaultTexturePath;
+    descriptor.skinning = false;
     
-    if (!m_FbxManager->Load(gfx, filePath, defaultTexturePath))
+    if (!m_FbxManager->Load(gfx, filePath, descriptor))
     {
         throw std::runtime_error("Failed to load FBX model: " + filePath);
     }
@@ -143,20 +149,15 @@ void FbxTBNModel::Render(ZGraphics& gfx) const noxnd
     cbufCopy.pointLight.range = pointLight.range;
     cbufCopy.pointLight.att = pointLight.att;
 
-    // Create and bind constant buffer
-    D3D11_BUFFER_DESC cbd{};
-    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbd.Usage = D3D11_USAGE_DYNAMIC;
-    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    cbd.ByteWidth = sizeof(FbxTBNModelConstantBuffer);
-
-    D3D11_SUBRESOURCE_DATA csd{};
-    csd.pSysMem = &cbufCopy;
-
-    Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
-    gfx.GetDeviceCOM()->CreateBuffer(&cbd, &csd, &pConstantBuffer);
-    gfx.GetDeviceContext()->VSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
-    gfx.GetDeviceContext()->PSSetConstantBuffers(0u, 1u, pConstantBuffer.GetAddressOf());
+    // Upload and bind constant buffer (this frame's ring memory)
+    ZConstantRing& ring = gfx.GetConstantRing();
+    ZConstantRing::Allocation cbAlloc;
+    if (!ring.Upload(&cbufCopy, sizeof(FbxTBNModelConstantBuffer), cbAlloc))
+    {
+        return;
+    }
+    ring.BindVS(0u, cbAlloc);
+    ring.BindPS(0u, cbAlloc);
 
     // Set vertex and index buffers
     ID3D11Buffer* vb = m_FbxManager->GetVertexBuffer();
@@ -164,8 +165,8 @@ void FbxTBNModel::Render(ZGraphics& gfx) const noxnd
     UINT stride = m_FbxManager->GetVertexStride();
     UINT offset = m_FbxManager->GetVertexOffset();
 
-    gfx.GetDeviceContext()->IASetVertexBuffers(0u, 1u, &vb, &stride, &offset);
-    gfx.GetDeviceContext()->IASetIndexBuffer(ib, DXGI_FORMAT_R32_UINT, 0u);
+    gfx.GetStateCache().SetVertexBuffer(0u, vb, stride, offset);
+    gfx.GetStateCache().SetIndexBuffer(ib, m_FbxManager->GetIndexFormat(), 0u);
 
     // Render subsets
     const auto& subsets = m_FbxManager->GetSubsets();
@@ -176,10 +177,10 @@ void FbxTBNModel::Render(ZGraphics& gfx) const noxnd
         if (subset.materialIndex >= 0 && subset.materialIndex < (int)srvs.size())
         {
             ID3D11ShaderResourceView* srv = srvs[subset.materialIndex].Get();
-            gfx.GetDeviceContext()->PSSetShaderResources(0u, 1u, &srv);
+            gfx.GetStateCache().SetPSShaderResource(0u, srv);
         }
 
-        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, 0);
+        gfx.GetDeviceContext()->DrawIndexed(subset.indexCount, subset.startIndex, subset.baseVertex);
     }
 }
 
@@ -67,7 +67,7 @@ public:
                 DirectX::XMFLOAT3 baseMaterialColor = { 1.0f, 1.0f, 1.0f },
                 const std::string& defaultTexturePath = "");
 
-    void Render(ZGraphics& gfx) const noxnd;
+    void Render(ZGraphics& gfx) const noxnd override;
     void Update(float deltaTime) noexcept override;
     DirectX::XMMATRIX GetTransformXM() const noexcept override;
     
@@ -15,6 +15,20 @@
 #include "Keyboard.h"
 #include "Mouse.h"
 #include "GameMain.h"
+#include "FbxAnimation.h"
+#include "FbxAnimationBatch.h"
+#include "FbxPackedVertex.h"
+#include "FbxPaletteArena.h"
+#include "ZAssetCooker.h"
+#include "ZConstantRing.h"
+#include "ZStateCache.h"
+#include "ZRenderQueue.h"
+#include "ZInstanceBuffer.h"
+#include "ZTransformBatch.h"
+#include "ZTransformStream.h"
+#include <iostream>
+#include <sstream>
+#include <string>
 
 #pragma comment(lib, "winmm.lib")
 #pragma comment(lib, "gdiplus.lib")
@@ -41,10 +55,102 @@ void SetupConsole()
     freopen_s(&pConsole, "CONOUT$", "w", stdout);
 }
 
+// Rigs for the headless animation modes
+const std::vector<FbxAnimBenchmarkRig>& GetBenchmarkRigs()
+{
+    static const std::vector<FbxAnimBenchmarkRig> rigs = {
+        { "Erika", "./Data/Models/Erika/Erika Archer.fbx", {
+            "./Data/Models/Erika/Animations/Unarmed Idle 01.fbx",
+            "./Data/Models/Erika/Animations/Catwalk Walk Forward.fbx",
+            "./Data/Models/Erika/Animations/Drunk Walk.fbx" } },
+        { "Ely", "./Data/Models/Ely By K.Atienza/Ely By K.Atienza.fbx", {
+            "./Data/Models/Ely By K.Atienza/Animations/Unarmed Idle 01.fbx",
+            "./Data/Models/Ely By K.Atienza/Animations/Catwalk Walk Forward.fbx",
+            "./Data/Models/Ely By K.Atienza/Animations/Drunk Walk.fbx" } },
+    };
+    return rigs;
+}
+
+// Headless modes: 창/디바이스 없이 검사/벤치마크를 돌리고 결과를 콘솔에 남긴다 (종료 코드 0 = 통과, 대화 상자 없음)
+// 이 프로젝트에는 테스트 타깃이 따로 없으므로 자동 검사는 모두 이 표에 등록한다.
+struct HeadlessMode
+{
+    const char* flag;     // 명령줄 인자와 정확히 일치해야 한다
+    const char* title;
+    bool (*run)();
+};
+
+const HeadlessMode kHeadlessModes[] =
+{
+    // 애니메이션 배치 갱신 스케일링
+    { "--anim-batch-bench", "Animation batch benchmark", []() { return FbxAnimBatch::RunScalingBenchmark(GetBenchmarkRigs()); } },
+    // 정상 상태 애니메이션 갱신의 힙 할당 0회 (Debug 빌드)
+    { "--anim-alloc-check", "Animation allocation check", []() { return FbxAnimBatch::RunUpdateAllocationCheck(GetBenchmarkRigs()); } },
+    // Erika/Ely 클립: 키 스캔(기존) vs 압축 클립 샘플링 시간과 오차
+    { "--anim-sampling-bench", "Animation sampling benchmark", []() { return FbxAnim::RunSamplingBenchmark(GetBenchmarkRigs()); } },
+    // Erika/Ely 클립: 압축 크기와 원본 대비 월드 공간 본 끝점 오차
+    { "--anim-compression-report", "Animation compression report", []() { return FbxAnim::RunCompressionReport(GetBenchmarkRigs()); } },
+    // 3x4 팔레트 패킹을 기존 4x4 경로와 비교
+    { "--palette-check", "Palette packing check", []() { return FbxPalette::RunPackingCheck(GetBenchmarkRigs()); } },
+    // 양자화 스킨 정점 인코딩/디코딩 왕복 오차
+    { "--vertex-pack-check", "Vertex packing check", []() { return FbxVertexPack::RunRoundTripCheck(); } },
+    // Data/ 아래 모델/클립/텍스처를 런타임 형식으로 쿡, 바뀌지 않은 자산은 건너뛴다
+    { "--cook", "Asset cooking", []() { return ZAssetCooker::Run(ZAssetCooker::CookSettings{}); } },
+    // WARP 장치로 프레임을 흉내 내며 워밍업 뒤 상수 버퍼 생성이 0회인지
+    { "--cb-ring-check", "Constant ring check", []() { return ZConstantRing::RunSteadyStateCheck(); } },
+    // 기록용 컨텍스트로 중복 상태 바인드 필터링
+    { "--state-filter-check", "State filter check", []() { return ZStateFilter::RunRecordingCheck(); } },
+    // 1k~50k 객체 변환 일괄 계산 vs 객체별 계산
+    { "--transform-batch-bench", "Transform batch benchmark", []() { return ZTransformBatch::RunBenchmark(); } },
+    // 1k~50k 인스턴스 스트림 패킹, 드로우 호출 수 전/후
+    { "--instancing-bench", "Instancing benchmark", []() { return ZInstancing::RunPackingBenchmark(); } },
+    // 10k~100k 드로우 패킷 키 생성/기수 정렬
+    { "--render-queue-bench", "Render queue benchmark", []() { return ZRenderQueue::RunBenchmark(); } },
+};
+
+// lpCmdLine을 공백으로 나눈 인자 중 flag와 정확히 같은 것이 있는지 (부분 문자열은 일치로 보지 않는다)
+bool HasCommandLineFlag(const char* cmdLine, const char* flag)
+{
+    std::istringstream args(cmdLine);
+    std::string arg;
+    while (args >> arg)
+    {
+        if (arg == flag)
+            return true;
+    }
+    return false;
+}
+
+// 첫 번째로 일치한 headless 모드를 실행하고 종료 코드를 돌려준다, 일치하는 모드가 없으면 -1
+int RunHeadlessMode(const char* cmdLine)
+{
+    if (!cmdLine)
+        return -1;
+
+    for (const HeadlessMode& mode : kHeadlessModes)
+    {
+        if (!HasCommandLineFlag(cmdLine, mode.flag))
+            continue;
+
+        // 자동 실행이 멈추지 않도록 결과는 콘솔에만 출력한다
+        const bool passed = mode.run();
+        std::cout << "[Headless] " << mode.title << (passed ? " passed" : " FAILED") << std::endl;
+        FreeConsole();
+        return passed ? 0 : 1;
+    }
+    return -1;
+}
+
 int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nCmdShow)
 {
     SetupConsole();
 
+    const int headlessExitCode = RunHeadlessMode(lpCmdLine);
+    if (headlessExitCode >= 0)
+    {
+        return headlessExitCode;
+    }
+
     // 클라이언트 영역 크기
     const int clientWidth = 1920;
     const int clientHeight = 1080;
@@ -590,6 +696,12 @@ BOOL ZApp::Frame()
             ImGui::Text((const char*)u8"Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
             ImGui::InputText((const char*)u8"Input Test", buffer, sizeof(buffer));
 
+            const ZStateStats& stateStats = m_pGraphics->GetStateCache().GetStats();
+            ImGui::Text("State changes: %u issued, %u skipped", stateStats.TotalIssued(), stateStats.TotalSkipped());
+            const ZTransformStream::Stats& transformStats = m_pGraphics->GetTransformStream().GetStats();
+            ImGui::Text("Transform stream: %u objects, %u maps, %u offset binds", transformStats.objects, transformStats.maps,
+                        transformStats.offsetBinds);
+
 
             PROCESS_MEMORY_COUNTERS pmc;
             GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "ZVertex.h"
 #include <vector>
+#include <cstdint>
 #include <DirectXMath.h>
 
 template<class T>
@@ -8,7 +9,7 @@ class IndexedTriangleList
 {
 public:
     IndexedTriangleList() = default;
-    IndexedTriangleList(std::vector<T> verts_in, std::vector<unsigned short> indices_in)
+    IndexedTriangleList(std::vector<T> verts_in, std::vector<uint32_t> indices_in)
         :
         vertices(std::move(verts_in)),
         indices(std::move(indices_in))
@@ -51,5 +52,5 @@ public:
 
 public:
     std::vector<T> vertices;
-    std::vector<unsigned short> indices;
+    std::vector<uint32_t> indices;
 };
\ No newline at end of file
@@ -53,6 +53,12 @@ LightBox::LightBox(ZGraphics& gfx,
 
         AddStaticBind(std::make_unique<Bind::ZTopology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST));
 
+        // 인스턴싱: 변환/재질을 인스턴스 스트림에서 읽는 셰이더 (RenderInstances)
+        auto pivs = std::make_unique<Bind::ZVertexShader>(gfx, L"./x64/Debug/PhongInstancedVS.cso");
+        auto pivsbc = pivs->GetBytecode();
+        AddStaticInstancedBind(std::move(pivs));
+        AddStaticInstancedBind(std::make_unique<Bind::ZPixelShader>(gfx, L"./x64/Debug/PhongInstancedPS.cso"));
+        AddStaticInstancedBind(std::make_unique<Bind::ZInputLayout>(gfx, ZInstancing::AppendInstanceElements(ied), pivsbc));
     }
     else
     {
@@ -71,6 +77,15 @@ LightBox::LightBox(ZGraphics& gfx,
     AddBind(std::make_unique<Bind::ZTransformVSConstBuffer>(gfx, *this));
 }
 
+ZInstanceMaterial LightBox::GetInstanceMaterial() const noexcept
+{
+    ZInstanceMaterial material;
+    material.color = materialConstants.color;
+    material.specularIntensity = materialConstants.specularIntensity;
+    material.specularPower = materialConstants.specularPower;
+    return material;
+}
+
 DirectX::XMMATRIX LightBox::GetTransformXM() const noexcept
 {
     namespace dx = DirectX;
@@ -27,5 +27,6 @@ public:
         std::uniform_real_distribution<float>& bdist,
         DirectX::XMFLOAT3 materialColor);
     DirectX::XMMATRIX GetTransformXM() const noexcept override;
+    ZInstanceMaterial GetInstanceMaterial() const noexcept;   // 인스턴싱 경로 (SpawnControlWindow 수정이 바로 반영된다)
     bool SpawnControlWindow(int id, ZGraphics& gfx) noexcept;
 };
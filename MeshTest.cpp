@@ -6,6 +6,7 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include "ZVertex.h"
+#include "ZMeshOptimizer.h"
 
 using namespace Bind;
 
@@ -39,28 +40,42 @@ MeshTest::MeshTest(ZGraphics& gfx, std::mt19937& rng,
         );
         const auto pMesh = pModel->mMeshes[0];
 
+        std::vector<uint32_t> meshIndices;
+        meshIndices.reserve(pMesh->mNumFaces * 3);
+        for (unsigned int i = 0; i < pMesh->mNumFaces; i++)
+        {
+            const auto& face = pMesh->mFaces[i];
+            assert(face.mNumIndices == 3);
+            meshIndices.push_back(face.mIndices[0]);
+            meshIndices.push_back(face.mIndices[1]);
+            meshIndices.push_back(face.mIndices[2]);
+        }
+
+        // 캐시 → 오버드로 → 정점 페치 순서 최적화 (FbxManager 임포트와 같은 단계)
+        ZMeshOptimizer::OptimizeVertexCache(meshIndices.data(), meshIndices.size(), pMesh->mNumVertices);
+        ZMeshOptimizer::OptimizeOverdraw(meshIndices.data(), meshIndices.size(), pMesh->mVertices, sizeof(aiVector3D),
+                                         pMesh->mNumVertices);
+        std::vector<uint32_t> remap;
+        ZMeshOptimizer::OptimizeVertexFetch(meshIndices.data(), meshIndices.size(), pMesh->mNumVertices, remap);
+
+        // remap[old] = new → 새 순서대로 채운다
+        std::vector<unsigned int> sourceOfVertex(pMesh->mNumVertices);
         for (unsigned int i = 0; i < pMesh->mNumVertices; i++)
         {
+            sourceOfVertex[remap[i]] = i;
+        }
+        for (unsigned int n = 0; n < pMesh->mNumVertices; n++)
+        {
+            const unsigned int i = sourceOfVertex[n];
             vbuf.EmplaceBack(
                 dx::XMFLOAT3{ pMesh->mVertices[i].x * scale,pMesh->mVertices[i].y * scale,pMesh->mVertices[i].z * scale },
                 *reinterpret_cast<dx::XMFLOAT3*>(&pMesh->mNormals[i])
             );
         }
 
-        std::vector<unsigned short> indices;
-        indices.reserve(pMesh->mNumFaces * 3);
-        for (unsigned int i = 0; i < pMesh->mNumFaces; i++)
-        {
-            const auto& face = pMesh->mFaces[i];
-            assert(face.mNumIndices == 3);
-            indices.push_back(face.mIndices[0]);
-            indices.push_back(face.mIndices[1]);
-            indices.push_back(face.mIndices[2]);
-        }
-
         AddStaticBind(std::make_unique<ZVertexBuffer>(gfx, vbuf));
 
-        AddStaticIndexBuffer(std::make_unique<ZIndexBuffer>(gfx, indices));
+        AddStaticIndexBuffer(std::make_unique<ZIndexBuffer>(gfx, meshIndices));
 
         auto pvs = std::make_unique<ZVertexShader>(gfx, L"./x64/Debug/PhongVS.cso");
         auto pvsbc = pvs->GetBytecode();
@@ -71,6 +86,14 @@ MeshTest::MeshTest(ZGraphics& gfx, std::mt19937& rng,
         AddStaticBind(std::make_unique<ZInputLayout>(gfx, vbuf.GetLayout().GetD3DLayout(), pvsbc));
 
         AddStaticBind(std::make_unique<ZTopology>(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST));
+
+        // 인스턴싱: 변환/재질을 인스턴스 스트림에서 읽는 셰이더 (RenderInstances)
+        auto pivs = std::make_unique<ZVertexShader>(gfx, L"./x64/Debug/PhongInstancedVS.cso");
+        auto pivsbc = pivs->GetBytecode();
+        AddStaticInstancedBind(std::move(pivs));
+        AddStaticInstancedBind(std::make_unique<ZPixelShader>(gfx, L"./x64/Debug/PhongInstancedPS.cso"));
+        AddStaticInstancedBind(std::make_unique<ZInputLayout>(gfx,
+            ZInstancing::AppendInstanceElements(vbuf.GetLayout().GetD3DLayout()), pivsbc));
     }
     else
     {
@@ -85,6 +108,9 @@ MeshTest::MeshTest(ZGraphics& gfx, std::mt19937& rng,
         float padding[3];
     } pmc;
     pmc.color = material;
+    instanceMaterial.color = pmc.color;
+    instanceMaterial.specularIntensity = pmc.specularIntensity;
+    instanceMaterial.specularPower = pmc.specularPower;
     AddBind(std::make_unique<PSConstBuffer<PSMaterialConstant>>(gfx, pmc, 1u));
 
     AddBind(std::make_unique<ZTransformVSConstBuffer>(gfx, *this));
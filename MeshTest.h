@@ -3,6 +3,9 @@
 
 class MeshTest : public ZInteractableTransform<MeshTest>
 {
+private:
+    ZInstanceMaterial instanceMaterial;   // 슬롯 1 상수 버퍼와 같은 값 (인스턴싱 경로)
+
 public:
     MeshTest(ZGraphics& gfx, std::mt19937& rng,
         std::uniform_real_distribution<float>& adist,
@@ -11,4 +14,5 @@ public:
         std::uniform_real_distribution<float>& rdist,
         DirectX::XMFLOAT3 material,
         float scale);
+    ZInstanceMaterial GetInstanceMaterial() const noexcept { return instanceMaterial; }
 };
\ No newline at end of file
@@ -0,0 +1,37 @@
+// Instanced PhongPS: PhongPS와 같은 조명, 재질은 PhongInstancedVS가 인스턴스 스트림에서 넘겨준다 (ObjectCBuf 대신)
+cbuffer LightCBuf
+{
+    float3 lightPos;
+    float3 ambient;
+    float3 diffuseColor;
+    float diffuseIntensity;
+    float attConst;
+    float attLin;
+    float attQuad;
+};
+
+float4 main(float3 viewPos : Position, float3 n : Normal,
+            nointerpolation float4 material : Material,
+            nointerpolation float specularPower : SpecularPower) : SV_TARGET
+{
+    const float3 materialColor = material.rgb;
+    const float specularIntensity = material.a;
+
+	// fragment to light vector data
+    const float3 vToL = lightPos - viewPos;
+    const float distToL = length(vToL);
+    const float3 dirToL = vToL / distToL;
+	// attenuation
+    const float att = 1.0f / (attConst + attLin * distToL + attQuad * (distToL * distToL));
+	// diffuse intensity
+    const float3 diffuse = diffuseColor * diffuseIntensity * att * max(0.0f, dot(dirToL, n));
+	// reflected light vector
+    const float3 w = n * dot(vToL, n);
+    const float3 r = w * 2.0f - vToL;
+	// specular intensity between view vector and reflection
+    const float3 viewDir = normalize(-viewPos);
+    const float3 specular = att * (diffuseColor * diffuseIntensity) * specularIntensity
+                        * pow(max(0.0f, dot(normalize(r), viewDir)), specularPower);
+	// final color
+    return float4(saturate((diffuse + ambient + specular) * materialColor), 1.0f);
+}
\ No newline at end of file
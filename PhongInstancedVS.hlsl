@@ -0,0 +1,37 @@
+// Instanced PhongVS: 변환/재질은 인스턴스 스트림 (입력 슬롯 1), 투영만 상수 버퍼
+cbuffer FrameCBuf
+{
+    matrix proj;
+};
+
+struct VSIn
+{
+    float3 pos : Position;
+    float3 n : Normal;
+    float4 modelView0 : InstanceModelView0;    // transpose(model * view) 행 0~2
+    float4 modelView1 : InstanceModelView1;
+    float4 modelView2 : InstanceModelView2;
+    float4 material : InstanceMaterial0;       // rgb: materialColor, a: specularIntensity
+    float4 materialExtra : InstanceMaterial1;  // x: specularPower
+};
+
+struct VSOut
+{
+    float3 cameraPos : Position;
+    float3 normal : Normal;
+    nointerpolation float4 material : Material;
+    nointerpolation float specularPower : SpecularPower;
+    float4 pos : SV_Position;
+};
+
+VSOut main(VSIn vin)
+{
+    VSOut vso;
+    const float4 p = float4(vin.pos, 1.0f);
+    vso.cameraPos = float3(dot(vin.modelView0, p), dot(vin.modelView1, p), dot(vin.modelView2, p));
+    vso.normal = float3(dot(vin.modelView0.xyz, vin.n), dot(vin.modelView1.xyz, vin.n), dot(vin.modelView2.xyz, vin.n));
+    vso.pos = mul(float4(vso.cameraPos, 1.0f), proj);
+    vso.material = vin.material;
+    vso.specularPower = vin.materialExtra.x;
+    return vso;
+}
\ No newline at end of file
@@ -1,4 +1,4 @@
-#pragma once
+﻿#pragma once
 
 #include <vector>
 #include <array>
@@ -73,7 +73,7 @@ public:
         }
 
         // ========== 2단계: 인덱스 생성 (삼각형 구성) ==========
-        std::vector<unsigned short> indices;
+        std::vector<uint32_t> indices;
         // 각 사각형은 2개의 삼각형(6개 인덱스)으로 구성됨
         indices.reserve(sqroot(divisions_x * divisions_y) * 6);
         {
@@ -82,7 +82,7 @@ public:
             // 예: nVertices_x=3일 때, (1,2) -> 2*3+1 = 7
             const auto vxy2i = [nVertices_x](size_t x, size_t y)
                 {
-                    return (unsigned short)(y * nVertices_x + x);
+                    return (uint32_t)(y * nVertices_x + x);
                 };
             
             // 각 사각형(quad)을 순회하며 삼각형 생성
@@ -101,7 +101,7 @@ public:
                     //    |        |
                     //    |        |
                     //   [0]------[1]
-                    const std::array<unsigned short, 4> indexArray =
+                    const std::array<uint32_t, 4> indexArray =
                     { vxy2i(x,y),vxy2i(x + 1,y),vxy2i(x,y + 1),vxy2i(x + 1,y + 1) };
                     
                     // 첫 번째 삼각형: 왼쪽 아래 삼각형 (0 -> 2 -> 1)
@@ -126,6 +126,7 @@ void PlayerControlState::Exit()
         ID3D11Buffer* nullVB[1] = { nullptr };
         context->IAGetVertexBuffers(0, 1, nullVB, &stride, &offset);
         context->IASetIndexBuffer(nullptr, DXGI_FORMAT_UNKNOWN, 0);
+        gfx_.GetStateCache().Invalidate();  // 캐시를 거치지 않고 풀었다
 
         // 렌더 타겟 클리어
         gfx_.ClearBuffer(0.0f, 0.0f, 0.0f);
@@ -139,7 +140,9 @@ void PlayerControlState::Update(float deltaTime)
     elapsedTime_ += deltaTime;
     deltaTime_ = deltaTime;
 
-    fbxModel_->Update(deltaTime);
+    // 스킨드 인스턴스 전체를 한 번에 갱신 (애니메이션 LOD 적용, 렌더 전에 join)
+    FbxModel* models[] = { fbxModel_.get() };
+    FbxModel::UpdateAnimations(gfx_, models, 1, deltaTime, animLodInstances_);
 }
 
 void PlayerControlState::Render(ZGraphics& gfx)
@@ -148,7 +151,7 @@ void PlayerControlState::Render(ZGraphics& gfx)
 
     if (gfx.IsImguiEnabled())
     {
-        fbxModel_->ShowControlWindow();
+        fbxModel_->ShowControlWindow(gfx);
     }
 }
 
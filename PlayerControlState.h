@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "GameState.h"
+#include "FbxAnimationLod.h"
+#include <vector>
 
 class PlayerControlState : public GameState
 {
@@ -35,5 +37,6 @@ private:
     double deltaTime_; // 게임 플레이 사이사이 시간(프레임과 프레임 사이 시간)
 
     std::unique_ptr<class FbxModel> fbxModel_; // 클래스 멤버변수 뒤에 _ 
+    std::vector<FbxAnimLodInstance> animLodInstances_; // FbxModel::UpdateAnimations 버퍼 (프레임마다 재사용)
 
 };
\ No newline at end of file
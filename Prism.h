@@ -20,11 +20,11 @@ public:
         std::vector<V> vertices;
         vertices.emplace_back();
         vertices.back().pos = { 0.0f,0.0f,-1.0f };
-        const auto iCenterNear = (unsigned short)(vertices.size() - 1);
+        const auto iCenterNear = (uint32_t)(vertices.size() - 1);
         // far center
         vertices.emplace_back();
         vertices.back().pos = { 0.0f,0.0f,1.0f };
-        const auto iCenterFar = (unsigned short)(vertices.size() - 1);
+        const auto iCenterFar = (uint32_t)(vertices.size() - 1);
 
         // base vertices
         for (int iLong = 0; iLong < longDiv; iLong++)
@@ -51,8 +51,8 @@ public:
         }
 
         // side indices
-        std::vector<unsigned short> indices;
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        std::vector<uint32_t> indices;
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             const auto i = iLong * 2;
             const auto mod = longDiv * 2;
@@ -65,7 +65,7 @@ public:
         }
 
         // base indices
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             const auto i = iLong * 2;
             const auto mod = longDiv * 2;
@@ -92,12 +92,12 @@ public:
         std::vector<V> vertices;
 
         // near center
-        const auto iCenterNear = (unsigned short)vertices.size();
+        const auto iCenterNear = (uint32_t)vertices.size();
         vertices.emplace_back();
         vertices.back().pos = { 0.0f,0.0f,-1.0f };
         vertices.back().n = { 0.0f,0.0f,-1.0f };
         // near base vertices
-        const auto iBaseNear = (unsigned short)vertices.size();
+        const auto iBaseNear = (uint32_t)vertices.size();
         for (int iLong = 0; iLong < longDiv; iLong++)
         {
             vertices.emplace_back();
@@ -109,12 +109,12 @@ public:
             vertices.back().n = { 0.0f,0.0f,-1.0f };
         }
         // far center
-        const auto iCenterFar = (unsigned short)vertices.size();
+        const auto iCenterFar = (uint32_t)vertices.size();
         vertices.emplace_back();
         vertices.back().pos = { 0.0f,0.0f,1.0f };
         vertices.back().n = { 0.0f,0.0f,1.0f };
         // far base vertices
-        const auto iBaseFar = (unsigned short)vertices.size();
+        const auto iBaseFar = (uint32_t)vertices.size();
         for (int iLong = 0; iLong < longDiv; iLong++)
         {
             vertices.emplace_back();
@@ -127,7 +127,7 @@ public:
             vertices.back().n = { 0.0f,0.0f,1.0f };
         }
         // fusilage vertices
-        const auto iFusilage = (unsigned short)vertices.size();
+        const auto iFusilage = (uint32_t)vertices.size();
         for (int iLong = 0; iLong < longDiv; iLong++)
         {
             // near base
@@ -153,10 +153,10 @@ public:
             }
         }
 
-        std::vector<unsigned short> indices;
+        std::vector<uint32_t> indices;
 
         // near base indices
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             const auto i = iLong;
             const auto mod = longDiv;
@@ -166,7 +166,7 @@ public:
             indices.push_back((i + 1) % mod + iBaseNear);
         }
         // far base indices
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             const auto i = iLong;
             const auto mod = longDiv;
@@ -176,7 +176,7 @@ public:
             indices.push_back((i + 1) % mod + iBaseFar);
         }
         // fusilage indices
-        for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+        for (int iLong = 0; iLong < longDiv; iLong++)
         {
             const auto i = iLong * 2;
             const auto mod = longDiv * 2;
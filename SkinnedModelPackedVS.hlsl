@@ -0,0 +1,140 @@
+// Skinned Vertex Shader for the quantized vertex format (FbxPackedVertex, 32 bytes)
+// Same skinning and outputs as SkinnedModelVS.hlsl; the vertex is decoded first
+
+// Constant Buffer (b0)
+cbuffer ConstantBuffer : register(b0)
+{
+    matrix world;
+    matrix view;
+    matrix proj;
+    matrix worldInvTranspose;
+    
+    // Material (not used in VS, but keeps buffer layout consistent)
+    float4 materialAmbient;
+    float4 materialDiffuse;
+    float4 materialSpecular;
+    float4 materialReflect;
+    
+    // DirectionalLight (not used in VS)
+    float4 dirLightAmbient;
+    float4 dirLightDiffuse;
+    float4 dirLightSpecular;
+    float3 dirLightDirection;
+    float  dirLightPad;
+    
+    // PointLight (not used in VS)
+    float4 pointLightAmbient;
+    float4 pointLightDiffuse;
+    float4 pointLightSpecular;
+    float3 pointLightPosition;
+    float  pointLightRange;
+    float3 pointLightAtt;
+    float  pointLightPad;
+    
+    float3 eyePosW;
+    float  pad;
+    int    shadingMode;
+    float3 pad2;
+    int    enableNormalMap;       // Used only in pixel shader
+    float3 pad3;
+    int    useSpecularMap;
+    float3 pad4;
+}
+
+// Bone Palette (t0): 3 float4 rows per bone (3x4 affine, column vector), shared by all instances
+Buffer<float4> bonePalette : register(t0);
+
+// Bone range of this instance (b1)
+cbuffer BonesBuffer : register(b1)
+{
+    uint paletteBase;   // first row of this instance in bonePalette
+    uint boneCount;
+    uint2 bonePad;
+}
+
+// Vertex Input (FbxPackedVertex)
+struct VertexInPacked
+{
+    float3 posL     : POSITION;
+    float2 normalL  : NORMAL;        // octahedral (R16G16_SNORM)
+    float4 tangentL : TANGENT;       // octahedral xy, w = bitangent sign (R8G8B8A8_SNORM)
+    float2 tex      : TEXCOORD;      // R16G16_FLOAT
+    uint4  boneIdx  : BLENDINDICES;  // R8G8B8A8_UINT
+    float4 boneW    : BLENDWEIGHT;   // R8G8B8A8_UNORM, sum = 1
+};
+
+// Vertex Output (same as SkinnedModelVS.hlsl)
+struct VertexOut
+{
+    float4 posH      : SV_POSITION;
+    float3 posW      : TEXCOORD0;
+    float3 normalW   : TEXCOORD1;
+    float2 tex       : TEXCOORD2;
+    float4 color     : COLOR;
+    float3 tangentW  : TEXCOORD3;
+    float3 bitanW    : TEXCOORD4;
+};
+
+// Octahedral decode (FbxVertexPack::DecodeOctahedral)
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0f) ? -t : t;
+    return normalize(n);
+}
+
+// Vertex Shader Entry Point
+VertexOut main(VertexInPacked vIn)
+{
+    VertexOut vOut;
+    
+    // Tangent frame (bitangent rebuilt from the handedness sign)
+    float3 normalIn = DecodeOctahedral(vIn.normalL);
+    float3 tangentIn = DecodeOctahedral(vIn.tangentL.xy);
+    float3 bitanIn = cross(normalIn, tangentIn) * (vIn.tangentL.w < 0.0f ? -1.0f : 1.0f);
+    
+    // Skinning: blend up to 4 bones (3 rows each)
+    float4 skinRow0 = 0.0f;
+    float4 skinRow1 = 0.0f;
+    float4 skinRow2 = 0.0f;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint boneIndex = vIn.boneIdx[i];
+        float weight = vIn.boneW[i];
+        
+        if (weight > 0.0f && boneIndex < boneCount)
+        {
+            uint row = paletteBase + boneIndex * 3;
+            skinRow0 += bonePalette[row + 0] * weight;
+            skinRow1 += bonePalette[row + 1] * weight;
+            skinRow2 += bonePalette[row + 2] * weight;
+        }
+    }
+    
+    // Apply skinning to position
+    float4 skinPos = float4(vIn.posL, 1.0f);
+    float4 posL = float4(dot(skinRow0, skinPos), dot(skinRow1, skinPos), dot(skinRow2, skinPos), 1.0f);
+    
+    // Transform to world space
+    float4 posW = mul(posL, world);
+    vOut.posH = mul(posW, view);
+    vOut.posH = mul(vOut.posH, proj);
+    vOut.posW = posW.xyz;
+    
+    // Apply skinning to normal, tangent, bitangent (only rotation, no translation)
+    float3x3 skinRotation = float3x3(skinRow0.xyz, skinRow1.xyz, skinRow2.xyz);
+    float3 normalL = mul(skinRotation, normalIn);
+    float3 tangentL = mul(skinRotation, tangentIn);
+    float3 bitanL = mul(skinRotation, bitanIn);
+    
+    // Normal with the inverse transpose (non-uniform scale), tangent frame with the world matrix
+    vOut.normalW = normalize(mul(normalL, (float3x3)worldInvTranspose));
+    vOut.tangentW = mul(tangentL, (float3x3)world);
+    vOut.bitanW = mul(bitanL, (float3x3)world);
+    
+    vOut.tex = vIn.tex;
+    vOut.color = float4(1.0f, 1.0f, 1.0f, 1.0f);   // no color stream (source path was always white)
+    
+    return vOut;
+}
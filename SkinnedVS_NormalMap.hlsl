@@ -41,13 +41,15 @@ cbuffer ConstantBuffer : register(b0)
     float3 pad4;
 }
 
-// Bone Palette Buffer (b1)
-#define MAX_BONES 1023
+// Bone Palette (t0): 3 float4 rows per bone (3x4 affine, column vector), shared by all instances
+Buffer<float4> bonePalette : register(t0);
+
+// Bone range of this instance (b1)
 cbuffer BonesBuffer : register(b1)
 {
-    row_major matrix bonePalette[MAX_BONES];
+    uint paletteBase;   // first row of this instance in bonePalette
     uint boneCount;
-    float3 bonePad;
+    uint2 bonePad;
 }
 
 // Vertex Input (Skinned format with tangent space)
@@ -80,8 +82,10 @@ VertexOut main(VertexInSkinned vIn)
 {
     VertexOut vOut;
     
-    // Skinning: blend up to 4 bones
-    float4x4 skinTransform = (float4x4)0;
+    // Skinning: blend up to 4 bones (3 rows each)
+    float4 skinRow0 = 0.0f;
+    float4 skinRow1 = 0.0f;
+    float4 skinRow2 = 0.0f;
     for (int i = 0; i < 4; ++i)
     {
         uint boneIndex = vIn.boneIdx[i];
@@ -89,12 +93,16 @@ VertexOut main(VertexInSkinned vIn)
         
         if (weight > 0.0f && boneIndex < boneCount)
         {
-            skinTransform += bonePalette[boneIndex] * weight;
+            uint row = paletteBase + boneIndex * 3;
+            skinRow0 += bonePalette[row + 0] * weight;
+            skinRow1 += bonePalette[row + 1] * weight;
+            skinRow2 += bonePalette[row + 2] * weight;
         }
     }
     
     // Apply skinning to position
-    float4 posL = mul(float4(vIn.posL, 1.0f), skinTransform);
+    float4 skinPos = float4(vIn.posL, 1.0f);
+    float4 posL = float4(dot(skinRow0, skinPos), dot(skinRow1, skinPos), dot(skinRow2, skinPos), 1.0f);
     
     // Transform to world space
     float4 posW = mul(posL, world);
@@ -104,9 +112,10 @@ VertexOut main(VertexInSkinned vIn)
     
     // Apply skinning to normal, tangent, bitangent (only rotation, no translation)
     // This ensures proper tangent space transformation for normal mapping
-    float3 normalL = mul(vIn.normalL, (float3x3)skinTransform);
-    float3 tangentL = mul(vIn.tangentL, (float3x3)skinTransform);
-    float3 bitanL = mul(vIn.bitanL, (float3x3)skinTransform);
+    float3x3 skinRotation = float3x3(skinRow0.xyz, skinRow1.xyz, skinRow2.xyz);
+    float3 normalL = mul(skinRotation, vIn.normalL);
+    float3 tangentL = mul(skinRotation, vIn.tangentL);
+    float3 bitanL = mul(skinRotation, vIn.bitanL);
     
     // Transform to world space
     // === 노멀 벡터 변환 (비균일 스케일링 보정) ===
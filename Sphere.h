@@ -39,19 +39,19 @@ public:
         }
 
         // add the cap vertices
-        const auto iNorthPole = (unsigned short)vertices.size();
+        const auto iNorthPole = (uint32_t)vertices.size();
         vertices.emplace_back();
         dx::XMStoreFloat3(&vertices.back().pos, base);
-        const auto iSouthPole = (unsigned short)vertices.size();
+        const auto iSouthPole = (uint32_t)vertices.size();
         vertices.emplace_back();
         dx::XMStoreFloat3(&vertices.back().pos, dx::XMVectorNegate(base));
 
-        const auto calcIdx = [latDiv, longDiv](unsigned short iLat, unsigned short iLong)
-            { return iLat * longDiv + iLong; };
-        std::vector<unsigned short> indices;
-        for (unsigned short iLat = 0; iLat < latDiv - 2; iLat++)
+        const auto calcIdx = [latDiv, longDiv](int iLat, int iLong)
+            { return (uint32_t)(iLat * longDiv + iLong); };
+        std::vector<uint32_t> indices;
+        for (int iLat = 0; iLat < latDiv - 2; iLat++)
         {
-            for (unsigned short iLong = 0; iLong < longDiv - 1; iLong++)
+            for (int iLong = 0; iLong < longDiv - 1; iLong++)
             {
                 indices.push_back(calcIdx(iLat, iLong));
                 indices.push_back(calcIdx(iLat + 1, iLong));
@@ -70,7 +70,7 @@ public:
         }
 
         // cap fans
-        for (unsigned short iLong = 0; iLong < longDiv - 1; iLong++)
+        for (int iLong = 0; iLong < longDiv - 1; iLong++)
         {
             // north
             indices.push_back(iNorthPole);
@@ -64,6 +64,12 @@ TexturedBox::TexturedBox(ZGraphics& gfx,
             float padding[2];
         } colorConst;
         AddStaticBind(std::make_unique<PSConstBuffer<PSMaterialConstant>>(gfx, colorConst, 1u));
+
+        // 인스턴싱: 변환만 인스턴스 스트림에서 읽는다 (재질은 위의 정적 상수 버퍼, PS 공용)
+        auto pivs = std::make_unique<ZVertexShader>(gfx, L"./x64/Debug/TexturedPhongInstancedVS.cso");
+        auto pivsbc = pivs->GetBytecode();
+        AddStaticInstancedBind(std::move(pivs));
+        AddStaticInstancedBind(std::make_unique<ZInputLayout>(gfx, ZInstancing::AppendInstanceElements(ied), pivsbc));
     }
     else
     {
@@ -0,0 +1,34 @@
+// Instanced TexturedPhongVS: 변환은 인스턴스 스트림 (입력 슬롯 1), 재질은 TexturedPhongPS의 정적 ObjectCBuf
+cbuffer FrameCBuf
+{
+    matrix proj;
+};
+
+struct VSIn
+{
+    float3 pos : Position;
+    float3 n : Normal;
+    float2 tc : Texcoord;
+    float4 modelView0 : InstanceModelView0;    // transpose(model * view) 행 0~2
+    float4 modelView1 : InstanceModelView1;
+    float4 modelView2 : InstanceModelView2;
+};
+
+struct VSOut
+{
+    float3 worldPos : Position;
+    float3 normal : Normal;
+    float2 tc : Texcoord;
+    float4 pos : SV_Position;
+};
+
+VSOut main(VSIn vin)
+{
+    VSOut vso;
+    const float4 p = float4(vin.pos, 1.0f);
+    vso.worldPos = float3(dot(vin.modelView0, p), dot(vin.modelView1, p), dot(vin.modelView2, p));
+    vso.normal = float3(dot(vin.modelView0.xyz, vin.n), dot(vin.modelView1.xyz, vin.n), dot(vin.modelView2.xyz, vin.n));
+    vso.pos = mul(float4(vso.worldPos, 1.0f), proj);
+    vso.tc = vin.tc;
+    return vso;
+}
\ No newline at end of file
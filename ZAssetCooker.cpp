@@ -0,0 +1,919 @@
+﻿#include "ZAssetCooker.h"
+#include "FbxManager.h"
+#include "FbxMeshCache.h"
+#include "FbxPackedVertex.h"
+#include "ZThreadPool.h"
+#include "DDSTextureLoader.h"
+#include "WICTextureLoader.h"
+#include <wincodec.h>
+#include <wrl/client.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cwctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#pragma comment(lib, "windowscodecs.lib")
+
+using Microsoft::WRL::ComPtr;
+namespace fs = std::filesystem;
+
+namespace
+{
+    // DDS file layout (DDS.h of DirectXTex/DirectXTK is not part of the public headers)
+    constexpr uint32_t kDdsMagic = 0x20534444;            // "DDS "
+    constexpr uint32_t kDdsFourCCDX10 = 0x30315844;       // "DX10"
+    constexpr uint32_t kDdsHeaderFlags = 0x1 | 0x2 | 0x4 | 0x8 | 0x1000 | 0x20000;  // CAPS|HEIGHT|WIDTH|PITCH|PIXELFORMAT|MIPMAPCOUNT
+    constexpr uint32_t kDdsPixelFormatFourCC = 0x4;
+    constexpr uint32_t kDdsCapsTexture = 0x1000;
+    constexpr uint32_t kDdsCapsMipmap = 0x400000 | 0x8;   // MIPMAP|COMPLEX
+    constexpr uint32_t kDdsDimensionTexture2D = 3;
+
+    struct DdsPixelFormat
+    {
+        uint32_t size;
+        uint32_t flags;
+        uint32_t fourCC;
+        uint32_t rgbBitCount;
+        uint32_t rBitMask;
+        uint32_t gBitMask;
+        uint32_t bBitMask;
+        uint32_t aBitMask;
+    };
+
+    struct DdsHeader
+    {
+        uint32_t size;
+        uint32_t flags;
+        uint32_t height;
+        uint32_t width;
+        uint32_t pitchOrLinearSize;
+        uint32_t depth;
+        uint32_t mipMapCount;
+        uint32_t reserved1[11];    // 쿡 스탬프 (DDS 로더는 읽지 않는다)
+        DdsPixelFormat pixelFormat;
+        uint32_t caps;
+        uint32_t caps2;
+        uint32_t caps3;
+        uint32_t caps4;
+        uint32_t reserved2;
+    };
+    static_assert(sizeof(DdsHeader) == 124, "DDS_HEADER layout");
+
+    struct DdsHeaderDX10
+    {
+        uint32_t dxgiFormat;
+        uint32_t resourceDimension;
+        uint32_t miscFlag;
+        uint32_t arraySize;
+        uint32_t miscFlags2;
+    };
+
+    // Source identity + settings, stored in DdsHeader::reserved1
+    constexpr char kTextureStampMagic[4] = { 'Z', 'C', 'K', 'T' };
+    struct TextureStamp
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceSize;
+        uint64_t sourceWriteTime;
+        uint64_t sourceHash;
+        uint32_t settings;
+    };
+    static_assert(sizeof(TextureStamp) <= sizeof(DdsHeader::reserved1), "stamp must fit DDS reserved1");
+
+    uint32_t TextureSettingsKey(const ZAssetCooker::CookSettings& settings)
+    {
+        return settings.generateMips ? 1u : 0u;
+    }
+
+    std::string ToLower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    // WIC로 읽을 수 있는 이미지만 (DDS는 이미 런타임 형식, TGA/PSD는 런타임도 읽지 않는다)
+    bool IsTextureFile(const fs::path& path)
+    {
+        const std::string ext = ToLower(path.extension().string());
+        return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tif" || ext == ".tiff" || ext == ".gif";
+    }
+
+    bool IsModelFile(const fs::path& path)
+    {
+        return ToLower(path.extension().string()) == ".fbx";
+    }
+
+    // Animations/, animation/, animations/ ... below the model root
+    bool IsInAnimationDirectory(const fs::path& relativePath)
+    {
+        for (const fs::path& part : relativePath.parent_path())
+        {
+            if (ToLower(part.string()).rfind("anim", 0) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool ReadTextureStamp(const fs::path& cookedPath, TextureStamp& outStamp)
+    {
+        std::ifstream in(cookedPath, std::ios::binary);
+        uint32_t magic = 0;
+        DdsHeader header{};
+        if (!in.read(reinterpret_cast<char*>(&magic), sizeof(magic)) || !in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return false;
+        if (magic != kDdsMagic || header.size != sizeof(DdsHeader))
+            return false;
+        std::memcpy(&outStamp, header.reserved1, sizeof(TextureStamp));
+        return std::memcmp(outStamp.magic, kTextureStampMagic, sizeof(kTextureStampMagic)) == 0;
+    }
+
+    bool IsCookedTextureValid(const fs::path& sourcePath, const fs::path& cookedPath, uint32_t settingsKey)
+    {
+        TextureStamp stamp{};
+        if (!ReadTextureStamp(cookedPath, stamp) || stamp.version != ZAssetCooker::kTextureVersion || stamp.settings != settingsKey)
+            return false;
+        return FbxMeshCache::MatchesSource(sourcePath.string(),
+                                           FbxMeshCache::SourceStamp{ stamp.sourceSize, stamp.sourceWriteTime, stamp.sourceHash });
+    }
+
+    fs::path GetCookedTexturePath(const fs::path& sourcePath)
+    {
+        fs::path cooked = sourcePath;
+        cooked += ".zdds";
+        return cooked;
+    }
+
+    // sRGB <-> linear (밉은 선형 공간에서 평균)
+    const std::array<float, 256>& SrgbToLinearTable()
+    {
+        static const std::array<float, 256> table = []()
+        {
+            std::array<float, 256> values{};
+            for (int i = 0; i < 256; ++i)
+            {
+                const float c = i / 255.0f;
+                values[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    uint8_t LinearToSrgb(float linear)
+    {
+        const float c = (linear <= 0.0031308f) ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>((std::min)(255.0f, (std::max)(0.0f, c * 255.0f + 0.5f)));
+    }
+
+    // 2x2 box filter (홀수 크기는 가장자리 텍셀을 반복), alpha is always linear
+    void DownsampleBox(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst, uint32_t dstWidth,
+                       uint32_t dstHeight, uint32_t channels, bool srgb)
+    {
+        const std::array<float, 256>& toLinear = SrgbToLinearTable();
+        for (uint32_t y = 0; y < dstHeight; ++y)
+        {
+            const uint32_t y0 = (std::min)(y * 2, srcHeight - 1);
+            const uint32_t y1 = (std::min)(y * 2 + 1, srcHeight - 1);
+            for (uint32_t x = 0; x < dstWidth; ++x)
+            {
+                const uint32_t x0 = (std::min)(x * 2, srcWidth - 1);
+                const uint32_t x1 = (std::min)(x * 2 + 1, srcWidth - 1);
+                const uint8_t* texels[4] = {
+                    src + (static_cast<size_t>(y0) * srcWidth + x0) * channels, src + (static_cast<size_t>(y0) * srcWidth + x1) * channels,
+                    src + (static_cast<size_t>(y1) * srcWidth + x0) * channels, src + (static_cast<size_t>(y1) * srcWidth + x1) * channels };
+                uint8_t* out = dst + (static_cast<size_t>(y) * dstWidth + x) * channels;
+
+                for (uint32_t c = 0; c < channels; ++c)
+                {
+                    if (srgb && c < 3)
+                    {
+                        const float sum = toLinear[texels[0][c]] + toLinear[texels[1][c]] + toLinear[texels[2][c]] + toLinear[texels[3][c]];
+                        out[c] = LinearToSrgb(sum * 0.25f);
+                    }
+                    else
+                    {
+                        out[c] = static_cast<uint8_t>((texels[0][c] + texels[1][c] + texels[2][c] + texels[3][c] + 2) / 4);
+                    }
+                }
+            }
+        }
+    }
+
+    // WICTextureLoader와 같은 sRGB 판정 (PNG sRGB 청크, 그 외는 EXIF 색공간)
+    bool IsSrgbImage(IWICBitmapDecoder* decoder, IWICBitmapFrameDecode* frame)
+    {
+        ComPtr<IWICMetadataQueryReader> metadata;
+        GUID container{};
+        if (FAILED(frame->GetMetadataQueryReader(&metadata)) || FAILED(decoder->GetContainerFormat(&container)))
+            return false;
+
+        bool srgb = false;
+        PROPVARIANT value;
+        PropVariantInit(&value);
+        if (container == GUID_ContainerFormatPng)
+        {
+            srgb = SUCCEEDED(metadata->GetMetadataByName(L"/sRGB/RenderingIntent", &value)) && value.vt == VT_UI1;
+        }
+        else if (SUCCEEDED(metadata->GetMetadataByName(L"System.Image.ColorSpace", &value)) && value.vt == VT_UI2)
+        {
+            srgb = (value.uiVal == 1);
+        }
+        PropVariantClear(&value);
+        return srgb;
+    }
+
+    // COM + WIC factory for the calling thread (풀 스레드는 COM이 초기화되어 있지 않다, 이미 되어 있으면 S_FALSE/RPC_E_CHANGED_MODE)
+    class ScopedWicFactory
+    {
+    public:
+        ScopedWicFactory()
+            : coInit_(CoInitializeEx(nullptr, COINIT_MULTITHREADED))
+        {
+            CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory_));
+        }
+
+        ~ScopedWicFactory()
+        {
+            factory_.Reset();
+            if (SUCCEEDED(coInit_))
+            {
+                CoUninitialize();
+            }
+        }
+
+        IWICImagingFactory* Get() const { return factory_.Get(); }
+
+    private:
+        HRESULT coInit_;
+        ComPtr<IWICImagingFactory> factory_;
+    };
+
+    // Decode → RGBA8 (8-bit gray: R8, same as WICTextureLoader) + box filtered mip chain
+    bool DecodeTexture(IWICImagingFactory* factory, const fs::path& sourcePath, bool generateMips,
+                       ZAssetCooker::DecodedTexture& out, std::string& outMessage)
+    {
+        ComPtr<IWICBitmapDecoder> decoder;
+        ComPtr<IWICBitmapFrameDecode> frame;
+        WICPixelFormatGUID sourceFormat{};
+        if (!factory ||
+            FAILED(factory->CreateDecoderFromFilename(sourcePath.wstring().c_str(), nullptr, GENERIC_READ,
+                                                      WICDecodeMetadataCacheOnDemand, &decoder)) ||
+            FAILED(decoder->GetFrame(0, &frame)) || FAILED(frame->GetPixelFormat(&sourceFormat)))
+        {
+            outMessage = "WIC decode failed";
+            return false;
+        }
+
+        const bool gray = (sourceFormat == GUID_WICPixelFormat8bppGray);
+        const uint32_t channels = gray ? 1 : 4;
+        ComPtr<IWICFormatConverter> converter;
+        if (FAILED(factory->CreateFormatConverter(&converter)) ||
+            FAILED(converter->Initialize(frame.Get(), gray ? GUID_WICPixelFormat8bppGray : GUID_WICPixelFormat32bppRGBA,
+                                         WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeMedianCut)))
+        {
+            outMessage = "WIC conversion failed";
+            return false;
+        }
+
+        UINT width = 0;
+        UINT height = 0;
+        frame->GetSize(&width, &height);
+        if (width == 0 || height == 0 || width > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION || height > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+        {
+            outMessage = "unsupported size " + std::to_string(width) + "x" + std::to_string(height);
+            return false;
+        }
+        const bool srgb = !gray && IsSrgbImage(decoder.Get(), frame.Get());
+
+        uint32_t mipCount = 1;
+        if (generateMips)
+        {
+            for (uint32_t size = (std::max)(width, height); size > 1; size >>= 1)
+                ++mipCount;
+        }
+
+        out.width = width;
+        out.height = height;
+        out.mipCount = mipCount;
+        out.bytesPerPixel = channels;
+        out.format = gray ? DXGI_FORMAT_R8_UNORM : (srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM);
+        out.pixels.resize(static_cast<size_t>(width) * height * channels);
+        if (FAILED(converter->CopyPixels(nullptr, width * channels, width * height * channels, out.pixels.data())))
+        {
+            outMessage = "WIC copy failed";
+            return false;
+        }
+
+        size_t levelOffset = 0;
+        uint32_t levelWidth = width;
+        uint32_t levelHeight = height;
+        for (uint32_t level = 1; level < mipCount; ++level)
+        {
+            const uint32_t nextWidth = (std::max)(1u, levelWidth / 2);
+            const uint32_t nextHeight = (std::max)(1u, levelHeight / 2);
+            const size_t nextOffset = out.pixels.size();
+            out.pixels.resize(nextOffset + static_cast<size_t>(nextWidth) * nextHeight * channels);
+            DownsampleBox(out.pixels.data() + levelOffset, levelWidth, levelHeight, out.pixels.data() + nextOffset, nextWidth,
+                          nextHeight, channels, srgb);
+            levelOffset = nextOffset;
+            levelWidth = nextWidth;
+            levelHeight = nextHeight;
+        }
+        return true;
+    }
+
+    // Decoded image → DDS (DX10 header) next to the source
+    bool CookTexture(IWICImagingFactory* factory, const fs::path& sourcePath, const ZAssetCooker::CookSettings& settings,
+                     bool& outUpToDate, std::string& outMessage)
+    {
+        const fs::path cookedPath = GetCookedTexturePath(sourcePath);
+        const uint32_t settingsKey = TextureSettingsKey(settings);
+        outUpToDate = IsCookedTextureValid(sourcePath, cookedPath, settingsKey);
+        if (outUpToDate)
+            return true;
+
+        ZAssetCooker::DecodedTexture image;
+        if (!DecodeTexture(factory, sourcePath, settings.generateMips, image, outMessage))
+            return false;
+
+        FbxMeshCache::SourceStamp sourceStamp;
+        if (!FbxMeshCache::StampSource(sourcePath.string(), sourceStamp))
+        {
+            outMessage = "cannot hash source";
+            return false;
+        }
+        TextureStamp stamp{};
+        std::memcpy(stamp.magic, kTextureStampMagic, sizeof(kTextureStampMagic));
+        stamp.version = ZAssetCooker::kTextureVersion;
+        stamp.sourceSize = sourceStamp.size;
+        stamp.sourceWriteTime = sourceStamp.writeTime;
+        stamp.sourceHash = sourceStamp.hash;
+        stamp.settings = settingsKey;
+
+        DdsHeader header{};
+        header.size = sizeof(DdsHeader);
+        header.flags = kDdsHeaderFlags;
+        header.height = image.height;
+        header.width = image.width;
+        header.pitchOrLinearSize = image.width * image.bytesPerPixel;
+        header.mipMapCount = image.mipCount;
+        std::memcpy(header.reserved1, &stamp, sizeof(stamp));
+        header.pixelFormat.size = sizeof(DdsPixelFormat);
+        header.pixelFormat.flags = kDdsPixelFormatFourCC;
+        header.pixelFormat.fourCC = kDdsFourCCDX10;
+        header.caps = kDdsCapsTexture | (image.mipCount > 1 ? kDdsCapsMipmap : 0);
+
+        DdsHeaderDX10 headerDX10{};
+        headerDX10.dxgiFormat = image.format;
+        headerDX10.resourceDimension = kDdsDimensionTexture2D;
+        headerDX10.arraySize = 1;
+
+        // Header + every mip level in one buffer
+        const size_t headerBytes = sizeof(kDdsMagic) + sizeof(DdsHeader) + sizeof(DdsHeaderDX10);
+        std::vector<uint8_t> file(headerBytes + image.pixels.size());
+        std::memcpy(file.data(), &kDdsMagic, sizeof(kDdsMagic));
+        std::memcpy(file.data() + sizeof(kDdsMagic), &header, sizeof(DdsHeader));
+        std::memcpy(file.data() + sizeof(kDdsMagic) + sizeof(DdsHeader), &headerDX10, sizeof(DdsHeaderDX10));
+        std::memcpy(file.data() + headerBytes, image.pixels.data(), image.pixels.size());
+
+        if (!FbxMeshCache::WriteFileAtomically(cookedPath.string(), file.data(), file.size()))
+        {
+            outMessage = "cannot write " + cookedPath.string();
+            return false;
+        }
+        outMessage = std::to_string(image.width) + "x" + std::to_string(image.height) + ", " + std::to_string(image.mipCount) +
+                     " mips" + (image.format == DXGI_FORMAT_R8_UNORM ? ", R8" : "") +
+                     (image.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ? ", sRGB" : "") + ", " + std::to_string(file.size() / 1024) + " KB";
+        return true;
+    }
+
+    // Process-wide decoded-image cache
+    // 경로 → (크기, 수정 시각, 내용 해시), 내용 → 이미지. 다른 폴더의 같은 파일은 해시로 만나 한 번만 디코드된다.
+    struct FileIdentity
+    {
+        uint64_t size = 0;
+        int64_t writeTime = 0;
+
+        bool operator==(const FileIdentity& other) const { return size == other.size && writeTime == other.writeTime; }
+    };
+
+    bool QueryFileIdentity(const fs::path& path, FileIdentity& out)
+    {
+        std::error_code ec;
+        out.size = fs::file_size(path, ec);
+        if (ec)
+            return false;
+        out.writeTime = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+        return !ec;
+    }
+
+    std::wstring DecodedCacheKey(const fs::path& path)
+    {
+        std::error_code ec;
+        std::wstring key = fs::absolute(path, ec).lexically_normal().wstring();
+        std::transform(key.begin(), key.end(), key.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+        return key;
+    }
+
+    class DecodedTextureCache
+    {
+    public:
+        static DecodedTextureCache& Shared()
+        {
+            static DecodedTextureCache cache;
+            return cache;
+        }
+
+        ZAssetCooker::DecodedTextureRef FindByPath(const std::wstring& key, const FileIdentity& identity)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto pathIt = paths_.find(key);
+            if (pathIt == paths_.end())
+                return nullptr;
+            if (!(pathIt->second.identity == identity))
+            {
+                paths_.erase(pathIt);
+                return nullptr;
+            }
+            return Touch(pathIt->second.content);
+        }
+
+        // Same bytes already decoded under another path: alias key to it
+        ZAssetCooker::DecodedTextureRef FindByContent(const std::wstring& key, const FileIdentity& identity, uint64_t hash)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const ContentKey content{ identity.size, hash };
+            ZAssetCooker::DecodedTextureRef image = Touch(content);
+            if (image)
+            {
+                paths_[key] = PathEntry{ identity, content };
+            }
+            return image;
+        }
+
+        // 같은 내용을 두 스레드가 동시에 디코드했다면 먼저 들어온 쪽을 돌려준다
+        ZAssetCooker::DecodedTextureRef Insert(const std::wstring& key, const FileIdentity& identity, uint64_t hash,
+                                               ZAssetCooker::DecodedTextureRef image)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const ContentKey content{ identity.size, hash };
+            auto result = images_.emplace(content, ImageEntry{ image, ++clock_ });
+            if (result.second)
+            {
+                bytes_ += image->pixels.size();
+            }
+            paths_[key] = PathEntry{ identity, content };
+            image = result.first->second.image;
+            Evict();
+            return image;
+        }
+
+        void SetBudget(size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            budget_ = bytes;
+            Evict();
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            paths_.clear();
+            images_.clear();
+            bytes_ = 0;
+        }
+
+    private:
+        using ContentKey = std::pair<uint64_t, uint64_t>;   // (size, hash)
+
+        struct PathEntry
+        {
+            FileIdentity identity;
+            ContentKey content;
+        };
+
+        struct ImageEntry
+        {
+            ZAssetCooker::DecodedTextureRef image;
+            uint64_t lastUse = 0;
+        };
+
+        ZAssetCooker::DecodedTextureRef Touch(const ContentKey& content)
+        {
+            auto imageIt = images_.find(content);
+            if (imageIt == images_.end())
+                return nullptr;
+            imageIt->second.lastUse = ++clock_;
+            return imageIt->second.image;
+        }
+
+        // Least recently used first; 경로 항목은 다음 조회에서 정리된다 (사용 중인 이미지는 참조가 살려 둔다)
+        void Evict()
+        {
+            while (bytes_ > budget_ && !images_.empty())
+            {
+                auto oldest = images_.begin();
+                for (auto it = images_.begin(); it != images_.end(); ++it)
+                {
+                    if (it->second.lastUse < oldest->second.lastUse)
+                        oldest = it;
+                }
+                bytes_ -= oldest->second.image->pixels.size();
+                images_.erase(oldest);
+            }
+        }
+
+        std::mutex mutex_;
+        size_t budget_ = ZAssetCooker::kDefaultDecodedCacheBudget;
+        size_t bytes_ = 0;
+        uint64_t clock_ = 0;
+        std::unordered_map<std::wstring, PathEntry> paths_;
+        std::map<ContentKey, ImageEntry> images_;
+    };
+
+    // Cached image of sourcePath, decoded with factory on a miss (factory == nullptr: lookup only)
+    ZAssetCooker::DecodedTextureRef AcquireDecodedTexture(IWICImagingFactory* factory, const fs::path& sourcePath, bool& outDecoded)
+    {
+        outDecoded = false;
+        FileIdentity identity;
+        if (!QueryFileIdentity(sourcePath, identity))
+            return nullptr;
+
+        DecodedTextureCache& cache = DecodedTextureCache::Shared();
+        const std::wstring key = DecodedCacheKey(sourcePath);
+        if (ZAssetCooker::DecodedTextureRef image = cache.FindByPath(key, identity))
+            return image;
+        if (!factory)
+            return nullptr;
+
+        FbxMeshCache::SourceStamp stamp;
+        if (!FbxMeshCache::StampSource(sourcePath.string(), stamp))
+            return nullptr;
+        if (ZAssetCooker::DecodedTextureRef image = cache.FindByContent(key, identity, stamp.hash))
+            return image;
+
+        auto image = std::make_shared<ZAssetCooker::DecodedTexture>();
+        std::string message;
+        if (!DecodeTexture(factory, sourcePath, true, *image, message))
+        {
+            std::cerr << "[ZAssetCooker] " << message << ": " << sourcePath.string() << std::endl;
+            return nullptr;
+        }
+        outDecoded = true;
+        return cache.Insert(key, identity, stamp.hash, std::move(image));
+    }
+
+    // Upload phase: immutable texture with every mip level from the decoded image
+    HRESULT CreateTextureFromDecoded(ID3D11Device* device, const ZAssetCooker::DecodedTexture& image,
+                                     ID3D11Resource** texture, ID3D11ShaderResourceView** textureView)
+    {
+        if (!device || (!texture && !textureView))
+            return E_INVALIDARG;
+
+        D3D11_TEXTURE2D_DESC desc{};
+        desc.Width = image.width;
+        desc.Height = image.height;
+        desc.MipLevels = image.mipCount;
+        desc.ArraySize = 1;
+        desc.Format = image.format;
+        desc.SampleDesc.Count = 1;
+        desc.Usage = D3D11_USAGE_IMMUTABLE;
+        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+        std::vector<D3D11_SUBRESOURCE_DATA> levels(image.mipCount);
+        size_t offset = 0;
+        uint32_t levelWidth = image.width;
+        uint32_t levelHeight = image.height;
+        for (D3D11_SUBRESOURCE_DATA& level : levels)
+        {
+            level.pSysMem = image.pixels.data() + offset;
+            level.SysMemPitch = levelWidth * image.bytesPerPixel;
+            offset += static_cast<size_t>(levelWidth) * levelHeight * image.bytesPerPixel;
+            levelWidth = (std::max)(1u, levelWidth / 2);
+            levelHeight = (std::max)(1u, levelHeight / 2);
+        }
+
+        ComPtr<ID3D11Texture2D> resource;
+        HRESULT hr = device->CreateTexture2D(&desc, levels.data(), &resource);
+        if (FAILED(hr))
+            return hr;
+
+        if (textureView)
+        {
+            D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc{};
+            viewDesc.Format = desc.Format;
+            viewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+            viewDesc.Texture2D.MipLevels = desc.MipLevels;
+            hr = device->CreateShaderResourceView(resource.Get(), &viewDesc, textureView);
+            if (FAILED(hr))
+                return hr;
+        }
+        if (texture)
+        {
+            *texture = resource.Detach();
+        }
+        return S_OK;
+    }
+
+    struct CookJob
+    {
+        enum class Kind : uint8_t { Model, Texture };
+        enum class Result : uint8_t { Failed, Cooked, UpToDate };
+
+        Kind kind = Kind::Texture;
+        fs::path path;
+        std::vector<std::string> animations;   // models: clip files cooked against this skeleton
+
+        Result result = Result::Failed;
+        std::string message;
+        double milliseconds = 0.0;
+    };
+
+    void RunModelJob(CookJob& job, const ZAssetCooker::CookSettings& settings)
+    {
+        FbxManager model;
+        model.SetVertexFormat(settings.packedVertices ? FbxVertexFormat::Packed : FbxVertexFormat::Full);
+        model.SetAnimationLogging(false);
+
+        bool upToDate = false;
+        if (!model.CookModel(job.path.string(), upToDate))
+        {
+            job.message = "import failed";
+            return;
+        }
+        job.result = upToDate ? CookJob::Result::UpToDate : CookJob::Result::Cooked;
+        job.message = std::to_string(model.GetSubsets().size()) + " subsets, " + std::to_string(model.GetBoneCount()) + " bones";
+
+        // External clips: FbxClipLibrary reads a valid .zclip or compiles and writes one
+        if (!job.animations.empty())
+        {
+            if (!model.HasSkinning())
+            {
+                job.message += ", no skeleton for " + std::to_string(job.animations.size()) + " clips";
+            }
+            else if (!model.LoadExternalAnimations(job.animations))
+            {
+                job.result = CookJob::Result::Failed;
+                job.message += ", clip cooking failed";
+            }
+            else
+            {
+                job.message += ", " + std::to_string(job.animations.size()) + " clips";
+            }
+        }
+    }
+
+    void RunTextureJob(CookJob& job, const ZAssetCooker::CookSettings& settings)
+    {
+        ScopedWicFactory factory;
+        if (!factory.Get())
+        {
+            job.message = "WIC unavailable";
+            return;
+        }
+
+        bool upToDate = false;
+        if (CookTexture(factory.Get(), job.path, settings, upToDate, job.message))
+        {
+            job.result = upToDate ? CookJob::Result::UpToDate : CookJob::Result::Cooked;
+        }
+    }
+
+    void CollectJobs(const ZAssetCooker::CookSettings& settings, std::vector<CookJob>& jobs, uint32_t& outOrphanClips)
+    {
+        std::error_code ec;
+        const fs::path root(settings.dataRoot);
+
+        // Models: animation files belong to the models of the same folder under Models/
+        const fs::path modelsRoot = root / "Models";
+        std::map<fs::path, std::vector<std::string>> animationsOfRoot;
+        std::vector<fs::path> modelFiles;
+        for (fs::recursive_directory_iterator it(modelsRoot, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if (!it->is_regular_file() || !IsModelFile(it->path()))
+                continue;
+
+            const fs::path relative = it->path().lexically_relative(modelsRoot);
+            const fs::path modelRoot = *relative.begin();
+            if (IsInAnimationDirectory(relative))
+                animationsOfRoot[modelRoot].push_back(it->path().string());
+            else
+                modelFiles.push_back(it->path());
+        }
+
+        std::map<fs::path, bool> rootHasModel;
+        for (const fs::path& modelFile : modelFiles)
+        {
+            CookJob job;
+            job.kind = CookJob::Kind::Model;
+            job.path = modelFile;
+            const fs::path modelRoot = *modelFile.lexically_relative(modelsRoot).begin();
+            job.animations = animationsOfRoot[modelRoot];
+            rootHasModel[modelRoot] = true;
+            jobs.push_back(std::move(job));
+        }
+
+        outOrphanClips = 0;
+        for (const auto& pair : animationsOfRoot)
+        {
+            if (!rootHasModel[pair.first])
+            {
+                std::cout << "[ZAssetCooker] No model in Models/" << pair.first.string() << ", skipping " << pair.second.size()
+                          << " clips (clips are cooked against the model skeleton)" << std::endl;
+                outOrphanClips += static_cast<uint32_t>(pair.second.size());
+            }
+        }
+
+        // Textures (model textures live next to the models)
+        for (const char* directory : { "Models", "Images", "Image", "GUI", "EFFECT" })
+        {
+            for (fs::recursive_directory_iterator it(root / directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                if (it->is_regular_file() && IsTextureFile(it->path()))
+                {
+                    CookJob job;
+                    job.kind = CookJob::Kind::Texture;
+                    job.path = it->path();
+                    jobs.push_back(std::move(job));
+                }
+            }
+            ec.clear();
+        }
+    }
+}
+
+namespace ZAssetCooker
+{
+    bool Run(const CookSettings& settings, CookStats* outStats)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::cout << "=== ZAssetCooker: " << settings.dataRoot << " ===" << std::endl;
+
+        std::vector<CookJob> jobs;
+        uint32_t orphanClips = 0;
+        CollectJobs(settings, jobs, orphanClips);
+
+        // 모델이 가장 오래 걸리므로 먼저 (목록 앞쪽부터 분배된다)
+        ZThreadPool& pool = ZThreadPool::Shared();
+        std::cout << jobs.size() << " assets, " << pool.GetWorkerCount() + 1 << " threads" << std::endl;
+        pool.ParallelFor(jobs.size(), 1, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                auto jobStart = std::chrono::high_resolution_clock::now();
+                if (jobs[i].kind == CookJob::Kind::Model)
+                    RunModelJob(jobs[i], settings);
+                else
+                    RunTextureJob(jobs[i], settings);
+                jobs[i].milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - jobStart).count();
+            }
+        });
+
+        // Report (job order, after every job is done)
+        CookStats stats;
+        const fs::path root(settings.dataRoot);
+        for (const CookJob& job : jobs)
+        {
+            const char* status = "FAILED    ";
+            switch (job.result)
+            {
+            case CookJob::Result::Cooked:   status = "cooked    "; ++stats.cooked; break;
+            case CookJob::Result::UpToDate: status = "up to date"; ++stats.upToDate; break;
+            default:                        ++stats.failed; break;
+            }
+            std::cout << "  " << status << " " << job.path.lexically_relative(root).generic_string() << " ("
+                      << job.message << ", " << job.milliseconds << " ms)" << std::endl;
+        }
+
+        stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "=== ZAssetCooker: " << stats.cooked << " cooked, " << stats.upToDate << " up to date, " << stats.failed
+                  << " failed, " << orphanClips << " clips without a model (" << stats.milliseconds << " ms) ===" << std::endl;
+
+        if (outStats)
+        {
+            *outStats = stats;
+        }
+        return stats.failed == 0;
+    }
+
+    std::wstring FindCookedTexture(const std::wstring& sourcePath)
+    {
+        const fs::path source(sourcePath);
+        const fs::path cooked = GetCookedTexturePath(source);
+        std::error_code ec;
+        if (!fs::is_regular_file(cooked, ec) || !IsCookedTextureValid(source, cooked, TextureSettingsKey(CookSettings{})))
+            return std::wstring();
+        return cooked.wstring();
+    }
+
+    std::vector<DecodedTextureRef> PrefetchTextures(const std::vector<std::wstring>& fileNames)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::vector<DecodedTextureRef> images(fileNames.size());
+        std::vector<uint8_t> decoded(fileNames.size(), 0);
+
+        // 같은 경로가 여러 번 나오면 첫 번째만 디코드, 쿡된 텍스처는 업로드 단계에서 DDS로 바로 읽는다
+        std::vector<size_t> pending;
+        std::unordered_map<std::wstring, size_t> firstIndex;
+        for (size_t i = 0; i < fileNames.size(); ++i)
+        {
+            const fs::path source(fileNames[i]);
+            if (!IsTextureFile(source) || !firstIndex.emplace(DecodedCacheKey(source), i).second || !FindCookedTexture(fileNames[i]).empty())
+                continue;
+            pending.push_back(i);
+        }
+
+        ZThreadPool::Shared().ParallelFor(pending.size(), 1, [&](size_t begin, size_t end)
+        {
+            ScopedWicFactory factory;
+            for (size_t p = begin; p < end; ++p)
+            {
+                const size_t i = pending[p];
+                bool wasDecoded = false;
+                images[i] = AcquireDecodedTexture(factory.Get(), fs::path(fileNames[i]), wasDecoded);
+                decoded[i] = wasDecoded ? 1 : 0;
+            }
+        });
+
+        size_t decodedCount = 0;
+        size_t cachedCount = 0;
+        for (size_t i = 0; i < fileNames.size(); ++i)
+        {
+            if (!images[i])
+            {
+                // Duplicate path: share the first one's image
+                auto first = firstIndex.find(DecodedCacheKey(fs::path(fileNames[i])));
+                if (first != firstIndex.end())
+                    images[i] = images[first->second];
+                continue;
+            }
+            if (decoded[i])
+                ++decodedCount;
+            else
+                ++cachedCount;
+        }
+
+        if (!pending.empty())
+        {
+            std::cout << "[ZAssetCooker] Texture decode: " << decodedCount << " decoded, " << cachedCount << " from cache, "
+                      << pending.size() - decodedCount - cachedCount << " failed ("
+                      << std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count()
+                      << " ms)" << std::endl;
+        }
+        return images;
+    }
+
+    void SetDecodedCacheBudget(size_t bytes)
+    {
+        DecodedTextureCache::Shared().SetBudget(bytes);
+    }
+
+    void ClearDecodedCache()
+    {
+        DecodedTextureCache::Shared().Clear();
+    }
+
+    HRESULT CreateTextureFromFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName,
+                                  ID3D11Resource** texture, ID3D11ShaderResourceView** textureView)
+    {
+        const std::wstring cooked = FindCookedTexture(fileName);
+        if (!cooked.empty())
+        {
+            const HRESULT hr = DirectX::CreateDDSTextureFromFile(device, cooked.c_str(), texture, textureView);
+            if (SUCCEEDED(hr))
+                return hr;
+        }
+
+        const fs::path source(fileName);
+        if (IsTextureFile(source))
+        {
+            // Prefetched (or cached) image first, decode here on a miss
+            bool decoded = false;
+            DecodedTextureRef image = AcquireDecodedTexture(nullptr, source, decoded);
+            if (!image)
+            {
+                std::error_code ec;
+                if (fs::is_regular_file(source, ec))
+                {
+                    ScopedWicFactory factory;
+                    image = AcquireDecodedTexture(factory.Get(), source, decoded);
+                }
+            }
+            if (image && SUCCEEDED(CreateTextureFromDecoded(device, *image, texture, textureView)))
+                return S_OK;
+        }
+
+        return context ? DirectX::CreateWICTextureFromFile(device, context, fileName, texture, textureView)
+                       : DirectX::CreateWICTextureFromFile(device, fileName, texture, textureView);
+    }
+}
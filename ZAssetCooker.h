@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include <d3d11.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Offline asset cooker (headless --cook) and the runtime lookup of cooked files
+// 쿡 결과는 원본 옆에 놓인다:
+//  - 모델 (.fbx): "<source>.zmesh" (FbxMeshCache, 메시/LOD/스켈레톤/내장 클립)
+//  - 애니메이션 (Animations 폴더의 .fbx): "<source>.zclip" (모델 스켈레톤에 맞춰 압축된 클립)
+//  - 텍스처 (.png/.jpg/.bmp/...): "<source>.zdds" (RGBA8 + 박스 필터 밉 체인, 표준 DDS)
+// 원본 해시 + 설정이 같은 결과는 다시 만들지 않는다.
+// 쿡되지 않은 텍스처는 런타임에 같은 디코더로 읽고, 디코드 결과는 프로세스 전역 캐시에 남는다.
+namespace ZAssetCooker
+{
+    constexpr uint32_t kTextureVersion = 1;
+
+    struct CookSettings
+    {
+        std::string dataRoot = "./Data";
+        bool packedVertices = true;      // FbxModel과 같은 정점 형식 (.zmesh는 형식이 키에 들어간다)
+        bool generateMips = true;
+    };
+
+    struct CookStats
+    {
+        uint32_t cooked = 0;
+        uint32_t upToDate = 0;
+        uint32_t failed = 0;
+        double milliseconds = 0.0;
+    };
+
+    // Walks Models/, Images/, Image/, GUI/ and EFFECT/ under dataRoot, cooks on ZThreadPool::Shared().
+    // false if any asset failed (report on the console)
+    bool Run(const CookSettings& settings, CookStats* outStats = nullptr);
+
+    // Cooked texture of sourcePath if it is up to date, empty otherwise
+    std::wstring FindCookedTexture(const std::wstring& sourcePath);
+
+    // Decoded image: RGBA8 (8-bit gray: R8) with its box filtered mip chain, levels packed back to back
+    struct DecodedTexture
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipCount = 0;
+        uint32_t bytesPerPixel = 0;
+        DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+        std::vector<uint8_t> pixels;
+    };
+    using DecodedTextureRef = std::shared_ptr<const DecodedTexture>;
+
+    // Decode phase of material loading: decodes fileNames on ZThreadPool::Shared() into the decoded-image cache
+    // (files with an up-to-date .zdds are skipped, the DDS loader reads those directly).
+    // Hold the returned references until the textures are created; null for skipped or failed files
+    std::vector<DecodedTextureRef> PrefetchTextures(const std::vector<std::wstring>& fileNames);
+
+    // Process-wide decoded-image cache, keyed by path; identical files in different folders share one decode
+    // (size + content hash). 예산을 넘으면 가장 오래 쓰이지 않은 이미지부터 버린다.
+    constexpr size_t kDefaultDecodedCacheBudget = 512ull * 1024 * 1024;
+    void SetDecodedCacheBudget(size_t bytes);
+    void ClearDecodedCache();
+
+    // CreateWICTextureFromFile replacement: cooked .zdds when valid, otherwise the decoded-image cache
+    // (decoding on the calling thread on a miss); WIC loader for images the decoder rejects.
+    // context != nullptr: WIC 경로에서 밉 자동 생성 (쿡/디코드된 텍스처는 밉을 이미 갖고 있다)
+    HRESULT CreateTextureFromFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName,
+                                  ID3D11Resource** texture, ID3D11ShaderResourceView** textureView);
+}
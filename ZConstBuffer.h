@@ -70,12 +70,12 @@ namespace Bind
         // template inheritance
         using ZConstBuffer<C>::pConstantBuffer;
         using ZConstBuffer<C>::slot;
-        using ZBindable::GetContext;
+        using ZBindable::GetStateCache;
     public:
         using ZConstBuffer<C>::ZConstBuffer;
         void Bind(ZGraphics& gfx) noexcept override
         {
-            GetContext(gfx)->VSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+            GetStateCache(gfx).SetVSConstantBuffer(slot, pConstantBuffer.Get());
         }
     };
 
@@ -85,12 +85,12 @@ namespace Bind
         // template inheritance
         using ZConstBuffer<C>::pConstantBuffer;
         using ZConstBuffer<C>::slot;
-        using ZBindable::GetContext;
+        using ZBindable::GetStateCache;
     public:
         using ZConstBuffer<C>::ZConstBuffer;
         void Bind(ZGraphics& gfx) noexcept override
         {
-            GetContext(gfx)->PSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+            GetStateCache(gfx).SetPSConstantBuffer(slot, pConstantBuffer.Get());
         }
     };
 }
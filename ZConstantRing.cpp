@@ -0,0 +1,332 @@
+﻿#include "ZConstantRing.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace wrl = Microsoft::WRL;
+
+ZConstantRing::ZConstantRing(ID3D11Device* device, ID3D11DeviceContext* context, ZStateCache* stateCache,
+                             bool allowOffsetting)
+    :
+    pDevice_(device),
+    pContext_(context),
+    pStateCache_(stateCache)
+{
+    // 오프셋 바인딩 + 동적 상수 버퍼 NO_OVERWRITE가 모두 되어야 페이지 경로를 쓴다
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+    const bool supported = allowOffsetting &&
+        SUCCEEDED(pContext_.As(&pContext1_)) &&
+        SUCCEEDED(pDevice_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+        options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+    if (!supported)
+    {
+        pContext1_.Reset();
+    }
+
+    std::cout << "[ZConstantRing] " << (pContext1_ ? "64KB pages, offset binding (D3D11.1)" : "pooled buffers (no D3D11.1 offsets)")
+              << std::endl;
+}
+
+void ZConstantRing::BeginFrame()
+{
+    Reclaim(true);
+    stats_.allocations = 0;
+    stats_.bytes = 0;
+    stats_.framesInFlight = static_cast<uint32_t>(inFlight_.size());
+}
+
+void ZConstantRing::EndFrame()
+{
+    if (currentPage_ != SIZE_MAX)
+    {
+        frame_.pages.push_back(currentPage_);
+        currentPage_ = SIZE_MAX;
+    }
+    if (frame_.pages.empty() && frame_.buffers.empty())
+        return;
+
+    if (!freeQueries_.empty())
+    {
+        frame_.query = std::move(freeQueries_.back());
+        freeQueries_.pop_back();
+    }
+    else
+    {
+        D3D11_QUERY_DESC qd{};
+        qd.Query = D3D11_QUERY_EVENT;
+        if (FAILED(pDevice_->CreateQuery(&qd, &frame_.query)))
+        {
+            // 펜스 없이는 돌려줄 수 없다: 다음 프레임 펜스에 합쳐진다
+            return;
+        }
+    }
+
+    pContext_->End(frame_.query.Get());
+    inFlight_.push_back(std::move(frame_));
+    frame_ = FrameFence{};
+}
+
+void ZConstantRing::Reclaim(bool wait)
+{
+    while (!inFlight_.empty())
+    {
+        FrameFence& fence = inFlight_.front();
+
+        BOOL done = FALSE;
+        HRESULT hr = pContext_->GetData(fence.query.Get(), &done, sizeof(done), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+        if (hr == S_FALSE)
+        {
+            if (!wait || inFlight_.size() < kMaxFramesInFlight)
+                break;
+
+            // 너무 앞서 나갔다: 가장 오래된 프레임이 끝날 때까지 기다린다
+            ++stats_.fenceWaits;
+            while ((hr = pContext_->GetData(fence.query.Get(), &done, sizeof(done), 0)) == S_FALSE)
+            {
+                std::this_thread::yield();
+            }
+        }
+        // 실패(장치 제거 등)여도 GPU가 더 읽지 않으므로 회수한다
+
+        for (size_t index : fence.pages)
+        {
+            pages_[index].used = 0;
+            freePages_.push_back(index);
+        }
+        for (PooledBuffer& pooled : fence.buffers)
+        {
+            freeBuffers_[pooled.size].push_back(std::move(pooled.buffer));
+        }
+        freeQueries_.push_back(std::move(fence.query));
+        inFlight_.pop_front();
+    }
+}
+
+bool ZConstantRing::CreateBuffer(UINT size, wrl::ComPtr<ID3D11Buffer>& out)
+{
+    D3D11_BUFFER_DESC cbd{};
+    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbd.Usage = D3D11_USAGE_DYNAMIC;
+    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    cbd.ByteWidth = size;
+
+    if (FAILED(pDevice_->CreateBuffer(&cbd, nullptr, &out)))
+    {
+        std::cerr << "[ZConstantRing] Failed to create constant buffer (" << size << " bytes)" << std::endl;
+        return false;
+    }
+    ++stats_.buffersCreated;
+    return true;
+}
+
+bool ZConstantRing::Upload(const void* data, UINT bytes, Allocation& out)
+{
+    out = Allocation{};
+    if (bytes == 0)
+        return false;
+
+    // 한 페이지보다 큰 블록은 오프셋 경로로 바인딩할 수 없다
+    const bool uploaded = (pContext1_ && bytes <= kPageSize) ? UploadOffset(data, bytes, out) : UploadPooled(data, bytes, out);
+    if (uploaded)
+    {
+        ++stats_.allocations;
+        stats_.bytes += bytes;
+    }
+    return uploaded;
+}
+
+bool ZConstantRing::UploadOffset(const void* data, UINT bytes, Allocation& out)
+{
+    const UINT aligned = (bytes + kAlignment - 1) & ~(kAlignment - 1);
+
+    if (currentPage_ == SIZE_MAX || pages_[currentPage_].used + aligned > kPageSize)
+    {
+        if (currentPage_ != SIZE_MAX)
+        {
+            frame_.pages.push_back(currentPage_);
+            currentPage_ = SIZE_MAX;
+        }
+
+        if (!freePages_.empty())
+        {
+            currentPage_ = freePages_.back();
+            freePages_.pop_back();
+        }
+        else
+        {
+            Page page;
+            if (!CreateBuffer(kPageSize, page.buffer))
+                return false;
+            pages_.push_back(std::move(page));
+            currentPage_ = pages_.size() - 1;
+        }
+    }
+
+    Page& page = pages_[currentPage_];
+
+    // 새 버퍼의 첫 Map은 DISCARD여야 한다. 이후 쓰는 구간은 펜스가 끝난 페이지의 것뿐이다
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    const D3D11_MAP mapType = page.mapped ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD;
+    if (FAILED(pContext_->Map(page.buffer.Get(), 0, mapType, 0, &mapped)))
+        return false;
+    std::memcpy(static_cast<uint8_t*>(mapped.pData) + page.used, data, bytes);
+    pContext_->Unmap(page.buffer.Get(), 0);
+    page.mapped = true;
+
+    out.buffer = page.buffer.Get();
+    out.firstConstant = page.used / 16;
+    out.numConstants = aligned / 16;
+    out.offset = true;
+    page.used += aligned;
+    return true;
+}
+
+bool ZConstantRing::UploadPooled(const void* data, UINT bytes, Allocation& out)
+{
+    const UINT size = (bytes + 15) & ~15u;
+
+    wrl::ComPtr<ID3D11Buffer> buffer;
+    auto it = freeBuffers_.find(size);
+    if (it != freeBuffers_.end() && !it->second.empty())
+    {
+        buffer = std::move(it->second.back());
+        it->second.pop_back();
+    }
+    else if (!CreateBuffer(size, buffer))
+    {
+        return false;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(pContext_->Map(buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+    {
+        freeBuffers_[size].push_back(std::move(buffer));
+        return false;
+    }
+    std::memcpy(mapped.pData, data, bytes);
+    pContext_->Unmap(buffer.Get(), 0);
+
+    out.buffer = buffer.Get();
+    out.firstConstant = 0;
+    out.numConstants = size / 16;
+    out.offset = false;
+    frame_.buffers.push_back(PooledBuffer{ size, std::move(buffer) });
+    return true;
+}
+
+void ZConstantRing::BindVS(UINT slot, const Allocation& allocation) const
+{
+    if (allocation.offset)
+        pContext1_->VSSetConstantBuffers1(slot, 1u, &allocation.buffer, &allocation.firstConstant, &allocation.numConstants);
+    else
+        pContext_->VSSetConstantBuffers(slot, 1u, &allocation.buffer);
+
+    // 같은 페이지를 다른 오프셋으로 다시 바인딩하므로 포인터 비교로 걸러서는 안 된다
+    if (pStateCache_)
+        pStateCache_->ForgetVSConstantBuffer(slot);
+}
+
+void ZConstantRing::BindPS(UINT slot, const Allocation& allocation) const
+{
+    if (allocation.offset)
+        pContext1_->PSSetConstantBuffers1(slot, 1u, &allocation.buffer, &allocation.firstConstant, &allocation.numConstants);
+    else
+        pContext_->PSSetConstantBuffers(slot, 1u, &allocation.buffer);
+
+    if (pStateCache_)
+        pStateCache_->ForgetPSConstantBuffer(slot);
+}
+
+bool ZConstantRing::RunSteadyStateCheck()
+{
+    constexpr int kWarmupFrames = 64;
+    constexpr int kMeasuredFrames = 512;
+    constexpr uint32_t kPeakDraws = 600;
+    // FBX 모델 상수 버퍼 크기대 (행렬 3개 + 조명/재질, 본 팔레트는 별도 버퍼)
+    constexpr UINT kBlockSizes[] = { 208, 320, 416, 96 };
+
+    bool allPassed = true;
+    std::cout << "=== ZConstantRing steady-state check ===" << std::endl;
+
+    for (const bool offsetting : { true, false })
+    {
+        const char* pathName = offsetting ? "offset pages" : "pooled buffers";
+
+        // 창/스왑 체인 없이 WARP 장치
+        wrl::ComPtr<ID3D11Device> device;
+        wrl::ComPtr<ID3D11DeviceContext> context;
+        const D3D_FEATURE_LEVEL levels[] = { D3D_FEATURE_LEVEL_11_1, D3D_FEATURE_LEVEL_11_0 };
+        HRESULT hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0, levels, 2, D3D11_SDK_VERSION,
+                                       &device, nullptr, &context);
+        if (hr == E_INVALIDARG)
+        {
+            // 11.1을 모르는 런타임
+            hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0, &levels[1], 1, D3D11_SDK_VERSION,
+                                   &device, nullptr, &context);
+        }
+        if (FAILED(hr))
+        {
+            std::cerr << "[ZConstantRing] " << pathName << ": failed to create a WARP device" << std::endl;
+            allPassed = false;
+            continue;
+        }
+
+        ZConstantRing ring(device.Get(), context.Get(), nullptr, offsetting);
+        if (offsetting && !ring.UsesOffsetting())
+        {
+            std::cout << "[ZConstantRing] " << pathName << ": not supported by this runtime, skipped" << std::endl;
+            continue;
+        }
+
+        std::vector<uint8_t> payload(1024);
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            payload[i] = static_cast<uint8_t>(i * 31u);
+        }
+
+        bool uploadFailed = false;
+        auto runFrame = [&](uint32_t draws)
+        {
+            ring.BeginFrame();
+            for (uint32_t d = 0; d < draws; ++d)
+            {
+                Allocation allocation;
+                if (!ring.Upload(payload.data(), kBlockSizes[d % 4], allocation))
+                {
+                    uploadFailed = true;
+                    break;
+                }
+                ring.BindVS(0u, allocation);
+                ring.BindPS(0u, allocation);
+            }
+            ring.EndFrame();
+            context->Flush();   // Present 대신
+        };
+
+        for (int f = 0; f < kWarmupFrames; ++f)
+        {
+            runFrame(kPeakDraws);
+        }
+        const uint64_t warmupBuffers = ring.GetStats().buffersCreated;
+
+        std::mt19937 rng(20250301u);
+        std::uniform_int_distribution<uint32_t> drawCount(1, kPeakDraws);
+        for (int f = 0; f < kMeasuredFrames; ++f)
+        {
+            runFrame(drawCount(rng));
+        }
+
+        const uint64_t steadyBuffers = ring.GetStats().buffersCreated - warmupBuffers;
+        const bool passed = !uploadFailed && steadyBuffers == 0;
+        allPassed = allPassed && passed;
+        std::cout << "[ZConstantRing] " << pathName << ": " << warmupBuffers << " buffers after " << kWarmupFrames
+                  << " warm-up frames, " << steadyBuffers << " created in " << kMeasuredFrames << " frames, "
+                  << ring.GetStats().fenceWaits << " fence waits" << (uploadFailed ? ", upload FAILED" : "")
+                  << (passed ? "  OK" : "  FAILED") << std::endl;
+    }
+
+    std::cout << "=== ZConstantRing steady-state check " << (allPassed ? "passed" : "FAILED") << " ===" << std::endl;
+    return allPassed;
+}
@@ -0,0 +1,110 @@
+﻿#pragma once
+
+#include <d3d11_1.h>
+#include "ZStateCache.h"
+#include <wrl.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+// Per-frame constant buffer allocator (ZGraphics 소유, 드로우마다 CreateBuffer 하던 FBX 모델 상수 버퍼 대체)
+//  - D3D11.1 (ConstantBufferOffsetting + MapNoOverwriteOnDynamicConstantBuffer):
+//    64KB 동적 페이지를 256바이트 단위로 잘라 쓰고 *SetConstantBuffers1의 오프셋으로 바인딩한다.
+//    페이지의 첫 Map만 DISCARD, 이후는 NO_OVERWRITE (GPU가 읽는 구간은 펜스가 지킨다).
+//  - 그 외: 크기별 버퍼 풀, 할당마다 버퍼 하나를 DISCARD로 채운다.
+// 프레임이 쓴 페이지/버퍼는 EndFrame의 이벤트 쿼리(펜스)가 끝난 뒤에야 다시 쓴다.
+class ZConstantRing
+{
+public:
+    static constexpr UINT kPageSize = 64 * 1024;          // 상수 버퍼 한 번에 바인딩 가능한 최대 크기 (4096 constants)
+    static constexpr UINT kAlignment = 256;               // firstConstant/numConstants는 16 constants 단위
+    static constexpr size_t kMaxFramesInFlight = 3;       // 넘으면 가장 오래된 프레임의 펜스를 기다린다
+
+    struct Allocation
+    {
+        ID3D11Buffer* buffer = nullptr;
+        UINT firstConstant = 0;   // 16바이트 단위
+        UINT numConstants = 0;
+        bool offset = false;      // true: *SetConstantBuffers1로 바인딩
+    };
+
+    struct Stats
+    {
+        uint64_t buffersCreated = 0;   // 누적 (페이지 + 풀 버퍼)
+        uint32_t allocations = 0;      // 이번 프레임
+        size_t bytes = 0;              // 이번 프레임
+        uint32_t framesInFlight = 0;
+        uint32_t fenceWaits = 0;       // 누적
+    };
+
+    // stateCache: 바인딩한 상수 버퍼 슬롯을 잊게 할 섀도 상태 (없으면 nullptr)
+    // allowOffsetting = false: 장치가 지원해도 버퍼 풀 경로 사용 (헤드리스 검사용)
+    ZConstantRing(ID3D11Device* device, ID3D11DeviceContext* context, ZStateCache* stateCache = nullptr,
+                  bool allowOffsetting = true);
+    ZConstantRing(const ZConstantRing&) = delete;
+    ZConstantRing& operator=(const ZConstantRing&) = delete;
+
+    // BeginFrame: 펜스가 끝난 프레임의 페이지/버퍼 회수, EndFrame: 이번 프레임 펜스 삽입
+    void BeginFrame();
+    void EndFrame();
+
+    // Copies bytes into this frame's memory; false if the device refused (out.buffer == nullptr)
+    bool Upload(const void* data, UINT bytes, Allocation& out);
+
+    void BindVS(UINT slot, const Allocation& allocation) const;
+    void BindPS(UINT slot, const Allocation& allocation) const;
+
+    bool UsesOffsetting() const { return pContext1_ != nullptr; }
+    const Stats& GetStats() const { return stats_; }
+
+    // Headless: WARP 장치에서 프레임을 흉내 내며 워밍업 뒤 버퍼 생성이 0회인지 두 경로 모두 검사 (--cb-ring-check)
+    static bool RunSteadyStateCheck();
+
+private:
+    struct Page
+    {
+        Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+        UINT used = 0;
+        bool mapped = false;   // 한 번이라도 Map 했으면 이후 NO_OVERWRITE
+    };
+
+    struct PooledBuffer
+    {
+        UINT size = 0;
+        Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    };
+
+    struct FrameFence
+    {
+        Microsoft::WRL::ComPtr<ID3D11Query> query;
+        std::vector<size_t> pages;           // pages_ 인덱스
+        std::vector<PooledBuffer> buffers;
+    };
+
+    bool UploadOffset(const void* data, UINT bytes, Allocation& out);
+    bool UploadPooled(const void* data, UINT bytes, Allocation& out);
+    bool CreateBuffer(UINT size, Microsoft::WRL::ComPtr<ID3D11Buffer>& out);
+    void Reclaim(bool wait);
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device> pDevice_;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> pContext_;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext1> pContext1_;   // null: 오프셋 바인딩 불가
+    ZStateCache* pStateCache_;
+
+    // Offset path
+    std::vector<Page> pages_;
+    std::vector<size_t> freePages_;
+    size_t currentPage_ = SIZE_MAX;
+
+    // Pooled path: 크기 → 재사용 가능한 버퍼
+    std::unordered_map<UINT, std::vector<Microsoft::WRL::ComPtr<ID3D11Buffer>>> freeBuffers_;
+
+    FrameFence frame_;                      // 이번 프레임이 쓴 것
+    std::deque<FrameFence> inFlight_;
+    std::vector<Microsoft::WRL::ComPtr<ID3D11Query>> freeQueries_;
+
+    Stats stats_;
+};
@@ -396,6 +396,9 @@ BOOL ZGUIManager::Render( float fElapsedTime )
 			pDialog->Render( fElapsedTime );
 	}
 
+	// SpriteBatch가 셰이더/레이아웃/샘플러 등을 직접 바꿨다
+	m_pGraphicsRef->GetStateCache().Invalidate();
+
 	return TRUE;
 }
 
@@ -4,6 +4,9 @@
 #include <d3dcompiler.h>
 #include <DirectXMath.h> // dx math
 #include "ZGraphics.h"
+#include "ZConstantRing.h"
+#include "ZTransformStream.h"
+#include "FbxPaletteArena.h"
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_dx11.h"
 #include "imgui/imgui_impl_win32.h"
@@ -129,6 +132,18 @@ ZGraphics::ZGraphics(HWND hWnd, double winRatio, DWORD width, DWORD height)
     blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
     GFX_THROW_INFO(pDevice->CreateBlendState(&blendDesc, &pBlendState));
 
+    // 바인드는 섀도 상태를 거친다 (이미 바인딩된 객체는 다시 보내지 않는다)
+    pStateCache = std::make_unique<ZStateCache>(pContext.Get());
+
+    // 드로우별 상수 버퍼는 링에서 잘라 쓴다
+    pConstantRing = std::make_unique<ZConstantRing>(pDevice.Get(), pContext.Get(), pStateCache.get());
+
+    // 렌더 큐로 그리는 객체의 변환 상수는 큐 실행마다 한 번에 쓴다
+    pTransformStream = std::make_unique<ZTransformStream>(pDevice.Get(), pContext.Get(), pStateCache.get());
+
+    // 스킨 팔레트는 인스턴스마다 공유 버퍼 구간을 잘라 쓴다 (버퍼는 첫 업로드 때 생성)
+    pPaletteArena = std::make_unique<FbxPaletteArena>();
+
     // init imgui d3d impl
     ImGui_ImplDX11_Init(pDevice.Get(), pContext.Get());
 }
@@ -147,6 +162,9 @@ void ZGraphics::EndFrame()
         ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
     }
 
+    // 이번 프레임 상수 버퍼 구간의 펜스
+    pConstantRing->EndFrame();
+
 	HRESULT hr;
 
 #ifndef NDEBUG
@@ -187,6 +205,12 @@ void ZGraphics::BeginFrame(float red, float green, float blue) noexcept
         ImGui::NewFrame();
     }
 
+    // GPU가 다 읽은 프레임의 상수 버퍼 구간 회수, 상태 카운터 리셋
+    pConstantRing->BeginFrame();
+    pStateCache->BeginFrame();
+    pTransformStream->BeginFrame();
+    pPaletteArena->BeginFrame();     // 스킨 팔레트 구간은 프레임마다 새로 할당
+
     ClearBuffer(red, green, blue);
 }
 
@@ -233,6 +257,11 @@ void ZGraphics::RenderIndexed(UINT count) noxnd
     GFX_THROW_INFO_ONLY(pContext->DrawIndexed(count, 0u, 0u));
 }
 
+void ZGraphics::RenderIndexedInstanced(UINT indexCount, UINT instanceCount) noxnd
+{
+    GFX_THROW_INFO_ONLY(pContext->DrawIndexedInstanced(indexCount, instanceCount, 0u, 0, 0u));
+}
+
 void ZGraphics::SetProjection(DirectX::FXMMATRIX proj) noexcept
 {
     projection = proj;
@@ -303,6 +332,26 @@ ID3D11BlendState* ZGraphics::GetBlendState() noexcept
 	return pBlendState.Get();
 }
 
+ZConstantRing& ZGraphics::GetConstantRing() noexcept
+{
+    return *pConstantRing;
+}
+
+ZTransformStream& ZGraphics::GetTransformStream() noexcept
+{
+    return *pTransformStream;
+}
+
+ZStateCache& ZGraphics::GetStateCache() noexcept
+{
+    return *pStateCache;
+}
+
+FbxPaletteArena& ZGraphics::GetPaletteArena() noexcept
+{
+    return *pPaletteArena;
+}
+
 HWND ZGraphics::GetHWND() noexcept
 {
     return static_cast<HWND>(m_hWnd);
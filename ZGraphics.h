@@ -1,9 +1,15 @@
 ﻿#pragma once
 #include "ChiliException.h"
 #include <wrl.h> // ComPtr
+#include <memory>
 #include <DirectXMath.h> // DirectX Math
 #include "DxgiInfoManager.h"
 #include "ZConditionalNoExcept.h"
+#include "ZStateCache.h"
+
+class ZConstantRing;
+class ZTransformStream;
+class FbxPaletteArena;
 
 // D3D 11의 초기화 및 핵심 인터페이스 관리
 
@@ -45,6 +51,10 @@ private:
 	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> pTarget;	// 렌더 타겟 뷰, 렌더링 결과가 저장되는 곳
     Microsoft::WRL::ComPtr<ID3D11DepthStencilView> pDSV;
     Microsoft::WRL::ComPtr<ID3D11BlendState> pBlendState;	// 알파 블렌드 상태
+    std::unique_ptr<ZStateCache> pStateCache;               // 바인딩된 파이프라인 상태 섀도 (중복 바인드 생략)
+    std::unique_ptr<ZConstantRing> pConstantRing;           // 프레임 단위 상수 버퍼 할당 (BeginFrame 회수 / EndFrame 펜스)
+    std::unique_ptr<ZTransformStream> pTransformStream;     // 렌더 큐 객체 변환을 한 번에 계산/Map (오프셋 바인딩)
+    std::unique_ptr<FbxPaletteArena> pPaletteArena;         // 프레임의 모든 스킨 인스턴스가 공유하는 3x4 본 팔레트 버퍼
 
     double winRatio;
     HANDLE m_hWnd;
@@ -116,6 +126,7 @@ public:
     void BeginFrame(float red, float green, float blue) noexcept;
     void SetViewport() noexcept;
     void RenderIndexed(UINT count) noxnd;
+    void RenderIndexedInstanced(UINT indexCount, UINT instanceCount) noxnd;
     void SetProjection(DirectX::FXMMATRIX proj) noexcept;
     DirectX::XMMATRIX GetProjection() const noexcept;
     void SetCamera(DirectX::FXMMATRIX cam) noexcept;
@@ -132,6 +143,10 @@ public:
     ID3D11Device* GetDeviceCOM() noexcept;
     ID3D11DeviceContext* GetDeviceContext() noexcept;
     ID3D11BlendState* GetBlendState() noexcept;
+    ZConstantRing& GetConstantRing() noexcept;
+    ZTransformStream& GetTransformStream() noexcept;
+    FbxPaletteArena& GetPaletteArena() noexcept;
+    ZStateCache& GetStateCache() noexcept;
     HWND GetHWND() noexcept;
     DWORD GetClientWidth();
     DWORD GetClientHeight();
@@ -23,6 +23,11 @@ ID3D11BlendState* ZGraphicsResource::GetBlendState(ZGraphics& gfx) noexcept
     return gfx.pBlendState.Get();
 }
 
+ZStateCache& ZGraphicsResource::GetStateCache(ZGraphics& gfx) noexcept
+{
+    return *gfx.pStateCache;
+}
+
 DxgiInfoManager& ZGraphicsResource::GetInfoManager(ZGraphics& gfx)
 {
 #ifndef NDEBUG
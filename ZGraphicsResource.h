@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "ZStateCache.h"
 
 class ZGraphics;
 class DxgiInfoManager;
@@ -10,6 +11,7 @@ protected: // ZGraphics friend 접근 제약에 사용
 	static ID3D11Device* GetDevice(ZGraphics& gfx) noexcept;
     static ID3D11RenderTargetView* GetTarget(ZGraphics& gfx) noexcept;
     static ID3D11BlendState* GetBlendState(ZGraphics& gfx) noexcept;
+    static ZStateCache& GetStateCache(ZGraphics& gfx) noexcept;
 	static DxgiInfoManager& GetInfoManager(ZGraphics& gfx);
     static DWORD GetClientWidth(ZGraphics& gfx);
     static DWORD GetClientHeight(ZGraphics& gfx);
@@ -1,12 +1,36 @@
 ﻿#include "ZD3D11.h"
 #include "ZIndexBuffer.h"
 #include "GraphicsThrowMacros.h"
+#include <algorithm>
 
 namespace Bind
 {
     ZIndexBuffer::ZIndexBuffer(ZGraphics& gfx, const std::vector<unsigned short>& indices)
         :
-        count((UINT)indices.size())
+        count((UINT)indices.size()),
+        format(DXGI_FORMAT_R16_UINT)
+    {
+        Create(gfx, indices.data(), sizeof(unsigned short));
+    }
+
+    ZIndexBuffer::ZIndexBuffer(ZGraphics& gfx, const std::vector<uint32_t>& indices)
+        :
+        count((UINT)indices.size()),
+        format(DXGI_FORMAT_R32_UINT)
+    {
+        if (FitsIn16Bit(indices.data(), indices.size()))
+        {
+            const std::vector<uint16_t> narrow = Narrow(indices.data(), indices.size());
+            format = DXGI_FORMAT_R16_UINT;
+            Create(gfx, narrow.data(), sizeof(uint16_t));
+        }
+        else
+        {
+            Create(gfx, indices.data(), sizeof(uint32_t));
+        }
+    }
+
+    void ZIndexBuffer::Create(ZGraphics& gfx, const void* indices, UINT indexSize)
     {
         INFOMAN(gfx);
 
@@ -15,22 +39,39 @@ namespace Bind
         ibd.Usage = D3D11_USAGE_DEFAULT;
         ibd.CPUAccessFlags = 0u;
         ibd.MiscFlags = 0u;
-        ibd.ByteWidth = UINT(count * sizeof(unsigned short));
-        ibd.StructureByteStride = sizeof(unsigned short);
+        ibd.ByteWidth = UINT(count * indexSize);
+        ibd.StructureByteStride = indexSize;
 
         D3D11_SUBRESOURCE_DATA isd = {};
-        isd.pSysMem = indices.data();
+        isd.pSysMem = indices;
 
         GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&ibd, &isd, &pIndexBuffer));
     }
 
     void ZIndexBuffer::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->IASetIndexBuffer(pIndexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0u);
+        GetStateCache(gfx).SetIndexBuffer(pIndexBuffer.Get(), format, 0u);
     }
 
     UINT ZIndexBuffer::GetCount() const noexcept
     {
         return count;
     }
+
+    DXGI_FORMAT ZIndexBuffer::GetFormat() const noexcept
+    {
+        return format;
+    }
+
+    bool ZIndexBuffer::FitsIn16Bit(const uint32_t* indices, size_t indexCount) noexcept
+    {
+        return std::all_of(indices, indices + indexCount, [](uint32_t i) { return i <= 0xFFFFu; });
+    }
+
+    std::vector<uint16_t> ZIndexBuffer::Narrow(const uint32_t* indices, size_t indexCount)
+    {
+        std::vector<uint16_t> narrow(indexCount);
+        std::transform(indices, indices + indexCount, narrow.begin(), [](uint32_t i) { return static_cast<uint16_t>(i); });
+        return narrow;
+    }
 }
\ No newline at end of file
@@ -1,17 +1,30 @@
 ﻿#pragma once
 #include "ZBindable.h"
+#include <cstdint>
 
 namespace Bind
 {
+    // Index buffer in 16-bit (R16_UINT) or 32-bit (R32_UINT) indices
+    // 32비트 인덱스로 만들어도 최대 인덱스가 0xFFFF 이하면 16비트로 줄여서 올린다 (메모리/대역폭 절반).
     class ZIndexBuffer : public ZBindable
     {
     protected:
         UINT count;
+        DXGI_FORMAT format;
         Microsoft::WRL::ComPtr<ID3D11Buffer> pIndexBuffer;
 
     public:
         ZIndexBuffer(ZGraphics& gfx, const std::vector<unsigned short>& indices);
+        ZIndexBuffer(ZGraphics& gfx, const std::vector<uint32_t>& indices);
         void Bind(ZGraphics& gfx) noexcept override;
         UINT GetCount() const noexcept;
+        DXGI_FORMAT GetFormat() const noexcept;
+
+        // Width selection, shared with index buffers built outside this class (FbxManager, FbxStaticModel)
+        static bool FitsIn16Bit(const uint32_t* indices, size_t indexCount) noexcept;
+        static std::vector<uint16_t> Narrow(const uint32_t* indices, size_t indexCount);
+
+    private:
+        void Create(ZGraphics& gfx, const void* indices, UINT indexSize);
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <vector>
+#include <cstdint>
 #include <DirectXMath.h>
 
 template<class T>
@@ -7,7 +8,7 @@ class ZIndexedTriangleList
 {
 public:
     ZIndexedTriangleList() = default;
-    ZIndexedTriangleList(std::vector<T> verts_in, std::vector<unsigned short> indices_in)
+    ZIndexedTriangleList(std::vector<T> verts_in, std::vector<uint32_t> indices_in)
         :
         vertices(std::move(verts_in)),
         indices(std::move(indices_in))
@@ -29,5 +30,5 @@ public:
 
 public:
     std::vector<T> vertices;
-    std::vector<unsigned short> indices;
+    std::vector<uint32_t> indices;
 };
\ No newline at end of file
@@ -20,6 +20,6 @@ namespace Bind
 
     void ZInputLayout::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->IASetInputLayout(pInputLayout.Get());
+        GetStateCache(gfx).SetInputLayout(pInputLayout.Get());
     }
 }
\ No newline at end of file
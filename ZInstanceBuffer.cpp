@@ -0,0 +1,200 @@
+﻿#include "ZD3D11.h"
+#include "ZInstanceBuffer.h"
+#include "ZConstantRing.h"
+#include "GraphicsThrowMacros.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+using namespace DirectX;
+
+namespace ZInstancing
+{
+    std::vector<D3D11_INPUT_ELEMENT_DESC> AppendInstanceElements(std::vector<D3D11_INPUT_ELEMENT_DESC> layout)
+    {
+        const D3D11_INPUT_ELEMENT_DESC instanceElements[] =
+        {
+            { "InstanceModelView", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, kInstanceSlot, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "InstanceModelView", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, kInstanceSlot, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "InstanceModelView", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, kInstanceSlot, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "InstanceMaterial",  0, DXGI_FORMAT_R32G32B32A32_FLOAT, kInstanceSlot, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "InstanceMaterial",  1, DXGI_FORMAT_R32G32B32A32_FLOAT, kInstanceSlot, 64, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        };
+        layout.insert(layout.end(), std::begin(instanceElements), std::end(instanceElements));
+        return layout;
+    }
+
+    bool BindFrameConstants(ZGraphics& gfx)
+    {
+        const XMMATRIX proj = XMMatrixTranspose(gfx.GetProjection());
+        ZConstantRing& ring = gfx.GetConstantRing();
+        ZConstantRing::Allocation alloc;
+        if (!ring.Upload(&proj, sizeof(proj), alloc))
+        {
+            return false;
+        }
+        ring.BindVS(0u, alloc);
+        return true;
+    }
+
+    bool RunPackingBenchmark()
+    {
+        constexpr size_t kCounts[] = { 1000, 10000, 50000 };
+        constexpr int kIterations = 20;
+        constexpr size_t kTypes = 3;   // LightBox / TexturedBox / MeshTest
+
+        bool allPassed = true;
+        std::cout << "=== ZInstancing packing benchmark ===" << std::endl;
+
+        const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 20.0f, -80.0f, 1.0f), XMVectorZero(),
+                                               XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const XMMATRIX proj = XMMatrixPerspectiveLH(1.0f, 9.0f / 16.0f, 0.5f, 400.0f);
+
+        for (const size_t count : kCounts)
+        {
+            // ZInteractableTransform과 같은 모양의 월드 행렬 + 임의 재질
+            std::mt19937 rng(20250315u);
+            std::uniform_real_distribution<float> angle(0.0f, XM_2PI);
+            std::uniform_real_distribution<float> radius(20.0f, 30.0f);
+            std::uniform_real_distribution<float> scale(0.4f, 3.0f);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            std::vector<XMFLOAT4X4> worlds(count);
+            std::vector<ZInstanceMaterial> materials(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const XMMATRIX world = XMMatrixScaling(1.0f, 1.0f, scale(rng)) *
+                    XMMatrixRotationRollPitchYaw(angle(rng), angle(rng), angle(rng)) *
+                    XMMatrixTranslation(radius(rng), 0.0f, 0.0f) *
+                    XMMatrixRotationRollPitchYaw(angle(rng), angle(rng), angle(rng));
+                XMStoreFloat4x4(&worlds[i], world);
+                materials[i].color = XMFLOAT3(unit(rng), unit(rng), unit(rng));
+                materials[i].specularIntensity = 0.05f + unit(rng) * 4.0f;
+                materials[i].specularPower = 1.0f + unit(rng) * 200.0f;
+            }
+
+            std::vector<ZInstanceData> stream(count);
+            std::vector<XMFLOAT4X4> legacy(count * 2);   // 기존 경로: 드로우마다 modelView + modelViewProj 상수
+            double packMs = 0.0, legacyMs = 0.0;
+
+            for (int iteration = 0; iteration < kIterations; ++iteration)
+            {
+                // 1. Instance stream (RenderInstances)
+                auto packStart = std::chrono::high_resolution_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    Pack(XMLoadFloat4x4(&worlds[i]), view, materials[i], stream[i]);
+                }
+                auto packEnd = std::chrono::high_resolution_clock::now();
+                packMs += std::chrono::duration<double, std::milli>(packEnd - packStart).count();
+
+                // 2. Per-draw constants (ZTransformVSConstBuffer::Bind, Map/Unmap 제외)
+                auto legacyStart = std::chrono::high_resolution_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const XMMATRIX modelView = XMLoadFloat4x4(&worlds[i]) * view;
+                    XMStoreFloat4x4(&legacy[i * 2], XMMatrixTranspose(modelView));
+                    XMStoreFloat4x4(&legacy[i * 2 + 1], XMMatrixTranspose(modelView * proj));
+                }
+                auto legacyEnd = std::chrono::high_resolution_clock::now();
+                legacyMs += std::chrono::duration<double, std::milli>(legacyEnd - legacyStart).count();
+            }
+
+            // 셰이더 흉내 (PhongInstancedVS): 행마다 dot → 뷰 공간 위치/법선, 기존 행렬 곱과 비교
+            float maxError = 0.0f;
+            bool materialsMatch = true;
+            const XMVECTOR probe = XMVectorSet(0.5f, -0.5f, 0.5f, 1.0f);
+            const XMVECTOR probeNormal = XMVectorSet(0.0f, 0.70710678f, 0.70710678f, 0.0f);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const ZInstanceData& d = stream[i];
+                const XMMATRIX modelView = XMLoadFloat4x4(&worlds[i]) * view;
+                const XMVECTOR expected = XMVector3TransformCoord(probe, modelView);
+                const XMVECTOR expectedNormal = XMVector3TransformNormal(probeNormal, modelView);
+                for (int r = 0; r < 3; ++r)
+                {
+                    const XMVECTOR row = XMLoadFloat4(&d.modelView[r]);
+                    const float position = XMVectorGetX(XMVector4Dot(row, probe));
+                    const float normal = XMVectorGetX(XMVector3Dot(row, probeNormal));
+                    const float scale = (std::max)(1.0f, std::fabs(XMVectorGetByIndex(expected, r)));
+                    maxError = (std::max)(maxError, std::fabs(position - XMVectorGetByIndex(expected, r)) / scale);
+                    maxError = (std::max)(maxError, std::fabs(normal - XMVectorGetByIndex(expectedNormal, r)));
+                }
+                materialsMatch = materialsMatch &&
+                    d.material.x == materials[i].color.x && d.material.y == materials[i].color.y &&
+                    d.material.z == materials[i].color.z && d.material.w == materials[i].specularIntensity &&
+                    d.materialExtra.x == materials[i].specularPower;
+            }
+
+            const bool passed = maxError < 1e-4f && materialsMatch;
+            allPassed = allPassed && passed;
+
+            const double avgPack = packMs / kIterations;
+            const double avgLegacy = legacyMs / kIterations;
+            std::cout << "[" << count << " instances] pack " << avgPack << " ms ("
+                      << (avgPack * 1e6 / count) << " ns/instance), per-draw constants " << avgLegacy << " ms" << std::endl;
+            std::cout << "  stream " << (count * sizeof(ZInstanceData) / 1024) << " KB/frame in 1 map per type vs "
+                      << (count * sizeof(XMFLOAT4X4) * 2 / 1024) << " KB in " << count << " maps" << std::endl;
+            std::cout << "  draw calls: " << count << " DrawIndexed -> " << kTypes << " DrawIndexedInstanced ("
+                      << kTypes << " types, material in stream)" << std::endl;
+            std::cout << "  shader emulation max error " << maxError << (materialsMatch ? "" : ", MATERIAL MISMATCH")
+                      << (passed ? " OK" : " FAILED") << std::endl;
+        }
+
+        std::cout << (allPassed ? "Instancing benchmark passed" : "Instancing benchmark FAILED") << std::endl;
+        return allPassed;
+    }
+}
+
+namespace Bind
+{
+    void ZInstanceBuffer::Update(ZGraphics& gfx, const ZInstanceData* instances, UINT instanceCount)
+    {
+        INFOMAN(gfx);
+
+        count = instanceCount;
+        if (instanceCount == 0)
+        {
+            return;
+        }
+
+        if (instanceCount > capacity)
+        {
+            // 다시 만드는 횟수를 줄이려고 두 배씩 늘린다 (최소 64개)
+            UINT newCapacity = (std::max)(capacity, 64u);
+            while (newCapacity < instanceCount)
+            {
+                newCapacity *= 2;
+            }
+
+            D3D11_BUFFER_DESC bd = {};
+            bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+            bd.Usage = D3D11_USAGE_DYNAMIC;
+            bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+            bd.MiscFlags = 0u;
+            bd.ByteWidth = UINT(sizeof(ZInstanceData) * newCapacity);
+            bd.StructureByteStride = sizeof(ZInstanceData);
+
+            pInstanceBuffer.Reset();
+            GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&bd, nullptr, &pInstanceBuffer));
+            capacity = newCapacity;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE msr;
+        GFX_THROW_INFO(GetContext(gfx)->Map(
+            pInstanceBuffer.Get(), 0u,
+            D3D11_MAP_WRITE_DISCARD, 0u,
+            &msr
+        ));
+        memcpy(msr.pData, instances, sizeof(ZInstanceData) * instanceCount);
+        GetContext(gfx)->Unmap(pInstanceBuffer.Get(), 0u);
+    }
+
+    void ZInstanceBuffer::Bind(ZGraphics& gfx) noexcept
+    {
+        GetStateCache(gfx).SetVertexBuffer(ZInstancing::kInstanceSlot, pInstanceBuffer.Get(), sizeof(ZInstanceData), 0u);
+    }
+}
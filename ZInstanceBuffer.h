@@ -0,0 +1,69 @@
+﻿#pragma once
+#include "ZBindable.h"
+#include <DirectXMath.h>
+#include <wrl.h>
+#include <vector>
+
+// Per-instance stream element (input slot 1, D3D11_INPUT_PER_INSTANCE_DATA)
+// PhongInstancedVS / TexturedPhongInstancedVS가 읽는다. 투영은 프레임 상수 (VS slot 0)
+struct ZInstanceData
+{
+    DirectX::XMFLOAT4 modelView[3];   // transpose(model * view)의 앞 세 행 (아핀이라 네 번째 행은 0 0 0 1)
+    DirectX::XMFLOAT4 material;       // rgb: 재질 색, a: specularIntensity
+    DirectX::XMFLOAT4 materialExtra;  // x: specularPower
+};
+static_assert(sizeof(ZInstanceData) == 80, "ZInstanceData must match the instanced vertex shaders");
+
+// Material constants carried per instance (PhongPS ObjectCBuf와 같은 의미)
+struct ZInstanceMaterial
+{
+    DirectX::XMFLOAT3 color = { 1.0f, 1.0f, 1.0f };
+    float specularIntensity = 0.6f;
+    float specularPower = 30.0f;
+};
+
+class ZGraphics;
+
+namespace ZInstancing
+{
+    constexpr UINT kInstanceSlot = 1;
+
+    // Per-vertex layout + slot 1 per-instance elements (InstanceModelView0..2, InstanceMaterial0..1)
+    std::vector<D3D11_INPUT_ELEMENT_DESC> AppendInstanceElements(std::vector<D3D11_INPUT_ELEMENT_DESC> layout);
+
+    inline void Pack(DirectX::FXMMATRIX world, DirectX::CXMMATRIX view, const ZInstanceMaterial& material,
+                     ZInstanceData& out) noexcept
+    {
+        // 전치행렬 사용 이유는 ZTransformVSConstBuffer와 같다. 셰이더는 행마다 dot(row, float4(pos, 1))
+        const DirectX::XMMATRIX modelView = DirectX::XMMatrixTranspose(world * view);
+        DirectX::XMStoreFloat4(&out.modelView[0], modelView.r[0]);
+        DirectX::XMStoreFloat4(&out.modelView[1], modelView.r[1]);
+        DirectX::XMStoreFloat4(&out.modelView[2], modelView.r[2]);
+        out.material = DirectX::XMFLOAT4(material.color.x, material.color.y, material.color.z, material.specularIntensity);
+        out.materialExtra = DirectX::XMFLOAT4(material.specularPower, 0.0f, 0.0f, 0.0f);
+    }
+
+    // Instanced VS slot 0: transposed projection from this frame's constant ring; false if the upload failed
+    bool BindFrameConstants(ZGraphics& gfx);
+
+    // Headless: 1k~50k 인스턴스 스트림 패킹 시간, 셰이더 계산과 비교, 드로우 호출 수 전/후 (--instancing-bench)
+    bool RunPackingBenchmark();
+}
+
+namespace Bind
+{
+    // Dynamic per-instance vertex buffer (ZRenderableBase<T>마다 하나)
+    // Update는 프레임마다 WRITE_DISCARD 한 번, 용량이 모자라면 두 배로 다시 만든다.
+    class ZInstanceBuffer : public ZBindable
+    {
+    private:
+        Microsoft::WRL::ComPtr<ID3D11Buffer> pInstanceBuffer;
+        UINT capacity = 0;
+        UINT count = 0;
+
+    public:
+        void Update(ZGraphics& gfx, const ZInstanceData* instances, UINT instanceCount);
+        UINT GetCount() const noexcept { return count; }
+        void Bind(ZGraphics& gfx) noexcept override;
+    };
+}
@@ -0,0 +1,884 @@
+﻿#include "ZMeshOptimizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    // Timestamp cache model shared by Tipsify and the cluster split:
+    // a vertex is resident while (time - stamp) <= cacheSize, a miss stamps it and advances time.
+    // time += cacheSize + 1 flushes the whole cache.
+    struct TimestampCache
+    {
+        std::vector<uint32_t> stamps;
+        uint32_t time = 0;
+        uint32_t size = 0;
+
+        TimestampCache(size_t vertexCount, uint32_t cacheSize)
+            : stamps(vertexCount, 0), time(cacheSize + 1), size(cacheSize)
+        {
+        }
+
+        bool Touch(uint32_t v)
+        {
+            if (time - stamps[v] > size)
+            {
+                stamps[v] = time++;
+                return true;
+            }
+            return false;
+        }
+
+        uint32_t Triangle(const uint32_t* tri)
+        {
+            return static_cast<uint32_t>(Touch(tri[0])) + Touch(tri[1]) + Touch(tri[2]);
+        }
+
+        void Flush() { time += size + 1; }
+    };
+
+    bool IsValidTriangleList(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+    {
+        if (indexCount < 3 || indexCount % 3 != 0)
+            return false;
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            if (indices[i] >= vertexCount)
+                return false;
+        }
+        return true;
+    }
+
+    struct Float3
+    {
+        float x, y, z;
+    };
+
+    Float3 LoadPosition(const void* positions, size_t stride, uint32_t v)
+    {
+        const float* p = reinterpret_cast<const float*>(static_cast<const uint8_t*>(positions) + v * stride);
+        return Float3{ p[0], p[1], p[2] };
+    }
+
+    // Plane/edge quadric: error(p) = pᵀAp + 2bᵀp + c, weighted (error / w = mean squared distance)
+    struct Quadric
+    {
+        double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+        double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+        double c = 0.0;
+        double w = 0.0;
+
+        void AddPlane(double nx, double ny, double nz, double d, double weight)
+        {
+            a00 += weight * nx * nx; a11 += weight * ny * ny; a22 += weight * nz * nz;
+            a01 += weight * nx * ny; a02 += weight * nx * nz; a12 += weight * ny * nz;
+            b0 += weight * nx * d; b1 += weight * ny * d; b2 += weight * nz * d;
+            c += weight * d * d;
+            w += weight;
+        }
+
+        void Add(const Quadric& q)
+        {
+            a00 += q.a00; a11 += q.a11; a22 += q.a22; a01 += q.a01; a02 += q.a02; a12 += q.a12;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2;
+            c += q.c;
+            w += q.w;
+        }
+
+        double Error(const Float3& p) const
+        {
+            const double x = p.x, y = p.y, z = p.z;
+            const double rx = a00 * x + a01 * y + a02 * z;
+            const double ry = a01 * x + a11 * y + a12 * z;
+            const double rz = a02 * x + a12 * y + a22 * z;
+            const double e = rx * x + ry * y + rz * z + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return w > 0.0 ? std::fabs(e) / w : 0.0;
+        }
+    };
+
+    Float3 Sub(const Float3& a, const Float3& b) { return Float3{ a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Float3 Cross(const Float3& a, const Float3& b) { return Float3{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    float Dot(const Float3& a, const Float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+    enum class VertexKind : uint8_t
+    {
+        Manifold,    // interior, any collapse
+        Border,      // open boundary, collapses along the boundary only
+        Seam,        // two wedges at one position (UV/normal/weight seam), collapses along the seam with its partner
+        Locked       // corners, non-manifold, seam/boundary junctions
+    };
+
+    constexpr float kBorderWeight = 10.0f;   // 경계/이음매 선을 유지하는 수직 평면 가중치
+
+    // Triangles around each vertex of the current index list (rebuilt every pass)
+    struct TriangleAdjacency
+    {
+        std::vector<uint32_t> offset;
+        std::vector<uint32_t> triangles;
+        const uint32_t* indices = nullptr;
+
+        void Build(const uint32_t* indexData, size_t indexCount, size_t vertexCount)
+        {
+            indices = indexData;
+            offset.assign(vertexCount + 1, 0);
+            for (size_t i = 0; i < indexCount; ++i)
+            {
+                ++offset[indexData[i] + 1];
+            }
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                offset[v + 1] += offset[v];
+            }
+            triangles.resize(indexCount);
+            std::vector<uint32_t> fill(offset.begin(), offset.end() - 1);
+            for (size_t i = 0; i < indexCount; ++i)
+            {
+                triangles[fill[indexData[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        // Directed edge a→b in some triangle's winding
+        bool HasEdge(uint32_t a, uint32_t b) const
+        {
+            for (uint32_t k = offset[a]; k < offset[a + 1]; ++k)
+            {
+                const uint32_t* tri = indices + triangles[k] * 3;
+                if ((tri[0] == a && tri[1] == b) || (tri[1] == a && tri[2] == b) || (tri[2] == a && tri[0] == b))
+                    return true;
+            }
+            return false;
+        }
+
+        // Edge used by triangles on one side only
+        bool IsOpenEdge(uint32_t a, uint32_t b) const
+        {
+            return HasEdge(a, b) != HasEdge(b, a);
+        }
+    };
+
+    // 0 = same influences, 1 = disjoint
+    float SkinDistance(const ZMeshOptimizer::SkinInfluences& skin, uint32_t a, uint32_t b)
+    {
+        const uint8_t* base = reinterpret_cast<const uint8_t*>(skin.boneIndices);
+        const uint32_t* boneA = reinterpret_cast<const uint32_t*>(base + a * skin.stride);
+        const uint32_t* boneB = reinterpret_cast<const uint32_t*>(base + b * skin.stride);
+        const uint8_t* weightBase = reinterpret_cast<const uint8_t*>(skin.boneWeights);
+        const float* weightA = reinterpret_cast<const float*>(weightBase + a * skin.stride);
+        const float* weightB = reinterpret_cast<const float*>(weightBase + b * skin.stride);
+
+        float distance = 0.0f;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (weightA[i] <= 0.0f)
+                continue;
+            float matched = 0.0f;
+            for (int j = 0; j < 4; ++j)
+            {
+                if (boneB[j] == boneA[i] && weightB[j] > 0.0f)
+                    matched = weightB[j];
+            }
+            distance += std::fabs(weightA[i] - matched);
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+            if (weightB[j] <= 0.0f)
+                continue;
+            bool shared = false;
+            for (int i = 0; i < 4; ++i)
+            {
+                if (boneA[i] == boneB[j] && weightA[i] > 0.0f)
+                    shared = true;
+            }
+            if (!shared)
+                distance += weightB[j];
+        }
+        return 0.5f * distance;
+    }
+}
+
+namespace ZMeshOptimizer
+{
+    CacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+    {
+        CacheStats stats;
+        if (!IsValidTriangleList(indices, indexCount, vertexCount) || cacheSize == 0)
+            return stats;
+
+        std::vector<uint32_t> fifo(cacheSize, kNone);
+        std::vector<uint8_t> resident(vertexCount, 0);
+        std::vector<uint8_t> seen(vertexCount, 0);
+        size_t head = 0;
+
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            const uint32_t v = indices[i];
+            if (!seen[v])
+            {
+                seen[v] = 1;
+                ++stats.vertices;
+            }
+            if (resident[v])
+                continue;
+
+            // Miss: FIFO replacement
+            ++stats.misses;
+            if (fifo[head] != kNone)
+                resident[fifo[head]] = 0;
+            fifo[head] = v;
+            resident[v] = 1;
+            head = (head + 1) % cacheSize;
+        }
+
+        stats.triangles = static_cast<uint32_t>(indexCount / 3);
+        stats.acmr = static_cast<float>(stats.misses) / static_cast<float>(stats.triangles);
+        stats.atvr = stats.vertices > 0 ? static_cast<float>(stats.misses) / static_cast<float>(stats.vertices) : 0.0f;
+        return stats;
+    }
+
+    void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+    {
+        if (!IsValidTriangleList(indices, indexCount, vertexCount) || cacheSize < 3)
+            return;
+
+        const size_t triangleCount = indexCount / 3;
+
+        // Vertex → triangles (CSR), live = triangles not yet emitted
+        std::vector<uint32_t> liveCount(vertexCount, 0);
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            ++liveCount[indices[i]];
+        }
+        std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            adjacencyOffset[v + 1] = adjacencyOffset[v] + liveCount[v];
+        }
+        std::vector<uint32_t> adjacency(indexCount);
+        {
+            std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+                }
+            }
+        }
+
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> deadEnds;              // recently referenced vertices (LIFO)
+        std::vector<uint32_t> candidates;            // vertices of the triangles emitted by the current fan
+        std::vector<uint32_t> output;
+        deadEnds.reserve(indexCount);
+        output.reserve(indexCount);
+
+        TimestampCache cache(vertexCount, cacheSize);
+        size_t scan = 0;                             // 막다른 곳에서 순차 탐색을 이어갈 위치
+
+        auto skipDeadEnd = [&]() -> uint32_t
+        {
+            while (!deadEnds.empty())
+            {
+                const uint32_t v = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveCount[v] > 0)
+                    return v;
+            }
+            for (; scan < vertexCount; ++scan)
+            {
+                if (liveCount[scan] > 0)
+                    return static_cast<uint32_t>(scan);
+            }
+            return kNone;
+        };
+
+        uint32_t fan = skipDeadEnd();
+        while (fan != kNone)
+        {
+            // Emit every live triangle around the fanning vertex
+            candidates.clear();
+            for (uint32_t a = adjacencyOffset[fan]; a < adjacencyOffset[fan + 1]; ++a)
+            {
+                const uint32_t t = adjacency[a];
+                if (emitted[t])
+                    continue;
+                emitted[t] = 1;
+
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t v = indices[t * 3 + k];
+                    output.push_back(v);
+                    deadEnds.push_back(v);
+                    candidates.push_back(v);
+                    --liveCount[v];
+                    cache.Touch(v);
+                }
+            }
+
+            // Next fan: the oldest candidate that is still resident after emitting its remaining triangles
+            uint32_t next = kNone;
+            int64_t bestPriority = -1;
+            for (const uint32_t v : candidates)
+            {
+                if (liveCount[v] == 0)
+                    continue;
+
+                int64_t priority = 0;
+                const uint32_t age = cache.time - cache.stamps[v];
+                if (age + 2 * liveCount[v] <= cacheSize)
+                    priority = age;
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    next = v;
+                }
+            }
+
+            fan = (next != kNone) ? next : skipDeadEnd();
+        }
+
+        std::copy(output.begin(), output.end(), indices);
+    }
+
+    void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const void* positions, size_t positionStride,
+                          size_t vertexCount, uint32_t cacheSize, float threshold)
+    {
+        if (!IsValidTriangleList(indices, indexCount, vertexCount) || !positions || cacheSize < 3)
+            return;
+
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2)
+            return;
+
+        TimestampCache cache(vertexCount, cacheSize);
+
+        // Hard boundaries: triangles that miss all three vertices (Tipsify restarted after a dead end)
+        std::vector<uint32_t> hardClusters;
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            if (cache.Triangle(indices + t * 3) == 3)
+                hardClusters.push_back(static_cast<uint32_t>(t));
+        }
+
+        // Soft boundaries: split a hard cluster as soon as its running ACMR reaches threshold x the cluster's own ACMR
+        // (클러스터가 작을수록 정렬 자유도가 커지고, 캐시 손실은 threshold로 묶인다)
+        std::vector<uint32_t> clusters;
+        for (size_t h = 0; h < hardClusters.size(); ++h)
+        {
+            const uint32_t start = hardClusters[h];
+            const uint32_t end = (h + 1 < hardClusters.size()) ? hardClusters[h + 1] : static_cast<uint32_t>(triangleCount);
+
+            cache.Flush();
+            uint32_t clusterMisses = 0;
+            for (uint32_t t = start; t < end; ++t)
+            {
+                clusterMisses += cache.Triangle(indices + t * 3);
+            }
+            const float target = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+            clusters.push_back(start);
+            cache.Flush();
+            uint32_t runningMisses = 0;
+            uint32_t runningTriangles = 0;
+            for (uint32_t t = start; t < end; ++t)
+            {
+                runningMisses += cache.Triangle(indices + t * 3);
+                ++runningTriangles;
+                if (t + 1 < end && static_cast<float>(runningMisses) <= target * static_cast<float>(runningTriangles))
+                {
+                    clusters.push_back(t + 1);
+                    cache.Flush();
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+
+            // 마지막 조각이 목표 ACMR에 못 미치면 앞 클러스터에 붙인다
+            if (clusters.back() != start && runningTriangles > 0 &&
+                static_cast<float>(runningMisses) > target * static_cast<float>(runningTriangles))
+            {
+                clusters.pop_back();
+            }
+        }
+
+        if (clusters.size() < 2)
+            return;
+
+        // Mesh centroid (triangle corners)
+        double meshX = 0.0, meshY = 0.0, meshZ = 0.0;
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            const Float3 p = LoadPosition(positions, positionStride, indices[i]);
+            meshX += p.x;
+            meshY += p.y;
+            meshZ += p.z;
+        }
+        const float invCorners = 1.0f / static_cast<float>(indexCount);
+        const Float3 meshCentroid{ static_cast<float>(meshX) * invCorners, static_cast<float>(meshY) * invCorners,
+                                   static_cast<float>(meshZ) * invCorners };
+
+        // Sort key per cluster: how far the cluster faces outward from the mesh centroid
+        // 바깥을 향한 클러스터를 먼저 그려서, 뒤에 오는 (가려지는) 클러스터가 깊이 테스트에서 걸러지게 한다
+        struct ClusterKey
+        {
+            uint32_t start;
+            uint32_t end;
+            float key;
+        };
+        std::vector<ClusterKey> keys(clusters.size());
+        for (size_t c = 0; c < clusters.size(); ++c)
+        {
+            const uint32_t start = clusters[c];
+            const uint32_t end = (c + 1 < clusters.size()) ? clusters[c + 1] : static_cast<uint32_t>(triangleCount);
+
+            Float3 centroid{ 0.0f, 0.0f, 0.0f };
+            Float3 normal{ 0.0f, 0.0f, 0.0f };
+            float area = 0.0f;
+            for (uint32_t t = start; t < end; ++t)
+            {
+                const Float3 a = LoadPosition(positions, positionStride, indices[t * 3 + 0]);
+                const Float3 b = LoadPosition(positions, positionStride, indices[t * 3 + 1]);
+                const Float3 c3 = LoadPosition(positions, positionStride, indices[t * 3 + 2]);
+
+                const Float3 ab{ b.x - a.x, b.y - a.y, b.z - a.z };
+                const Float3 ac{ c3.x - a.x, c3.y - a.y, c3.z - a.z };
+                const Float3 n{ ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x };
+                const float triangleArea = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+
+                centroid.x += (a.x + b.x + c3.x) * triangleArea;
+                centroid.y += (a.y + b.y + c3.y) * triangleArea;
+                centroid.z += (a.z + b.z + c3.z) * triangleArea;
+                normal.x += n.x;
+                normal.y += n.y;
+                normal.z += n.z;
+                area += triangleArea;
+            }
+
+            float key = 0.0f;
+            const float normalLength = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+            if (area > 0.0f && normalLength > 0.0f)
+            {
+                const float invArea = 1.0f / (3.0f * area);
+                const Float3 toCluster{ centroid.x * invArea - meshCentroid.x, centroid.y * invArea - meshCentroid.y,
+                                        centroid.z * invArea - meshCentroid.z };
+                key = (toCluster.x * normal.x + toCluster.y * normal.y + toCluster.z * normal.z) / normalLength;
+            }
+            keys[c] = ClusterKey{ start, end, key };
+        }
+
+        std::stable_sort(keys.begin(), keys.end(), [](const ClusterKey& a, const ClusterKey& b) { return a.key > b.key; });
+
+        std::vector<uint32_t> output;
+        output.reserve(indexCount);
+        for (const ClusterKey& cluster : keys)
+        {
+            output.insert(output.end(), indices + cluster.start * 3, indices + cluster.end * 3);
+        }
+        std::copy(output.begin(), output.end(), indices);
+    }
+
+    size_t OptimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount, std::vector<uint32_t>& remap)
+    {
+        remap.assign(vertexCount, kNone);
+        if (!IsValidTriangleList(indices, indexCount, vertexCount))
+        {
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                remap[v] = static_cast<uint32_t>(v);
+            }
+            return vertexCount;
+        }
+
+        uint32_t next = 0;
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            uint32_t& slot = remap[indices[i]];
+            if (slot == kNone)
+                slot = next++;
+            indices[i] = slot;
+        }
+
+        const size_t referenced = next;
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            if (remap[v] == kNone)
+                remap[v] = next++;
+        }
+        return referenced;
+    }
+
+    float ComputeMeshScale(const void* positions, size_t positionStride, size_t vertexCount)
+    {
+        if (vertexCount == 0)
+            return 0.0f;
+
+        Float3 minP = LoadPosition(positions, positionStride, 0);
+        Float3 maxP = minP;
+        for (size_t v = 1; v < vertexCount; ++v)
+        {
+            const Float3 p = LoadPosition(positions, positionStride, static_cast<uint32_t>(v));
+            minP = Float3{ (std::min)(minP.x, p.x), (std::min)(minP.y, p.y), (std::min)(minP.z, p.z) };
+            maxP = Float3{ (std::max)(maxP.x, p.x), (std::max)(maxP.y, p.y), (std::max)(maxP.z, p.z) };
+        }
+        return (std::max)(maxP.x - minP.x, (std::max)(maxP.y - minP.y, maxP.z - minP.z));
+    }
+
+    size_t Simplify(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                    const void* positions, size_t positionStride, size_t vertexCount,
+                    size_t targetIndexCount, float targetError, const SkinInfluences* skin, float* outError)
+    {
+        if (outError)
+            *outError = 0.0f;
+        if (!IsValidTriangleList(indices, indexCount, vertexCount) || !positions)
+        {
+            std::copy(indices, indices + indexCount, destination);
+            return indexCount;
+        }
+
+        // Positions in the unit box (errors are relative to the mesh size)
+        const float scale = ComputeMeshScale(positions, positionStride, vertexCount);
+        const float invScale = scale > 0.0f ? 1.0f / scale : 0.0f;
+        const Float3 origin = LoadPosition(positions, positionStride, 0);
+        std::vector<Float3> position(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const Float3 p = LoadPosition(positions, positionStride, static_cast<uint32_t>(v));
+            position[v] = Float3{ (p.x - origin.x) * invScale, (p.y - origin.y) * invScale, (p.z - origin.z) * invScale };
+        }
+
+        // Wedges: vertices sharing a position (first one = position id), linked in a ring
+        std::vector<uint32_t> positionId(vertexCount);
+        std::vector<uint32_t> wedge(vertexCount);
+        {
+            struct PositionHash
+            {
+                size_t operator()(const Float3& p) const
+                {
+                    uint32_t h[3];
+                    std::memcpy(h, &p, sizeof(h));
+                    return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+                }
+            };
+            struct PositionEqual
+            {
+                bool operator()(const Float3& a, const Float3& b) const { return std::memcmp(&a, &b, sizeof(Float3)) == 0; }
+            };
+            std::unordered_map<Float3, uint32_t, PositionHash, PositionEqual> firstOfPosition;
+            firstOfPosition.reserve(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                const auto it = firstOfPosition.emplace(position[v], v).first;
+                const uint32_t first = it->second;
+                positionId[v] = first;
+                if (first == v)
+                {
+                    wedge[v] = v;
+                }
+                else
+                {
+                    wedge[v] = wedge[first];
+                    wedge[first] = v;
+                }
+            }
+        }
+        auto wedgeCount = [&](uint32_t v)
+        {
+            uint32_t count = 1;
+            for (uint32_t w = wedge[v]; w != v; w = wedge[w])
+                ++count;
+            return count;
+        };
+
+        std::vector<uint32_t> result(indices, indices + indexCount);
+        TriangleAdjacency adjacency;
+        adjacency.Build(result.data(), result.size(), vertexCount);
+
+        // Open (one-sided) edges per vertex
+        constexpr uint32_t kMany = kNone - 1;
+        std::vector<uint32_t> openOut(vertexCount, kNone);
+        std::vector<uint32_t> openIn(vertexCount, kNone);
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            const uint32_t a = result[i];
+            const uint32_t b = result[(i % 3 == 2) ? i - 2 : i + 1];
+            if (adjacency.HasEdge(b, a))
+                continue;
+            openOut[a] = (openOut[a] == kNone) ? b : kMany;
+            openIn[b] = (openIn[b] == kNone) ? a : kMany;
+        }
+
+        auto positionEdgeExists = [&](uint32_t a, uint32_t b)
+        {
+            uint32_t x = a;
+            do
+            {
+                uint32_t y = b;
+                do
+                {
+                    if (adjacency.HasEdge(x, y))
+                        return true;
+                    y = wedge[y];
+                } while (y != b);
+                x = wedge[x];
+            } while (x != a);
+            return false;
+        };
+
+        std::vector<VertexKind> kind(vertexCount, VertexKind::Locked);
+        for (uint32_t v = 0; v < vertexCount; ++v)
+        {
+            const bool hasOpen = openOut[v] != kNone || openIn[v] != kNone;
+            const bool singleOpen = openOut[v] < kMany && openIn[v] < kMany;
+            const uint32_t wedges = wedgeCount(v);
+
+            if (wedges == 1)
+            {
+                if (!hasOpen)
+                    kind[v] = VertexKind::Manifold;
+                else if (singleOpen && !positionEdgeExists(openOut[v], v) && !positionEdgeExists(v, openIn[v]))
+                    kind[v] = VertexKind::Border;
+            }
+            else if (wedges == 2 && singleOpen)
+            {
+                // 두 쪽이 서로의 열린 변을 닫아 주면 (위치 기준으로는 닫힌) 이음매
+                const uint32_t w = wedge[v];
+                if (openOut[w] < kMany && openIn[w] < kMany &&
+                    positionId[openOut[v]] == positionId[openIn[w]] && positionId[openIn[v]] == positionId[openOut[w]])
+                {
+                    kind[v] = VertexKind::Seam;
+                }
+            }
+        }
+
+        // Quadrics per position: triangle planes (area weighted) + planes along open edges
+        std::vector<Quadric> quadric(vertexCount);
+        for (size_t t = 0; t < indexCount / 3; ++t)
+        {
+            const uint32_t* tri = indices + t * 3;
+            const Float3 p0 = position[tri[0]];
+            const Float3 p1 = position[tri[1]];
+            const Float3 p2 = position[tri[2]];
+            Float3 n = Cross(Sub(p1, p0), Sub(p2, p0));
+            const float length = std::sqrt(Dot(n, n));
+            if (length <= 0.0f)
+                continue;
+            n = Float3{ n.x / length, n.y / length, n.z / length };
+            const double area = 0.5 * length;
+
+            for (int k = 0; k < 3; ++k)
+            {
+                quadric[positionId[tri[k]]].AddPlane(n.x, n.y, n.z, -Dot(n, p0), area);
+            }
+
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t a = tri[k];
+                const uint32_t b = tri[(k + 1) % 3];
+                if (adjacency.HasEdge(b, a))
+                    continue;
+
+                // Plane through the edge, perpendicular to the triangle
+                const Float3 edge = Sub(position[b], position[a]);
+                const float edgeLengthSq = Dot(edge, edge);
+                Float3 side = Cross(edge, n);
+                const float sideLength = std::sqrt(Dot(side, side));
+                if (sideLength <= 0.0f)
+                    continue;
+                side = Float3{ side.x / sideLength, side.y / sideLength, side.z / sideLength };
+                const double d = -Dot(side, position[a]);
+                quadric[positionId[a]].AddPlane(side.x, side.y, side.z, d, edgeLengthSq * kBorderWeight);
+                quadric[positionId[b]].AddPlane(side.x, side.y, side.z, d, edgeLengthSq * kBorderWeight);
+            }
+        }
+
+        // Partner collapse of a seam: the wedge of v that shares an open edge with the wedge of u
+        auto seamPartner = [&](uint32_t u, uint32_t v) -> uint32_t
+        {
+            const uint32_t s0 = wedge[u];
+            uint32_t s1 = v;
+            do
+            {
+                if (adjacency.IsOpenEdge(s0, s1))
+                    return s1;
+                s1 = wedge[s1];
+            } while (s1 != v);
+            return kNone;
+        };
+
+        auto canCollapse = [&](uint32_t u, uint32_t v)
+        {
+            switch (kind[u])
+            {
+            case VertexKind::Manifold:
+                return true;
+            case VertexKind::Border:
+                return adjacency.IsOpenEdge(u, v);
+            case VertexKind::Seam:
+                return adjacency.IsOpenEdge(u, v) && seamPartner(u, v) != kNone;
+            default:
+                return false;
+            }
+        };
+
+        // Geometric error + skinning penalty (가중치가 전혀 다르면 변 길이만큼 움직인 것으로 친다)
+        auto skinPenalty = [&](uint32_t u, uint32_t v)
+        {
+            if (!skin || !skin->boneIndices || !skin->boneWeights)
+                return 0.0f;
+            const Float3 edge = Sub(position[v], position[u]);
+            return SkinDistance(*skin, u, v) * Dot(edge, edge);
+        };
+
+        // Moving u onto v must not turn any remaining triangle around u inside out
+        auto flipsTriangle = [&](uint32_t u, uint32_t v)
+        {
+            for (uint32_t k = adjacency.offset[u]; k < adjacency.offset[u + 1]; ++k)
+            {
+                const uint32_t* tri = result.data() + adjacency.triangles[k] * 3;
+                if (tri[0] == v || tri[1] == v || tri[2] == v)
+                    continue;
+
+                const Float3 p0 = position[tri[0]];
+                const Float3 p1 = position[tri[1]];
+                const Float3 p2 = position[tri[2]];
+                const Float3 before = Cross(Sub(p1, p0), Sub(p2, p0));
+                const Float3 q0 = tri[0] == u ? position[v] : p0;
+                const Float3 q1 = tri[1] == u ? position[v] : p1;
+                const Float3 q2 = tri[2] == u ? position[v] : p2;
+                const Float3 after = Cross(Sub(q1, q0), Sub(q2, q0));
+                if (Dot(before, after) <= 0.0f)
+                    return true;
+            }
+            return false;
+        };
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            float error;     // quadric (squared distance)
+            float cost;      // error + skinning penalty: order and limit
+        };
+        std::vector<Collapse> collapses;
+        std::vector<uint8_t> lockedThisPass(vertexCount, 0);
+        std::vector<uint32_t> collapseRemap(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v)
+        {
+            collapseRemap[v] = v;
+        }
+
+        const float errorLimit = targetError * targetError;
+        float maxError = 0.0f;
+        size_t resultCount = indexCount;
+
+        while (resultCount > targetIndexCount)
+        {
+            adjacency.Build(result.data(), resultCount, vertexCount);
+
+            // Cheapest valid direction of every edge
+            collapses.clear();
+            for (size_t i = 0; i < resultCount; ++i)
+            {
+                const uint32_t a = result[i];
+                const uint32_t b = result[(i % 3 == 2) ? i - 2 : i + 1];
+                if (positionId[a] == positionId[b])
+                    continue;
+
+                const bool ab = canCollapse(a, b);
+                const bool ba = canCollapse(b, a);
+                if (!ab && !ba)
+                    continue;
+                Collapse best{ kNone, kNone, FLT_MAX, FLT_MAX };
+                if (ab)
+                {
+                    const float error = static_cast<float>(quadric[positionId[a]].Error(position[b]));
+                    best = Collapse{ a, b, error, error + skinPenalty(a, b) };
+                }
+                if (ba)
+                {
+                    const float error = static_cast<float>(quadric[positionId[b]].Error(position[a]));
+                    const float cost = error + skinPenalty(b, a);
+                    if (cost < best.cost)
+                        best = Collapse{ b, a, error, cost };
+                }
+                collapses.push_back(best);
+            }
+            if (collapses.empty())
+                break;
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+            // 한 패스에 남은 삼각형 수의 일부만 접는다 (접힌 정점 주변은 다음 패스에서 다시 평가)
+            const size_t collapseGoal = (std::max)(static_cast<size_t>(1), (resultCount - targetIndexCount) / 6);
+            size_t applied = 0;
+            std::fill(lockedThisPass.begin(), lockedThisPass.end(), static_cast<uint8_t>(0));
+
+            for (const Collapse& collapse : collapses)
+            {
+                if (collapse.cost > errorLimit)
+                    break;
+
+                const uint32_t u = collapse.from;
+                const uint32_t v = collapse.to;
+                if (lockedThisPass[positionId[u]] || lockedThisPass[positionId[v]])
+                    continue;
+
+                uint32_t s0 = kNone;
+                uint32_t s1 = kNone;
+                if (kind[u] == VertexKind::Seam)
+                {
+                    s0 = wedge[u];
+                    s1 = seamPartner(u, v);
+                    if (s1 == kNone || flipsTriangle(s0, s1))
+                        continue;
+                }
+                if (flipsTriangle(u, v))
+                    continue;
+
+                collapseRemap[u] = v;
+                if (s0 != kNone)
+                    collapseRemap[s0] = s1;
+                quadric[positionId[v]].Add(quadric[positionId[u]]);
+                lockedThisPass[positionId[u]] = 1;
+                lockedThisPass[positionId[v]] = 1;
+                maxError = (std::max)(maxError, collapse.error);
+
+                if (++applied >= collapseGoal)
+                    break;
+            }
+            if (applied == 0)
+                break;
+
+            // Remap, drop triangles that collapsed (index or position)
+            size_t write = 0;
+            for (size_t i = 0; i < resultCount; i += 3)
+            {
+                const uint32_t a = collapseRemap[result[i + 0]];
+                const uint32_t b = collapseRemap[result[i + 1]];
+                const uint32_t c = collapseRemap[result[i + 2]];
+                if (positionId[a] == positionId[b] || positionId[b] == positionId[c] || positionId[c] == positionId[a])
+                    continue;
+                result[write + 0] = a;
+                result[write + 1] = b;
+                result[write + 2] = c;
+                write += 3;
+            }
+            resultCount = write;
+
+            for (const Collapse& collapse : collapses)
+            {
+                collapseRemap[collapse.from] = collapse.from;
+                if (kind[collapse.from] == VertexKind::Seam)
+                    collapseRemap[wedge[collapse.from]] = wedge[collapse.from];
+            }
+        }
+
+        std::copy(result.begin(), result.begin() + resultCount, destination);
+        if (outError)
+            *outError = std::sqrt(maxError);
+        return resultCount;
+    }
+}
@@ -0,0 +1,76 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Import-time triangle/vertex reordering for indexed triangle lists (one subset at a time)
+// 1) OptimizeVertexCache: Tipsify (Sander et al. 2007) - post-transform 캐시 재사용을 최대화하는 삼각형 순서
+// 2) OptimizeOverdraw: 캐시 순서를 클러스터로 나누고, 바깥을 향하는 클러스터부터 그리도록 정렬
+// 3) OptimizeVertexFetch: 정점을 처음 쓰이는 순서로 재배치 (remap 테이블 + 인덱스 갱신)
+// 4) Simplify: quadric edge collapse로 LOD 인덱스 버퍼 생성 (정점 버퍼는 그대로 공유)
+// 인덱스는 모두 서브셋 로컬 (0 ~ vertexCount-1), 삼각형 리스트만 지원한다.
+namespace ZMeshOptimizer
+{
+    constexpr uint32_t kDefaultCacheSize = 16;       // Tipsify / 클러스터링이 가정하는 FIFO 크기
+    constexpr uint32_t kStatsCacheSize = 32;         // ACMR/ATVR 리포트 (최근 GPU의 실효 크기)
+    constexpr float kDefaultOverdrawThreshold = 1.05f;  // 클러스터 ACMR 허용 증가율
+
+    // Post-transform cache statistics (FIFO simulation, CPU only)
+    struct CacheStats
+    {
+        uint32_t triangles = 0;
+        uint32_t vertices = 0;       // referenced vertices
+        uint32_t misses = 0;         // vertex shader invocations
+        float acmr = 0.0f;           // misses / triangle (0.5 ~ 3.0, 낮을수록 좋다)
+        float atvr = 0.0f;           // misses / referenced vertex (1.0 = 정점당 한 번)
+    };
+
+    CacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                  uint32_t cacheSize = kStatsCacheSize);
+
+    // In place
+    void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount,
+                             uint32_t cacheSize = kDefaultCacheSize);
+
+    // In place, expects the output of OptimizeVertexCache. positions: float3 at positionStride bytes apart
+    void OptimizeOverdraw(uint32_t* indices, size_t indexCount, const void* positions, size_t positionStride,
+                          size_t vertexCount, uint32_t cacheSize = kDefaultCacheSize,
+                          float threshold = kDefaultOverdrawThreshold);
+
+    // Rewrites indices to first-use order; remap[old] = new (unreferenced vertices keep their order at the end)
+    // Returns the number of referenced vertices
+    size_t OptimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount, std::vector<uint32_t>& remap);
+
+    // Skinning influences next to the positions (4 bone indices + 4 weights per vertex)
+    struct SkinInfluences
+    {
+        const uint32_t* boneIndices = nullptr;   // vertex 0
+        const float* boneWeights = nullptr;      // vertex 0
+        size_t stride = 0;                       // bytes between vertices
+    };
+
+    // Largest bounding box extent (the unit of Simplify's errors)
+    float ComputeMeshScale(const void* positions, size_t positionStride, size_t vertexCount);
+
+    // Quadric edge-collapse simplification into destination (index buffer only, vertices are reused)
+    // 같은 위치의 서로 다른 정점(UV/노멀/가중치 이음매)은 이음매를 따라 함께 접히고, 열린 경계는 경계를 따라서만 접힌다.
+    // 스키닝 가중치가 다른 정점으로 접으면 가중치 차이만큼 비용을 더한다.
+    // targetError: limit of error + skinning penalty, outError: largest geometric error (both relative to ComputeMeshScale)
+    // Returns the index count written (<= indexCount)
+    size_t Simplify(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                    const void* positions, size_t positionStride, size_t vertexCount,
+                    size_t targetIndexCount, float targetError, const SkinInfluences* skin = nullptr,
+                    float* outError = nullptr);
+
+    // vertices[remap[i]] = old vertices[i]
+    template<typename Vertex>
+    void ApplyVertexRemap(Vertex* vertices, size_t vertexCount, const std::vector<uint32_t>& remap)
+    {
+        std::vector<Vertex> source(vertices, vertices + vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            vertices[remap[i]] = source[i];
+        }
+    }
+}
@@ -19,6 +19,6 @@ namespace Bind
 
     void ZPixelShader::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->PSSetShader(pPixelShader.Get(), nullptr, 0u);
+        GetStateCache(gfx).SetPixelShader(pPixelShader.Get());
     }
 }
\ No newline at end of file
@@ -74,6 +74,6 @@ namespace Bind
 
     void ZRasterizer::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->RSSetState(pRasterizer.Get());
+        GetStateCache(gfx).SetRasterizer(pRasterizer.Get());
     }
 }
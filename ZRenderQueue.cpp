@@ -0,0 +1,235 @@
+﻿#include "ZD3D11.h"
+#include "ZRenderQueue.h"
+#include "ZTransformStream.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr size_t kRadixMinPackets = 64;   // 이보다 작으면 stable_sort가 빠르다
+
+    bool KeyLess(const ZDrawPacket& a, const ZDrawPacket& b) noexcept
+    {
+        return a.key < b.key;
+    }
+}
+
+void ZRenderQueue::Begin(FXMMATRIX view)
+{
+    XMStoreFloat4x4(&view_, view);
+    packets_.clear();
+}
+
+uint32_t ZRenderQueue::ShaderIdOf(const void* shaderKey)
+{
+    auto it = shaderIds_.find(shaderKey);
+    if (it != shaderIds_.end())
+        return it->second;
+    const uint32_t id = static_cast<uint32_t>(shaderIds_.size()) & ((1u << ZSortKey::kShaderBits) - 1);
+    shaderIds_.emplace(shaderKey, id);
+    return id;
+}
+
+uint32_t ZRenderQueue::MaterialIdOf(const void* materialKey)
+{
+    if (!materialKey)
+        return 0;
+    auto it = materialIds_.find(materialKey);
+    if (it != materialIds_.end())
+        return it->second;
+    // 0은 "재질 없음"
+    const uint32_t id = static_cast<uint32_t>(materialIds_.size() + 1) & ((1u << ZSortKey::kMaterialBits) - 1);
+    materialIds_.emplace(materialKey, id);
+    return id;
+}
+
+void ZRenderQueue::Submit(const ZRenderable& renderable)
+{
+    // 원점의 view 공간 z (행벡터 규약: world * view)
+    const XMVECTOR origin = renderable.GetTransformXM().r[3];
+    const float depth = XMVectorGetZ(XMVector3Transform(origin, XMLoadFloat4x4(&view_)));
+
+    const uint64_t key = ZSortKey::Make(renderable.GetRenderPass(), ShaderIdOf(renderable.GetShaderKey()),
+                                        MaterialIdOf(renderable.GetMaterialKey()), depth);
+    packets_.push_back(ZDrawPacket{ key, &renderable });
+}
+
+void ZRenderQueue::Submit(uint64_t key, const ZRenderable* renderable)
+{
+    packets_.push_back(ZDrawPacket{ key, renderable });
+}
+
+void ZRenderQueue::Sort()
+{
+    const size_t count = packets_.size();
+    if (count < kRadixMinPackets)
+    {
+        std::stable_sort(packets_.begin(), packets_.end(), KeyLess);
+        return;
+    }
+
+    // 8개 자릿수의 히스토그램을 한 번에
+    uint32_t histograms[8][256] = {};
+    for (const ZDrawPacket& packet : packets_)
+    {
+        uint64_t key = packet.key;
+        for (int digit = 0; digit < 8; ++digit, key >>= 8)
+        {
+            ++histograms[digit][key & 0xFF];
+        }
+    }
+
+    scratch_.resize(count);
+    ZDrawPacket* src = packets_.data();
+    ZDrawPacket* dst = scratch_.data();
+    for (int digit = 0; digit < 8; ++digit)
+    {
+        const int shift = digit * 8;
+        uint32_t* histogram = histograms[digit];
+
+        // 모든 키의 이 자릿수가 같으면 건너뛴다 (셰이더/재질 수가 적으면 대부분의 상위 자릿수)
+        if (histogram[(src[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket)
+        {
+            const uint32_t n = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != packets_.data())
+    {
+        packets_.swap(scratch_);
+    }
+}
+
+void ZRenderQueue::Execute(ZGraphics& gfx) const
+{
+    // 모든 패킷의 변환을 먼저 한 번에 써 두고, 드로우마다 자기 슬롯을 고르게 한다
+    ZTransformStream& transforms = gfx.GetTransformStream();
+    const bool streamed = transforms.Build(packets_.data(), packets_.size(), gfx.GetCamera(), gfx.GetProjection());
+
+    for (size_t i = 0; i < packets_.size(); ++i)
+    {
+        if (streamed)
+        {
+            transforms.Select(i);
+        }
+        packets_[i].renderable->Render(gfx);
+    }
+    transforms.End();
+}
+
+bool ZRenderQueue::RunBenchmark()
+{
+    constexpr size_t kCounts[] = { 10000, 50000, 100000 };
+    constexpr int kIterations = 20;
+    constexpr uint32_t kShaders = 16;
+    constexpr uint32_t kMaterials = 256;
+
+    bool allPassed = true;
+    std::cout << "=== ZRenderQueue benchmark ===" << std::endl;
+
+    const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 20.0f, -80.0f, 1.0f), XMVectorZero(),
+                                           XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+
+    for (const size_t count : kCounts)
+    {
+        // 씬 흉내: 위치, 셰이더, 재질, 10%는 반투명
+        std::mt19937 rng(20250315u);
+        std::uniform_real_distribution<float> coord(-200.0f, 200.0f);
+        std::uniform_int_distribution<uint32_t> shader(0, kShaders - 1);
+        std::uniform_int_distribution<uint32_t> material(0, kMaterials - 1);
+        std::uniform_int_distribution<int> percent(0, 99);
+
+        std::vector<XMFLOAT3> positions(count);
+        std::vector<uint32_t> shaders(count), materials(count);
+        std::vector<ZRenderPass> passes(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            positions[i] = XMFLOAT3(coord(rng), coord(rng), coord(rng));
+            shaders[i] = shader(rng);
+            materials[i] = material(rng);
+            passes[i] = percent(rng) < 10 ? ZRenderPass::Blended : ZRenderPass::Opaque;
+        }
+
+        ZRenderQueue queue;
+        std::vector<ZDrawPacket> submitted;
+        double buildMs = 0.0, radixMs = 0.0, stableSortMs = 0.0;
+        bool matches = true;
+
+        for (int iteration = 0; iteration < kIterations; ++iteration)
+        {
+            // 1. Packet construction (depth + key)
+            auto buildStart = std::chrono::high_resolution_clock::now();
+            queue.Begin(view);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float depth = XMVectorGetZ(XMVector3Transform(XMLoadFloat3(&positions[i]), view));
+                // 렌더러블 대신 제출 순서 (역참조하지 않는다, 안정성 검사용)
+                queue.Submit(ZSortKey::Make(passes[i], shaders[i], materials[i], depth),
+                             reinterpret_cast<const ZRenderable*>((i + 1) * 16));
+            }
+            auto buildEnd = std::chrono::high_resolution_clock::now();
+            buildMs += std::chrono::duration<double, std::milli>(buildEnd - buildStart).count();
+
+            submitted = queue.GetPackets();
+
+            // 2. Radix sort
+            auto radixStart = std::chrono::high_resolution_clock::now();
+            queue.Sort();
+            auto radixEnd = std::chrono::high_resolution_clock::now();
+            radixMs += std::chrono::duration<double, std::milli>(radixEnd - radixStart).count();
+
+            // 3. Reference
+            std::vector<ZDrawPacket> reference = submitted;
+            auto stableStart = std::chrono::high_resolution_clock::now();
+            std::stable_sort(reference.begin(), reference.end(), KeyLess);
+            auto stableEnd = std::chrono::high_resolution_clock::now();
+            stableSortMs += std::chrono::duration<double, std::milli>(stableEnd - stableStart).count();
+
+            const std::vector<ZDrawPacket>& sorted = queue.GetPackets();
+            for (size_t i = 0; i < count && matches; ++i)
+            {
+                matches = sorted[i].key == reference[i].key && sorted[i].renderable == reference[i].renderable;
+            }
+        }
+
+        // 셰이더/재질 전환 횟수: 제출 순서 vs 정렬 순서 (불투명 패스)
+        auto countTransitions = [&](const std::vector<ZDrawPacket>& packets)
+        {
+            size_t transitions = 0;
+            uint64_t previous = UINT64_MAX;
+            for (const ZDrawPacket& packet : packets)
+            {
+                if ((packet.key >> 60) != static_cast<uint64_t>(ZRenderPass::Opaque))
+                    continue;
+                const uint64_t group = packet.key >> 32;   // pass + shader + material
+                transitions += (group != previous) ? 1 : 0;
+                previous = group;
+            }
+            return transitions;
+        };
+
+        allPassed = allPassed && matches;
+        std::cout << "[ZRenderQueue] " << count << " packets: build " << buildMs / kIterations << " ms, radix sort "
+                  << radixMs / kIterations << " ms, std::stable_sort " << stableSortMs / kIterations
+                  << " ms, opaque shader/material changes " << countTransitions(submitted) << " -> "
+                  << countTransitions(queue.GetPackets()) << (matches ? "  OK" : "  MISMATCH") << std::endl;
+    }
+
+    std::cout << "=== ZRenderQueue benchmark " << (allPassed ? "passed" : "FAILED") << " ===" << std::endl;
+    return allPassed;
+}
@@ -0,0 +1,82 @@
+﻿#pragma once
+
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "ZRenderable.h"
+
+class ZGraphics;
+
+// Draw packet: 64-bit sort key + the renderable that draws itself (Render → ZStateCache 경유 바인드)
+struct ZDrawPacket
+{
+    uint64_t key;
+    const ZRenderable* renderable;
+};
+
+// Sort key layout (정렬 = 키 오름차순)
+//  Opaque:  [pass:4][shader:12][material:16][depth:32]      같은 셰이더/재질끼리 모으고 안에서는 앞→뒤
+//  Blended: [pass:4][~depth:32][shader:12][material:16]     깊이가 우선, 뒤→앞
+namespace ZSortKey
+{
+    constexpr uint32_t kShaderBits = 12;
+    constexpr uint32_t kMaterialBits = 16;
+
+    // View-space depth → 단조 증가하는 부호 없는 정수 (음수 깊이도 순서 유지)
+    inline uint32_t DepthBits(float depth) noexcept
+    {
+        uint32_t bits;
+        static_assert(sizeof(bits) == sizeof(depth), "float must be 32-bit");
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    inline uint64_t Make(ZRenderPass pass, uint32_t shader, uint32_t material, float depth) noexcept
+    {
+        const uint64_t passBits = static_cast<uint64_t>(pass) << 60;
+        const uint64_t shaderBits = shader & ((1u << kShaderBits) - 1);
+        const uint64_t materialBits = material & ((1u << kMaterialBits) - 1);
+        if (pass == ZRenderPass::Opaque)
+        {
+            return passBits | (shaderBits << 48) | (materialBits << 32) | DepthBits(depth);
+        }
+        return passBits | (static_cast<uint64_t>(~DepthBits(depth)) << 28) | (shaderBits << 16) | materialBits;
+    }
+}
+
+// Per-frame render queue: Begin → Submit (객체마다) → Sort (LSD radix, 8비트 x 8회) → Execute
+// 정렬은 안정적이라 키가 같은 패킷은 제출 순서를 유지한다. ZStateCache와 함께 쓰면
+// 같은 셰이더/재질이 연속으로 그려져 실제 상태 변경이 줄어든다.
+class ZRenderQueue
+{
+public:
+    // view: 깊이 계산용 카메라 행렬 (ZGraphics::GetCamera)
+    void Begin(DirectX::FXMMATRIX view);
+
+    // Key from the renderable's pass / shader key / material key and its origin's view depth
+    void Submit(const ZRenderable& renderable);
+    void Submit(uint64_t key, const ZRenderable* renderable);
+
+    void Sort();
+    void Execute(ZGraphics& gfx) const;
+
+    const std::vector<ZDrawPacket>& GetPackets() const noexcept { return packets_; }
+
+    // Dense id of a shader/material key (프레임을 넘어 유지, 비트 폭을 넘으면 접힌다)
+    uint32_t ShaderIdOf(const void* shaderKey);
+    uint32_t MaterialIdOf(const void* materialKey);
+
+    // Headless: 10k~100k 패킷 키 생성/정렬 시간, std::stable_sort와 결과 비교 (--render-queue-bench)
+    static bool RunBenchmark();
+
+private:
+    DirectX::XMFLOAT4X4 view_ = {};
+    std::vector<ZDrawPacket> packets_;
+    std::vector<ZDrawPacket> scratch_;
+    std::unordered_map<const void*, uint32_t> shaderIds_;
+    std::unordered_map<const void*, uint32_t> materialIds_;
+};
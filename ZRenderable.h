@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <DirectXMath.h>
+#include <cstdint>
 #include "ZConditionalNoexcept.h"
 
 namespace Bind
@@ -10,6 +11,14 @@ namespace Bind
 
 class ZGraphics;
 
+// Render queue pass (sort key top bits): opaque → blended → overlay
+enum class ZRenderPass : uint8_t
+{
+    Opaque = 0,     // 셰이더/재질별로 묶고, 같은 묶음 안에서는 앞에서 뒤로
+    Blended,        // 뒤에서 앞으로
+    Overlay
+};
+
 class ZRenderable
 {
     template<class T>
@@ -26,8 +35,15 @@ public:
     ZRenderable() = default;
     ZRenderable(const ZRenderable&) = delete;
     virtual DirectX::XMMATRIX GetTransformXM() const noexcept = 0;
-    void Render(ZGraphics& gfx) const noxnd;
+    virtual void Render(ZGraphics& gfx) const noxnd;
     virtual void Update(float dt) noexcept = 0;
+
+    // Render queue sort inputs (ZRenderQueue::Submit)
+    virtual ZRenderPass GetRenderPass() const noexcept { return ZRenderPass::Opaque; }
+    // 같은 값 = 같은 셰이더/정적 바인드 (기본: 타입별 정적 바인드 목록, ZRenderableBase<T>마다 하나)
+    virtual const void* GetShaderKey() const noexcept { return &GetStaticBinds(); }
+    // 재질/텍스처 묶음 (기본: 구분 없음)
+    virtual const void* GetMaterialKey() const noexcept { return nullptr; }
     virtual ~ZRenderable() = default;
 
 protected:
@@ -1,7 +1,9 @@
 ﻿#pragma once
+#include <map>
 #include "ZD3D11.h"
 #include "ZRenderable.h"
 #include "ZIndexBuffer.h"
+#include "ZInstanceBuffer.h"
 #include "ZConditionalNoexcept.h"
 
 /**
@@ -38,6 +40,15 @@
  * };
  * @endcode
  * 
+ * 변형별 정적 바인딩 (선택):
+ * - 같은 타입이라도 정점 형식 등에 따라 VS/입력 레이아웃이 다르면 AddStaticVariantBind(variant, ...)로 변형마다 한 벌 등록
+ * - Render()에서 BindAll() 다음에 BindStaticVariant(gfx, variant), 정렬 키는 GetStaticVariantKey(variant)
+ * 
+ * 인스턴싱 (선택):
+ * - 정적 초기화에서 AddStaticInstancedBind()로 인스턴스 스트림을 읽는 VS/레이아웃/PS 등록
+ * - 프레임마다 Render() 대신 SubmitInstance(), 그다음 GetInstanceBatch()를 렌더 큐에 제출 (실행 시 RenderInstances())
+ * - 재질이 객체마다 다르면 T가 GetInstanceMaterial()을 같은 이름으로 제공 (스트림에 들어간다)
+ * 
  * CRTP 패턴 설명:
  * - 각 파생 클래스 T마다 별도의 staticBinds 정적 변수 생성
  * - Box<Box>와 Sphere<Sphere>는 서로 다른 staticBinds를 가짐
@@ -144,6 +155,89 @@ protected:
      * }
      * @endcode
      */
+    /**
+     * @brief 인스턴싱용 정적 바인딩 추가
+     * 
+     * RenderInstances()에서 정적 바인딩 다음에 바인딩되어 VS/입력 레이아웃/PS를 덮어씁니다.
+     * 입력 레이아웃은 ZInstancing::AppendInstanceElements()로 슬롯 1 요소를 붙여 만듭니다.
+     * 
+     * @param bind 추가할 바인딩 리소스 (unique_ptr로 소유권 이전)
+     * 
+     * 사용 예:
+     * @code
+     * auto pivs = std::make_unique<ZVertexShader>(gfx, L"./x64/Debug/PhongInstancedVS.cso");
+     * auto pivsbc = pivs->GetBytecode();
+     * AddStaticInstancedBind(std::move(pivs));
+     * AddStaticInstancedBind(std::make_unique<ZInputLayout>(gfx, ZInstancing::AppendInstanceElements(ied), pivsbc));
+     * @endcode
+     */
+    static void AddStaticInstancedBind(std::unique_ptr<Bind::ZBindable> bind) noxnd
+    {
+        assert("Index buffer is shared with the static binds" && typeid(*bind) != typeid(Bind::ZIndexBuffer));
+        staticInstancedBinds.push_back(std::move(bind));
+    }
+
+    /**
+     * @brief 변형(variant)의 정적 바인딩이 초기화되었는지 확인
+     * 
+     * @param variant 변형 번호 (예: 정점 형식)
+     * @return true 이미 초기화됨 (리소스 재사용 가능)
+     */
+    static bool IsStaticVariantInitialized(size_t variant) noexcept
+    {
+        const auto it = staticVariantBinds.find(variant);
+        return it != staticVariantBinds.end() && !it->second.empty();
+    }
+
+    /**
+     * @brief 변형 전용 정적 바인딩 추가
+     * 
+     * 같은 변형의 모든 객체가 공유하고, 정적 바인딩과 같은 수명을 가집니다.
+     * 
+     * @param variant 변형 번호
+     * @param bind 추가할 바인딩 리소스 (unique_ptr로 소유권 이전)
+     * 
+     * 사용 예:
+     * @code
+     * if (!IsStaticVariantInitialized(variant))
+     * {
+     *     auto pvs = std::make_unique<ZVertexShader>(gfx, L"./x64/Debug/SkinnedModelPackedVS.cso");
+     *     auto pvsbc = pvs->GetBytecode();
+     *     AddStaticVariantBind(variant, std::move(pvs));
+     *     AddStaticVariantBind(variant, std::make_unique<ZInputLayout>(gfx, ied, pvsbc));
+     * }
+     * @endcode
+     */
+    static void AddStaticVariantBind(size_t variant, std::unique_ptr<Bind::ZBindable> bind) noxnd
+    {
+        assert("Index buffer is shared with the static binds" && typeid(*bind) != typeid(Bind::ZIndexBuffer));
+        staticVariantBinds[variant].push_back(std::move(bind));
+    }
+
+    /**
+     * @brief 변형의 정적 바인딩을 파이프라인에 바인딩 (BindAll 다음에 호출)
+     */
+    static void BindStaticVariant(ZGraphics& gfx, size_t variant) noxnd
+    {
+        const auto it = staticVariantBinds.find(variant);
+        assert("Static variant binds were not added" && it != staticVariantBinds.end());
+        for (auto& b : it->second)
+        {
+            b->Bind(gfx);
+        }
+    }
+
+    /**
+     * @brief 변형의 렌더 큐 셰이더 키 (GetShaderKey 오버라이드용)
+     * 
+     * @note map 노드 주소라 다른 변형이 추가되어도 바뀌지 않음
+     */
+    static const void* GetStaticVariantKey(size_t variant) noexcept
+    {
+        const auto it = staticVariantBinds.find(variant);
+        return it == staticVariantBinds.end() ? static_cast<const void*>(&staticBinds) : static_cast<const void*>(&it->second);
+    }
+
     void SetIndexFromStatic() noxnd
     {
         assert("Attempting to add index buffer a second time" && pIndexBuffer == nullptr);
@@ -160,7 +254,140 @@ protected:
         assert("Failed to find index buffer in static binds" && pIndexBuffer != nullptr);
     }
     
+public:
+    /**
+     * @brief 인스턴싱 경로가 준비된 타입인지 확인
+     * 
+     * @return true AddStaticInstancedBind()로 인스턴스용 바인딩이 등록됨
+     */
+    static bool SupportsInstancing() noexcept
+    {
+        return !staticInstancedBinds.empty();
+    }
+
+    /**
+     * @brief 이번 프레임 인스턴스 배치에 추가 (Render() 대신)
+     * 
+     * @warning 객체는 같은 프레임의 RenderInstances()까지 살아 있어야 함
+     */
+    void SubmitInstance() const
+    {
+        instanceQueue.push_back(static_cast<const T*>(this));
+    }
+
+    /**
+     * @brief 모은 인스턴스를 DrawIndexedInstanced 한 번으로 그림
+     * 
+     * 동작 과정:
+     * 1. 인스턴스마다 transpose(model * view) + 재질을 ZInstanceData로 패킹
+     * 2. 인스턴스 버퍼 갱신 (Map DISCARD 한 번) → 입력 슬롯 1
+     * 3. 정적 바인딩 → 인스턴싱용 바인딩 → 투영 상수 (VS slot 0, 프레임 상수 링)
+     * 4. DrawIndexedInstanced, 배치 비움
+     * 
+     * @return UINT 발행한 드로우 호출 수 (0 또는 1)
+     */
+    static UINT RenderInstances(ZGraphics& gfx) noxnd
+    {
+        if (instanceQueue.empty())
+        {
+            return 0u;
+        }
+        assert("Instanced binds were not added for this type" && SupportsInstancing());
+
+        const DirectX::XMMATRIX view = gfx.GetCamera();
+        instanceData.resize(instanceQueue.size());
+        for (size_t i = 0; i < instanceQueue.size(); ++i)
+        {
+            // T가 GetInstanceMaterial()을 가리면 그쪽이 불린다 (CRTP 정적 디스패치)
+            ZInstancing::Pack(instanceQueue[i]->GetTransformXM(), view, instanceQueue[i]->GetInstanceMaterial(), instanceData[i]);
+        }
+
+        if (!pInstanceBuffer)
+        {
+            pInstanceBuffer = std::make_unique<Bind::ZInstanceBuffer>();
+        }
+        const UINT instanceCount = static_cast<UINT>(instanceData.size());
+        pInstanceBuffer->Update(gfx, instanceData.data(), instanceCount);
+
+        // 인덱스 버퍼는 타입 공통 (정적 바인딩)
+        const Bind::ZIndexBuffer* pIndices = static_cast<const ZRenderable*>(instanceQueue.front())->pIndexBuffer;
+        instanceQueue.clear();
+
+        for (auto& b : staticBinds)
+        {
+            b->Bind(gfx);
+        }
+        for (auto& b : staticInstancedBinds)
+        {
+            b->Bind(gfx);
+        }
+        pInstanceBuffer->Bind(gfx);
+        if (!ZInstancing::BindFrameConstants(gfx))
+        {
+            return 0u;
+        }
+
+        gfx.RenderIndexedInstanced(pIndices->GetCount(), instanceCount);
+        return 1u;
+    }
+
+    /**
+     * @brief 이번 프레임 인스턴스 배치를 나타내는 렌더러블 (렌더 큐 패킷 하나)
+     * 
+     * 정렬 키는 첫 인스턴스의 패스/셰이더 키를 따른다 → 인스턴싱을 끈 경로와 같은 셰이더 묶음에 정렬된다.
+     * 재질은 인스턴스 스트림에 있으므로 재질 키는 없음, 깊이는 원점 기준 (배치는 한 위치가 아니다).
+     * 
+     * @return const ZRenderable* SubmitInstance()된 객체가 없으면 nullptr
+     */
+    static const ZRenderable* GetInstanceBatch() noexcept
+    {
+        return instanceQueue.empty() ? nullptr : &instanceBatch;
+    }
+
+    /**
+     * @brief 인스턴스 재질 기본값 (재질이 타입 공통이거나 정적 상수 버퍼에 있는 경우)
+     * 
+     * @note 가상 함수가 아님: T가 같은 이름의 public 함수로 가린다
+     */
+    ZInstanceMaterial GetInstanceMaterial() const noexcept
+    {
+        return {};
+    }
+
 private:
+    /**
+     * @brief 렌더 큐에서 RenderInstances()를 실행하는 배치 프록시 (타입마다 하나)
+     */
+    class InstanceBatch : public ZRenderable
+    {
+    public:
+        DirectX::XMMATRIX GetTransformXM() const noexcept override
+        {
+            return DirectX::XMMatrixIdentity();
+        }
+        void Render(ZGraphics& gfx) const noxnd override
+        {
+            RenderInstances(gfx);
+        }
+        void Update(float) noexcept override
+        {
+        }
+        ZRenderPass GetRenderPass() const noexcept override
+        {
+            return instanceQueue.empty() ? ZRenderPass::Opaque : instanceQueue.front()->GetRenderPass();
+        }
+        const void* GetShaderKey() const noexcept override
+        {
+            return instanceQueue.empty() ? &staticBinds : instanceQueue.front()->GetShaderKey();
+        }
+
+    private:
+        const std::vector<std::unique_ptr<Bind::ZBindable>>& GetStaticBinds() const noexcept override
+        {
+            return staticBinds;
+        }
+    };
+
     /**
      * @brief 정적 바인딩 리소스 접근자 (ZRenderable 순수 가상 함수 구현)
      * 
@@ -201,6 +428,28 @@ private:
      * @note 클래스 외부에서 정의 필요 (템플릿 정적 멤버)
      */
     static std::vector<std::unique_ptr<Bind::ZBindable>> staticBinds;
+
+    /**
+     * @brief 변형별 정적 바인딩 저장소 (변형 번호 → 바인딩 리스트)
+     * 
+     * @note 정적 바인딩과 같은 수명 (타입 T마다 하나)
+     */
+    static std::map<size_t, std::vector<std::unique_ptr<Bind::ZBindable>>> staticVariantBinds;
+
+    /**
+     * @brief 인스턴싱 경로 정적 리소스
+     * 
+     * - staticInstancedBinds: 인스턴스 스트림을 읽는 VS/입력 레이아웃/PS (정적 바인딩 뒤에 바인딩)
+     * - instanceQueue: 이번 프레임 SubmitInstance()된 객체 (RenderInstances에서 비움)
+     * - instanceData: 패킹 작업 공간 (프레임을 넘어 용량 유지)
+     * - pInstanceBuffer: 동적 인스턴스 버퍼 (첫 RenderInstances에서 생성)
+     * - instanceBatch: 렌더 큐에 제출되는 배치 프록시 (GetInstanceBatch)
+     */
+    static std::vector<std::unique_ptr<Bind::ZBindable>> staticInstancedBinds;
+    static std::vector<const T*> instanceQueue;
+    static std::vector<ZInstanceData> instanceData;
+    static std::unique_ptr<Bind::ZInstanceBuffer> pInstanceBuffer;
+    static InstanceBatch instanceBatch;
 };
 
 /**
@@ -215,4 +464,22 @@ private:
  * - ZRenderableBase<Pyramid>::staticBinds (Pyramid 전용)
  */
 template<class T>
-std::vector<std::unique_ptr<Bind::ZBindable>> ZRenderableBase<T>::staticBinds;
\ No newline at end of file
+std::vector<std::unique_ptr<Bind::ZBindable>> ZRenderableBase<T>::staticBinds;
+
+template<class T>
+std::map<size_t, std::vector<std::unique_ptr<Bind::ZBindable>>> ZRenderableBase<T>::staticVariantBinds;
+
+template<class T>
+std::vector<std::unique_ptr<Bind::ZBindable>> ZRenderableBase<T>::staticInstancedBinds;
+
+template<class T>
+std::vector<const T*> ZRenderableBase<T>::instanceQueue;
+
+template<class T>
+std::vector<ZInstanceData> ZRenderableBase<T>::instanceData;
+
+template<class T>
+std::unique_ptr<Bind::ZInstanceBuffer> ZRenderableBase<T>::pInstanceBuffer;
+
+template<class T>
+typename ZRenderableBase<T>::InstanceBatch ZRenderableBase<T>::instanceBatch;
\ No newline at end of file
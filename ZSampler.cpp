@@ -27,7 +27,7 @@ namespace Bind
 
     void ZSampler::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->PSSetSamplers(0, 1, pSampler.GetAddressOf());
+        GetStateCache(gfx).SetPSSampler(0u, pSampler.Get());
     }
 }
 
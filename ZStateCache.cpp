@@ -0,0 +1,109 @@
+﻿#include "ZStateCache.h"
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    // Context stand-in: records every call the cache issues (pointers are never dereferenced)
+    struct RecordingContext
+    {
+        std::vector<ZStateKind> calls;
+
+        void VSSetShader(ID3D11VertexShader*, ID3D11ClassInstance* const*, UINT) { calls.push_back(ZStateKind::VertexShader); }
+        void PSSetShader(ID3D11PixelShader*, ID3D11ClassInstance* const*, UINT) { calls.push_back(ZStateKind::PixelShader); }
+        void IASetInputLayout(ID3D11InputLayout*) { calls.push_back(ZStateKind::InputLayout); }
+        void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY) { calls.push_back(ZStateKind::Topology); }
+        void RSSetState(ID3D11RasterizerState*) { calls.push_back(ZStateKind::Rasterizer); }
+        void PSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) { calls.push_back(ZStateKind::Sampler); }
+        void IASetVertexBuffers(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) { calls.push_back(ZStateKind::VertexBuffer); }
+        void IASetIndexBuffer(ID3D11Buffer*, DXGI_FORMAT, UINT) { calls.push_back(ZStateKind::IndexBuffer); }
+        void PSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) { calls.push_back(ZStateKind::ShaderResource); }
+        void VSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) { calls.push_back(ZStateKind::ConstantBuffer); }
+        void PSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) { calls.push_back(ZStateKind::ConstantBuffer); }
+    };
+
+    template<typename T>
+    T* FakeObject(uintptr_t id)
+    {
+        return reinterpret_cast<T*>(id * 0x100);
+    }
+
+    bool Expect(const char* what, size_t actual, size_t expected)
+    {
+        const bool passed = actual == expected;
+        std::cout << "[ZStateCache] " << what << ": " << actual << " (expected " << expected << ")"
+                  << (passed ? "  OK" : "  FAILED") << std::endl;
+        return passed;
+    }
+}
+
+namespace ZStateFilter
+{
+    bool RunRecordingCheck()
+    {
+        std::cout << "=== ZStateCache recording check ===" << std::endl;
+
+        RecordingContext context;
+        ZStateCacheT<RecordingContext> cache(&context);
+        bool passed = true;
+
+        // LightBox 30개: 정적 바인드(셰이더/레이아웃/토폴로지/샘플러/래스터라이저/VB/IB/변환 CB)는 공유,
+        // 인스턴스마다 다른 것은 재질 PS 상수 버퍼뿐
+        constexpr int kInstances = 30;
+        auto bindLightBox = [&](int instance)
+        {
+            cache.SetVertexShader(FakeObject<ID3D11VertexShader>(1));
+            cache.SetPixelShader(FakeObject<ID3D11PixelShader>(2));
+            cache.SetInputLayout(FakeObject<ID3D11InputLayout>(3));
+            cache.SetTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            cache.SetPSSampler(0u, FakeObject<ID3D11SamplerState>(4));
+            cache.SetRasterizer(FakeObject<ID3D11RasterizerState>(5));
+            cache.SetVertexBuffer(0u, FakeObject<ID3D11Buffer>(6), 24u, 0u);
+            cache.SetIndexBuffer(FakeObject<ID3D11Buffer>(7), DXGI_FORMAT_R16_UINT, 0u);
+            cache.SetVSConstantBuffer(0u, FakeObject<ID3D11Buffer>(8));
+            cache.SetPSConstantBuffer(1u, FakeObject<ID3D11Buffer>(100 + instance));
+        };
+
+        cache.BeginFrame();
+        for (int i = 0; i < kInstances; ++i)
+        {
+            bindLightBox(i);
+        }
+        passed &= Expect("30 LightBoxes, issued", cache.GetStats().TotalIssued(), 9 + kInstances);
+        passed &= Expect("30 LightBoxes, skipped", cache.GetStats().TotalSkipped(), 9 * (kInstances - 1));
+        passed &= Expect("30 LightBoxes, context calls", context.calls.size(), cache.GetStats().TotalIssued());
+        passed &= Expect("30 LightBoxes, vertex shader sets", cache.GetStats().issued[static_cast<size_t>(ZStateKind::VertexShader)], 1);
+
+        // 새 프레임: 섀도를 버리므로 첫 인스턴스는 전부 다시 보낸다
+        context.calls.clear();
+        cache.BeginFrame();
+        bindLightBox(0);
+        bindLightBox(0);
+        passed &= Expect("Next frame, issued", context.calls.size(), 10);
+
+        // 슬롯/인자 구분
+        context.calls.clear();
+        cache.SetPSShaderResource(0u, FakeObject<ID3D11ShaderResourceView>(20));
+        cache.SetPSShaderResource(1u, FakeObject<ID3D11ShaderResourceView>(20));
+        cache.SetPSShaderResource(1u, FakeObject<ID3D11ShaderResourceView>(20));
+        cache.SetVertexBuffer(0u, FakeObject<ID3D11Buffer>(6), 32u, 0u);          // stride만 다름
+        cache.SetIndexBuffer(FakeObject<ID3D11Buffer>(7), DXGI_FORMAT_R32_UINT, 0u); // 형식만 다름
+        cache.SetTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        passed &= Expect("Slots and arguments, issued", context.calls.size(), 4);
+
+        // 캐시 밖 변경: Forget 뒤 같은 버퍼도 다시 보낸다, null도 상태다
+        context.calls.clear();
+        cache.ForgetVSConstantBuffer(0u);
+        cache.SetVSConstantBuffer(0u, FakeObject<ID3D11Buffer>(8));
+        cache.SetPSShaderResource(0u, nullptr);
+        cache.SetPSShaderResource(0u, nullptr);
+        cache.Invalidate();
+        cache.SetPSShaderResource(0u, nullptr);
+        cache.SetPSSampler(ZStateCacheT<RecordingContext>::kTrackedSlots, FakeObject<ID3D11SamplerState>(4));
+        cache.SetPSSampler(ZStateCacheT<RecordingContext>::kTrackedSlots, FakeObject<ID3D11SamplerState>(4));
+        passed &= Expect("Forget / null / untracked slots, issued", context.calls.size(), 5);
+
+        std::cout << "=== ZStateCache recording check " << (passed ? "passed" : "FAILED") << " ===" << std::endl;
+        return passed;
+    }
+}
@@ -0,0 +1,258 @@
+﻿#pragma once
+
+#include <d3d11.h>
+#include <cstddef>
+#include <cstdint>
+
+// Kinds of pipeline state filtered by ZStateCacheT (counter index)
+enum class ZStateKind : uint8_t
+{
+    VertexShader = 0,
+    PixelShader,
+    InputLayout,
+    Topology,
+    Rasterizer,
+    Sampler,
+    VertexBuffer,
+    IndexBuffer,
+    ShaderResource,
+    ConstantBuffer,
+    Count
+};
+
+// Per-frame counters (ZStateCacheT::BeginFrame에서 0으로)
+struct ZStateStats
+{
+    uint32_t issued[static_cast<size_t>(ZStateKind::Count)] = {};
+    uint32_t skipped[static_cast<size_t>(ZStateKind::Count)] = {};
+
+    uint32_t TotalIssued() const
+    {
+        uint32_t total = 0;
+        for (uint32_t n : issued) total += n;
+        return total;
+    }
+    uint32_t TotalSkipped() const
+    {
+        uint32_t total = 0;
+        for (uint32_t n : skipped) total += n;
+        return total;
+    }
+};
+
+// Shadow copy of the pipeline state bound through ZBindable (ZGraphics 소유)
+// 이미 바인딩된 객체를 다시 바인딩하면 포인터 비교로 끝난다. 바인딩된 객체는 컨텍스트가 참조를 쥐고 있으므로
+// 캐시에 남은 주소가 다른 객체로 재사용될 일은 없다.
+// Context: ID3D11DeviceContext (헤드리스 검사에서는 같은 시그니처의 기록용 컨텍스트)
+// 캐시를 거치지 않고 컨텍스트를 직접 만지는 코드(SpriteBatch, 슬롯 정리 루프)는 끝난 뒤 Invalidate 해야 한다.
+template<typename Context>
+class ZStateCacheT
+{
+public:
+    static constexpr UINT kTrackedSlots = 8;   // 샘플러/SRV/상수 버퍼 추적 슬롯, 그 위는 항상 그대로 보낸다
+
+    explicit ZStateCacheT(Context* context) noexcept
+        :
+        context_(context)
+    {
+    }
+
+    ZStateCacheT(const ZStateCacheT&) = delete;
+    ZStateCacheT& operator=(const ZStateCacheT&) = delete;
+
+    // 프레임 시작: 카운터 리셋 + 섀도 무효화 (프레임 사이에 ImGui/외부 코드가 상태를 바꿀 수 있다)
+    void BeginFrame() noexcept
+    {
+        stats_ = ZStateStats{};
+        Invalidate();
+    }
+
+    // Forget everything: the next bind of every state is issued
+    void Invalidate() noexcept
+    {
+        vertexShader_.known = false;
+        pixelShader_.known = false;
+        inputLayout_.known = false;
+        topology_.known = false;
+        rasterizer_.known = false;
+        indexBuffer_.known = false;
+        for (UINT i = 0; i < kTrackedSlots; ++i)
+        {
+            samplers_[i].known = false;
+            vertexBuffers_[i].known = false;
+            shaderResources_[i].known = false;
+            vsShaderResources_[i].known = false;
+            vsConstantBuffers_[i].known = false;
+            psConstantBuffers_[i].known = false;
+        }
+    }
+
+    // 오프셋 바인딩(*SetConstantBuffers1)처럼 캐시 밖에서 슬롯을 바꾼 경우
+    void ForgetVSConstantBuffer(UINT slot) noexcept
+    {
+        if (slot < kTrackedSlots)
+            vsConstantBuffers_[slot].known = false;
+    }
+    void ForgetPSConstantBuffer(UINT slot) noexcept
+    {
+        if (slot < kTrackedSlots)
+            psConstantBuffers_[slot].known = false;
+    }
+
+    void SetVertexShader(ID3D11VertexShader* shader) noexcept
+    {
+        if (Filter(vertexShader_, shader, ZStateKind::VertexShader))
+            context_->VSSetShader(shader, nullptr, 0u);
+    }
+
+    void SetPixelShader(ID3D11PixelShader* shader) noexcept
+    {
+        if (Filter(pixelShader_, shader, ZStateKind::PixelShader))
+            context_->PSSetShader(shader, nullptr, 0u);
+    }
+
+    void SetInputLayout(ID3D11InputLayout* layout) noexcept
+    {
+        if (Filter(inputLayout_, layout, ZStateKind::InputLayout))
+            context_->IASetInputLayout(layout);
+    }
+
+    void SetTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept
+    {
+        if (Filter(topology_, topology, ZStateKind::Topology))
+            context_->IASetPrimitiveTopology(topology);
+    }
+
+    void SetRasterizer(ID3D11RasterizerState* state) noexcept
+    {
+        if (Filter(rasterizer_, state, ZStateKind::Rasterizer))
+            context_->RSSetState(state);
+    }
+
+    void SetPSSampler(UINT slot, ID3D11SamplerState* sampler) noexcept
+    {
+        if (FilterSlot(samplers_, slot, sampler, ZStateKind::Sampler))
+            context_->PSSetSamplers(slot, 1u, &sampler);
+    }
+
+    void SetVertexBuffer(UINT slot, ID3D11Buffer* buffer, UINT stride, UINT offset) noexcept
+    {
+        if (FilterSlot(vertexBuffers_, slot, VertexBufferBinding{ buffer, stride, offset }, ZStateKind::VertexBuffer))
+            context_->IASetVertexBuffers(slot, 1u, &buffer, &stride, &offset);
+    }
+
+    void SetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset) noexcept
+    {
+        if (Filter(indexBuffer_, IndexBufferBinding{ buffer, format, offset }, ZStateKind::IndexBuffer))
+            context_->IASetIndexBuffer(buffer, format, offset);
+    }
+
+    void SetPSShaderResource(UINT slot, ID3D11ShaderResourceView* view) noexcept
+    {
+        if (FilterSlot(shaderResources_, slot, view, ZStateKind::ShaderResource))
+            context_->PSSetShaderResources(slot, 1u, &view);
+    }
+
+    void SetVSShaderResource(UINT slot, ID3D11ShaderResourceView* view) noexcept
+    {
+        if (FilterSlot(vsShaderResources_, slot, view, ZStateKind::ShaderResource))
+            context_->VSSetShaderResources(slot, 1u, &view);
+    }
+
+    void SetVSConstantBuffer(UINT slot, ID3D11Buffer* buffer) noexcept
+    {
+        if (FilterSlot(vsConstantBuffers_, slot, buffer, ZStateKind::ConstantBuffer))
+            context_->VSSetConstantBuffers(slot, 1u, &buffer);
+    }
+
+    void SetPSConstantBuffer(UINT slot, ID3D11Buffer* buffer) noexcept
+    {
+        if (FilterSlot(psConstantBuffers_, slot, buffer, ZStateKind::ConstantBuffer))
+            context_->PSSetConstantBuffers(slot, 1u, &buffer);
+    }
+
+    const ZStateStats& GetStats() const noexcept { return stats_; }
+
+private:
+    template<typename T>
+    struct Tracked
+    {
+        T value{};
+        bool known = false;
+    };
+
+    struct VertexBufferBinding
+    {
+        ID3D11Buffer* buffer;
+        UINT stride;
+        UINT offset;
+        bool operator==(const VertexBufferBinding& o) const noexcept
+        {
+            return buffer == o.buffer && stride == o.stride && offset == o.offset;
+        }
+    };
+
+    struct IndexBufferBinding
+    {
+        ID3D11Buffer* buffer;
+        DXGI_FORMAT format;
+        UINT offset;
+        bool operator==(const IndexBufferBinding& o) const noexcept
+        {
+            return buffer == o.buffer && format == o.format && offset == o.offset;
+        }
+    };
+
+    // true: 실제로 보내야 한다
+    template<typename T>
+    bool Filter(Tracked<T>& tracked, const T& value, ZStateKind kind) noexcept
+    {
+        const size_t k = static_cast<size_t>(kind);
+        if (tracked.known && tracked.value == value)
+        {
+            ++stats_.skipped[k];
+            return false;
+        }
+        tracked.value = value;
+        tracked.known = true;
+        ++stats_.issued[k];
+        return true;
+    }
+
+    template<typename T>
+    bool FilterSlot(Tracked<T>(&slots)[kTrackedSlots], UINT slot, const T& value, ZStateKind kind) noexcept
+    {
+        if (slot >= kTrackedSlots)
+        {
+            ++stats_.issued[static_cast<size_t>(kind)];
+            return true;
+        }
+        return Filter(slots[slot], value, kind);
+    }
+
+private:
+    Context* context_;
+
+    Tracked<ID3D11VertexShader*> vertexShader_;
+    Tracked<ID3D11PixelShader*> pixelShader_;
+    Tracked<ID3D11InputLayout*> inputLayout_;
+    Tracked<D3D11_PRIMITIVE_TOPOLOGY> topology_;
+    Tracked<ID3D11RasterizerState*> rasterizer_;
+    Tracked<IndexBufferBinding> indexBuffer_;
+    Tracked<ID3D11SamplerState*> samplers_[kTrackedSlots];
+    Tracked<VertexBufferBinding> vertexBuffers_[kTrackedSlots];
+    Tracked<ID3D11ShaderResourceView*> shaderResources_[kTrackedSlots];
+    Tracked<ID3D11ShaderResourceView*> vsShaderResources_[kTrackedSlots];
+    Tracked<ID3D11Buffer*> vsConstantBuffers_[kTrackedSlots];
+    Tracked<ID3D11Buffer*> psConstantBuffers_[kTrackedSlots];
+
+    ZStateStats stats_;
+};
+
+using ZStateCache = ZStateCacheT<ID3D11DeviceContext>;
+
+namespace ZStateFilter
+{
+    // Headless: 기록용 컨텍스트로 LightBox 30개 같은 바인드 순서를 흘려 보내고 발행/생략 수를 검사 (--state-filter-check)
+    bool RunRecordingCheck();
+}
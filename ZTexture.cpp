@@ -1,7 +1,7 @@
 ﻿#include "ZD3D11.h"
 #include "ZTexture.h"
 #include "ZGraphics.h"
-#include "WICTextureLoader.h" // From DirectX Tool Kit
+#include "ZAssetCooker.h"   // cooked .zdds, WIC decode otherwise
 #include "GraphicsThrowMacros.h"
 
 
@@ -41,8 +41,9 @@ namespace Bind
         _tcscpy_s(m_pFileName, MAX_PATH, Filename);
 
         Microsoft::WRL::ComPtr<ID3D11Resource> resource;
-        GFX_THROW_INFO(DirectX::CreateWICTextureFromFile(
+        GFX_THROW_INFO(ZAssetCooker::CreateTextureFromFile(
             GetDevice(gfx),
+            nullptr,
             Filename,
             resource.GetAddressOf(),
             pTextureSRV.GetAddressOf()
@@ -115,7 +116,7 @@ namespace Bind
 
     void ZTexture::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->PSSetShaderResources(0u, 1u, pTextureSRV.GetAddressOf());
+        GetStateCache(gfx).SetPSShaderResource(0u, pTextureSRV.Get());
     }
 
     BOOL ZTexture::IsLoaded()
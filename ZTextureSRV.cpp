@@ -16,6 +16,6 @@ namespace Bind
     void ZTextureSRV::Bind(ZGraphics& gfx) noexcept
     {
         // Pixel Shader에 텍스처 바인딩
-        GetContext(gfx)->PSSetShaderResources(m_Slot, 1u, pTextureSRV.GetAddressOf());
+        GetStateCache(gfx).SetPSShaderResource(m_Slot, pTextureSRV.Get());
     }
 }
@@ -0,0 +1,153 @@
+﻿#include "ZThreadPool.h"
+#include <algorithm>
+
+ZThreadPool::ZThreadPool(int workerCount)
+{
+    if (workerCount < 0)
+    {
+        const unsigned int hw = std::thread::hardware_concurrency();
+        workerCount = (hw > 1) ? static_cast<int>(hw) - 1 : 0;
+    }
+
+    for (int i = 0; i <= workerCount; ++i)
+    {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    threads_.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+    {
+        threads_.emplace_back(&ZThreadPool::WorkerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+ZThreadPool::~ZThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (std::thread& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+ZThreadPool& ZThreadPool::Shared()
+{
+    static ZThreadPool pool;
+    return pool;
+}
+
+void ZThreadPool::ParallelFor(size_t count, size_t grainSize, const RangeFunction& body)
+{
+    if (count == 0)
+        return;
+
+    grainSize = (std::max)(grainSize, static_cast<size_t>(1));
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    // 청크 하나면 스레드 전환 없이 바로 실행
+    if (chunkCount == 1 || threads_.empty())
+    {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<size_t> remaining{ chunkCount };
+
+    // 큐에 넣기 전에 먼저 센다: TryPop/TrySteal의 감소가 증가보다 앞서면 queued_가 언더플로한다
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        queued_ += chunkCount;
+    }
+
+    // Round-robin distribution; 불균형은 스틸링이 메운다
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+        Task task;
+        task.body = &body;
+        task.begin = c * grainSize;
+        task.end = (std::min)(count, task.begin + grainSize);
+        task.remaining = &remaining;
+
+        Queue& queue = *queues_[c % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+    wake_.notify_all();
+
+    // Calling thread helps until every chunk of this call has finished
+    // 호출자는 모두 마지막 큐를 도움 큐로 공유한다. 동시/중첩 ParallelFor는 서로의 청크도 실행할 수 있으며,
+    // 반환 시점은 자기 호출의 remaining만 기준이므로 join은 정확하지만 다른 호출의 긴 청크만큼 늦게 반환될 수 있다.
+    const size_t callerQueue = queues_.size() - 1;
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        Task task;
+        if (TryPop(callerQueue, task) || TrySteal(callerQueue, task))
+        {
+            Execute(task);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool ZThreadPool::TryPop(size_t queueIndex, Task& task)
+{
+    Queue& queue = *queues_[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    --queued_;
+    return true;
+}
+
+bool ZThreadPool::TrySteal(size_t thiefIndex, Task& task)
+{
+    const size_t queueCount = queues_.size();
+    for (size_t offset = 1; offset < queueCount; ++offset)
+    {
+        Queue& victim = *queues_[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty())
+            continue;
+
+        task = victim.tasks.front();
+        victim.tasks.pop_front();
+        --queued_;
+        return true;
+    }
+    return false;
+}
+
+void ZThreadPool::Execute(const Task& task)
+{
+    (*task.body)(task.begin, task.end);
+    task.remaining->fetch_sub(1, std::memory_order_release);
+}
+
+void ZThreadPool::WorkerLoop(size_t queueIndex)
+{
+    for (;;)
+    {
+        Task task;
+        if (TryPop(queueIndex, task) || TrySteal(queueIndex, task))
+        {
+            Execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wake_.wait(lock, [this]() { return stop_ || queued_.load() > 0; });
+        if (stop_ && queued_.load() == 0)
+            return;
+    }
+}
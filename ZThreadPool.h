@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for data-parallel frame work
+// 각 워커는 자기 큐 뒤쪽에서 꺼내고(LIFO), 비면 다른 큐 앞쪽에서 훔친다(FIFO).
+// ParallelFor는 호출 스레드도 작업에 참여하고, 모든 청크가 끝난 뒤에만 반환한다 (결정적 join).
+class ZThreadPool
+{
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    // workerCount < 0 → hardware_concurrency - 1 (호출 스레드가 나머지 코어 하나를 쓴다)
+    // workerCount == 0 → 워커 없음, ParallelFor는 호출 스레드에서 바로 실행
+    explicit ZThreadPool(int workerCount = -1);
+    ~ZThreadPool();
+
+    ZThreadPool(const ZThreadPool&) = delete;
+    ZThreadPool& operator=(const ZThreadPool&) = delete;
+
+    // Process-wide pool used by the frame update
+    static ZThreadPool& Shared();
+
+    unsigned int GetWorkerCount() const { return static_cast<unsigned int>(threads_.size()); }
+
+    // body(begin, end) over [0, count) in chunks of grainSize.
+    // body는 예외를 던지지 않아야 하고, 청크끼리 같은 데이터에 쓰지 않아야 한다.
+    // 여러 스레드에서 동시에, 또는 body 안에서 중첩 호출해도 되지만 호출자끼리 도움 큐를 공유한다 (서로의 청크를 실행할 수 있음).
+    void ParallelFor(size_t count, size_t grainSize, const RangeFunction& body);
+
+private:
+    struct Task
+    {
+        const RangeFunction* body = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        std::atomic<size_t>* remaining = nullptr;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool TryPop(size_t queueIndex, Task& task);
+    bool TrySteal(size_t thiefIndex, Task& task);
+    void Execute(const Task& task);
+    void WorkerLoop(size_t queueIndex);
+
+private:
+    std::vector<std::unique_ptr<Queue>> queues_;  // one per worker + one shared by all calling threads (last)
+    std::vector<std::thread> threads_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{ 0 };             // tasks pushed but not yet taken
+    bool stop_ = false;
+};
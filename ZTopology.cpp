@@ -11,6 +11,6 @@ namespace Bind
 
     void ZTopology::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->IASetPrimitiveTopology(type);
+        GetStateCache(gfx).SetTopology(type);
     }
 }
\ No newline at end of file
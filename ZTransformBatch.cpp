@@ -0,0 +1,113 @@
+﻿#include "ZTransformBatch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+namespace ZTransformBatch
+{
+    void Compute(const XMFLOAT4X4* worlds, size_t count, FXMMATRIX view, CXMMATRIX proj, void* out, size_t strideBytes)
+    {
+        // view * proj는 한 번만, 객체마다 행렬 곱 두 번 (전치는 곱셈에 합쳐진다)
+        const XMMATRIX viewProj = XMMatrixMultiply(view, proj);
+        uint8_t* dst = static_cast<uint8_t*>(out);
+        for (size_t i = 0; i < count; ++i, dst += strideBytes)
+        {
+            const XMMATRIX world = XMLoadFloat4x4(&worlds[i]);
+            ZTransformConstants* constants = reinterpret_cast<ZTransformConstants*>(dst);
+            XMStoreFloat4x4A(&constants->modelView, XMMatrixMultiplyTranspose(world, view));
+            XMStoreFloat4x4A(&constants->modelViewProj, XMMatrixMultiplyTranspose(world, viewProj));
+        }
+    }
+
+    bool RunBenchmark()
+    {
+        constexpr size_t kCounts[] = { 1000, 10000, 50000 };
+        constexpr int kIterations = 20;
+        constexpr size_t kSlotBytes = 256;   // ZTransformStream::kSlotBytes
+
+        bool allPassed = true;
+        std::cout << "=== ZTransformBatch benchmark ===" << std::endl;
+
+        const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 20.0f, -80.0f, 1.0f), XMVectorZero(),
+                                               XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const XMMATRIX proj = XMMatrixPerspectiveLH(1.0f, 9.0f / 16.0f, 0.5f, 400.0f);
+
+        for (const size_t count : kCounts)
+        {
+            // ZInteractableTransform과 같은 모양의 월드 행렬
+            std::mt19937 rng(20250315u);
+            std::uniform_real_distribution<float> angle(0.0f, XM_2PI);
+            std::uniform_real_distribution<float> radius(20.0f, 30.0f);
+            std::uniform_real_distribution<float> scale(0.4f, 3.0f);
+
+            std::vector<XMFLOAT4X4> worlds(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                XMStoreFloat4x4(&worlds[i], XMMatrixScaling(1.0f, 1.0f, scale(rng)) *
+                    XMMatrixRotationRollPitchYaw(angle(rng), angle(rng), angle(rng)) *
+                    XMMatrixTranslation(radius(rng), 0.0f, 0.0f) *
+                    XMMatrixRotationRollPitchYaw(angle(rng), angle(rng), angle(rng)));
+            }
+
+            // 기존 경로: 객체마다 계산 → 128바이트를 이름이 바뀐 버퍼로 복사 (Map/Unmap 자체는 드라이버 비용이라 제외)
+            std::vector<ZTransformConstants> legacy(count);
+            // 일괄 경로: 256바이트 슬롯 (상수 버퍼 오프셋 단위), 매핑된 메모리 흉내
+            std::vector<XMFLOAT4X4A> stream(count * (kSlotBytes / sizeof(XMFLOAT4X4A)));
+            double legacyMs = 0.0, batchMs = 0.0;
+
+            for (int iteration = 0; iteration < kIterations; ++iteration)
+            {
+                auto legacyStart = std::chrono::high_resolution_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    // ZTransformVSConstBuffer::Bind의 객체별 경로와 같은 계산
+                    const XMMATRIX modelView = XMLoadFloat4x4(&worlds[i]) * view;
+                    const XMMATRIX tf[2] = { XMMatrixTranspose(modelView), XMMatrixTranspose(modelView * proj) };
+                    std::memcpy(&legacy[i], tf, sizeof(ZTransformConstants));
+                }
+                auto legacyEnd = std::chrono::high_resolution_clock::now();
+                legacyMs += std::chrono::duration<double, std::milli>(legacyEnd - legacyStart).count();
+
+                auto batchStart = std::chrono::high_resolution_clock::now();
+                Compute(worlds.data(), count, view, proj, stream.data(), kSlotBytes);
+                auto batchEnd = std::chrono::high_resolution_clock::now();
+                batchMs += std::chrono::duration<double, std::milli>(batchEnd - batchStart).count();
+            }
+
+            // 결과 비교: 곱셈 순서만 다르다 ((W*V)*P vs W*(V*P)) → 상대 오차
+            float maxError = 0.0f;
+            const uint8_t* slots = reinterpret_cast<const uint8_t*>(stream.data());
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float* a = reinterpret_cast<const float*>(&legacy[i]);
+                const float* b = reinterpret_cast<const float*>(slots + i * kSlotBytes);
+                for (int e = 0; e < 32; ++e)
+                {
+                    const float magnitude = (std::max)(1.0f, std::fabs(a[e]));
+                    maxError = (std::max)(maxError, std::fabs(a[e] - b[e]) / magnitude);
+                }
+            }
+
+            const bool passed = maxError < 1e-4f;
+            allPassed = allPassed && passed;
+
+            const double avgLegacy = legacyMs / kIterations;
+            const double avgBatch = batchMs / kIterations;
+            std::cout << "[" << count << " objects] per-object " << avgLegacy << " ms, batch " << avgBatch << " ms ("
+                      << (avgBatch * 1e6 / count) << " ns/object, x" << (avgBatch > 0.0 ? avgLegacy / avgBatch : 0.0) << ")"
+                      << std::endl;
+            std::cout << "  maps per frame: " << count << " -> 1 (" << (count * kSlotBytes / 1024) << " KB stream)"
+                      << ", max relative error " << maxError << (passed ? " OK" : " FAILED") << std::endl;
+        }
+
+        std::cout << (allPassed ? "Transform batch benchmark passed" : "Transform batch benchmark FAILED") << std::endl;
+        return allPassed;
+    }
+}
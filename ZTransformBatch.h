@@ -0,0 +1,24 @@
+﻿#pragma once
+
+#include <DirectXMath.h>
+#include <cstddef>
+
+// Per-draw transform constants (PhongVS/TexturedPhongVS CBuf 레이아웃, 둘 다 전치)
+struct ZTransformConstants
+{
+    DirectX::XMFLOAT4X4A modelView;
+    DirectX::XMFLOAT4X4A modelViewProj;
+};
+static_assert(sizeof(ZTransformConstants) == 128, "ZTransformConstants must match the vertex shader CBuf");
+
+// Batch transform kernel (D3D 헤더 없이 DirectXMath만 사용, ZTransformStream이 Map한 버퍼에 바로 쓴다)
+namespace ZTransformBatch
+{
+    // out + i * strideBytes ← transpose(world_i * view), transpose(world_i * view * proj)
+    // out은 16바이트 정렬, strideBytes는 16의 배수 (상수 버퍼 오프셋 바인딩: 256)
+    void Compute(const DirectX::XMFLOAT4X4* worlds, size_t count, DirectX::FXMMATRIX view, DirectX::CXMMATRIX proj,
+                 void* out, size_t strideBytes);
+
+    // Headless: 1k~50k 객체, 객체마다 계산 + 복사(기존 경로) vs 일괄 계산, 결과 비교 (--transform-batch-bench)
+    bool RunBenchmark();
+}
@@ -0,0 +1,118 @@
+﻿#include "ZD3D11.h"
+#include "ZTransformStream.h"
+#include <algorithm>
+#include <iostream>
+
+namespace wrl = Microsoft::WRL;
+using namespace DirectX;
+
+ZTransformStream::ZTransformStream(ID3D11Device* device, ID3D11DeviceContext* context, ZStateCache* stateCache)
+    :
+    pDevice_(device),
+    pContext_(context),
+    pStateCache_(stateCache)
+{
+    // 64KB(4096 constants)보다 큰 상수 버퍼를 만들고 창을 옮겨 가며 바인딩하려면 오프셋 바인딩이 필요하다
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+    const bool supported =
+        SUCCEEDED(pContext_.As(&pContext1_)) &&
+        SUCCEEDED(pDevice_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+        options.ConstantBufferOffsetting;
+    if (!supported)
+    {
+        pContext1_.Reset();
+    }
+
+    std::cout << "[ZTransformStream] " << (pContext1_ ? "one map per queue, offset binding (D3D11.1)" : "per-object constant buffer (no D3D11.1 offsets)")
+              << std::endl;
+}
+
+void ZTransformStream::BeginFrame()
+{
+    renderables_.clear();
+    current_ = SIZE_MAX;
+
+    stats_.objects = 0;
+    stats_.maps = 0;
+    stats_.offsetBinds = 0;
+}
+
+bool ZTransformStream::Reserve(size_t count)
+{
+    if (count <= capacity_)
+        return true;
+
+    // 두 배씩 늘린다 (최소 256 슬롯 = 64KB)
+    size_t newCapacity = (std::max)(capacity_, static_cast<size_t>(256));
+    while (newCapacity < count)
+    {
+        newCapacity *= 2;
+    }
+
+    D3D11_BUFFER_DESC cbd{};
+    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbd.Usage = D3D11_USAGE_DYNAMIC;
+    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    cbd.ByteWidth = static_cast<UINT>(newCapacity * kSlotBytes);
+
+    wrl::ComPtr<ID3D11Buffer> buffer;
+    if (FAILED(pDevice_->CreateBuffer(&cbd, nullptr, &buffer)))
+    {
+        std::cerr << "[ZTransformStream] Failed to create transform buffer (" << cbd.ByteWidth << " bytes)" << std::endl;
+        return false;
+    }
+
+    pBuffer_ = buffer;
+    capacity_ = newCapacity;
+    ++stats_.buffersCreated;
+    return true;
+}
+
+bool ZTransformStream::Build(const ZDrawPacket* packets, size_t count, FXMMATRIX view, CXMMATRIX proj)
+{
+    renderables_.clear();
+    current_ = SIZE_MAX;
+
+    if (!pContext1_ || count == 0 || !Reserve(count))
+        return false;
+
+    renderables_.resize(count);
+    worlds_.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        renderables_[i] = packets[i].renderable;
+        XMStoreFloat4x4(&worlds_[i], packets[i].renderable->GetTransformXM());
+    }
+
+    // 프레임(큐)당 한 번: DISCARD로 통째로 새로 쓴다
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(pContext_->Map(pBuffer_.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+    {
+        renderables_.clear();
+        return false;
+    }
+    ZTransformBatch::Compute(worlds_.data(), count, view, proj, mapped.pData, kSlotBytes);
+    pContext_->Unmap(pBuffer_.Get(), 0);
+
+    ++stats_.maps;
+    stats_.objects += static_cast<uint32_t>(count);
+    return true;
+}
+
+bool ZTransformStream::BindCurrent(const ZRenderable& renderable, UINT slot)
+{
+    if (current_ >= renderables_.size() || renderables_[current_] != &renderable)
+        return false;
+
+    ID3D11Buffer* buffer = pBuffer_.Get();
+    const UINT firstConstant = static_cast<UINT>(current_ * (kSlotBytes / 16));
+    const UINT numConstants = kSlotBytes / 16;
+    pContext1_->VSSetConstantBuffers1(slot, 1u, &buffer, &firstConstant, &numConstants);
+
+    // 같은 버퍼를 다른 오프셋으로 다시 바인딩하므로 포인터 비교로 걸러서는 안 된다
+    if (pStateCache_)
+        pStateCache_->ForgetVSConstantBuffer(slot);
+
+    ++stats_.offsetBinds;
+    return true;
+}
@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include <d3d11_1.h>
+#include "ZStateCache.h"
+#include "ZRenderQueue.h"
+#include "ZTransformBatch.h"
+#include <wrl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Frame-level transform stream (ZGraphics 소유)
+// ZRenderQueue::Execute가 그릴 객체들의 변환을 ZTransformBatch로 한 번에 계산해 큰 동적 상수 버퍼 하나에
+// Map(DISCARD) 한 번으로 쓰고, ZTransformVSConstBuffer::Bind는 자기 슬롯을 *SetConstantBuffers1 오프셋으로 고른다.
+// 객체마다 Map/Unmap 하던 것이 큐 실행마다 한 번으로 줄어든다.
+// D3D11.1 ConstantBufferOffsetting이 없으면 Build가 false → 기존 객체별 경로.
+class ZTransformStream
+{
+public:
+    static constexpr UINT kSlotBytes = 256;   // ZTransformConstants(128) → 오프셋 단위 16 constants
+
+    struct Stats
+    {
+        uint32_t objects = 0;          // 이번 프레임 스트림에 쓴 객체
+        uint32_t maps = 0;             // 이번 프레임
+        uint32_t offsetBinds = 0;      // 이번 프레임, 스트림 슬롯으로 바인딩된 드로우
+        uint64_t buffersCreated = 0;   // 누적
+    };
+
+    ZTransformStream(ID3D11Device* device, ID3D11DeviceContext* context, ZStateCache* stateCache = nullptr);
+    ZTransformStream(const ZTransformStream&) = delete;
+    ZTransformStream& operator=(const ZTransformStream&) = delete;
+
+    // 지난 프레임 슬롯 무효화, 통계 초기화
+    void BeginFrame();
+
+    // Transforms of packets[i].renderable into slot i with one map; false → 객체별 경로 (슬롯 없음)
+    bool Build(const ZDrawPacket* packets, size_t count, DirectX::FXMMATRIX view, DirectX::CXMMATRIX proj);
+
+    // Slot of the draw about to run (ZRenderQueue::Execute), End: 큐 밖의 드로우는 스트림을 쓰지 않는다
+    void Select(size_t index) noexcept { current_ = index; }
+    void End() noexcept { current_ = SIZE_MAX; }
+
+    // renderable이 현재 슬롯의 객체면 VS slot에 오프셋 바인딩하고 true
+    bool BindCurrent(const ZRenderable& renderable, UINT slot);
+
+    bool IsAvailable() const { return pContext1_ != nullptr; }
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    bool Reserve(size_t count);
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device> pDevice_;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> pContext_;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext1> pContext1_;   // null: 오프셋 바인딩 불가
+    ZStateCache* pStateCache_;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pBuffer_;
+    size_t capacity_ = 0;                                       // 슬롯 수
+
+    std::vector<const ZRenderable*> renderables_;              // 슬롯 → 객체 (BindCurrent 확인용)
+    std::vector<DirectX::XMFLOAT4X4> worlds_;                  // 일괄 계산 입력
+    size_t current_ = SIZE_MAX;
+
+    Stats stats_;
+};
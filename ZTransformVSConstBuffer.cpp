@@ -1,11 +1,13 @@
 ﻿#include "ZD3D11.h"
 #include "ZTransformVSConstBuffer.h"
+#include "ZTransformStream.h"
 
 namespace Bind
 {
     ZTransformVSConstBuffer::ZTransformVSConstBuffer(ZGraphics& gfx, const ZRenderable& parent, UINT slot)
         :
-        parent(parent)
+        parent(parent),
+        slot(slot)
     {
         if (!pVcbuf) // 한번만 생성한다.
         {
@@ -15,6 +17,12 @@ namespace Bind
 
     void ZTransformVSConstBuffer::Bind(ZGraphics& gfx) noexcept
     {
+        // 렌더 큐가 이번 프레임 스트림에 미리 써 두었으면 오프셋만 바꿔 바인딩 (Map 없음)
+        if (gfx.GetTransformStream().BindCurrent(parent, slot))
+        {
+            return;
+        }
+
         const auto modelView = parent.GetTransformXM() * gfx.GetCamera();
         const Transforms tf =
         {
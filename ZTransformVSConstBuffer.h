@@ -14,9 +14,11 @@ namespace Bind
             DirectX::XMMATRIX modelViewProj;
         };
     private:
+        // 객체별 경로 (ZTransformStream 슬롯이 없을 때)
         // VSConstBuffer는 매프래임마다 다시 계산하기 때문에 재활용한다.
         static std::unique_ptr<Bind::VSConstBuffer<ZTransformVSConstBuffer::Transforms>> pVcbuf;
         const ZRenderable& parent;
+        UINT slot;
 
     public:
         ZTransformVSConstBuffer(ZGraphics& gfx, const ZRenderable& parent, UINT slot = 0);
@@ -87,6 +87,16 @@ namespace Dvtx
             return sizeof(Map<UInt4>::SysType);
         case Float4:
             return sizeof(Map<Float4>::SysType);
+        case PackedNormal:
+            return sizeof(Map<PackedNormal>::SysType);
+        case PackedTangent:
+            return sizeof(Map<PackedTangent>::SysType);
+        case HalfTexture2D:
+            return sizeof(Map<HalfTexture2D>::SysType);
+        case UByte4:
+            return sizeof(Map<UByte4>::SysType);
+        case UByte4Norm:
+            return sizeof(Map<UByte4Norm>::SysType);
         }
         assert("Invalid element type" && false);
         return 0u;
@@ -121,6 +131,16 @@ namespace Dvtx
             return Map<UInt4>::code;
         case Float4:
             return Map<Float4>::code;
+        case PackedNormal:
+            return Map<PackedNormal>::code;
+        case PackedTangent:
+            return Map<PackedTangent>::code;
+        case HalfTexture2D:
+            return Map<HalfTexture2D>::code;
+        case UByte4:
+            return Map<UByte4>::code;
+        case UByte4Norm:
+            return Map<UByte4Norm>::code;
         }
         assert("Invalid element type" && false);
         return "Invalid";
@@ -151,6 +171,16 @@ namespace Dvtx
             return GenerateDesc<UInt4>(GetOffset());
         case Float4:
             return GenerateDesc<Float4>(GetOffset());
+        case PackedNormal:
+            return GenerateDesc<PackedNormal>(GetOffset());
+        case PackedTangent:
+            return GenerateDesc<PackedTangent>(GetOffset());
+        case HalfTexture2D:
+            return GenerateDesc<HalfTexture2D>(GetOffset());
+        case UByte4:
+            return GenerateDesc<UByte4>(GetOffset());
+        case UByte4Norm:
+            return GenerateDesc<UByte4Norm>(GetOffset());
         }
         assert("Invalid element type" && false);
         return { "INVALID",0,DXGI_FORMAT_UNKNOWN,0,0,D3D11_INPUT_PER_VERTEX_DATA,0 };
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <vector>
 #include <type_traits>
+#include <DirectXPackedVector.h>
 //#include "Graphics.h"
 #include "ZColor.h"
 #include "ZConditionalNoexcept.h"
@@ -23,6 +24,12 @@ namespace Dvtx
             BGRAColor,
             UInt4,
             Float4,
+            // Quantized skinned vertex (FbxPackedVertex)
+            PackedNormal,
+            PackedTangent,
+            HalfTexture2D,
+            UByte4,
+            UByte4Norm,
             Count,
         };
         template<ElementType> struct Map;
@@ -103,6 +110,41 @@ namespace Dvtx
             static constexpr const char* semantic = "BLENDWEIGHT";
             static constexpr const char* code = "BW";
         };
+        template<> struct Map<PackedNormal>
+        {
+            using SysType = DirectX::PackedVector::XMSHORTN2;   // octahedral
+            static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16_SNORM;
+            static constexpr const char* semantic = "NORMAL";
+            static constexpr const char* code = "No";
+        };
+        template<> struct Map<PackedTangent>
+        {
+            using SysType = DirectX::PackedVector::XMBYTEN4;   // octahedral xy, w = bitangent sign
+            static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R8G8B8A8_SNORM;
+            static constexpr const char* semantic = "TANGENT";
+            static constexpr const char* code = "Nto";
+        };
+        template<> struct Map<HalfTexture2D>
+        {
+            using SysType = DirectX::PackedVector::XMHALF2;
+            static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16_FLOAT;
+            static constexpr const char* semantic = "TEXCOORD";
+            static constexpr const char* code = "Th";
+        };
+        template<> struct Map<UByte4>
+        {
+            using SysType = DirectX::PackedVector::XMUBYTE4;
+            static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R8G8B8A8_UINT;
+            static constexpr const char* semantic = "BLENDINDICES";
+            static constexpr const char* code = "BI8";
+        };
+        template<> struct Map<UByte4Norm>
+        {
+            using SysType = DirectX::PackedVector::XMUBYTEN4;
+            static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+            static constexpr const char* semantic = "BLENDWEIGHT";
+            static constexpr const char* code = "BW8";
+        };
 
         class Element
         {
@@ -200,6 +242,21 @@ namespace Dvtx
             case VertexLayout::Float4:
                 SetAttribute<VertexLayout::Float4>(pAttribute, std::forward<T>(val));
                 break;
+            case VertexLayout::PackedNormal:
+                SetAttribute<VertexLayout::PackedNormal>(pAttribute, std::forward<T>(val));
+                break;
+            case VertexLayout::PackedTangent:
+                SetAttribute<VertexLayout::PackedTangent>(pAttribute, std::forward<T>(val));
+                break;
+            case VertexLayout::HalfTexture2D:
+                SetAttribute<VertexLayout::HalfTexture2D>(pAttribute, std::forward<T>(val));
+                break;
+            case VertexLayout::UByte4:
+                SetAttribute<VertexLayout::UByte4>(pAttribute, std::forward<T>(val));
+                break;
+            case VertexLayout::UByte4Norm:
+                SetAttribute<VertexLayout::UByte4Norm>(pAttribute, std::forward<T>(val));
+                break;
             default:
                 assert("Bad element type" && false);
             }
@@ -37,7 +37,6 @@ namespace Bind
 
     void ZVertexBuffer::Bind(ZGraphics& gfx) noexcept
     {
-        const UINT offset = 0u;
-        GetContext(gfx)->IASetVertexBuffers(0u, 1u, pVertexBuffer.GetAddressOf(), &stride, &offset);
+        GetStateCache(gfx).SetVertexBuffer(0u, pVertexBuffer.Get(), stride, 0u);
     }
 }
@@ -20,7 +20,7 @@ namespace Bind
 
     void ZVertexShader::Bind(ZGraphics& gfx) noexcept
     {
-        GetContext(gfx)->VSSetShader(pVertexShader.Get(), nullptr, 0u);
+        GetStateCache(gfx).SetVertexShader(pVertexShader.Get());
     }
 
     ID3DBlob* ZVertexShader::GetBytecode() const noexcept